@@ -16,6 +16,8 @@
 #include <StGL/StGLContext.h>
 #include <StGLStereo/StFormatEnum.h>
 #include <StFile/StFileNode.h>
+#include <StThreads/StStartupProfiler.h>
+#include <StThreads/StThread.h>
 #include <StVersion.h>
 
 #include "StEventsBuffer.h"
@@ -26,6 +28,13 @@ namespace {
     static const StCString ST_SETTING_RENDERER      = stCString("rendererPlugin");
     static const StCString ST_SETTING_AUTO_VALUE    = stCString("Auto");
     static const StCString ST_SETTING_DEF_DRAWER    = stCString("defaultDrawer");
+    static const StCString ST_SETTING_IDLE_HEARTBEAT = stCString("idleHeartbeatMs");
+
+    /**
+     * Sleep duration within idle iteration (without redraw).
+     * Small enough to keep input latency unnoticeable.
+     */
+    static const int THE_IDLE_SLEEP_MS = 10;
 
     /**
      * Auxiliary parameter.
@@ -67,16 +76,37 @@ void StApplication::doChangeDevice(const int32_t theValue) {
     }
 
     mySwitchTo.nullify();
-    const StHandle<StOutDevice>& aDev = myDevices[theValue];
+    const StHandle<StOutDevice> aDev = myDevices[theValue]; // devices list might be re-filled below
     for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        if(aDev->PluginId == aRend->getRendererId()) {
-            if(aRend->setDevice(aDev->DeviceId)
-            || aRend != myWindow) {
-                mySwitchTo = aRend;
+        if(aDev->PluginId != getRendererId(aRendIter)) {
+            continue;
+        }
+
+        if(initRenderer(aRendIter)) {
+            // placeholder of not yet created renderer has been selected
+            updateDevices();
+            myToRecreateMenu = true; // menu lists devices
+        }
+
+        const StHandle<StWindow>& aRend = myRenderers[aRendIter];
+        StString aDevId = aDev->DeviceId;
+        if(aDevId.isEmpty()) {
+            // choose the best device of just created renderer
+            int aBestPriority = ST_DEVICE_SUPPORT_IGNORE;
+            for(size_t aDevIter = 0; aDevIter < myDevices.size(); ++aDevIter) {
+                const StHandle<StOutDevice>& aRendDev = myDevices[aDevIter];
+                if(aRendDev->PluginId == aDev->PluginId
+                && aRendDev->Priority > aBestPriority) {
+                    aBestPriority = aRendDev->Priority;
+                    aDevId        = aRendDev->DeviceId;
+                }
             }
-            break;
         }
+        if(aRend->setDevice(aDevId)
+        || aRend != myWindow) {
+            mySwitchTo = aRend;
+        }
+        break;
     }
 }
 
@@ -88,11 +118,17 @@ StApplication::StApplication(const StHandle<StResourceManager>& theResMgr,
   myEventsBuffer(new StEventsBuffer()),
   myWinParent(theParentWin),
   myRendId(ST_SETTING_AUTO_VALUE),
+  myToProfileStartup(false),
+  myIsFirstFrameDrawn(false),
   myExitCode(0),
   myGlDebug(false),
   myIsOpened(false),
   myToQuit(false),
-  myToRecreateMenu(false) {
+  myToRecreateMenu(false),
+  myToRedraw(true),
+  myRedrawTimer(true),
+  myStatsTimer(true),
+  myDrawTimer(false) {
     stApplicationInit(theOpenInfo);
 }
 
@@ -103,6 +139,7 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
 #ifdef ST_DEBUG_GL
     myGlDebug = true;
 #endif
+    StStartupProfiler::Scope aProfScope("StApplication init");
     StSettings aGlobalSettings(myResMgr, "sview");
     params.ActiveDevice = new StEnumParam(0, stCString("activeDevice"), stCString("Change device"));
     params.ActiveDevice->signals.onChanged.connect(this, &StApplication::doChangeDevice);
@@ -112,6 +149,9 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
     params.VSyncMode->changeValues().add("On");
     params.VSyncMode->changeValues().add("Mixed");
 
+    params.IdleHeartbeat = new StInt32ParamNamed(1000, ST_SETTING_IDLE_HEARTBEAT, stCString("Idle redraw period"));
+    aGlobalSettings.loadParam(params.IdleHeartbeat);
+
     bool isOutModeAuto = true; // AUTO by default
     aGlobalSettings.loadBool(ST_SETTING_RENDERER_AUTO, isOutModeAuto);
     if(!isOutModeAuto) {
@@ -136,9 +176,11 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
     const StString ARGUMENT_PLUGIN_OUT        = "out";
     const StString ARGUMENT_PLUGIN_OUT_DEVICE = "outDevice";
     const StString ARGUMENT_GLDEBUG           = "gldebug";
+    const StString ARGUMENT_PROFILE_STARTUP   = "profileStartup";
     StArgument anArgRenderer = anArgs[ARGUMENT_PLUGIN_OUT];
     StArgument anArgDevice   = anArgs[ARGUMENT_PLUGIN_OUT_DEVICE];
     StArgument anArgGlDebug  = anArgs[ARGUMENT_GLDEBUG];
+    StArgument anArgProfile  = anArgs[ARGUMENT_PROFILE_STARTUP];
     if(anArgRenderer.isValid()) {
         myRendId = anArgRenderer.getValue();
     }
@@ -148,6 +190,14 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
     if(anArgGlDebug.isValid()) {
         myGlDebug = true;
     }
+    if(anArgProfile.isValid()) {
+        // --profileStartup dumps startup phases into log, --profileStartup=file.json also into the file
+        myToProfileStartup = true;
+        if(!anArgProfile.getValue().isEmpty()
+        && !anArgProfile.getValue().isEqualsIgnoreCase(stCString("on"))) {
+            myProfileStartup = anArgProfile.getValue();
+        }
+    }
 }
 
 StApplication::~StApplication() {
@@ -172,6 +222,7 @@ bool StApplication::open() {
         return true;
     }
 
+    const int aProfPhase = StStartupProfiler::getDefault().begin("renderer init");
     StSettings aGlobalSettings(myResMgr, "sview");
     if(!mySwitchTo.isNull()) {
         myRendId = mySwitchTo->getRendererId();
@@ -187,10 +238,13 @@ bool StApplication::open() {
         } else {
             bool isAuto = myRendId.isEqualsIgnoreCase(ST_SETTING_AUTO_VALUE);
             if(!isAuto) {
+                // create only requested renderer, others will be created when selected
                 for(size_t anIter = 0; anIter < myRenderers.size(); ++anIter) {
-                    StHandle<StWindow> aWin = myRenderers[anIter];
-                    if(myRendId == aWin->getRendererId()) {
-                        myWindow = aWin;
+                    if(myRendId == getRendererId(anIter)) {
+                        if(initRenderer(anIter)) {
+                            updateDevices();
+                        }
+                        myWindow = myRenderers[anIter];
                         aGlobalSettings.saveString(ST_SETTING_RENDERER,      myRendId);
                         aGlobalSettings.saveBool  (ST_SETTING_RENDERER_AUTO, isAuto);
                         break;
@@ -204,7 +258,8 @@ bool StApplication::open() {
             }
 
             if(isAuto) {
-                // autodetection
+                // autodetection - requires devices list of all renderers
+                initRenderers();
                 aGlobalSettings.saveString(ST_SETTING_RENDERER,      ST_SETTING_AUTO_VALUE);
                 aGlobalSettings.saveBool  (ST_SETTING_RENDERER_AUTO, isAuto);
                 myWindow = myRenderers[0];
@@ -248,8 +303,11 @@ bool StApplication::open() {
         StWinAttr_NULL
     };
     myWindow->setAttributes(anAttribs);
+    StStartupProfiler::getDefault().end(aProfPhase);
 
+    const int aProfPhaseGl = StStartupProfiler::getDefault().begin("GL context");
     myIsOpened = myWindow->create();
+    StStartupProfiler::getDefault().end(aProfPhaseGl);
     if(myIsOpened) {
         // connect slots
         myWindow->signals.onRedraw    = stSlot(this, &StApplication::doDrawProxy);
@@ -280,7 +338,11 @@ void StApplication::addRenderer(const StHandle<StWindow>& theRenderer) {
     StHandle<StWindow> aRenderer = theRenderer;
     aRenderer->params.VSyncMode = params.VSyncMode; // share VSync mode between renderers
     aRenderer->setMessagesQueue(myMsgQueue);
+    if(!myRendererAttribs.empty()) {
+        aRenderer->setAttributes(&myRendererAttribs[0]);
+    }
     myRenderers.add(aRenderer);
+    myRendererFactories.push_back(StHandle<StRendererFactory>());
     size_t aDevIter = myDevices.size();
     aRenderer->getDevices(myDevices);
     for(; aDevIter < myDevices.size(); ++aDevIter) {
@@ -288,10 +350,129 @@ void StApplication::addRenderer(const StHandle<StWindow>& theRenderer) {
     }
 }
 
+void StApplication::addRenderer(const StHandle<StRendererFactory>& theFactory) {
+    if(theFactory.isNull()) {
+        return;
+    }
+
+    myRenderers.add(StHandle<StWindow>());
+    myRendererFactories.push_back(theFactory);
+}
+
+void StApplication::setRendererAttributes(const StWinAttr* theAttribs) {
+    myRendererAttribs.clear();
+    for(const StWinAttr* anAttrib = theAttribs; *anAttrib != StWinAttr_NULL; anAttrib += 2) {
+        myRendererAttribs.push_back(anAttrib[0]);
+        myRendererAttribs.push_back(anAttrib[1]);
+    }
+    myRendererAttribs.push_back(StWinAttr_NULL);
+
+    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
+        StHandle<StWindow>& aRend = myRenderers[aRendIter];
+        if(!aRend.isNull()) {
+            aRend->setAttributes(&myRendererAttribs[0]);
+        }
+    }
+}
+
+StString StApplication::getRendererId(const size_t theIndex) const {
+    const StHandle<StWindow>& aRend = myRenderers[theIndex];
+    if(!aRend.isNull()) {
+        return aRend->getRendererId();
+    }
+    const StHandle<StRendererFactory>& aFactory = myRendererFactories[theIndex];
+    return !aFactory.isNull() ? StString(aFactory->getRendererId()) : StString();
+}
+
+bool StApplication::initRenderer(const size_t theIndex) {
+    StHandle<StWindow>& aRend = myRenderers.changeValue(theIndex);
+    const StHandle<StRendererFactory>& aFactory = myRendererFactories[theIndex];
+    if(!aRend.isNull()
+    ||  aFactory.isNull()) {
+        return false;
+    }
+
+    StStartupProfiler::Scope aProfScope(aFactory->getRendererId());
+    aRend = aFactory->create(myResMgr, myWinParent);
+    aRend->params.VSyncMode = params.VSyncMode; // share VSync mode between renderers
+    aRend->setMessagesQueue(myMsgQueue);
+    if(!myRendererAttribs.empty()) {
+        aRend->setAttributes(&myRendererAttribs[0]);
+    }
+    return true;
+}
+
+void StApplication::initRenderers() {
+    bool isCreated = false;
+    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
+        if(initRenderer(aRendIter)) {
+            isCreated = true;
+        }
+    }
+    if(isCreated) {
+        updateDevices();
+        myToRecreateMenu = myToRecreateMenu || myIsOpened; // menu lists devices
+    }
+}
+
+void StApplication::updateDevices() {
+    myDevices.clear();
+    params.ActiveDevice->changeValues().clear();
+    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
+        const StHandle<StWindow>& aRend = myRenderers[aRendIter];
+        if(aRend.isNull()) {
+            const StHandle<StRendererFactory>& aFactory = myRendererFactories[aRendIter];
+            if(aFactory.isNull()) {
+                continue;
+            }
+
+            // placeholder with empty device id - renderer will be created when selected
+            StHandle<StOutDevice> aPlaceholder = new StOutDevice();
+            aPlaceholder->PluginId = aFactory->getRendererId();
+            aPlaceholder->Name     = aFactory->getTitle();
+            aPlaceholder->Desc     = aFactory->getTitle();
+            aPlaceholder->Priority = ST_DEVICE_SUPPORT_NONE;
+            myDevices.add(aPlaceholder);
+            params.ActiveDevice->changeValues().add(aPlaceholder->Name);
+            continue;
+        }
+
+        size_t aDevIter = myDevices.size();
+        aRend->getDevices(myDevices);
+        for(; aDevIter < myDevices.size(); ++aDevIter) {
+            params.ActiveDevice->changeValues().add(myDevices[aDevIter]->Name);
+        }
+    }
+    if(myWindow.isNull()) {
+        return;
+    }
+
+    const StString aPluginId = myWindow->getRendererId();
+    const StString aDeviceId = myWindow->getDeviceId();
+    for(size_t aDevIter = 0; aDevIter < myDevices.size(); ++aDevIter) {
+        const StHandle<StOutDevice>& aDev = myDevices[aDevIter];
+        if(aPluginId == aDev->PluginId
+        && aDeviceId == aDev->DeviceId) {
+            params.ActiveDevice->setValue((int32_t )aDevIter);
+            break;
+        }
+    }
+}
+
 void StApplication::beforeDraw() {
     //
 }
 
+bool StApplication::isRedrawNeeded() const {
+    const int32_t aHeartbeat = params.IdleHeartbeat->getValue();
+    return aHeartbeat <= 0
+        || myToRedraw
+        || myWindow->hasNewEvents()
+        || myWindow->isPaused() // let application handle inactivity
+        || myWindow->toDrawContinuously()
+        || myRedrawTimer.getElapsedTimeInMilliSec() >= double(aHeartbeat);
+}
+
 void StApplication::doDrawProxy(unsigned int theView) {
     stglDraw(!myWindow.isNull() && myWindow->isStereoOutput() ? theView : ST_DRAW_MONO);
 }
@@ -489,6 +670,9 @@ void StApplication::processEvents() {
 
     // application-specific queued events
     myEventsBuffer->swapBuffers();
+    if(myEventsBuffer->getSize() != 0) {
+        myToRedraw = true;
+    }
     for(size_t anEventIter = 0; anEventIter < myEventsBuffer->getSize(); ++anEventIter) {
         StEvent& anEvent = myEventsBuffer->changeEvent(anEventIter);
         if(anEvent.Type == stEvent_Action) {
@@ -498,16 +682,48 @@ void StApplication::processEvents() {
 
     // draw iteration
     beforeDraw();
-    myWindow->stglDraw();
+    if(isRedrawNeeded()) {
+        myToRedraw = false; // reset before drawing - drawing itself might request another redraw
+        myRedrawTimer.restart();
+        myDrawTimer.restart();
+        myWindow->stglDraw();
+        myRedrawStatsAcc.DrawTimeMs += myDrawTimer.getElapsedTimeInMilliSec();
+        ++myRedrawStatsAcc.NbDrawn;
+        if(!myIsFirstFrameDrawn) {
+            myIsFirstFrameDrawn = true;
+            StStartupProfiler& aProfiler = StStartupProfiler::getDefault();
+            aProfiler.mark("first frame");
+            if(aProfiler.finish()
+            && myToProfileStartup) {
+                aProfiler.dumpToLog();
+                if(!myProfileStartup.isEmpty()) {
+                    aProfiler.dumpToJson(myProfileStartup);
+                }
+            }
+        }
+    } else {
+        ++myRedrawStatsAcc.NbSkipped;
+        StThread::sleep(THE_IDLE_SLEEP_MS);
+    }
+
+    const double aStatsPeriod = myStatsTimer.getElapsedTimeInMilliSec();
+    if(aStatsPeriod >= 1000.0) {
+        myRedrawStatsAcc.PeriodMs = aStatsPeriod;
+        myRedrawStats    = myRedrawStatsAcc;
+        myRedrawStatsAcc = RedrawStats();
+        myStatsTimer.restart();
+    }
 
     const StString aDevice = myWindow->getDeviceId();
     const int32_t  aDevNum = params.ActiveDevice->getValue();
     if(!mySwitchTo.isNull()) {
+        myToRedraw = true;
         if(!resetDevice()) {
             myToQuit = true;
         }
         mySwitchTo.nullify();
     } else if(myWindow->isLostDevice()) {
+        myToRedraw = true;
         mySwitchTo = myWindow;
         if(!resetDevice()) {
             myToQuit = true;
@@ -639,8 +855,10 @@ void StApplication::doChangeLanguage(const int32_t ) {
     myLangMap->resetReloaded();
 
     for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        aRend->doChangeLanguage();
+        StHandle<StWindow>& aRend = myRenderers.changeValue(aRendIter);
+        if(!aRend.isNull()) {
+            aRend->doChangeLanguage();
+        }
     }
 
     for(size_t aDevIter = 0; aDevIter < myDevices.size(); ++aDevIter) {
@@ -19,7 +19,8 @@
  * Swap method reverse buffers mission.
  *
  * Current implementation is lossy - buffers created with limited size
- * and if not swaped in time, new events will be lost.
+ * and if not swaped in time, new events will be lost (counted by getNbDropped()).
+ * Consecutive resize events are folded into the last one.
  */
 class StEventsBuffer {
 
@@ -36,7 +37,9 @@ class StEventsBuffer {
     : myEventsRead (new StEvent[BUFFER_SIZE]),
       myEventsWrite(new StEvent[BUFFER_SIZE]),
       mySizeRead (0),
-      mySizeWrite(0) {
+      mySizeWrite(0),
+      myNbDroppedRead (0),
+      myNbDroppedWrite(0) {
         //
     }
 
@@ -58,6 +61,8 @@ class StEventsBuffer {
         swapBuffers();
         mySizeRead  = 0;
         mySizeWrite = 0;
+        myNbDroppedRead  = 0;
+        myNbDroppedWrite = 0;
     }
 
     /**
@@ -67,6 +72,13 @@ class StEventsBuffer {
         return mySizeRead;
     }
 
+    /**
+     * @return number of events dropped due to write buffer overflow before last swap
+     */
+    ST_LOCAL size_t getNbDropped() const {
+        return myNbDroppedRead;
+    }
+
     /**
      * @param theId Index of event to retrieve
      * @return event from read-only buffer
@@ -88,7 +100,14 @@ class StEventsBuffer {
      */
     ST_LOCAL void append(const StEvent& theEvent) {
         StMutexAuto aLock(myMutex);
-        if(mySizeWrite >= BUFFER_SIZE) {
+        if(theEvent.Type == stEvent_Size
+        && mySizeWrite != 0
+        && myEventsWrite[mySizeWrite - 1].Type == stEvent_Size) {
+            // only the last size is of interest
+            myEventsWrite[mySizeWrite - 1] = theEvent;
+            return;
+        } else if(mySizeWrite >= BUFFER_SIZE) {
+            ++myNbDroppedWrite;
             return;
         }
 
@@ -145,15 +164,19 @@ class StEventsBuffer {
         std::swap(myEventsRead, myEventsWrite);
         mySizeRead  = mySizeWrite;
         mySizeWrite = 0;
+        myNbDroppedRead  = myNbDroppedWrite;
+        myNbDroppedWrite = 0;
     }
 
         private: //! @name private fields
 
-    StMutex  myMutex;       //!< mutex for thread-safe access
-    StEvent* myEventsRead;  //!< read-only  events buffer, could be accessed by StWindow thread without lock
-    StEvent* myEventsWrite; //!< write-only events buffer, each insertion operation is protected with mutex
-    size_t   mySizeRead;    //!< number of events in read-only  buffer
-    size_t   mySizeWrite;   //!< number of events in write-only buffer
+    StMutex  myMutex;          //!< mutex for thread-safe access
+    StEvent* myEventsRead;     //!< read-only  events buffer, could be accessed by StWindow thread without lock
+    StEvent* myEventsWrite;    //!< write-only events buffer, each insertion operation is protected with mutex
+    size_t   mySizeRead;       //!< number of events in read-only  buffer
+    size_t   mySizeWrite;      //!< number of events in write-only buffer
+    size_t   myNbDroppedRead;  //!< number of events dropped before last swap
+    size_t   myNbDroppedWrite; //!< number of events dropped since last swap
 
 };
 
@@ -289,6 +289,11 @@ bool StWindow::isMouseMoved() const {
     return myWin->myIsMouseMoved;
 }
 
+bool StWindow::hasNewEvents() const {
+    return myWin->myHasNewEvents
+        || myWin->myIsMouseMoved;
+}
+
 const StHandle<StResourceManager>& StWindow::getResourceManager() const {
     return myWin->myResMgr;
 }
@@ -422,6 +427,10 @@ bool StWindow::toTrackOrientation() const {
     return myWin->myToTrackOrient;
 }
 
+bool StWindow::toDrawContinuously() const {
+    return toTrackOrientation();
+}
+
 void StWindow::setTrackOrientation(const bool theToTrack) {
     if(myWin->myHasOrientSensor) {
         myWin->myToTrackOrient = theToTrack;
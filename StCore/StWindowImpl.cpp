@@ -94,7 +94,8 @@ StWindowImpl::StWindowImpl(const StHandle<StResourceManager>& theResMgr,
   myAlignDB(0),
   myLastEventsTime(0.0),
   myEventsThreaded(false),
-  myIsMouseMoved(false) {
+  myIsMouseMoved(false),
+  myHasNewEvents(false) {
     stMemZero(&attribs, sizeof(attribs));
     stMemZero(&signals, sizeof(signals));
     myStEvent   .Type = stEvent_None;
@@ -1435,6 +1436,10 @@ void StWindowImpl::doTouch(const StTouchEvent& theTouches) {
 
 void StWindowImpl::swapEventsBuffers() {
     myEventsBuffer.swapBuffers();
+    myHasNewEvents = myEventsBuffer.getSize() != 0;
+    if(myEventsBuffer.getNbDropped() != 0) {
+        ST_ERROR_LOG("StWindow, " + myEventsBuffer.getNbDropped() + " events have been dropped due to buffer overflow");
+    }
     for(size_t anEventIter = 0; anEventIter < myEventsBuffer.getSize(); ++anEventIter) {
         StEvent& anEvent = myEventsBuffer.changeEvent(anEventIter);
         switch(anEvent.Type) {
@@ -1546,6 +1551,7 @@ void StWindowImpl::swapEventsBuffers() {
                 aHoldEvent.Flags = StVirtFlags(aHoldEvent.Flags | ST_VF_FUNCTION);
             }
             if(aHoldEvent.Progress > 1.e-7) {
+                myHasNewEvents = true;
                 signals.onKeyHold->emit(aHoldEvent);
             }
         }
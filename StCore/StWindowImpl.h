@@ -488,6 +488,7 @@ class StWindowImpl {
     double         myLastEventsTime;   //!< time when processEvents() was last called
     bool           myEventsThreaded;
     bool           myIsMouseMoved;
+    bool           myHasNewEvents;     //!< flag indicating that some events have been processed within last swapEventsBuffers()
 
 };
 
@@ -128,7 +128,7 @@ void StGLCheckbox::stglDraw(unsigned int theView) {
         stglResize();
     }
 
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
     aProgram.use(aCtx, getRoot()->getScreenDispX());
     myVertBuf.bindVertexAttrib  (aCtx, aProgram.getVVertexLoc());
@@ -12,6 +12,7 @@
 
 #include <StGL/StGLContext.h>
 #include <StGLCore/StGLCore20.h>
+#include <StStrings/StStringBuilder.h>
 
 StGLFpsLabel::StGLFpsLabel(StGLWidget* theParent)
 : StGLTextArea(theParent,
@@ -23,8 +24,17 @@ StGLFpsLabel::StGLFpsLabel(StGLWidget* theParent)
   myPlayFps(-1.0),
   myPlayQueued(0),
   myPlayQueueLen(0),
+  myNbDrawn(0),
+  myNbSkipped(0),
+  myBusyRatio(-1.0),
+  myClockDriftPpm(0.0),
+  myNbDropped(0),
+  myNbRepeated(0),
+  myHasSyncStats(false),
   myTimer(true),
-  myCounter(0) {
+  myCounter(0),
+  myNbStrAllocs(stStrAllocCounter()) {
+    stMemZero(mySyncErrors, sizeof(mySyncErrors));
     StGLWidget::signals.onMouseUnclick.connect(this, &StGLFpsLabel::doMouseUnclick);
 
     setupAlignment(StGLTextFormatter::ST_ALIGN_X_CENTER,
@@ -45,7 +55,6 @@ void StGLFpsLabel::doMouseUnclick(const int ) {
 void StGLFpsLabel::update(const bool      theIsStereo,
                           const double    theTargetFps,
                           const StString& theExtraInfo) {
-    char aBuffer[128];
     const double aTime = myTimer.getElapsedTimeInSec();
     if(aTime < 1.0) {
         ++myCounter;
@@ -54,19 +63,46 @@ void StGLFpsLabel::update(const bool      theIsStereo,
 
     myTimer.restart();
     const double aFpsCurrent = double(myCounter) / aTime;
+    StStringBuilder aText;
     if(myPlayFps <= 0.0) {
-        stsprintf(aBuffer, 128, "%c %4.1f (%4.1f)",
-                  theIsStereo ? 'S' : 'M', aFpsCurrent, theTargetFps);
+        aText.appendFormat("%c %4.1f (%4.1f)",
+                           theIsStereo ? 'S' : 'M', aFpsCurrent, theTargetFps);
     } else {
-        stsprintf(aBuffer, 128, "%c %4.1f (%4.1f)\n%d / %d [%4.1f]",
-                  theIsStereo ? 'S' : 'M', aFpsCurrent, theTargetFps,
-                  myPlayQueued, myPlayQueueLen, myPlayFps);
+        aText.appendFormat("%c %4.1f (%4.1f)\n%d / %d [%4.1f]",
+                           theIsStereo ? 'S' : 'M', aFpsCurrent, theTargetFps,
+                           myPlayQueued, myPlayQueueLen, myPlayFps);
     }
-    StString aText(aBuffer);
+
+    const StGLRootWidget::DrawStats& aStats = myRoot->getDrawStats();
+    aText.appendFormat("\nUI %u draws (%u blocks) %u binds %4.2f ms",
+                       aStats.NbTextDraws, aStats.NbTextBlocks, aStats.NbProgramBinds, aStats.CpuTimeMs);
+    if(myRoot->isCachedGui()) {
+        aText.appendFormat(", cache %u hits %u updates",
+                           aStats.NbCacheHits, aStats.NbCacheUpdates);
+    }
+    if(myBusyRatio >= 0.0) {
+        aText.appendFormat("\nRedraws %u, idle %u, busy %4.1f%%",
+                           myNbDrawn, myNbSkipped, 100.0 * myBusyRatio);
+    }
+
+    if(myHasSyncStats) {
+        aText.appendFormat("\nA/V sync %.1f / %.1f / %.1f ms, dropped %u, repeated %u, drift %+.0f ppm",
+                           mySyncErrors[0], mySyncErrors[1], mySyncErrors[2],
+                           myNbDropped, myNbRepeated, myClockDriftPpm);
+    }
+
+#ifdef ST_STR_ALLOC_STATS
+    // string allocations within all threads
+    const uint32_t aNbStrAllocs = stStrAllocCounter();
+    aText.appendFormat("\nStrings %.0f allocs/s", double(aNbStrAllocs - myNbStrAllocs) / aTime);
+    myNbStrAllocs = aNbStrAllocs;
+#endif
+
     if(!theExtraInfo.isEmpty()) {
-        aText += "\n";
-        aText += theExtraInfo;
+        aText << "\n" << theExtraInfo;
+    }
+    if(!aText.isEquals(getText())) {
+        setText(aText.toString());
     }
-    setText(aText);
     myCounter = 1;
 }
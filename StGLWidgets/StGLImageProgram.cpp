@@ -17,19 +17,23 @@ namespace {
     const char F_DEF_2D_ALPHA[] =
         "#define stSampler sampler2D\n"
         "#define stTexture(theSampler, theCoords) texture2D(theSampler, theCoords.xy)\n"
-        "#define stAlpha a\n";
+        "#define stAlpha a\n"
+        "#define stUV ra\n";
     const char F_DEF_2D_RED[] =
         "#define stSampler sampler2D\n"
         "#define stTexture(theSampler, theCoords) texture2D(theSampler, theCoords.xy)\n"
-        "#define stAlpha r\n";
+        "#define stAlpha r\n"
+        "#define stUV rg\n";
     const char F_DEF_CUBEMAP_ALPHA[] =
         "#define stSampler samplerCube\n"
         "#define stTexture(theSampler, theCoords) textureCube(theSampler, theCoords)\n"
-        "#define stAlpha a\n";
+        "#define stAlpha a\n"
+        "#define stUV ra\n";
     const char F_DEF_CUBEMAP_RED[] =
         "#define stSampler samplerCube\n"
         "#define stTexture(theSampler, theCoords) textureCube(theSampler, theCoords)\n"
-        "#define stAlpha r\n";
+        "#define stAlpha r\n"
+        "#define stUV rg\n";
 }
 
 void StGLImageProgram::regToRgb(const StGLContext& theCtx,
@@ -189,7 +193,7 @@ void StGLImageProgram::registerFragments(const StGLContext& theCtx) {
     const char F_SHADER_YUVNV2RGB_MPEG[] =
        "uniform stSampler uTextureU;\n"
        "void convertToRGB(inout vec4 color, in vec3 texCoordUV) {\n"
-       "    vec3 colorYUV = vec3(color.a, stTexture(uTextureU, texCoordUV).r, stTexture(uTextureU, texCoordUV).a);\n"
+       "    vec3 colorYUV = vec3(color.stAlpha, stTexture(uTextureU, texCoordUV).stUV);\n"
        "    colorYUV   *= TheRangeBits;\n"
        "    colorYUV.x  = 1.1643 * (colorYUV.x - 0.0625);\n"
        "    colorYUV.y -= 0.5;\n"
@@ -202,7 +206,7 @@ void StGLImageProgram::registerFragments(const StGLContext& theCtx) {
     const char F_SHADER_YUVNV2RGB_FULL[] =
        "uniform stSampler uTextureU;\n"
        "void convertToRGB(inout vec4 color, in vec3 texCoordUV) {\n"
-       "    vec3 colorYUV = vec3(color.a, stTexture(uTextureU, texCoordUV).r, stTexture(uTextureU, texCoordUV).a);\n"
+       "    vec3 colorYUV = vec3(color.stAlpha, stTexture(uTextureU, texCoordUV).stUV);\n"
        "    colorYUV   *= TheRangeBits;\n"
        "    colorYUV.x  = colorYUV.x;\n"
        "    colorYUV.y -= 0.5;\n"
@@ -244,6 +248,15 @@ void StGLImageProgram::registerFragments(const StGLContext& theCtx) {
         + "const float TheRangeBits = 1.0;\n"
         + F_SHADER_YUVNV2RGB_MPEG);
 
+    // P010 stores 10 bits in upper bits of 16 bits
+    regToRgb(theCtx, FragToRgb_FromYuvNv10Full, StString()
+        + "const float TheRangeBits = 65535.0 / 65472.0;\n"
+        + F_SHADER_YUVNV2RGB_FULL);
+
+    regToRgb(theCtx, FragToRgb_FromYuvNv10Mpeg, StString()
+        + "const float TheRangeBits = 65535.0 / 65472.0;\n"
+        + F_SHADER_YUVNV2RGB_MPEG);
+
     // main shader parts
     const char V_SHADER_FLAT[] =
        "uniform mat4 uProjMat;\n"
@@ -307,9 +320,95 @@ void StGLImageProgram::registerFragments(const StGLContext& theCtx) {
        "    gl_FragColor = aColor;\n"
        "}";
 
-    registerVertexShaderPart  (0, VertMain_Normal,  V_SHADER_FLAT);
-    registerVertexShaderPart  (0, VertMain_Cubemap, V_SHADER_CUBEMAP);
-    registerFragmentShaderPart(FragSection_Main, 0, F_SHADER_FLAT);
+    // view ray (in eye space) is interpolated across full-screen quad,
+    // while texture coordinates are computed per fragment - so that no tessellated mesh is required
+    const char V_SHADER_PANORAMA[] =
+       "uniform mat4 uProjMat;\n"
+
+       "attribute vec4 vVertex;\n"
+
+       "varying vec3 fTexCoord;\n"
+
+       "void main(void) {\n"
+       "    gl_Position = vec4(vVertex.x, vVertex.y, 0.0, 1.0);\n"
+       "    fTexCoord   = (uProjMat * gl_Position).xyz;\n"
+       "}\n";
+
+    const char F_SHADER_PANORAMA[] =
+       "uniform mat4  uModelMat;\n"
+       "uniform vec4  uTexData;\n"
+       "uniform vec4  uTexUVData;\n"
+       "uniform float uPanoProjection;\n"
+       "varying vec3  fTexCoord;\n"
+
+       "vec4 getColor(in vec3 texCoord);\n"
+       "void convertToRGB(inout vec4 theColor, in vec3 theTexUVCoord);\n"
+       "void applyCorrection(inout vec4 theColor);\n"
+       "void applyGamma(inout vec4 theColor);\n"
+       "bool getSurfaceCoord(in vec3 theRay, out vec2 theCoord);\n"
+
+       "void main(void) {\n"
+       "    vec3 aRay = fTexCoord;\n"
+       "    if(uPanoProjection > 0.5) {\n"
+                // re-interpret point on the rectilinear image plane
+       "        vec2  aPlane = aRay.xy / -aRay.z;\n"
+       "        float aDist  = length(aPlane);\n"
+       "        if(uPanoProjection > 1.5) {\n"
+                    // equidistant fisheye - distance from center is proportional to the angle
+       "            vec2 aDir = aDist > 0.0 ? aPlane / aDist : vec2(0.0);\n"
+       "            aRay = vec3(sin(aDist) * aDir, -cos(aDist));\n"
+       "        } else {\n"
+                    // stereographic
+       "            aRay = vec3(2.0 * aPlane, aDist * aDist - 1.0);\n"
+       "        }\n"
+       "    }\n"
+       "    aRay = (uModelMat * vec4(aRay, 0.0)).xyz;\n"
+
+       "    vec2 aCoord;\n"
+       "    if(!getSurfaceCoord(normalize(aRay), aCoord)) {\n"
+       "        discard;\n"
+       "    }\n"
+       "    vec4 aColor = getColor(vec3(uTexData.xy + aCoord * uTexData.zw, 0.0));\n"
+       "    convertToRGB(aColor, vec3(uTexUVData.xy + aCoord * uTexUVData.zw, 0.0));\n"
+       "    applyCorrection(aColor);\n"
+       "    applyGamma(aColor);\n"
+       "    gl_FragColor = aColor;\n"
+       "}";
+
+    // texture coordinates are defined in the same way as by StGLUVSphere and StGLUVCylinder meshes
+    registerFragmentShaderPart(FragSection_Surface, FragSurface_Flat, "");
+    registerFragmentShaderPart(FragSection_Surface, FragSurface_Sphere,
+       "const float THE_PI = 3.1415926535897932;\n"
+       "bool getSurfaceCoord(in vec3 theRay, out vec2 theCoord) {\n"
+       "    float aPhi = atan(theRay.z, theRay.x);\n"
+       "    if(aPhi < 0.0) { aPhi += 2.0 * THE_PI; }\n"
+       "    theCoord = vec2(aPhi / (2.0 * THE_PI), asin(clamp(theRay.y, -1.0, 1.0)) / THE_PI + 0.5);\n"
+       "    return true;\n"
+       "}\n\n");
+    registerFragmentShaderPart(FragSection_Surface, FragSurface_Hemisphere,
+       "const float THE_PI = 3.1415926535897932;\n"
+       "bool getSurfaceCoord(in vec3 theRay, out vec2 theCoord) {\n"
+       "    float aPhi = atan(theRay.z, theRay.x);\n"
+       "    if(aPhi < 0.0) { aPhi += 2.0 * THE_PI; }\n"
+       "    theCoord = vec2(aPhi / THE_PI - 0.5, asin(clamp(theRay.y, -1.0, 1.0)) / THE_PI + 0.5);\n"
+       "    return theCoord.x >= 0.0 && theCoord.x <= 1.0;\n"
+       "}\n\n");
+    registerFragmentShaderPart(FragSection_Surface, FragSurface_Cylinder,
+       "const float THE_PI = 3.1415926535897932;\n"
+       "bool getSurfaceCoord(in vec3 theRay, out vec2 theCoord) {\n"
+       "    float aRadius = length(theRay.xz);\n"
+       "    if(aRadius < 0.0001) { return false; }\n"
+       "    float aPhi = atan(theRay.z, theRay.x);\n"
+       "    if(aPhi < 0.0) { aPhi += 2.0 * THE_PI; }\n"
+       "    theCoord = vec2(aPhi / (2.0 * THE_PI), theRay.y / aRadius + 0.5);\n"
+       "    return theCoord.y >= 0.0 && theCoord.y <= 1.0;\n"
+       "}\n\n");
+
+    registerVertexShaderPart  (0, VertMain_Normal,   V_SHADER_FLAT);
+    registerVertexShaderPart  (0, VertMain_Cubemap,  V_SHADER_CUBEMAP);
+    registerVertexShaderPart  (0, VertMain_Panorama, V_SHADER_PANORAMA);
+    registerFragmentShaderPart(FragSection_Main, FragMain_Flat,     F_SHADER_FLAT);
+    registerFragmentShaderPart(FragSection_Main, FragMain_Panorama, F_SHADER_PANORAMA);
 }
 
 StGLImageProgram::~StGLImageProgram() {
@@ -337,6 +436,11 @@ void StGLImageProgram::setCubeTextureFlipZ(StGLContext& theCtx,
     theCtx.core20fwd->glUniform1f(uniTexCubeFlipZLoc, theToFlip ? 1.0f : -1.0f);
 }
 
+void StGLImageProgram::setPanoProjection(StGLContext&         theCtx,
+                                         const PanoProjection theProjection) {
+    theCtx.core20fwd->glUniform1f(uniPanoProjectionLoc, GLfloat(theProjection));
+}
+
 void StGLImageProgram::setupCorrection(StGLContext& theCtx) {
     if(getFragmentShaderPart(FragSection_Correct) == FragCorrect_Off) {
         return;
@@ -371,6 +475,8 @@ static inline StGLImageProgram::FragToRgb getColorShader(const StImage::ImgColor
                 case StImage::ImgScale_Full:   return StGLImageProgram::FragToRgb_FromYuvFull;
                 case StImage::ImgScale_NvMpeg: return StGLImageProgram::FragToRgb_FromYuvNvMpeg;
                 case StImage::ImgScale_NvFull: return StGLImageProgram::FragToRgb_FromYuvNvFull;
+                case StImage::ImgScale_Nv10Mpeg: return StGLImageProgram::FragToRgb_FromYuvNv10Mpeg;
+                case StImage::ImgScale_Nv10Full: return StGLImageProgram::FragToRgb_FromYuvNv10Full;
             }
             return StGLImageProgram::FragToRgb_FromYuvFull;
         }
@@ -385,12 +491,15 @@ static inline StGLImageProgram::FragToRgb getColorShader(const StImage::ImgColor
 bool StGLImageProgram::init(StGLContext&                 theCtx,
                             const StImage::ImgColorModel theColorModel,
                             const StImage::ImgColorScale theColorScale,
-                            const FragGetColor           theFilter) {
+                            const FragGetColor           theFilter,
+                            const FragSurface            theSurface) {
     registerFragments(theCtx);
 
     // re-configure shader parts when required
+    const bool isPanorama = theSurface != FragSurface_Flat;
     bool isChanged = myActiveProgram.isNull();
-    isChanged = setFragmentShaderPart(theCtx, FragSection_Main,    0) || isChanged;
+    isChanged = setFragmentShaderPart(theCtx, FragSection_Main,    isPanorama ? FragMain_Panorama : FragMain_Flat) || isChanged;
+    isChanged = setFragmentShaderPart(theCtx, FragSection_Surface, theSurface) || isChanged;
     isChanged = setFragmentShaderPart(theCtx, FragSection_Gamma,
                                       stAreEqual(params.gamma->getValue(), 1.0f, 0.0001f) ? FragGamma_Off : FragGamma_On) || isChanged;
     isChanged = setFragmentShaderPart(theCtx, FragSection_Correct,
@@ -404,8 +513,13 @@ bool StGLImageProgram::init(StGLContext&                 theCtx,
     }
 
     isChanged = setFragmentShaderPart(theCtx, FragSection_ToRgb,    aToRgb) || isChanged;
-    isChanged = setFragmentShaderPart(theCtx, FragSection_GetColor, theFilter) || isChanged;
-    isChanged = setVertexShaderPart  (theCtx, 0, theFilter == FragGetColor_Cubemap ? VertMain_Cubemap : VertMain_Normal) || isChanged;
+    // blend filter declares uniforms of panorama main function, and has no sense without vertical texture coordinate anyway
+    const FragGetColor aFilter = isPanorama && theFilter == FragGetColor_Blend ? FragGetColor_Normal : theFilter;
+    const VertMain aVertMain = isPanorama
+                             ? VertMain_Panorama
+                             : (theFilter == FragGetColor_Cubemap ? VertMain_Cubemap : VertMain_Normal);
+    isChanged = setFragmentShaderPart(theCtx, FragSection_GetColor, aFilter) || isChanged;
+    isChanged = setVertexShaderPart  (theCtx, 0, aVertMain) || isChanged;
     if(isChanged) {
         if(!initProgram(theCtx)) {
             return false;
@@ -418,6 +532,7 @@ bool StGLImageProgram::init(StGLContext&                 theCtx,
         uniTexSizePxLoc       = myActiveProgram->getUniformLocation(theCtx, "uTexSizePx");
         uniTexelSizePxLoc     = myActiveProgram->getUniformLocation(theCtx, "uTexelSize");
         uniTexCubeFlipZLoc    = myActiveProgram->getUniformLocation(theCtx, "uTexCubeFlipZ");
+        uniPanoProjectionLoc  = myActiveProgram->getUniformLocation(theCtx, "uPanoProjection");
         uniColorProcessingLoc = myActiveProgram->getUniformLocation(theCtx, "uColorProcessing");
         uniGammaLoc           = myActiveProgram->getUniformLocation(theCtx, "uGamma");
         myActiveProgram->atrVVertexLoc  = myActiveProgram->getAttribLocation(theCtx, "vVertex");
@@ -253,6 +253,11 @@ StGLImageRegion::StGLImageRegion(StGLWidget* theParent,
     params.DisplayRatio->defineOption(RATIO_5_4,   stCString("5:4"));
 
     params.ToHealAnamorphicRatio = new StBoolParamNamed(false, stCString("toHealAnamorphic"), stCString("Heal Anamorphic Ratio"));
+    params.ToRayCastPanorama = new StBoolParamNamed(false, stCString("toRayCastPano"), stCString("Ray-cast Panorama"));
+    params.PanoProjection = new StEnumParam(StGLImageProgram::PanoProjection_Perspective, stCString("panoProjection"), stCString("Panorama Projection"));
+    params.PanoProjection->defineOption(StGLImageProgram::PanoProjection_Perspective,   stCString("Perspective"));
+    params.PanoProjection->defineOption(StGLImageProgram::PanoProjection_Stereographic, stCString("Stereographic"));
+    params.PanoProjection->defineOption(StGLImageProgram::PanoProjection_Fisheye,       stCString("Fisheye"));
     params.TextureFilter = new StEnumParam(StGLImageProgram::FILTER_LINEAR, stCString("viewTexFilter"), stCString("Texture Filter"));
     params.TextureFilter->defineOption(StGLImageProgram::FILTER_NEAREST,   stCString("Nearest"));
     params.TextureFilter->defineOption(StGLImageProgram::FILTER_LINEAR,    stCString("Linear"));
@@ -633,6 +638,21 @@ void StGLImageRegion::stglDrawView(unsigned int theView) {
     StGLVec2 aTextureUVSize(GLfloat(aTextures.getPlane(1).getSizeX()),
                             GLfloat(aTextures.getPlane(1).getSizeY()));
     StGLMatrix aModelMat;
+
+    StViewSurface aViewMode = aParams->ViewingMode;
+    if(aTextures.getPlane(0).getTarget() == GL_TEXTURE_CUBE_MAP) {
+        aViewMode = StViewSurface_Cubemap;
+    } else if(aViewMode == StViewSurface_Cubemap) {
+        aViewMode = StViewSurface_Plain;
+    }
+
+    // texture coordinate computed by atan() within ray-cast panorama wraps from 1 to 0 on the seam,
+    // so that screen-space derivatives explode and mip-mapping picks the smallest level
+    // producing a visible line - sample the base level instead
+    const bool toAvoidMipMaps = params.ToRayCastPanorama->getValue()
+                             && (aViewMode == StViewSurface_Sphere
+                              || aViewMode == StViewSurface_Cylinder);
+
     // data rectangle in the texture
     StGLVec4 aClampVec, aClampUV;
     if(params.TextureFilter->getValue() == StGLImageProgram::FILTER_NEAREST) {
@@ -648,7 +668,8 @@ void StGLImageRegion::stglDrawView(unsigned int theView) {
         aClampUV.z() = aTextures.getPlane(1).getDataSize().x();
         aClampUV.w() = aTextures.getPlane(1).getDataSize().y();
     } else {
-        if(params.TextureFilter->getValue() == StGLImageProgram::FILTER_TRILINEAR) {
+        if(params.TextureFilter->getValue() == StGLImageProgram::FILTER_TRILINEAR
+        && !toAvoidMipMaps) {
             myTextureQueue->getQTexture().setMinMagFilter(aCtx, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
         } else {
             myTextureQueue->getQTexture().setMinMagFilter(aCtx, GL_LINEAR);
@@ -708,13 +729,6 @@ void StGLImageRegion::stglDrawView(unsigned int theView) {
 
     const float aVrScale = float(myRoot->getVrZoomOut());
 
-    StViewSurface aViewMode = aParams->ViewingMode;
-    if(aTextures.getPlane(0).getTarget() == GL_TEXTURE_CUBE_MAP) {
-        aViewMode = StViewSurface_Cubemap;
-    } else if(aViewMode == StViewSurface_Cubemap) {
-        aViewMode = StViewSurface_Plain;
-    }
-
     myProgram.setColorScale(aColorScale); // apply de-anaglyph color filter
     StGLImageProgram::FragGetColor aColorGetter = params.TextureFilter->getValue() == StGLImageProgram::FILTER_BLEND
                                                 ? StGLImageProgram::FragGetColor_Blend
@@ -949,21 +963,58 @@ void StGLImageRegion::stglDrawView(unsigned int theView) {
         case StViewSurface_Cylinder:
         case StViewSurface_Hemisphere:
         case StViewSurface_Sphere: {
-            if(!myProgram.init(aCtx, aTextures.getColorModel(), aTextures.getColorScale(), aColorGetter)) {
-                break;
-            }
-
+            const bool toRayCast = params.ToRayCastPanorama->getValue();
+            StGLImageProgram::FragSurface aSurface = StGLImageProgram::FragSurface_Flat;
             GLfloat aVertScale = 1.0f;
             StGLMesh* aMesh = &myUVSphere;
             if(aViewMode == StViewSurface_Hemisphere) {
-                aMesh = &myHemisphere;
+                aMesh    = &myHemisphere;
+                aSurface = StGLImageProgram::FragSurface_Hemisphere;
             } else if(aViewMode == StViewSurface_Cylinder) {
-                aMesh = &myCylinder;
+                aMesh    = &myCylinder;
+                aSurface = StGLImageProgram::FragSurface_Cylinder;
                 const StGLVec2 aSrcSize (aTextures.getPlane().getDataSize().x() * (float )aTextures.getPlane().getSizeX(),
                                          aTextures.getPlane().getDataSize().y() * (float )aTextures.getPlane().getSizeY());
                 aVertScale = float(2.0 * M_PI * aSrcSize.y()) / aSrcSize.x();
                 //aVertScale *= aTextures.getPlane().getDisplayRatio();
+            } else {
+                aSurface = StGLImageProgram::FragSurface_Sphere;
             }
+            if(!myProgram.init(aCtx, aTextures.getColorModel(), aTextures.getColorScale(), aColorGetter,
+                               toRayCast ? aSurface : StGLImageProgram::FragSurface_Flat)) {
+                break;
+            }
+
+            if(toRayCast) {
+                // perform scaling - the same as for the mesh
+                const float aScale = THE_SPHERE_RADIUS * THE_PANORAMA_DEF_ZOOM * aParams->ScaleFactor * aVrScale;
+                aModelMat.scale(aScale, aScale * aVertScale, THE_SPHERE_RADIUS);
+
+                // compute orientation
+                const StGLQuaternion anOri = getHeadOrientation(theView, true);
+                aModelMat = StGLMatrix::multiply(aModelMat, StGLMatrix(anOri));
+
+                myProgram.getActiveProgram()->use(aCtx);
+
+                // setup data rectangle in the texture
+                myProgram.setTextureSizePx      (aCtx, aTextureSize);
+                myProgram.setTextureMainDataSize(aCtx, aClampVec);
+                myProgram.setTextureUVDataSize  (aCtx, aClampUV);
+                myProgram.setPanoProjection     (aCtx, (StGLImageProgram::PanoProjection )params.PanoProjection->getValue());
+
+                // view ray is computed from inverted matrices
+                StGLMatrix aMatModelInv, aMatProjInv;
+                aModelMat.inverted(aMatModelInv);
+                myProjCam.getProjMatrixMono().inverted(aMatProjInv);
+                myProgram.getActiveProgram()->setProjMat (aCtx, aMatProjInv);
+                myProgram.getActiveProgram()->setModelMat(aCtx, aMatModelInv);
+
+                myQuad.draw(aCtx, *myProgram.getActiveProgram());
+
+                myProgram.getActiveProgram()->unuse(aCtx);
+                break;
+            }
+
             if(!aMesh->changeVBO(ST_VBO_VERTEX)->isValid()) {
                 if(!aMesh->initVBOs(aCtx)) {
                     aCtx.pushError(StString("Fail to init StGLUVSphere"));
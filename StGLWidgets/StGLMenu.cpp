@@ -192,7 +192,7 @@ void StGLMenu::stglDraw(unsigned int theView) {
     }
 
     StGLContext& aCtx = getContext();
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
 
     StGLMenuProgram& aProgram = myRoot->getMenuProgram();
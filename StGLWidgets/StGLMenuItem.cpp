@@ -198,7 +198,7 @@ bool StGLMenuItem::stglInit() {
 void StGLMenuItem::stglDrawArea(const StGLMenuItem::State theState,
                                 const bool                theIsOnlyArrow) {
     StGLContext& aCtx = getContext();
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
 
     StGLMenuProgram& aProgram = myRoot->getMenuProgram();
@@ -150,6 +150,7 @@ void StGLMessageBox::create(const StString& theTitle,
 }
 
 StGLMessageBox::~StGLMessageBox() {
+    signals.onDestroy(getUserData());
     if(myRoot->getModalDialog() == this) {
         myRoot->setModalDialog(NULL, false);
     }
@@ -353,7 +354,7 @@ void StGLMessageBox::stglDraw(unsigned int theView) {
 
     StGLMenuProgram& aProgram = myRoot->getMenuProgram();
     if(aProgram.isValid()) {
-        aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        aCtx.stglSetBlendAlpha();
         aCtx.core20fwd->glEnable(GL_BLEND);
 
         aProgram.use(aCtx, getRoot()->getScreenDispX());
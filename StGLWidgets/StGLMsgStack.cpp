@@ -20,7 +20,12 @@ StGLMsgStack::StGLMsgStack(StGLWidget*                 theParent,
 }
 
 StGLMsgStack::~StGLMsgStack() {
-    //
+    // message boxes are children of root widget and may outlive this widget
+    for(int aLevelIter = StLogger::ST_PANIC; aLevelIter <= StLogger::ST_TRACE; ++aLevelIter) {
+        if(myShown[aLevelIter].Box != NULL) {
+            myShown[aLevelIter].Box->signals.onDestroy.disconnect();
+        }
+    }
 }
 
 void StGLMsgStack::stglResize() {
@@ -33,13 +38,57 @@ void StGLMsgStack::stglUpdate(const StPointD_t& thePointZo,
                               bool theIsPreciseInput) {
     StGLWidget::stglUpdate(thePointZo, theIsPreciseInput);
 
-    // check messages stack
-    while(myMsgQueue->pop(myMsgTmp)) {
+    // check messages stack - drain all messages at once per frame
+    if(myMsgQueue->popBatch(myMsgBatch) == 0) {
+        return;
+    }
+
+    for(std::deque<StMsg>::const_iterator aMsgIter = myMsgBatch.begin(); aMsgIter != myMsgBatch.end(); ++aMsgIter) {
+        if(aMsgIter->IsRepeat
+        && updateShown(*aMsgIter)) {
+            continue;
+        }
+
         // always create message boxes in root widget
         // so that StGLRootWidget::setFocus() logic work as expected
-        //StGLMessageBox* aMsgBox = new StGLMessageBox(this, "", *myMsgTmp.Text);
-        StGLMessageBox* aMsgBox = new StGLMessageBox(myRoot, "", *myMsgTmp.Text);
+        //StGLMessageBox* aMsgBox = new StGLMessageBox(this, "", aMsgIter->getText());
+        StGLMessageBox* aMsgBox = new StGLMessageBox(myRoot, "", aMsgIter->getText());
         aMsgBox->addButton("Close");
         aMsgBox->stglInit();
+        if(aMsgIter->Level >= StLogger::ST_PANIC
+        && aMsgIter->Level <= StLogger::ST_TRACE) {
+            Shown& aShown = myShown[aMsgIter->Level];
+            if(aShown.Box != NULL) {
+                aShown.Box->signals.onDestroy.disconnect();
+            }
+            aShown.Box = aMsgBox;
+            aShown.Msg = *aMsgIter;
+            aMsgBox->setUserData(size_t(aMsgIter->Level));
+            aMsgBox->signals.onDestroy.connect(this, &StGLMsgStack::doBoxDestroyed);
+        }
+    }
+    myMsgBatch.clear();
+}
+
+bool StGLMsgStack::updateShown(const StMsg& theMsg) {
+    if(theMsg.Level < StLogger::ST_PANIC
+    || theMsg.Level > StLogger::ST_TRACE) {
+        return false;
+    }
+
+    Shown& aShown = myShown[theMsg.Level];
+    if(aShown.Box == NULL
+    || !aShown.Msg.isSame(theMsg)) {
+        return false;
+    }
+
+    aShown.Msg.NbRepeats += theMsg.NbRepeats;
+    aShown.Box->setText(aShown.Msg.getText());
+    return true;
+}
+
+void StGLMsgStack::doBoxDestroyed(const size_t theLevel) {
+    if(theLevel < sizeof(myShown) / sizeof(myShown[0])) {
+        myShown[theLevel].Box = NULL;
     }
 }
@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2015-2019 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2015-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * Distributed under the Boost Software License, Version 1.0.
  * See accompanying file license-boost.txt or copy at
@@ -15,7 +15,10 @@
 #include <StGLWidgets/StGLCheckbox.h>
 #include <StGLWidgets/StGLScrollArea.h>
 #include <StGLWidgets/StGLTextureButton.h>
+#include <StGLWidgets/StGLThumbnailGrid.h>
 
+#include <StImage/StThumbnailCache.h>
+#include <StThreads/StResourceManager.h>
 #include <StThreads/StThread.h>
 
 #include <fstream>
@@ -114,10 +117,12 @@ StGLOpenFile::StGLOpenFile(StGLWidget*     theParent,
   myHotListContent(NULL),
   myHotList(NULL),
   myList(NULL),
+  myGrid(NULL),
   myMainFilterCheck(NULL),
   myExtraFilterCheck(NULL),
   myToShowMainFilter(new StBoolParam(true)),
   myToShowExtraFilter(new StBoolParam(false)),
+  myToShowThumbs(new StBoolParam(false)),
   myHighlightColor(0.5f, 0.5f, 0.5f, 1.0f),
   myItemColor     (1.0f, 1.0f, 1.0f, 1.0f),
   myFileColor     (0.7f, 0.7f, 0.7f, 1.0f),
@@ -129,6 +134,7 @@ StGLOpenFile::StGLOpenFile(StGLWidget*     theParent,
 
     myToShowMainFilter ->signals.onChanged = stSlot(this, &StGLOpenFile::doFilterCheck);
     myToShowExtraFilter->signals.onChanged = stSlot(this, &StGLOpenFile::doFilterCheck);
+    myToShowThumbs     ->signals.onChanged = stSlot(this, &StGLOpenFile::doThumbnailsCheck);
 
     int aMarginTop = myMarginTop + myRoot->scale(30);
     myCurrentPath = new StGLTextArea(this, myMarginLeft, myMarginTop, StGLCorner(ST_VCORNER_TOP, ST_HCORNER_LEFT),
@@ -149,10 +155,7 @@ StGLOpenFile::StGLOpenFile(StGLWidget*     theParent,
     myHotList->setItemWidth(myHotSizeX);
     myHotList->setColor(StGLVec4(0.0f, 0.0f, 0.0f, 0.0f));
 
-    myList = new StGLOpenFileMenu(myContent, 0, 0, StGLMenu::MENU_VERTICAL_COMPACT);
-    myList->setOpacity(1.0f, true);
-    myList->setColor(StGLVec4(0.0f, 0.0f, 0.0f, 0.0f));
-    myList->setItemWidthMin(myContent->getRectPx().width());
+    initView();
 
     //if(!myRoot->isMobile()) {
         addButton(theCloseText);
@@ -161,6 +164,37 @@ StGLOpenFile::StGLOpenFile(StGLWidget*     theParent,
     addSystemDrives();
 }
 
+void StGLOpenFile::initView() {
+    if(myToShowThumbs->getValue()) {
+        if(myGrid != NULL) {
+            return;
+        }
+
+        delete myList;
+        myList = NULL;
+        if(myThumbCache.isNull()) {
+            myThumbCache = new StThumbnailCache(myRoot->getResourceManager()->getCacheFolder(), myRoot->scale(96));
+        }
+        myGrid = new StGLThumbnailGrid(myContent, myThumbCache, myContent->getRectPx().width());
+        myGrid->setOpacity(1.0f, true);
+        myGrid->setTextColor(myItemColor);
+        myGrid->setHilightColor(myHighlightColor);
+        myGrid->signals.onItemClick = stSlot(this, &StGLOpenFile::doGridItemClick);
+        return;
+    }
+
+    if(myList != NULL) {
+        return;
+    }
+
+    delete myGrid;
+    myGrid = NULL;
+    myList = new StGLOpenFileMenu(myContent, 0, 0, StGLMenu::MENU_VERTICAL_COMPACT);
+    myList->setOpacity(1.0f, true);
+    myList->setColor(StGLVec4(0.0f, 0.0f, 0.0f, 0.0f));
+    myList->setItemWidthMin(myContent->getRectPx().width());
+}
+
 void StGLOpenFile::addSystemDrives() {
 #ifdef _WIN32
     const DWORD aMask = ::GetLogicalDrives();
@@ -284,6 +318,15 @@ void StGLOpenFile::setMimeList(const StMIMEList& theFilter,
     initExtensions();
 }
 
+void StGLOpenFile::addThumbnailsCheckbox(const StHandle<StBoolParam>& theParam,
+                                         const StString& theName) {
+    myToShowThumbsApp = theParam;
+    if(!theParam.isNull()) {
+        myToShowThumbs->setValue(theParam->getValue());
+    }
+    addHotCheckbox(myToShowThumbs, theName);
+}
+
 StGLMenuCheckbox* StGLOpenFile::addHotCheckbox(const StHandle<StBoolParam>& theParam,
                                                const StString& theName) {
     StGLMenuCheckbox* aFilterWidget = new StGLMenuCheckbox(myHotList, theParam);
@@ -328,6 +371,26 @@ void StGLOpenFile::doFilterCheck(const bool ) {
     }
 }
 
+void StGLOpenFile::doThumbnailsCheck(const bool theIsChecked) {
+    if(!myToShowThumbsApp.isNull()) {
+        myToShowThumbsApp->setValue(theIsChecked);
+    }
+
+    initView();
+    if(!myFolder.isNull()) {
+        StString aPath = myFolder->getPath();
+        openFolder(aPath);
+    }
+}
+
+void StGLOpenFile::doGridItemClick(const size_t theUserData) {
+    if(theUserData == size_t(-1)) {
+        doFolderUpClick(0);
+    } else {
+        doFileItemClick(theUserData);
+    }
+}
+
 void StGLOpenFile::doFileItemClick(const size_t theItemId) {
     const StFileNode* aNode = myFolder->getValue(theItemId);
     myItemToLoad = aNode->getPath();
@@ -396,7 +459,28 @@ void StGLOpenFile::addHotItem(const StString& theTarget,
         myMainFilterCheck->changeRectPx().right() = myHotSizeX;
     }
     myContent->changeRectPx().left() = myHotListContent->getRectPx().right();
-    myList->setItemWidthMin(myContent->getRectPx().width());
+    if(myList != NULL) {
+        myList->setItemWidthMin(myContent->getRectPx().width());
+    }
+}
+
+bool StGLOpenFile::initItemIcons() {
+    if(!myTextureFolder.isNull()) {
+        return true;
+    }
+
+    const StString& anIcon0 = myRoot->getIcon(StGLRootWidget::IconImage_Folder);
+    const StString& anIcon1 = myRoot->getIcon(StGLRootWidget::IconImage_File);
+    if(anIcon0.isEmpty()
+    || anIcon1.isEmpty()) {
+        return false;
+    }
+
+    myTextureFolder = new StGLTextureArray(1);
+    myTextureFile   = new StGLTextureArray(1);
+    myTextureFolder->changeValue(0).setName(anIcon0);
+    myTextureFile  ->changeValue(0).setName(anIcon1);
+    return true;
 }
 
 void StGLOpenFile::setItemIcon(StGLMenuItem*   theItem,
@@ -407,18 +491,8 @@ void StGLOpenFile::setItemIcon(StGLMenuItem*   theItem,
     }
 
     theItem->changeMargins().left = myMarginX + myIconSizeX + myMarginX;
-    if(myTextureFolder.isNull()) {
-        const StString& anIcon0 = myRoot->getIcon(StGLRootWidget::IconImage_Folder);
-        const StString& anIcon1 = myRoot->getIcon(StGLRootWidget::IconImage_File);
-        if(!anIcon0.isEmpty()
-        && !anIcon1.isEmpty()) {
-            myTextureFolder = new StGLTextureArray(1);
-            myTextureFile   = new StGLTextureArray(1);
-            myTextureFolder->changeValue(0).setName(anIcon0);
-            myTextureFile  ->changeValue(0).setName(anIcon1);
-        } else {
-            return;
-        }
+    if(!initItemIcons()) {
+        return;
     }
 
     StGLIcon* anIcon = new StGLIcon(theItem, myMarginX, 0, StGLCorner(ST_VCORNER_CENTER, ST_HCORNER_LEFT), 0);
@@ -433,7 +507,12 @@ void StGLOpenFile::setItemIcon(StGLMenuItem*   theItem,
 
 void StGLOpenFile::openFolder(const StString& theFolder) {
     myItemToLoad.clear();
-    myList->destroyChildren();
+    initView();
+    if(myList != NULL) {
+        myList->destroyChildren();
+    } else {
+        myGrid->clearItems();
+    }
 
     StString aFolder = theFolder;
     if(aFolder.isEmpty()) {
@@ -451,6 +530,25 @@ void StGLOpenFile::openFolder(const StString& theFolder) {
                          + (!aPath.isEmpty() && !aPath.isEndsWith(SYS_FS_SPLITTER) ? ST_FILE_SPLITTER : ""));
 
     StString aPathUp = StFileNode::getFolderUp(aPath);
+    const size_t aNbItems = myFolder->size();
+    if(myGrid != NULL) {
+        initItemIcons();
+        if(!aPathUp.isEmpty()) {
+            myGrid->addItem("..", "", myTextureFolder, myItemColor, size_t(-1));
+        }
+        for(size_t anItemIter = 0; anItemIter < aNbItems; ++anItemIter) {
+            const StFileNode* aNode = myFolder->getValue(anItemIter);
+            if(aNode->isFolder()) {
+                myGrid->addItem(aNode->getSubPath(), "", myTextureFolder, myItemColor, anItemIter);
+            } else {
+                myGrid->addItem(aNode->getSubPath(), aNode->getPath(), myTextureFile, myFileColor, anItemIter);
+            }
+        }
+        myGrid->stglInit();
+        stglInit();
+        return;
+    }
+
     if(!aPathUp.isEmpty()) {
         StGLMenuItem* anUpItem = new StGLPassiveMenuItem(myList);
         anUpItem->setText("..");
@@ -460,7 +558,6 @@ void StGLOpenFile::openFolder(const StString& theFolder) {
         anUpItem->signals.onItemClick = stSlot(this, &StGLOpenFile::doFolderUpClick);
     }
 
-    const size_t aNbItems = myFolder->size();
     for(size_t anItemIter = 0; anItemIter < aNbItems; ++anItemIter) {
         const StFileNode* aNode = myFolder->getValue(anItemIter);
         StString aName = aNode->getSubPath();
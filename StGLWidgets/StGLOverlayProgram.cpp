@@ -0,0 +1,65 @@
+/**
+ * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StGLWidgets/StGLOverlayProgram.h>
+
+#include <StGLCore/StGLCore20.h>
+#include <StGL/StGLContext.h>
+
+StGLOverlayProgram::StGLOverlayProgram()
+: StGLProgram("StGLOverlayProgram") {
+    //
+}
+
+void StGLOverlayProgram::use(StGLContext&    theCtx,
+                             const GLfloat   theDispX,
+                             const StGLVec2& theTexScale) {
+    StGLProgram::use(theCtx);
+    theCtx.core20fwd->glUniform1f (uniDispLoc, theDispX);
+    theCtx.core20fwd->glUniform2fv(uniTexScaleLoc, 1, theTexScale);
+}
+
+bool StGLOverlayProgram::init(StGLContext& theCtx) {
+    const char VERTEX_SHADER[] =
+       "uniform float uDispX;\n"
+       "uniform vec2  uTexScale;\n"
+       "attribute vec4 vVertex;\n"
+       "varying vec2 fTexCoord;\n"
+       "void main(void) {\n"
+       "    fTexCoord   = (vVertex.xy * 0.5 + vec2(0.5)) * uTexScale;\n"
+       "    gl_Position = vVertex + vec4(uDispX, 0.0, 0.0, 0.0);\n"
+       "}\n";
+
+    const char FRAGMENT_SHADER[] =
+       "uniform sampler2D uTexture;\n"
+       "varying vec2 fTexCoord;\n"
+       "void main(void) {\n"
+       "    gl_FragColor = texture2D(uTexture, fTexCoord);\n"
+       "}\n";
+
+    StGLVertexShader aVertexShader(StGLProgram::getTitle());
+    aVertexShader.init(theCtx, VERTEX_SHADER);
+    StGLAutoRelease aTmp1(theCtx, aVertexShader);
+
+    StGLFragmentShader aFragmentShader(StGLProgram::getTitle());
+    aFragmentShader.init(theCtx, FRAGMENT_SHADER);
+    StGLAutoRelease aTmp2(theCtx, aFragmentShader);
+    if(!StGLProgram::create(theCtx)
+       .attachShader(theCtx, aVertexShader)
+       .attachShader(theCtx, aFragmentShader)
+       .bindAttribLocation(theCtx, "vVertex", getVVertexLoc())
+       .link(theCtx)) {
+        return false;
+    }
+
+    uniDispLoc     = StGLProgram::getUniformLocation(theCtx, "uDispX");
+    uniTexScaleLoc = StGLProgram::getUniformLocation(theCtx, "uTexScale");
+    return uniDispLoc.isValid()
+        && uniTexScaleLoc.isValid();
+}
@@ -131,7 +131,7 @@ void StGLRadioButton::stglDraw(unsigned int theView) {
         stglResize();
     }
 
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
     aProgram.use(aCtx, getRoot()->getScreenDispX());
     myVertBuf.bindVertexAttrib  (aCtx, aProgram.getVVertexLoc());
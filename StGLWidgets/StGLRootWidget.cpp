@@ -11,10 +11,13 @@
 
 #include <StGLWidgets/StGLMenuProgram.h>
 #include <StGLWidgets/StGLMessageBox.h>
+#include <StGLWidgets/StGLOverlayProgram.h>
+#include <StGLWidgets/StGLTextBatch.h>
 #include <StGLWidgets/StGLTextProgram.h>
 #include <StGLWidgets/StGLTextBorderProgram.h>
 
 #include <StCore/StEvent.h>
+#include <StGL/StGLArbFbo.h>
 #include <StGL/StGLContext.h>
 #include <StGLCore/StGLCore20.h>
 #include <StFile/StFileNode.h>
@@ -39,6 +42,15 @@ namespace {
         0
     };
 
+    /**
+     * Period to redraw cached GUI layer even without detected changes (to catch unreported animations).
+     */
+    static const double THE_CACHE_HEARTBEAT_MS = 1000.0;
+
+    inline size_t hashCombine(const size_t theHash, const size_t theValue) {
+        return theHash ^ (theValue + 0x9e3779b9 + (theHash << 6) + (theHash >> 2));
+    }
+
 }
 
 size_t StGLRootWidget::generateShareId() {
@@ -56,6 +68,13 @@ StGLRootWidget::StGLRootWidget(const StHandle<StResourceManager>& theResMgr)
   myMenuProgram(new StGLMenuProgram()),
   myTextProgram(new StGLTextProgram()),
   myTextBorderProgram(new StGLTextBorderProgram()),
+  myDrawTimer(false),
+  myCacheProgram(new StGLOverlayProgram()),
+  myCacheTimer(true),
+  myCacheSignature(0),
+  myToCacheGui(false),
+  myIsCacheDirty(true),
+  myIsDamaged(true),
   myIsMobile(false),
   myScaleGlX(1.0),
   myScaleGlY(1.0),
@@ -80,7 +99,8 @@ StGLRootWidget::StGLRootWidget(const StHandle<StResourceManager>& theResMgr)
     for(size_t aResId = 0; aResId < myShareSize; ++aResId) {
         myShareArray[aResId] = new StGLSharePointer();
     }
-    myGlFontMgr = new StGLFontManager(myResolution);
+    myGlFontMgr = new StGLFontManager(myResolution,
+                                      !myResMgr.isNull() ? myResMgr->getCacheFolder() : StString());
 
     myColors[Color_Menu]            = StGLVec4(0.855f, 0.855f, 0.855f, 1.0f);
     myColors[Color_MenuHighlighted] = StGLVec4(0.765f, 0.765f, 0.765f, 1.0f);
@@ -92,6 +112,7 @@ StGLRootWidget::StGLRootWidget(const StHandle<StResourceManager>& theResMgr)
     myColors[Color_ScrollBar]       = StGLVec4(0.765f, 0.765f, 0.765f, 0.8f);
     myColors[Color_IconActive]      = StGLVec4(1.000f, 1.000f, 1.000f, 1.0f);
 
+    myTextBatch = new StGLTextBatch(myTextProgram);
     setupTextures();
 }
 
@@ -105,6 +126,12 @@ StGLRootWidget::~StGLRootWidget() {
     }
     delete[] myShareArray;
     if(!myGlCtx.isNull()) {
+        myTextBatch->release(*myGlCtx);
+        myTextBatch.nullify();
+        myCacheFbo.release(*myGlCtx);
+        myCacheQuad.release(*myGlCtx);
+        myCacheProgram->release(*myGlCtx);
+        myCacheProgram.nullify();
         myMenuProgram->release(*myGlCtx);
         myMenuProgram.nullify();
         myTextProgram->release(*myGlCtx);
@@ -229,6 +256,7 @@ void StGLRootWidget::setScale(const GLfloat     theScale,
         return;
     }
 
+    invalidateCache();
     myScaleGUI   = aScale;
     myResolution = (unsigned int )(72.0f * aScale + 0.1f);
     myGlFontMgr->setResolution(myResolution);
@@ -260,6 +288,15 @@ bool StGLRootWidget::stglInit() {
 }
 
 void StGLRootWidget::stglDraw(unsigned int theView) {
+    if(theView != ST_DRAW_RIGHT) {
+        // new frame
+        myDrawStatsLast = myDrawStats;
+        myDrawStats = DrawStats();
+        myTextBatch->resetStats();
+        myGlCtx->resetFrameStats();
+    }
+    myDrawTimer.restart();
+
     myGlCtx->stglSyncState();
     myGlCtx->core20fwd->glGetIntegerv(GL_VIEWPORT, myViewport); // cache viewport
 
@@ -290,7 +327,167 @@ void StGLRootWidget::stglDraw(unsigned int theView) {
         myTextBorderProgram->unuse(*myGlCtx);
     }
 
-    StGLWidget::stglDraw(theView);
+    myGlCtx->stglSetDeferredDraw(myTextBatch.access());
+    if(!myToCacheGui
+    || !isVisible()
+    || !stglDrawCached(theView)) {
+        StGLWidget::stglDraw(theView);
+    }
+    myGlCtx->stglFlushDeferred();
+    myGlCtx->stglSetDeferredDraw(NULL);
+
+    myDrawStats.NbTextDraws    = myTextBatch->getNbDrawCalls();
+    myDrawStats.NbTextBlocks   = myTextBatch->getNbBlocks();
+    myDrawStats.NbTextQuads    = myTextBatch->getNbQuads();
+    myDrawStats.NbProgramBinds = myGlCtx->getFrameStats().NbProgramBinds;
+    myDrawStats.CpuTimeMs     += myDrawTimer.getElapsedTimeInMilliSec();
+}
+
+size_t StGLRootWidget::computeSignature(StGLWidget* theWidget,
+                                        size_t      theHash) {
+    for(StGLWidget* aChild = theWidget; aChild != NULL; aChild = aChild->getNext()) {
+        if(!aChild->isVisible()) {
+            continue;
+        }
+
+        const StRectI_t& aRect = aChild->getRectPx();
+        theHash = hashCombine(theHash, size_t(aRect.left()));
+        theHash = hashCombine(theHash, size_t(aRect.top()));
+        theHash = hashCombine(theHash, size_t(aRect.width()));
+        theHash = hashCombine(theHash, size_t(aRect.height()));
+        theHash = hashCombine(theHash, size_t(aChild->getOpacity() * 1024.0f));
+        theHash = hashCombine(theHash, size_t(aChild->isClicked(ST_MOUSE_LEFT) ? 1 : 0)
+                                     | size_t(aChild->myHasFocus ? 2 : 0));
+        theHash = computeSignature(aChild->myChildren.getStart(), theHash);
+    }
+    return theHash;
+}
+
+bool StGLRootWidget::stglDrawCached(unsigned int theView) {
+    if(myGlCtx->arbFbo == NULL
+    || myGlCtx->stglHasScissorRect()) {
+        return false;
+    } else if(!myCacheProgram->isValid()
+           && !myCacheProgram->init(*myGlCtx)) {
+        myToCacheGui = false;
+        return false;
+    }
+
+    // widgets up to the last dynamic one are drawn directly
+    StGLWidget* aFirstCached = myChildren.getStart();
+    for(StGLWidget* aChild = myChildren.getStart(); aChild != NULL; aChild = aChild->getNext()) {
+        if(aChild->isDynamic()
+        && aChild->isVisible()) {
+            aFirstCached = aChild->getNext();
+        }
+    }
+
+    const GLsizei aSizeX = myViewport[2];
+    const GLsizei aSizeY = myViewport[3];
+    if(aFirstCached != NULL) {
+        if(myCacheFbo.getVPSizeX() != aSizeX
+        || myCacheFbo.getVPSizeY() != aSizeY) {
+            myIsCacheDirty = true;
+        }
+        if(!myCacheFbo.initLazy(*myGlCtx, GL_RGBA8, aSizeX, aSizeY, false)) {
+            myCacheFbo.release(*myGlCtx);
+            myToCacheGui = false;
+            return false;
+        }
+        if(!myCacheQuad.isValid()) {
+            const GLfloat QUAD_VERTICES[2 * 4] = {
+                 1.0f,  1.0f, // top-right
+                 1.0f, -1.0f, // bottom-right
+                -1.0f,  1.0f, // top-left
+                -1.0f, -1.0f  // bottom-left
+            };
+            myCacheQuad.init(*myGlCtx, 2, 4, QUAD_VERTICES);
+        }
+    }
+
+    for(StGLWidget* aChildIter = myChildren.getStart(); aChildIter != aFirstCached;) {
+        StGLWidget* aChildActive = aChildIter;
+        aChildIter = aChildIter->getNext();
+        aChildActive->stglDraw(theView);
+    }
+    if(aFirstCached == NULL) {
+        return true;
+    }
+
+    const size_t aSignature = computeSignature(aFirstCached, 0);
+    if(aSignature != myCacheSignature
+    || myCacheTimer.getElapsedTimeInMilliSec() > THE_CACHE_HEARTBEAT_MS) {
+        myIsCacheDirty = true;
+    }
+
+    if(myIsCacheDirty) {
+        // reset flag before drawing - widgets might invalidate cache again within drawing
+        myIsCacheDirty   = false;
+        myCacheSignature = aSignature;
+        myCacheTimer.restart();
+        ++myDrawStats.NbCacheUpdates;
+
+        myGlCtx->stglFlushDeferred();
+        GLint aFboBack = 0;
+        GLfloat aClearBack[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        GLboolean aColorMaskBack[4] = { GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
+        myGlCtx->core20fwd->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &aFboBack);
+        myGlCtx->core20fwd->glGetFloatv(GL_COLOR_CLEAR_VALUE, aClearBack);
+        myGlCtx->core20fwd->glGetBooleanv(GL_COLOR_WRITEMASK, aColorMaskBack);
+        const StGLBoxPx aVPortBack = {{ myViewport[0], myViewport[1], myViewport[2], myViewport[3] }};
+
+        // output might draw views through color write masks (anaglyph), while cache is shared by both views
+        myCacheFbo.bindBuffer(*myGlCtx);
+        myGlCtx->stglResizeViewport(aSizeX, aSizeY);
+        myGlCtx->core20fwd->glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        myGlCtx->core20fwd->glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        myGlCtx->core20fwd->glClear(GL_COLOR_BUFFER_BIT);
+
+        // static layer is drawn without stereoscopic displacement - it is applied within compositing
+        const GLfloat aDispXBack   = myScrDispX;
+        const int     aDispXPxBack = myScrDispXPx;
+        myScrDispX    = 0.0f;
+        myScrDispXPx  = 0;
+        myViewport[0] = 0;
+        myViewport[1] = 0;
+        myGlCtx->stglSetPremultipliedTarget(true);
+        for(StGLWidget* aChildIter = aFirstCached; aChildIter != NULL;) {
+            StGLWidget* aChildActive = aChildIter;
+            aChildIter = aChildIter->getNext();
+            aChildActive->stglDraw(theView);
+        }
+        myGlCtx->stglFlushDeferred();
+        myGlCtx->stglSetPremultipliedTarget(false);
+        myScrDispX    = aDispXBack;
+        myScrDispXPx  = aDispXPxBack;
+        myViewport[0] = aVPortBack.x();
+        myViewport[1] = aVPortBack.y();
+
+        myGlCtx->stglBindFramebuffer(GLuint(aFboBack));
+        myGlCtx->stglResizeViewport(aVPortBack);
+        myGlCtx->core20fwd->glClearColor(aClearBack[0], aClearBack[1], aClearBack[2], aClearBack[3]);
+        myGlCtx->core20fwd->glColorMask(aColorMaskBack[0], aColorMaskBack[1], aColorMaskBack[2], aColorMaskBack[3]);
+    } else {
+        ++myDrawStats.NbCacheHits;
+    }
+
+    // composite cached layer (premultiplied alpha) with per-view displacement
+    const GLfloat aDispX = myRectPxFull.width() > 0
+                         ? 2.0f * GLfloat(myScrDispXPx) / GLfloat(myRectPxFull.width())
+                         : 0.0f;
+    const StGLVec2 aTexScale(GLfloat(myCacheFbo.getVPSizeX()) / GLfloat(myCacheFbo.getSizeX()),
+                             GLfloat(myCacheFbo.getVPSizeY()) / GLfloat(myCacheFbo.getSizeY()));
+    myCacheProgram->use(*myGlCtx, aDispX, aTexScale);
+    myGlCtx->core20fwd->glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    myGlCtx->core20fwd->glEnable(GL_BLEND);
+    myCacheFbo.bindTexture(*myGlCtx);
+    myCacheQuad.bindVertexAttrib(*myGlCtx, myCacheProgram->getVVertexLoc());
+    myGlCtx->core20fwd->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    myCacheQuad.unBindVertexAttrib(*myGlCtx, myCacheProgram->getVVertexLoc());
+    myCacheFbo.unbindTexture(*myGlCtx);
+    myGlCtx->core20fwd->glDisable(GL_BLEND);
+    myCacheProgram->unuse(*myGlCtx);
+    return true;
 }
 
 StGLSharePointer* StGLRootWidget::getShare(const size_t theResId) {
@@ -310,6 +507,12 @@ StGLSharePointer* StGLRootWidget::getShare(const size_t theResId) {
 
 void StGLRootWidget::stglUpdate(const StPointD_t& theCursorZo,
                                 bool theIsPreciseInput) {
+    // changes made within this update will be drawn within this frame
+    myIsDamaged = false;
+    if(myCursorZo != theCursorZo) {
+        // widgets highlighting depends on cursor position
+        invalidateCache();
+    }
     myCursorZo = theCursorZo;
     StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
 }
@@ -346,6 +549,9 @@ void StGLRootWidget::stglResize(const StGLBoxPx& theViewPort,
                         || myRectPxFull.bottom() != aNewSizeY
                         || myMarginsPx != theMargins
                         || myProjCamera.getAspect() != theAspect;
+    if(isChanged) {
+        invalidateCache();
+    }
     myMarginsPx = theMargins;
     myProjCamera.resize(theAspect);
     myRectPxFull.right()  = aNewSizeX; // (left, top) forced to zero point (0, 0)
@@ -398,6 +604,7 @@ void StGLRootWidget::getRectGl(const StRectI_t& theRectPx,
 
 bool StGLRootWidget::tryClick(const StClickEvent& theEvent,
                               bool&               theIsItemClicked) {
+    invalidateCache();
     const StPointD_t aCursorBack = myCursorZo;
     myCursorZo = StPointD_t(theEvent.PointX, theEvent.PointY);
     if(isPointIn(myCursorZo)) {
@@ -425,6 +632,7 @@ bool StGLRootWidget::tryClick(const StClickEvent& theEvent,
 
 bool StGLRootWidget::tryUnClick(const StClickEvent& theEvent,
                                 bool&               theIsItemUnclicked) {
+    invalidateCache();
     const StPointD_t aCursorBack = myCursorZo;
     myCursorZo = StPointD_t(theEvent.PointX, theEvent.PointY);
     if(isPointIn(myCursorZo)) {
@@ -438,6 +646,7 @@ bool StGLRootWidget::tryUnClick(const StClickEvent& theEvent,
 }
 
 bool StGLRootWidget::doScroll(const StScrollEvent& theEvent) {
+    invalidateCache();
     const StPointD_t aCursorBack = myCursorZo;
     myCursorZo = StPointD_t(theEvent.PointX, theEvent.PointY);
 
@@ -449,6 +658,7 @@ bool StGLRootWidget::doScroll(const StScrollEvent& theEvent) {
 
 bool StGLRootWidget::doKeyDown(const StKeyEvent& theEvent) {
     bool isProcessed = false;
+    invalidateCache();
     if(myFocusWidget != NULL) {
         isProcessed = myFocusWidget->doKeyDown(theEvent);
         clearDestroyList();
@@ -458,6 +668,7 @@ bool StGLRootWidget::doKeyDown(const StKeyEvent& theEvent) {
 
 bool StGLRootWidget::doKeyHold(const StKeyEvent& theEvent) {
     bool isProcessed = false;
+    invalidateCache();
     if(myFocusWidget != NULL) {
         isProcessed = myFocusWidget->doKeyHold(theEvent);
         clearDestroyList();
@@ -467,6 +678,7 @@ bool StGLRootWidget::doKeyHold(const StKeyEvent& theEvent) {
 
 bool StGLRootWidget::doKeyUp(const StKeyEvent& theEvent) {
     bool isProcessed = false;
+    invalidateCache();
     if(myFocusWidget != NULL) {
         isProcessed = myFocusWidget->doKeyUp(theEvent);
         clearDestroyList();
@@ -500,6 +712,7 @@ StGLWidget* StGLRootWidget::setFocus(StGLWidget* theWidget) {
         return myFocusWidget;
     }
 
+    invalidateCache();
     StGLWidget* aPrevWidget = myFocusWidget;
     if(aPrevWidget != NULL) {
         aPrevWidget->myHasFocus = false;
@@ -530,6 +743,7 @@ void StGLRootWidget::setModalDialog(StGLMessageBox* theWidget,
         return;
     }
 
+    invalidateCache();
     if(theToReleaseOld && myModalDialog != NULL) {
         destroyWithDelay(myModalDialog);
     }
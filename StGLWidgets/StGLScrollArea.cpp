@@ -180,7 +180,7 @@ void StGLScrollArea::stglDraw(unsigned int theView) {
     || !myBarVertBuf.isValid()) {
         return;
     }
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
     aProgram.use(aCtx, myRoot->getScreenDispX());
     myBarVertBuf.bindVertexAttrib(aCtx, aProgram.getVVertexLoc());
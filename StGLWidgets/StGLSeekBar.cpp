@@ -95,6 +95,87 @@ class StGLSeekBar::StProgramSB : public StGLProgram {
 
 };
 
+class StGLSeekBar::StProgramPreview : public StGLProgram {
+
+        public:
+
+    StProgramPreview() : StGLProgram("StGLSeekBarPreview") {}
+
+    StGLVarLocation getVVertexLoc()   const { return StGLVarLocation(0); }
+    StGLVarLocation getVTexCoordLoc() const { return StGLVarLocation(1); }
+
+    void setProjMat(StGLContext&      theCtx,
+                    const StGLMatrix& theProjMat) {
+        theCtx.core20fwd->glUniformMatrix4fv(uniProjMatLoc, 1, GL_FALSE, theProjMat);
+    }
+
+    using StGLProgram::use;
+    void use(StGLContext&  theCtx,
+             const GLfloat theOpacityValue,
+             const GLfloat theDispX) {
+        StGLProgram::use(theCtx);
+        theCtx.core20fwd->glUniform1f(uniOpacityLoc, theOpacityValue);
+        theCtx.core20fwd->glUniform4fv(uniDispLoc, 1, StGLVec4(theDispX, 0.0f, 0.0f, 0.0f));
+    }
+
+    virtual bool init(StGLContext& theCtx) ST_ATTR_OVERRIDE {
+        const char VERTEX_SHADER[] =
+           "uniform mat4 uProjMat;\n"
+           "uniform vec4 uDisp;\n"
+           "attribute vec4 vVertex;\n"
+           "attribute vec2 vTexCoord;\n"
+           "varying   vec2 fTexCoord;\n"
+           "void main(void) {\n"
+           "    fTexCoord = vTexCoord;\n"
+           "    gl_Position = uProjMat * (vVertex + uDisp);\n"
+           "}\n";
+
+        const char FRAGMENT_SHADER[] =
+           "uniform sampler2D uTexture;\n"
+           "uniform float     uOpacity;\n"
+           "varying vec2      fTexCoord;\n"
+           "void main(void) {\n"
+           "    gl_FragColor = vec4(texture2D(uTexture, fTexCoord).rgb, uOpacity);\n"
+           "}\n";
+
+        StGLVertexShader aVertexShader(StGLProgram::getTitle());
+        StGLAutoRelease aTmp1(theCtx, aVertexShader);
+        aVertexShader.init(theCtx, VERTEX_SHADER);
+
+        StGLFragmentShader aFragmentShader(StGLProgram::getTitle());
+        StGLAutoRelease aTmp2(theCtx, aFragmentShader);
+        aFragmentShader.init(theCtx, FRAGMENT_SHADER);
+        if(!StGLProgram::create(theCtx)
+           .attachShader(theCtx, aVertexShader)
+           .attachShader(theCtx, aFragmentShader)
+           .bindAttribLocation(theCtx, "vVertex",   getVVertexLoc())
+           .bindAttribLocation(theCtx, "vTexCoord", getVTexCoordLoc())
+           .link(theCtx)) {
+            return false;
+        }
+
+        StGLVarLocation uniTextureLoc = StGLProgram::getUniformLocation(theCtx, "uTexture");
+        if(uniTextureLoc.isValid()) {
+            StGLProgram::use(theCtx);
+            theCtx.core20fwd->glUniform1i(uniTextureLoc, StGLProgram::TEXTURE_SAMPLE_0);
+            StGLProgram::unuse(theCtx);
+        }
+
+        uniProjMatLoc = StGLProgram::getUniformLocation(theCtx, "uProjMat");
+        uniDispLoc    = StGLProgram::getUniformLocation(theCtx, "uDisp");
+        uniOpacityLoc = StGLProgram::getUniformLocation(theCtx, "uOpacity");
+        return uniProjMatLoc.isValid()
+            && uniTextureLoc.isValid();
+    }
+
+        private:
+
+    StGLVarLocation uniProjMatLoc;
+    StGLVarLocation uniDispLoc;
+    StGLVarLocation uniOpacityLoc;
+
+};
+
 StGLSeekBar::StGLSeekBar(StGLWidget* theParent,
                          int theTop,
                          int theMargin,
@@ -103,10 +184,14 @@ StGLSeekBar::StGLSeekBar(StGLWidget* theParent,
              theParent->getRoot()->scale(512),
              theParent->getRoot()->scale(12) + theMargin * 2),
   myProgram(new StProgramSB()),
+  myPreviewProgram(new StProgramPreview()),
   myProgress(0.0f),
   myProgressPx(0),
   myClickPos(-1),
-  myMoveTolerPx(0) {
+  myMoveTolerPx(0),
+  myPreviewTexture(GL_RGB8),
+  myPreviewPos(-1.0),
+  myToUploadPreview(false) {
     StGLWidget::signals.onMouseClick  .connect(this, &StGLSeekBar::doMouseClick);
     StGLWidget::signals.onMouseUnclick.connect(this, &StGLSeekBar::doMouseUnclick);
     myMargins.top    = theMargin;
@@ -118,8 +203,14 @@ StGLSeekBar::~StGLSeekBar() {
     if(!myProgram.isNull()) {
         myProgram->release(aCtx);
     }
+    if(!myPreviewProgram.isNull()) {
+        myPreviewProgram->release(aCtx);
+    }
     myVertices.release(aCtx);
     myColors.release(aCtx);
+    myPreviewTexture.release(aCtx);
+    myPreviewVerts.release(aCtx);
+    myPreviewTCrds.release(aCtx);
 }
 
 void StGLSeekBar::stglResize() {
@@ -134,6 +225,11 @@ void StGLSeekBar::stglResize() {
         myProgram->setProjMat(aCtx, getRoot()->getScreenProjection());
         myProgram->unuse(aCtx);
     }
+    if(myPreviewProgram->isValid()) {
+        myPreviewProgram->use(aCtx);
+        myPreviewProgram->setProjMat(aCtx, getRoot()->getScreenProjection());
+        myPreviewProgram->unuse(aCtx);
+    }
 }
 
 void StGLSeekBar::stglUpdateVertices() {
@@ -190,6 +286,11 @@ bool StGLSeekBar::stglInit() {
 
     stglUpdateVertices();
 
+    // preview is optional - do not fail widget initialization
+    if(!myPreviewProgram->init(aCtx)) {
+        myPreviewProgram->release(aCtx);
+    }
+
     return myProgram->init(aCtx)
         && StGLWidget::stglInit();
 }
@@ -203,7 +304,7 @@ void StGLSeekBar::stglDraw(unsigned int theView) {
         stglUpdateVertices();
     }
 
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
     myProgram->use(aCtx, myOpacity, myRoot->getScreenDispX());
 
@@ -223,12 +324,90 @@ void StGLSeekBar::stglDraw(unsigned int theView) {
     myProgram->unuse(aCtx);
     aCtx.core20fwd->glDisable(GL_BLEND);
 
+    stglDrawPreview();
     StGLWidget::stglDraw(theView);
 }
 
+void StGLSeekBar::updatePreview(const StPointD_t& theCursor) {
+    double aPos = -1.0;
+    StHandle<StImage> anImage;
+    if(!myPreviewProvider.isNull()
+    && isVisibleAndPointIn(theCursor)) {
+        aPos    = stMin(stMax(getPointInEx(theCursor), 0.0), 1.0);
+        anImage = myPreviewProvider->getPreview(aPos);
+    }
+
+    if(anImage != myPreviewImage) {
+        myPreviewImage    = anImage;
+        myToUploadPreview = true;
+        invalidate();
+    } else if(aPos != myPreviewPos
+          && !myPreviewImage.isNull()) {
+        invalidate();
+    }
+    myPreviewPos = aPos;
+}
+
+void StGLSeekBar::stglDrawPreview() {
+    StGLContext& aCtx = getContext();
+    if(myToUploadPreview) {
+        myToUploadPreview = false;
+        if(!myPreviewImage.isNull()
+        && !myPreviewImage->isNull()) {
+            myPreviewTexture.init(aCtx, myPreviewImage->getPlane(0));
+        } else {
+            myPreviewTexture.release(aCtx);
+        }
+    }
+    if(myPreviewPos < 0.0
+    || !myPreviewTexture.isValid()
+    || !myPreviewProgram->isValid()) {
+        return;
+    }
+
+    // place preview above the bar centered at cursor, but keep it within the screen
+    const StRectI_t aBarRect = getRectPxAbsolute();
+    const int aSizeX = myRoot->scale(192);
+    const int aSizeY = aSizeX * myPreviewTexture.getSizeY() / stMax(myPreviewTexture.getSizeX(), 1);
+    const int aBarSizeX = aBarRect.width() - myMargins.left - myMargins.right;
+    int aLeft = aBarRect.left() + myMargins.left + int(myPreviewPos * double(aBarSizeX)) - aSizeX / 2;
+    aLeft = stMax(stMin(aLeft, myRoot->getRectPx().width() - aSizeX), 0);
+
+    StRectI_t aRect;
+    aRect.bottom() = aBarRect.top() + myMargins.top - myRoot->scale(4);
+    aRect.top()    = aRect.bottom() - aSizeY;
+    aRect.left()   = aLeft;
+    aRect.right()  = aLeft + aSizeX;
+
+    StArray<StGLVec2> aVertices(4), aTexCoords(4);
+    aTexCoords[0] = StGLVec2(1.0f, 0.0f);
+    aTexCoords[1] = StGLVec2(1.0f, 1.0f);
+    aTexCoords[2] = StGLVec2(0.0f, 0.0f);
+    aTexCoords[3] = StGLVec2(0.0f, 1.0f);
+    myRoot->getRectGl(aRect, aVertices);
+    myPreviewVerts.init(aCtx, aVertices);
+    myPreviewTCrds.init(aCtx, aTexCoords);
+
+    aCtx.stglSetBlendAlpha();
+    aCtx.core20fwd->glEnable(GL_BLEND);
+    myPreviewTexture.bind(aCtx);
+    myPreviewProgram->use(aCtx, stMax(myOpacity, 0.5f), myRoot->getScreenDispX());
+
+    myPreviewVerts.bindVertexAttrib(aCtx, myPreviewProgram->getVVertexLoc());
+    myPreviewTCrds.bindVertexAttrib(aCtx, myPreviewProgram->getVTexCoordLoc());
+    aCtx.core20fwd->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    myPreviewTCrds.unBindVertexAttrib(aCtx, myPreviewProgram->getVTexCoordLoc());
+    myPreviewVerts.unBindVertexAttrib(aCtx, myPreviewProgram->getVVertexLoc());
+
+    myPreviewProgram->unuse(aCtx);
+    myPreviewTexture.unbind(aCtx);
+    aCtx.core20fwd->glDisable(GL_BLEND);
+}
+
 void StGLSeekBar::stglUpdate(const StPointD_t& theCursor,
                              bool theIsPreciseInput) {
     StGLWidget::stglUpdate(theCursor, theIsPreciseInput);
+    updatePreview(theCursor);
     if(!isClicked(ST_MOUSE_LEFT)) {
         return;
     }
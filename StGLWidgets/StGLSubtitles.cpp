@@ -420,7 +420,7 @@ void StGLSubtitles::stglDraw(unsigned int theView) {
     myVertBuf.init(aCtx, aVertices);
     myTCrdBuf.init(aCtx, aTexCoords);
 
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
     myTexture.bind(aCtx);
     myImgProgram->use(aCtx);
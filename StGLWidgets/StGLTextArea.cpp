@@ -10,6 +10,7 @@
 #include <StGLWidgets/StGLTextArea.h>
 
 #include <StGLWidgets/StGLRootWidget.h>
+#include <StGLWidgets/StGLTextBatch.h>
 #include <StGLWidgets/StGLTextProgram.h>
 #include <StGLWidgets/StGLTextBorderProgram.h>
 
@@ -42,12 +43,6 @@ StGLTextArea::StGLTextArea(StGLWidget* theParent,
 
 StGLTextArea::~StGLTextArea() {
     StGLContext& aCtx = getContext();
-
-    for(size_t anIter = 0; anIter < myTextVertBuf.size(); ++anIter) {
-        myTextVertBuf[anIter]->release(aCtx);
-        myTextTCrdBuf[anIter]->release(aCtx);
-    }
-
     myBorderIVertBuf.release(aCtx);
     myBorderOVertBuf.release(aCtx);
 }
@@ -60,6 +55,7 @@ bool StGLTextArea::setText(const StString& theText) {
     if(myText != theText) {
         myText = theText;
         myToRecompute = true;
+        invalidate();
         return true;
     }
     return false;
@@ -224,7 +220,7 @@ void StGLTextArea::formatText(StGLContext& theCtx) {
         myFormatter.reset();
         myFormatter.append(theCtx, myText, *myFont);
         myFormatter.format(myTextWidth, GLfloat(getRectPx().height()));
-        myFormatter.getResult(theCtx, myTexturesList, myTextVertBuf, myTextTCrdBuf);
+        myFormatter.getResult(myTexturesList, myTextVerts, myTextTCrds);
         myFormatter.getBndBox(myTextBndBox);
         if(myToShowBorder) {
             recomputeBorder(theCtx);
@@ -233,25 +229,15 @@ void StGLTextArea::formatText(StGLContext& theCtx) {
     }
 }
 
-void StGLTextArea::drawText(StGLContext& theCtx) {
-    theCtx.core20fwd->glActiveTexture(GL_TEXTURE0);
-    StGLTextProgram& aProgram = myRoot->getTextProgram();
-    for(size_t aTextureIter = 0; aTextureIter < myTexturesList.size(); ++aTextureIter) {
-        if(!myTextVertBuf[aTextureIter]->isValid() || myTextVertBuf[aTextureIter]->getElemsCount() < 1) {
-            continue;
-        }
-
-        theCtx.core20fwd->glBindTexture(GL_TEXTURE_2D, myTexturesList[aTextureIter]);
-
-        myTextVertBuf[aTextureIter]->bindVertexAttrib(theCtx, aProgram.getVVertexLoc());
-        myTextTCrdBuf[aTextureIter]->bindVertexAttrib(theCtx, aProgram.getVTexCoordLoc());
-
-        theCtx.core20fwd->glDrawArrays(GL_TRIANGLES, 0, GLsizei(myTextVertBuf[aTextureIter]->getElemsCount()));
-
-        myTextTCrdBuf[aTextureIter]->unBindVertexAttrib(theCtx, aProgram.getVTexCoordLoc());
-        myTextVertBuf[aTextureIter]->unBindVertexAttrib(theCtx, aProgram.getVVertexLoc());
+void StGLTextArea::drawText(StGLContext&      theCtx,
+                            const StGLMatrix& theModelMat,
+                            const StGLVec4&   theColor) {
+    StGLTextBatch& aBatch = myRoot->getTextBatch();
+    aBatch.append(theCtx, theModelMat, theColor, myTexturesList, myTextVerts, myTextTCrds);
+    if(theCtx.stglDeferredDraw() != &aBatch) {
+        // drawing outside of root widget - submit immediately
+        aBatch.stglFlush(theCtx);
     }
-    theCtx.core20fwd->glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void StGLTextArea::stglDraw(unsigned int theView) {
@@ -283,18 +269,18 @@ void StGLTextArea::stglDraw(unsigned int theView) {
                                  0.0f));
     aModelMat.scale(aSizeOut, aSizeOut, 0.0f);
 
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    aCtx.core20fwd->glEnable(GL_BLEND);
-
     // draw borders
     if(myToShowBorder) {
         if(myBorderOVertBuf.getElemsCount() == 0) {
             recomputeBorder(aCtx);
         }
 
+        // program binding submits pending text of previous widgets, so should be done before changing blending state
         StGLTextBorderProgram& aBorderProgram = myRoot->getTextBorderProgram();
         aBorderProgram.use(aCtx);
         aBorderProgram.setModelMat(aCtx, aModelMat);
+        aCtx.stglSetBlendAlpha();
+        aCtx.core20fwd->glEnable(GL_BLEND);
 
         aBorderProgram.setColor(aCtx, myBorderColor);
         myBorderOVertBuf.bindVertexAttrib(aCtx, aBorderProgram.getVVertexLoc());
@@ -306,37 +292,24 @@ void StGLTextArea::stglDraw(unsigned int theView) {
         aCtx.core20fwd->glDrawArrays(GL_TRIANGLE_STRIP, 0, GLsizei(myBorderIVertBuf.getElemsCount()));
         myBorderIVertBuf.unBindVertexAttrib(aCtx, aBorderProgram.getVVertexLoc());
         aBorderProgram.unuse(aCtx);
+        aCtx.core20fwd->glDisable(GL_BLEND);
     }
 
-    // draw text
-    aCtx.core20fwd->glActiveTexture(GL_TEXTURE0); // our shader is bound to first texture unit
-    StGLTextProgram& aTextProgram = myRoot->getTextProgram();
-    aTextProgram.use(aCtx);
-        aTextProgram.setModelMat(aCtx, aModelMat);
-        aTextProgram.setColor(aCtx, myToDrawShadow ? myShadowColor : aTextColor);
-
-        drawText(aCtx);
-
-        if(myToDrawShadow) {
-            aModelMat.initIdentity();
-            aTextRectPx.left() -= 1;
-            aTextRectPx.top()  -= 1;
-            aTextRectGl = getRoot()->getRectGl(getAbsolute(aTextRectPx));
-            aModelMat.translate(StGLVec3(getRoot()->getScreenDispX() + myTextDX, 0.0f, -getCamera()->getZScreen()));
-            aModelMat.translate(StGLVec3(GLfloat(aTextRectGl.left()),
-                                         GLfloat(aTextRectGl.top()),
-                                         0.0f));
-            aModelMat.scale(aSizeOut, aSizeOut, 0.0f);
-
-            aTextProgram.setModelMat(aCtx, aModelMat);
-            aTextProgram.setColor(aCtx, aTextColor);
-
-            drawText(aCtx);
-        }
-
-    aTextProgram.unuse(aCtx);
-
-    aCtx.core20fwd->glDisable(GL_BLEND);
+    // draw text (deferred by root widget to merge text of consecutive widgets)
+    drawText(aCtx, aModelMat, myToDrawShadow ? myShadowColor : aTextColor);
+    if(myToDrawShadow) {
+        aModelMat.initIdentity();
+        aTextRectPx.left() -= 1;
+        aTextRectPx.top()  -= 1;
+        aTextRectGl = getRoot()->getRectGl(getAbsolute(aTextRectPx));
+        aModelMat.translate(StGLVec3(getRoot()->getScreenDispX() + myTextDX, 0.0f, -getCamera()->getZScreen()));
+        aModelMat.translate(StGLVec3(GLfloat(aTextRectGl.left()),
+                                     GLfloat(aTextRectGl.top()),
+                                     0.0f));
+        aModelMat.scale(aSizeOut, aSizeOut, 0.0f);
+
+        drawText(aCtx, aModelMat, aTextColor);
+    }
 
     StGLWidget::stglDraw(theView);
 }
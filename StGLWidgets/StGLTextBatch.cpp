@@ -0,0 +1,150 @@
+/**
+ * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StGLWidgets/StGLTextBatch.h>
+
+#include <StGLWidgets/StGLTextProgram.h>
+
+#include <StGL/StGLContext.h>
+#include <StGLCore/StGLCore20.h>
+
+StGLTextBatch::StGLTextBatch(const StHandle<StGLTextProgram>& theProgram)
+: myProgram(theProgram),
+  myNbStreams(0),
+  myColor(0.0f, 0.0f, 0.0f, 1.0f),
+  myNbDrawCalls(0),
+  myNbQuads(0),
+  myNbBlocks(0) {
+    //
+}
+
+StGLTextBatch::~StGLTextBatch() {
+    //
+}
+
+void StGLTextBatch::release(StGLContext& theCtx) {
+    if(theCtx.stglDeferredDraw() == this) {
+        theCtx.stglSetDeferredDraw(NULL);
+    }
+    myVertBuf.release(theCtx);
+    myTCrdBuf.release(theCtx);
+    myStreams.clear();
+    myNbStreams = 0;
+}
+
+void StGLTextBatch::append(StGLContext&                                             theCtx,
+                           const StGLMatrix&                                        theModelMat,
+                           const StGLVec4&                                          theColor,
+                           const std::vector<GLuint>&                               theTextures,
+                           const std::vector< StHandle< std::vector<StGLVec2> > >& theVerts,
+                           const std::vector< StHandle< std::vector<StGLVec2> > >& theTCrds) {
+    if(theTextures.empty()) {
+        return;
+    }
+
+    if(myNbStreams != 0
+    && myColor != theColor) {
+        if(theCtx.stglDeferredDraw() == this) {
+            theCtx.stglFlushDeferred();
+        } else {
+            stglFlush(theCtx);
+        }
+    }
+    myColor = theColor;
+    ++myNbBlocks;
+
+    for(size_t aTexIter = 0; aTexIter < theTextures.size(); ++aTexIter) {
+        const std::vector<StGLVec2>& aVerts = *theVerts[aTexIter];
+        const std::vector<StGLVec2>& aTCrds = *theTCrds[aTexIter];
+        if(aVerts.empty()) {
+            continue;
+        }
+
+        // find the stream for this texture
+        Stream* aStream = NULL;
+        for(size_t aStreamIter = 0; aStreamIter < myNbStreams; ++aStreamIter) {
+            if(myStreams[aStreamIter].Texture == theTextures[aTexIter]) {
+                aStream = &myStreams[aStreamIter];
+                break;
+            }
+        }
+        if(aStream == NULL) {
+            if(myNbStreams >= myStreams.size()) {
+                myStreams.push_back(Stream());
+            }
+            aStream = &myStreams[myNbStreams++];
+            aStream->Texture = theTextures[aTexIter];
+            aStream->Verts.clear();
+            aStream->TCrds.clear();
+        }
+
+        // apply model-view transformation on CPU side to merge quads of different widgets
+        for(size_t aVertIter = 0; aVertIter < aVerts.size(); ++aVertIter) {
+            StGLVec4 aPnt = theModelMat * StGLVec4(aVerts[aVertIter].x(), aVerts[aVertIter].y(), 0.0f, 1.0f);
+            aStream->Verts.push_back(aPnt.xyz());
+        }
+        aStream->TCrds.insert(aStream->TCrds.end(), aTCrds.begin(), aTCrds.end());
+    }
+}
+
+void StGLTextBatch::stglFlush(StGLContext& theCtx) {
+    if(myNbStreams == 0
+    || myProgram.isNull()
+    || !myProgram->isValid()) {
+        myNbStreams = 0;
+        return;
+    }
+
+    // reset counter first - program binding below might lead to recursive flush
+    const size_t aNbStreams = myNbStreams;
+    myNbStreams = 0;
+
+    // flush might be triggered in the middle of another widget setup,
+    // so that blending and texture state should be restored afterwards
+    GLint aTexUnitBack = GL_TEXTURE0, aTextureBack = 0;
+    const GLboolean isBlendBack = theCtx.core20fwd->glIsEnabled(GL_BLEND);
+    theCtx.core20fwd->glGetIntegerv(GL_ACTIVE_TEXTURE, &aTexUnitBack);
+    theCtx.core20fwd->glActiveTexture(GL_TEXTURE0); // our shader is bound to first texture unit
+    theCtx.core20fwd->glGetIntegerv(GL_TEXTURE_BINDING_2D, &aTextureBack);
+
+    theCtx.stglSetBlendAlpha();
+    theCtx.core20fwd->glEnable(GL_BLEND);
+
+    myProgram->use(theCtx);
+    myProgram->setModelMat(theCtx, myIdentity);
+    myProgram->setColor(theCtx, myColor);
+    for(size_t aStreamIter = 0; aStreamIter < aNbStreams; ++aStreamIter) {
+        Stream& aStream = myStreams[aStreamIter];
+        if(aStream.Verts.empty()) {
+            continue;
+        }
+
+        theCtx.core20fwd->glBindTexture(GL_TEXTURE_2D, aStream.Texture);
+        myVertBuf.init(theCtx, aStream.Verts);
+        myTCrdBuf.init(theCtx, aStream.TCrds);
+
+        myVertBuf.bindVertexAttrib(theCtx, myProgram->getVVertexLoc());
+        myTCrdBuf.bindVertexAttrib(theCtx, myProgram->getVTexCoordLoc());
+        theCtx.core20fwd->glDrawArrays(GL_TRIANGLES, 0, GLsizei(aStream.Verts.size()));
+        myTCrdBuf.unBindVertexAttrib(theCtx, myProgram->getVTexCoordLoc());
+        myVertBuf.unBindVertexAttrib(theCtx, myProgram->getVVertexLoc());
+
+        ++myNbDrawCalls;
+        myNbQuads += (unsigned int )(aStream.Verts.size() / 6);
+        aStream.Verts.clear();
+        aStream.TCrds.clear();
+    }
+    myProgram->unuse(theCtx);
+
+    theCtx.core20fwd->glBindTexture(GL_TEXTURE_2D, GLuint(aTextureBack));
+    theCtx.core20fwd->glActiveTexture(GLenum(aTexUnitBack));
+    if(isBlendBack != GL_TRUE) {
+        theCtx.core20fwd->glDisable(GL_BLEND);
+    }
+}
@@ -333,6 +333,7 @@ void StGLTextureButton::setFaceId(const size_t theId) {
     }
 
     myFaceId = theId;
+    invalidate();
     const StGLNamedTexture& aTexture = myTextures->getValue(myFaceId);
     myProgramIndex = StGLTexture::isAlphaFormat(aTexture.getTextureFormat())
                    ? StGLTextureButton::ProgramIndex_WaveAlpha
@@ -483,9 +484,11 @@ void StGLTextureButton::stglUpdate(const StPointD_t& theCursorZo,
                 myWaveTimer.restart();
             }
             myAnimTime = (float )myWaveTimer.getElapsedTimeInSec();
-        } else {
+            invalidate(); // animated each frame
+        } else if(myWaveTimer.isOn()) {
             myWaveTimer.stop();
             myAnimTime = 0.0f;
+            invalidate();
         }
     }
     StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
@@ -506,7 +509,7 @@ void StGLTextureButton::stglDraw(unsigned int ) {
     }
 
     StGLContext& aCtx = getContext();
-    aCtx.core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    aCtx.stglSetBlendAlpha();
     aCtx.core20fwd->glEnable(GL_BLEND);
     aTexture.bind(aCtx);
 
@@ -0,0 +1,532 @@
+/**
+ * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StGLWidgets/StGLThumbnailGrid.h>
+
+#include <StGLWidgets/StGLMenuProgram.h>
+#include <StGLWidgets/StGLRootWidget.h>
+#include <StGLWidgets/StGLTextArea.h>
+#include <StGLWidgets/StGLTextureButton.h>
+
+#include <StGL/StGLContext.h>
+#include <StGL/StGLMatrix.h>
+#include <StGLCore/StGLCore20.h>
+#include <StCore/StEvent.h>
+#include <StStrings/StLogger.h>
+
+/**
+ * GLSL program drawing thumbnails from atlas texture.
+ */
+class StGLThumbnailGrid::Program : public StGLProgram {
+
+        public:
+
+    Program() : StGLProgram("StGLThumbnailGrid") {}
+
+    StGLVarLocation getVVertexLoc()   const { return StGLVarLocation(0); }
+    StGLVarLocation getVTexCoordLoc() const { return StGLVarLocation(1); }
+
+    using StGLProgram::use;
+    void use(StGLContext&      theCtx,
+             const StGLMatrix& theProjMat,
+             const GLfloat     theDispX,
+             const GLfloat     theOpacity) {
+        StGLProgram::use(theCtx);
+        theCtx.core20fwd->glUniformMatrix4fv(myUniformProjMat, 1, GL_FALSE, theProjMat);
+        theCtx.core20fwd->glUniform4fv(myUniformDisp, 1, StGLVec4(theDispX, 0.0f, 0.0f, 0.0f));
+        theCtx.core20fwd->glUniform1f(myUniformOpacity, theOpacity);
+    }
+
+    virtual bool init(StGLContext& theCtx) ST_ATTR_OVERRIDE {
+        const char VERTEX_SHADER[] =
+           "uniform mat4 uProjMat;\n"
+           "uniform vec4 uDisp;\n"
+           "attribute vec4 vVertex;\n"
+           "attribute vec2 vTexCoord;\n"
+           "varying vec2 fTexCoord;\n"
+           "void main(void) {\n"
+           "    fTexCoord   = vTexCoord;\n"
+           "    gl_Position = uProjMat * (vVertex + uDisp);\n"
+           "}\n";
+
+        const char FRAGMENT_SHADER[] =
+           "uniform sampler2D uTexture;\n"
+           "uniform float     uOpacity;\n"
+           "varying vec2 fTexCoord;\n"
+           "void main(void) {\n"
+           "    vec4 aColor = texture2D(uTexture, fTexCoord);\n"
+           "    aColor.a = uOpacity;\n"
+           "    gl_FragColor = aColor;\n"
+           "}\n";
+
+        StGLVertexShader aVertexShader(StGLProgram::getTitle());
+        aVertexShader.init(theCtx, VERTEX_SHADER);
+        StGLAutoRelease aTmp1(theCtx, aVertexShader);
+
+        StGLFragmentShader aFragmentShader(StGLProgram::getTitle());
+        aFragmentShader.init(theCtx, FRAGMENT_SHADER);
+        StGLAutoRelease aTmp2(theCtx, aFragmentShader);
+        if(!StGLProgram::create(theCtx)
+           .attachShader(theCtx, aVertexShader)
+           .attachShader(theCtx, aFragmentShader)
+           .bindAttribLocation(theCtx, "vVertex",   getVVertexLoc())
+           .bindAttribLocation(theCtx, "vTexCoord", getVTexCoordLoc())
+           .link(theCtx)) {
+            return false;
+        }
+
+        myUniformProjMat = StGLProgram::getUniformLocation(theCtx, "uProjMat");
+        myUniformDisp    = StGLProgram::getUniformLocation(theCtx, "uDisp");
+        myUniformOpacity = StGLProgram::getUniformLocation(theCtx, "uOpacity");
+
+        StGLVarLocation aUniformTexture = StGLProgram::getUniformLocation(theCtx, "uTexture");
+        if(aUniformTexture.isValid()) {
+            StGLProgram::use(theCtx);
+            theCtx.core20fwd->glUniform1i(aUniformTexture, StGLProgram::TEXTURE_SAMPLE_0);
+            StGLProgram::unuse(theCtx);
+        }
+        return myUniformProjMat.isValid()
+            && aUniformTexture.isValid();
+    }
+
+        private:
+
+    StGLVarLocation myUniformProjMat;
+    StGLVarLocation myUniformDisp;
+    StGLVarLocation myUniformOpacity;
+
+};
+
+namespace {
+    static const size_t SHARE_PROGRAM_ID = StGLRootWidget::generateShareId();
+
+    /**
+     * Atlas dimensions limit.
+     */
+    static const GLint THE_ATLAS_SIZE_MAX = 2048;
+
+    /**
+     * Maximum number of thumbnails uploaded into atlas within single frame.
+     */
+    static const int THE_MAX_UPLOADS_PER_FRAME = 4;
+
+    /**
+     * Thumbnail request priorities.
+     */
+    enum {
+        ThumbPriority_Background = 0, //!< the rest of the folder
+        ThumbPriority_Near       = 1, //!< cells within one page from visible area
+        ThumbPriority_Visible    = 2, //!< visible cells
+    };
+}
+
+StGLThumbnailGrid::StGLThumbnailGrid(StGLWidget*                        theParent,
+                                     const StHandle<StThumbnailCache>& theCache,
+                                     const int                          theWidth)
+: StGLWidget(theParent, 0, 0, StGLCorner(ST_VCORNER_TOP, ST_HCORNER_LEFT), theWidth, 0),
+  myCache(theCache),
+  myProgram(getRoot()->getShare(SHARE_PROGRAM_ID)),
+  myTextColor(1.0f, 1.0f, 1.0f, 1.0f),
+  myHilightColor(0.5f, 0.5f, 0.5f, 1.0f),
+  myThumbSize(theCache->getSize()),
+  myCellSizeX(0),
+  myCellSizeY(0),
+  myNbColumns(1),
+  mySlotsPerRow(0),
+  myRowFrom(-1),
+  myRowTo(-1),
+  myHilightCell(-1),
+  myClickedCell(-1) {
+    const int aMargin = myRoot->scale(4);
+    myCellSizeX = myThumbSize + aMargin * 2;
+    myCellSizeY = myThumbSize + aMargin * 2 + myRoot->scale(20);
+    myNbColumns = stMax(theWidth / myCellSizeX, 1);
+}
+
+StGLThumbnailGrid::~StGLThumbnailGrid() {
+    myCache->clear();
+    StGLContext& aCtx = getContext();
+    myAtlas.release(aCtx);
+    myVertBuf.release(aCtx);
+    myTCrdBuf.release(aCtx);
+    myHilightBuf.release(aCtx);
+}
+
+void StGLThumbnailGrid::clearItems() {
+    myCache->clear();
+    destroyChildren();
+    myCells.clear();
+    for(size_t aSlotIter = 0; aSlotIter < mySlotOwners.size(); ++aSlotIter) {
+        mySlotOwners[aSlotIter] = -1;
+    }
+    myRowFrom = myRowTo = -1;
+    myHilightCell = myClickedCell = -1;
+    changeRectPx().bottom() = getRectPx().top();
+}
+
+StRectI_t StGLThumbnailGrid::getCellRect(const size_t theCell) const {
+    const int aCol = int(theCell % size_t(myNbColumns));
+    const int aRow = int(theCell / size_t(myNbColumns));
+    return StRectI_t(aRow * myCellSizeY, (aRow + 1) * myCellSizeY,
+                     aCol * myCellSizeX, (aCol + 1) * myCellSizeX);
+}
+
+int StGLThumbnailGrid::getCellAt(const StPointD_t& thePointZo) const {
+    const StRectI_t aRectAbs = getRectPxAbsolute();
+    const int aPntX = int(thePointZo.x() * (double )myRoot->getRectPx().width())  - aRectAbs.left();
+    const int aPntY = int(thePointZo.y() * (double )myRoot->getRectPx().height()) - aRectAbs.top();
+    if(aPntX < 0 || aPntY < 0
+    || aPntX >= myNbColumns * myCellSizeX) {
+        return -1;
+    }
+
+    const size_t aCell = size_t(aPntY / myCellSizeY) * size_t(myNbColumns) + size_t(aPntX / myCellSizeX);
+    return aCell < myCells.size() ? int(aCell) : -1;
+}
+
+void StGLThumbnailGrid::getVisibleRows(int& theRowFrom,
+                                       int& theRowTo) const {
+    const int aViewSizeY = myParent != NULL ? myParent->getRectPx().height() : getRectPx().height();
+    const int aViewFrom  = stMax(-getRectPx().top(), 0);
+    theRowFrom = aViewFrom / myCellSizeY;
+    theRowTo   = (aViewFrom + stMax(aViewSizeY, 1) - 1) / myCellSizeY;
+}
+
+void StGLThumbnailGrid::addItem(const StString&                   theLabel,
+                                const StString&                   theImagePath,
+                                const StHandle<StGLTextureArray>& theIcon,
+                                const StGLVec4&                   theIconColor,
+                                const size_t                      theUserData) {
+    const StRectI_t aRect   = getCellRect(myCells.size());
+    const int       aMargin = myRoot->scale(4);
+
+    Cell aCell;
+    aCell.ImagePath = theImagePath;
+    aCell.Icon      = NULL;
+    aCell.UserData  = theUserData;
+    aCell.State     = theImagePath.isEmpty() ? ThumbState_Failed : ThumbState_None;
+    aCell.Priority  = -1;
+    aCell.Slot      = -1;
+    aCell.SizeX     = 0;
+    aCell.SizeY     = 0;
+    if(!theIcon.isNull()) {
+        const int anIconHalf = myRoot->scale(8);
+        aCell.Icon = new StGLIcon(this, aRect.left() + myCellSizeX / 2 - anIconHalf,
+                                  aRect.top() + aMargin + myThumbSize / 2 - anIconHalf,
+                                  StGLCorner(ST_VCORNER_TOP, ST_HCORNER_LEFT), 0);
+        aCell.Icon->setColor(theIconColor);
+        aCell.Icon->setExternalTextures(theIcon);
+    }
+
+    aCell.Label = new StGLTextArea(this, aRect.left(), aRect.top() + aMargin * 2 + myThumbSize,
+                                   StGLCorner(ST_VCORNER_TOP, ST_HCORNER_LEFT),
+                                   myCellSizeX, aRect.height() - aMargin * 2 - myThumbSize,
+                                   StGLTextArea::SIZE_SMALL);
+    aCell.Label->setupAlignment(StGLTextFormatter::ST_ALIGN_X_CENTER,
+                                StGLTextFormatter::ST_ALIGN_Y_TOP);
+    aCell.Label->setTextColor(myTextColor);
+    aCell.Label->setTextWidth(myCellSizeX);
+    aCell.Label->setText(theLabel);
+    myCells.push_back(aCell);
+
+    changeRectPx().bottom() = getRectPx().top() + aRect.bottom();
+    myRowFrom = myRowTo = -1; // request thumbnails on next update
+}
+
+bool StGLThumbnailGrid::stglInit() {
+    StGLContext& aCtx = getContext();
+    if(myProgram.isNull()) {
+        myProgram.create(getRoot()->getContextHandle(), new Program());
+        myProgram->init(aCtx);
+    }
+
+    if(!myAtlas.isValid()) {
+        GLint anInternalFormat = GL_RGB;
+        StGLTexture::getInternalFormat(aCtx, StImagePlane::ImgRGB, anInternalFormat);
+        const GLint aSize = stMin(THE_ATLAS_SIZE_MAX, aCtx.getMaxTextureSize());
+        myAtlas.setTextureFormat(anInternalFormat);
+        if(myAtlas.initTrash(aCtx, aSize, aSize)) {
+            myAtlas.setMinMagFilter(aCtx, GL_LINEAR);
+            mySlotsPerRow = aSize / myThumbSize;
+            mySlotOwners.assign(size_t(mySlotsPerRow * mySlotsPerRow), -1);
+        } else {
+            ST_ERROR_LOG("StGLThumbnailGrid, unable to create atlas texture " + aSize + "x" + aSize);
+        }
+    }
+    return StGLWidget::stglInit();
+}
+
+void StGLThumbnailGrid::updateRequests() {
+    const int aPageRows = myRowTo - myRowFrom + 1;
+    for(size_t aCellIter = 0; aCellIter < myCells.size(); ++aCellIter) {
+        Cell& aCell = myCells[aCellIter];
+        if(aCell.State == ThumbState_Loaded
+        || aCell.State == ThumbState_Failed) {
+            continue;
+        }
+
+        const int aRow = int(aCellIter / size_t(myNbColumns));
+        int aPriority = ThumbPriority_Background;
+        if(aRow >= myRowFrom && aRow <= myRowTo) {
+            aPriority = ThumbPriority_Visible;
+        } else if(aRow >= myRowFrom - aPageRows && aRow <= myRowTo + aPageRows) {
+            aPriority = ThumbPriority_Near;
+        }
+
+        if(aCell.State == ThumbState_None
+        && aPriority   == ThumbPriority_Background
+        && aCell.Priority >= 0) {
+            // already generated once and evicted from atlas - wait until it comes closer
+            continue;
+        }
+        if(aCell.State    == ThumbState_Requested
+        && aCell.Priority == aPriority) {
+            continue;
+        }
+
+        myCache->request(aCellIter, aCell.ImagePath, aPriority);
+        aCell.State    = ThumbState_Requested;
+        aCell.Priority = aPriority;
+    }
+}
+
+int StGLThumbnailGrid::allocateSlot(const bool theToEvict) {
+    int aFarSlot = -1;
+    int aFarDist = 0;
+    for(size_t aSlotIter = 0; aSlotIter < mySlotOwners.size(); ++aSlotIter) {
+        const int anOwner = mySlotOwners[aSlotIter];
+        if(anOwner < 0) {
+            return int(aSlotIter);
+        }
+
+        const int aRow  = anOwner / myNbColumns;
+        const int aDist = aRow < myRowFrom ? (myRowFrom - aRow) : (aRow - myRowTo);
+        if(aDist > aFarDist) {
+            aFarDist = aDist;
+            aFarSlot = int(aSlotIter);
+        }
+    }
+    if(aFarSlot < 0
+    || !theToEvict) {
+        return -1;
+    }
+
+    Cell& anEvicted = myCells[mySlotOwners[aFarSlot]];
+    anEvicted.State = ThumbState_None;
+    anEvicted.Slot  = -1;
+    if(anEvicted.Icon != NULL) {
+        anEvicted.Icon->setOpacity(1.0f, false);
+    }
+    mySlotOwners[aFarSlot] = -1;
+    return aFarSlot;
+}
+
+void StGLThumbnailGrid::uploadThumbnails(StGLContext& theCtx) {
+    if(!myAtlas.isValid()) {
+        return;
+    }
+
+    StThumbnailCache::Thumbnail aThumb;
+    for(int aNbUploaded = 0; aNbUploaded < THE_MAX_UPLOADS_PER_FRAME && myCache->pop(aThumb);) {
+        if(aThumb.Id >= myCells.size()) {
+            continue;
+        }
+
+        Cell& aCell = myCells[aThumb.Id];
+        if(aCell.State != ThumbState_Requested) {
+            continue;
+        } else if(aThumb.Image.isNull()) {
+            aCell.State = ThumbState_Failed;
+            continue;
+        }
+
+        // cells far from visible area take only free slots and never push out other thumbnails
+        const int aRow  = int(aThumb.Id / size_t(myNbColumns));
+        const int aDist = aRow < myRowFrom ? (myRowFrom - aRow) : stMax(aRow - myRowTo, 0);
+        const int aSlot = allocateSlot(aDist <= myRowTo - myRowFrom + 1);
+        if(aSlot < 0) {
+            aCell.State = ThumbState_None;
+            continue;
+        }
+
+        const GLsizei anOffsetX = GLsizei((aSlot % mySlotsPerRow) * myThumbSize);
+        const GLsizei anOffsetY = GLsizei((aSlot / mySlotsPerRow) * myThumbSize);
+        if(!myAtlas.fillRegion(theCtx, *aThumb.Image, anOffsetX, anOffsetY)) {
+            aCell.State = ThumbState_Failed;
+            continue;
+        }
+
+        mySlotOwners[aSlot] = int(aThumb.Id);
+        aCell.State = ThumbState_Loaded;
+        aCell.Slot  = aSlot;
+        aCell.SizeX = int(aThumb.Image->getSizeX());
+        aCell.SizeY = int(aThumb.Image->getSizeY());
+        if(aCell.Icon != NULL) {
+            aCell.Icon->setOpacity(0.0f, false);
+        }
+        ++aNbUploaded;
+    }
+}
+
+void StGLThumbnailGrid::stglUpdate(const StPointD_t& theCursorZo,
+                                   bool theIsPreciseInput) {
+    if(!isVisible()) {
+        StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
+        return;
+    }
+
+    int aRowFrom = 0, aRowTo = 0;
+    getVisibleRows(aRowFrom, aRowTo);
+    if(aRowFrom != myRowFrom
+    || aRowTo   != myRowTo) {
+        myRowFrom = aRowFrom;
+        myRowTo   = aRowTo;
+        updateRequests();
+    }
+
+    const int aHilightCell = myParent != NULL && myParent->isPointIn(theCursorZo)
+                           ? getCellAt(theCursorZo)
+                           : -1;
+    if(aHilightCell != myHilightCell) {
+        myHilightCell = aHilightCell;
+        invalidate();
+    }
+    if(myCache->hasResults()) {
+        invalidate();
+    }
+    StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
+}
+
+void StGLThumbnailGrid::stglDraw(unsigned int theView) {
+    if(!isVisible()) {
+        return;
+    }
+
+    StGLContext& aCtx = getContext();
+    uploadThumbnails(aCtx);
+
+    const StRectI_t aRectAbs = getRectPxAbsolute();
+    if(myHilightCell >= 0) {
+        StRectI_t aCellRect = getCellRect(size_t(myHilightCell));
+        aCellRect.move(StVec2<int>(aRectAbs.left(), aRectAbs.top()));
+        StArray<StGLVec2> aVertices(4);
+        myRoot->getRectGl(aCellRect, aVertices);
+        myHilightBuf.init(aCtx, aVertices);
+
+        aCtx.stglSetBlendAlpha();
+        aCtx.core20fwd->glEnable(GL_BLEND);
+        StGLMenuProgram& aProgram = myRoot->getMenuProgram();
+        aProgram.use(aCtx, myHilightColor, myOpacity, myRoot->getScreenDispX());
+        myHilightBuf.bindVertexAttrib(aCtx, aProgram.getVVertexLoc());
+        aCtx.core20fwd->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        myHilightBuf.unBindVertexAttrib(aCtx, aProgram.getVVertexLoc());
+        aProgram.unuse(aCtx);
+        aCtx.core20fwd->glDisable(GL_BLEND);
+    }
+
+    // collect visible thumbnails into single draw call
+    std::vector<StGLVec2> aVerts, aTCrds;
+    const int    aMargin     = myRoot->scale(4);
+    const GLfloat anAtlasSize = GLfloat(myAtlas.getSizeX());
+    const size_t aCellFrom   = size_t(stMax(myRowFrom, 0)) * size_t(myNbColumns);
+    const size_t aCellTo     = stMin(size_t(stMax(myRowTo + 1, 0)) * size_t(myNbColumns), myCells.size());
+    for(size_t aCellIter = aCellFrom; aCellIter < aCellTo; ++aCellIter) {
+        const Cell& aCell = myCells[aCellIter];
+        if(aCell.State != ThumbState_Loaded) {
+            continue;
+        }
+
+        const StRectI_t aCellRect = getCellRect(aCellIter);
+        StRectI_t aThumbRect;
+        aThumbRect.left()   = aRectAbs.left() + aCellRect.left() + (myCellSizeX - aCell.SizeX) / 2;
+        aThumbRect.top()    = aRectAbs.top()  + aCellRect.top()  + aMargin + (myThumbSize - aCell.SizeY) / 2;
+        aThumbRect.right()  = aThumbRect.left() + aCell.SizeX;
+        aThumbRect.bottom() = aThumbRect.top()  + aCell.SizeY;
+        const StRectD_t aRectGl = myRoot->getRectGl(aThumbRect);
+
+        const GLfloat aTexLeft   = GLfloat((aCell.Slot % mySlotsPerRow) * myThumbSize) / anAtlasSize;
+        const GLfloat aTexTop    = GLfloat((aCell.Slot / mySlotsPerRow) * myThumbSize) / anAtlasSize;
+        const GLfloat aTexRight  = aTexLeft + GLfloat(aCell.SizeX) / anAtlasSize;
+        const GLfloat aTexBottom = aTexTop  + GLfloat(aCell.SizeY) / anAtlasSize;
+
+        const StGLVec2 aLT(GLfloat(aRectGl.left()),  GLfloat(aRectGl.top()));
+        const StGLVec2 aLB(GLfloat(aRectGl.left()),  GLfloat(aRectGl.bottom()));
+        const StGLVec2 aRT(GLfloat(aRectGl.right()), GLfloat(aRectGl.top()));
+        const StGLVec2 aRB(GLfloat(aRectGl.right()), GLfloat(aRectGl.bottom()));
+        aVerts.push_back(aLT); aTCrds.push_back(StGLVec2(aTexLeft,  aTexTop));
+        aVerts.push_back(aLB); aTCrds.push_back(StGLVec2(aTexLeft,  aTexBottom));
+        aVerts.push_back(aRT); aTCrds.push_back(StGLVec2(aTexRight, aTexTop));
+        aVerts.push_back(aRT); aTCrds.push_back(StGLVec2(aTexRight, aTexTop));
+        aVerts.push_back(aLB); aTCrds.push_back(StGLVec2(aTexLeft,  aTexBottom));
+        aVerts.push_back(aRB); aTCrds.push_back(StGLVec2(aTexRight, aTexBottom));
+    }
+
+    if(!aVerts.empty()
+    && !myProgram.isNull()
+    &&  myProgram->isValid()) {
+        myVertBuf.init(aCtx, aVerts);
+        myTCrdBuf.init(aCtx, aTCrds);
+
+        aCtx.stglSetBlendAlpha();
+        aCtx.core20fwd->glEnable(GL_BLEND);
+        myAtlas.bind(aCtx);
+        myProgram->use(aCtx, myRoot->getScreenProjection(), myRoot->getScreenDispX(), myOpacity);
+        myVertBuf.bindVertexAttrib(aCtx, myProgram->getVVertexLoc());
+        myTCrdBuf.bindVertexAttrib(aCtx, myProgram->getVTexCoordLoc());
+        aCtx.core20fwd->glDrawArrays(GL_TRIANGLES, 0, GLsizei(aVerts.size()));
+        myTCrdBuf.unBindVertexAttrib(aCtx, myProgram->getVTexCoordLoc());
+        myVertBuf.unBindVertexAttrib(aCtx, myProgram->getVVertexLoc());
+        myProgram->unuse(aCtx);
+        myAtlas.unbind(aCtx);
+        aCtx.core20fwd->glDisable(GL_BLEND);
+    }
+
+    StGLWidget::stglDraw(theView); // draw icons and labels
+}
+
+bool StGLThumbnailGrid::tryClick(const StClickEvent& theEvent,
+                                 bool&               theIsItemClicked) {
+    // cells are handled by the grid itself, children are passive
+    if(!isVisible()
+    || theIsItemClicked
+    || !isPointIn(StPointD_t(theEvent.PointX, theEvent.PointY))) {
+        return false;
+    }
+
+    setClicked(theEvent.Button, true);
+    myClickedCell = getCellAt(StPointD_t(theEvent.PointX, theEvent.PointY));
+    return true;
+}
+
+bool StGLThumbnailGrid::tryUnClick(const StClickEvent& theEvent,
+                                   bool&               theIsItemUnclicked) {
+    if(!isVisible()) {
+        return false;
+    }
+
+    // clicked state is reset by scroll area when content has been dragged
+    const bool isSelfClicked = isClicked(theEvent.Button)
+                            && isPointIn(StPointD_t(theEvent.PointX, theEvent.PointY));
+    setClicked(theEvent.Button, false);
+    const int aClickedCell = myClickedCell;
+    myClickedCell = -1;
+    if(theIsItemUnclicked
+    || !isSelfClicked
+    ||  theEvent.Button != ST_MOUSE_LEFT
+    ||  theEvent.Type   == stEvent_MouseCancel) {
+        return false;
+    }
+
+    if(aClickedCell >= 0
+    && aClickedCell == getCellAt(StPointD_t(theEvent.PointX, theEvent.PointY))) {
+        theIsItemUnclicked = true;
+        signals.onItemClick(myCells[aClickedCell].UserData);
+    }
+    return true;
+}
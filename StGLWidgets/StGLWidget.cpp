@@ -36,6 +36,7 @@ StGLWidget::StGLWidget(StGLWidget* theParent,
     if(myParent != NULL) {
         myParent->getChildren()->add(this);
     }
+    invalidate();
     stMemSet(myMouseClicked, 0, sizeof(myMouseClicked));
 }
 
@@ -44,6 +45,9 @@ StGLWidget::~StGLWidget() {
     && myRoot->getFocus() == this) {
         myRoot->setFocus(NULL);
     }
+    if(myRoot != this) {
+        invalidate();
+    }
     if(myParent != NULL) {
         // remove self from parent
         myParent->getChildren()->remove(this);
@@ -390,7 +394,16 @@ bool StGLContainer::tryUnClick(const StClickEvent& theEvent,
     return false;
 }
 
+void StGLWidget::invalidate() {
+    if(myRoot != NULL) {
+        myRoot->invalidateCache();
+    }
+}
+
 void StGLWidget::setOpacity(const float theOpacity, bool theToSetChildren) {
+    if(myOpacity != theOpacity) {
+        invalidate();
+    }
     myOpacity = theOpacity;
     if(!theToSetChildren) {
         return;
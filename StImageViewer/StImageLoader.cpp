@@ -24,6 +24,7 @@
 #include "../StMoviePlayer/StMoviePlayerInfo.h"
 
 #include <StAV/StAVImage.h>
+#include <StImage/StExifTags.h>
 #include <StThreads/StThread.h>
 
 using namespace StImageViewerStrings;
@@ -66,6 +67,7 @@ StImageLoader::StImageLoader(const StImageFile::ImageClass      theImageLib,
   myMaxTexDim(theMaxTexDim),
   myTextureQueue(theTextureQueue),
   myMsgQueue(theMsgQueue),
+  mySaveQueue(new StImageSaveQueue(theMsgQueue)),
   myImageLib(theImageLib),
   myAction(Action_NONE),
   myToStickPano360(false),
@@ -93,27 +95,27 @@ void StImageLoader::processLoadFail(const StString& theErrorDesc) {
     myTextureQueue->clear();
 }
 
-void StImageLoader::metadataFromExif(const StHandle<StExifDir>& theDir,
+void StImageLoader::metadataFromExif(const StJpegParser::Image& theImage,
                                      StHandle<StImageInfo>&     theInfo) {
-    if(theDir.isNull()) {
-        return;
-    }
-
-    if(!theDir->CameraMaker.isEmpty()) {
+    // read only few tags without decoding complete EXIF (including large Maker Notes)
+    StString aValue;
+    if(theImage.getExifString(StExifDir::DType_General, StExifTags::Image_Make, aValue)
+    && !aValue.isEmpty()) {
         StDictEntry& anEntry  = theInfo->Info.addChange("Exif.Image.Make");
-        anEntry.changeValue() = theDir->CameraMaker;
+        anEntry.changeValue() = aValue;
     }
-    if(!theDir->CameraModel.isEmpty()) {
+    if(theImage.getExifString(StExifDir::DType_General, StExifTags::Image_Model, aValue)
+    && !aValue.isEmpty()) {
         StDictEntry& anEntry  = theInfo->Info.addChange("Exif.Image.Model");
-        anEntry.changeValue() = theDir->CameraModel;
-    }
-    if(!theDir->UserComment.isEmpty()) {
-        StDictEntry& anEntry  = theInfo->Info.addChange("Exif.UserComment");
-        anEntry.changeValue() = theDir->UserComment;
+        anEntry.changeValue() = aValue;
     }
 
-    for(size_t anExifId = 0; anExifId < theDir->SubDirs.size(); ++anExifId) {
-        metadataFromExif(theDir->SubDirs[anExifId], theInfo);
+    StExifReader::Entry aComment;
+    if(theImage.findExifEntry(StExifDir::DType_General, StExifTags::Photo_UserComment, aComment)
+    && StExifReader::decodeUserComment(aComment.Value, aValue)
+    && !aValue.isEmpty()) {
+        StDictEntry& anEntry  = theInfo->Info.addChange("Exif.UserComment");
+        anEntry.changeValue() = aValue;
     }
 }
 
@@ -341,9 +343,7 @@ bool StImageLoader::loadImage(const StHandle<StFileNode>& theSource,
             anEntry.changeValue() = aParser.getJpsComment();
         }
         if(!anImg1.isNull()) {
-            for(size_t anExifId = 0; anExifId < anImg1->Exif.size(); ++anExifId) {
-                metadataFromExif(anImg1->Exif[anExifId], anImgInfo);
-            }
+            metadataFromExif(*anImg1, anImgInfo);
             const StString aTime = anImg1->getDateTime();
             if(!aTime.isEmpty()) {
                 StDictEntry& anEntry  = anImgInfo->Info.addChange("Exif.Image.DateTime");
@@ -610,35 +610,39 @@ bool StImageLoader::saveImage(const StHandle<StFileNode>&     theSource,
         return false;
     }
 
+    StHandle<StImageFile> aDataLeft = StImageFile::create(myImageLib);
+    if(aDataLeft.isNull()) {
+        myMsgQueue->pushError(stCString("No any image library was found!"));
+        return false;
+    }
+
+    // take reference to displayed image instead of copying it when possible
     int aResult = StGLTextureQueue::SNAPSHOT_NO_NEW;
-    StImage aDataLeft, aDataRight;
+    StImage aDataRight;
     if(!theParams->ToSwapLR) {
-        aResult = getSnapshot(&aDataLeft, &aDataRight, true);
+        aResult = getSnapshot(aDataLeft.access(), &aDataRight, true, true);
     } else {
-        aResult = getSnapshot(&aDataRight, &aDataLeft, true);
+        aResult = getSnapshot(&aDataRight, aDataLeft.access(), true, true);
     }
 
     if(aResult == StGLTextureQueue::SNAPSHOT_NO_NEW
-    || aDataLeft.isNull()) {
+    || aDataLeft->isNull()) {
         myMsgQueue->pushInfo(tr(DIALOG_NO_SNAPSHOT));
         return false;
     }
-    StHandle<StImageFile> aDataResult = StImageFile::create(myImageLib);
-    if(aDataResult.isNull()) {
-        myMsgQueue->pushError(stCString("No any image library was found!"));
-        return false;
-    }
 
+    StHandle<StImageFile> aDataResult = aDataLeft;
     const bool toSaveStereo = !aDataRight.isNull();
-    if(toSaveStereo
-    && aDataResult->initSideBySide(aDataLeft, aDataRight,
-                                   theParams->getSeparationDx(),
-                                   theParams->getSeparationDy())) {
-        aDataLeft.nullify();
-        aDataRight.nullify();
-    } else {
-        aDataResult->initWrapper(aDataLeft);
+    if(toSaveStereo) {
+        StHandle<StImageFile> aDataPair = StImageFile::create(myImageLib);
+        if(aDataPair->initSideBySide(*aDataLeft, aDataRight,
+                                     theParams->getSeparationDx(),
+                                     theParams->getSeparationDy())) {
+            aDataResult = aDataPair;
+        }
     }
+    aDataLeft.nullify();
+    aDataRight.nullify();
 
     StOpenFileName anOpenInfo;
     anOpenInfo.Title = myLangMap->getValue(StImageViewerStrings::DIALOG_SAVE_SNAPSHOT);
@@ -692,17 +696,17 @@ bool StImageLoader::saveImage(const StHandle<StFileNode>&     theSource,
         }
 
         if(toSave) {
-            ST_DEBUG_LOG("Save snapshot to the path '" + aFileToSave + '\'');
-            StString strSaveState;
-            if(!aDataResult->save(aFileToSave, theImgType,
-                                  toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO)) {
-                // TODO (Kirill Gavrilov#7)
-                myMsgQueue->pushError(aDataResult->getState());
+            // encode and write the file in background to keep loader responsive
+            StImageSaveQueue::Job aJob;
+            aJob.Image   = aDataResult;
+            aJob.Path    = aFileToSave;
+            aJob.Type    = theImgType;
+            aJob.Format  = toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO;
+            aJob.DoneMsg = tr(DIALOG_SNAPSHOT_SAVED).format(aFileToSave);
+            if(!mySaveQueue->push(aJob)) {
+                myMsgQueue->pushError(tr(DIALOG_SNAPSHOT_BUSY));
                 return false;
             }
-            if(!aDataResult->getState().isEmpty()) {
-                ST_DEBUG_LOG(aDataResult->getState());
-            }
             // TODO (Kirill Gavrilov#8) - update playlist (append new file)
         }
     }
@@ -24,6 +24,7 @@
 #include <StGL/StPlayList.h>
 #include <StGLStereo/StGLTextureQueue.h>
 #include <StImage/StImageFile.h>
+#include <StImage/StImageSaveQueue.h>
 #include <StImage/StJpegParser.h>
 #include <StSlots/StSignal.h>
 #include <StStrings/StLangMap.h>
@@ -41,8 +42,9 @@ struct StImageInfo {
     StFormat                 StInfoStream;   //!< source format as stored in file metadata
     StFormat                 StInfoFileName; //!< source format detected from file name
     bool                     IsSavable;      //!< indicate that file can be saved without re-encoding
+    bool                     IsFullExif;     //!< indicate that complete EXIF has been decoded into Info
 
-    StImageInfo() : ImageType(StImageFile::ST_TYPE_NONE), StInfoStream(StFormat_AUTO), StInfoFileName(StFormat_AUTO), IsSavable(false) {}
+    StImageInfo() : ImageType(StImageFile::ST_TYPE_NONE), StInfoStream(StFormat_AUTO), StInfoFileName(StFormat_AUTO), IsSavable(false), IsFullExif(false) {}
 
 };
 
@@ -181,8 +183,8 @@ class StImageLoader {
 
     ST_LOCAL bool saveImageInfo(const StHandle<StImageInfo>& theInfo);
 
-    ST_LOCAL int getSnapshot(StImage* outDataLeft, StImage* outDataRight, bool isForce = false) {
-        return myTextureQueue->getSnapshot(outDataLeft, outDataRight, isForce);
+    ST_LOCAL int getSnapshot(StImage* outDataLeft, StImage* outDataRight, bool isForce = false, bool theToReference = false) {
+        return myTextureQueue->getSnapshot(outDataLeft, outDataRight, isForce, theToReference);
     }
 
     /**
@@ -191,9 +193,9 @@ class StImageLoader {
     ST_LOCAL void processLoadFail(const StString& theErrorDesc);
 
     /**
-     * Fill metadata map from EXIF.
+     * Fill metadata map with basic tags from EXIF.
      */
-    ST_LOCAL void metadataFromExif(const StHandle<StExifDir>& theDir,
+    ST_LOCAL void metadataFromExif(const StJpegParser::Image& theImage,
                                    StHandle<StImageInfo>&     theInfo);
 
     ST_LOCAL const StString& tr(const size_t theId) const {
@@ -216,6 +218,7 @@ class StImageLoader {
     StHandle<StImageInfo>       myImgInfo;       //!< info about currently loaded image
     StHandle<StImageInfo>       myInfoToSave;    //!< modified info to be saved
     StHandle<StMsgQueue>        myMsgQueue;      //!< messages queue
+    StHandle<StImageSaveQueue>  mySaveQueue;     //!< queue encoding snapshots in background
 
     volatile StImageFile::ImageClass myImageLib;
     volatile Action            myAction;
@@ -33,6 +33,7 @@
 #include <StGLWidgets/StGLPlayList.h>
 #include <StSettings/StSettings.h>
 #include <StSocket/StCheckUpdates.h>
+#include <StThreads/StStartupProfiler.h>
 #include <StThreads/StThread.h>
 #include <StImage/StImageFile.h>
 #include <StCore/StSearchMonitors.h>
@@ -137,8 +138,14 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
   myEscNoQuit(false),
   myToHideUIFullScr(false),
   myToCheckPoorOrient(true) {
-    mySettings = new StSettings(myResMgr, myAppName);
-    myLangMap  = new StTranslations(myResMgr, StImageViewer::ST_DRAWER_PLUGIN_NAME);
+    {
+        StStartupProfiler::Scope aProfScope("settings");
+        mySettings = new StSettings(myResMgr, myAppName);
+    }
+    {
+        StStartupProfiler::Scope aProfScope("translations");
+        myLangMap  = new StTranslations(myResMgr, StImageViewer::ST_DRAWER_PLUGIN_NAME);
+    }
     myOpenDialog = new StImageOpenDialog(this);
     StImageViewerStrings::loadDefaults(*myLangMap);
     myLangMap->params.language->signals.onChanged += stSlot(this, &StImageViewer::doChangeLanguage);
@@ -165,6 +172,7 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
     params.SrcStereoFormat->signals.onChanged.connect(this, &StImageViewer::doSwitchSrcFormat);
     params.ToShowPlayList   = new StBoolParamNamed(false, stCString("showPlaylist"));
     params.ToShowPlayList->signals.onChanged = stSlot(this, &StImageViewer::doShowPlayList);
+    myPlayList->signals.onTargetFound += stSlot(this, &StImageViewer::doPlayListTarget);
     params.ToShowAdjustImage = new StBoolParamNamed(false, stCString("showAdjustImage"));
     params.ToShowAdjustImage->signals.onChanged = stSlot(this, &StImageViewer::doShowAdjustImage);
     params.ToSwapJPS = new StBoolParamNamed(false, stCString("toSwapJPS"));
@@ -199,6 +207,7 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
     StApplication::params.VSyncMode->setValue(StGLContext::VSync_ON);
     params.ToOpenLast   = new StBoolParamNamed(false, stCString("toOpenLast"));
     params.ToSaveRecent = new StBoolParamNamed(false, stCString("toSaveRecent"));
+    params.ToShowThumbs = new StBoolParamNamed(true,  stCString("toShowThumbs"));
     params.imageLib = StImageFile::ST_LIBAV,
     params.TargetFps = new StInt32ParamNamed(0, stCString("fpsTarget"));
     updateStrings();
@@ -227,18 +236,19 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam (params.IsVSyncOn);
     mySettings->loadParam (params.ToShowPlayList);
     mySettings->loadParam (params.ToShowAdjustImage);
+    mySettings->loadParam (params.ToShowThumbs);
 
 #if defined(__ANDROID__)
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
+    addRendererLazy<StOutInterlace>  ("StOutInterlace", "Interlaced Output");
+    addRendererLazy<StOutAnaglyph>   ("StOutAnaglyph",  "Anaglyph Output");
+    addRendererLazy<StOutDistorted>  ("StOutDistorted", "Distorted Output");
 #else
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDual       (myResMgr, theParentWin));
-    addRenderer(new StOutIZ3D       (myResMgr, theParentWin));
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
-    addRenderer(new StOutPageFlipExt(myResMgr, theParentWin));
+    addRendererLazy<StOutAnaglyph>   ("StOutAnaglyph",  "Anaglyph Output");
+    addRendererLazy<StOutDual>       ("StOutDual",      "Dual Output");
+    addRendererLazy<StOutIZ3D>       ("StOutIZ3D",      "iZ3D Output");
+    addRendererLazy<StOutInterlace>  ("StOutInterlace", "Interlaced Output");
+    addRendererLazy<StOutDistorted>  ("StOutDistorted", "Distorted Output");
+    addRendererLazy<StOutPageFlipExt>("StOutPageFlip",  "Shutter glasses Output");
 #endif
 
     // no need in Depth buffer
@@ -247,10 +257,7 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
         StWinAttr_GlStencilSize, (StWinAttr )0,
         StWinAttr_NULL
     };
-    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        aRend->setAttributes(anAttribs);
-    }
+    setRendererAttributes(anAttribs);
 
     // create actions
     StHandle<StAction> anAction;
@@ -353,6 +360,8 @@ void StImageViewer::saveGuiParams() {
     mySettings->saveParam(myGUI->myImage->params.DisplayMode);
     mySettings->saveInt32(ST_SETTING_GAMMA, stRound(100.0f * myGUI->myImage->params.Gamma->getValue()));
     mySettings->saveParam(myGUI->myImage->params.ToHealAnamorphicRatio);
+    mySettings->saveParam(myGUI->myImage->params.ToRayCastPanorama);
+    mySettings->saveParam(myGUI->myImage->params.PanoProjection);
     mySettings->saveInt32(myGUI->myImage->params.DisplayRatio->getKey(),
                           params.ToRestoreRatio->getValue()
                         ? myGUI->myImage->params.DisplayRatio->getValue()
@@ -385,6 +394,7 @@ void StImageViewer::saveAllParams() {
         mySettings->saveParam (params.IsVSyncOn);
         mySettings->saveParam (params.ToShowPlayList);
         mySettings->saveParam (params.ToShowAdjustImage);
+        mySettings->saveParam (params.ToShowThumbs);
         if(myToSaveSrcFormat) {
             mySettings->saveParam(params.SrcStereoFormat);
         }
@@ -431,6 +441,7 @@ void StImageViewer::releaseDevice() {
 }
 
 StImageViewer::~StImageViewer() {
+    myPlayList->signals.onTargetFound -= stSlot(this, &StImageViewer::doPlayListTarget);
     myUpdates.nullify();
     releaseDevice();
     // wait image loading thread to quit and release resources
@@ -461,6 +472,8 @@ bool StImageViewer::createGui() {
     mySettings->loadParam (myGUI->myImage->params.TextureFilter);
     mySettings->loadParam (myGUI->myImage->params.DisplayRatio);
     mySettings->loadParam (myGUI->myImage->params.ToHealAnamorphicRatio);
+    mySettings->loadParam (myGUI->myImage->params.ToRayCastPanorama);
+    mySettings->loadParam (myGUI->myImage->params.PanoProjection);
     params.ToRestoreRatio->setValue(myGUI->myImage->params.DisplayRatio->getValue() != StGLImageRegion::RATIO_AUTO);
     int32_t loadedGamma = 100; // 1.0f
         mySettings->loadInt32(ST_SETTING_GAMMA, loadedGamma);
@@ -1090,6 +1103,18 @@ void StImageViewer::beforeDraw() {
     myGUI->myImage->getTextureQueue()->getUploadParams().MaxUploadIterations = 10;
 }
 
+bool StImageViewer::isRedrawNeeded() const {
+    if(StApplication::isRedrawNeeded()
+    || myGUI.isNull()
+    || myLoader.isNull()) {
+        return true;
+    }
+
+    // new image to upload / display, or changes within GUI
+    return myGUI->isDamaged()
+        || myLoader->getTextureQueue()->hasPendingUpdate();
+}
+
 void StImageViewer::stglDraw(unsigned int theView) {
     const bool hasCtx = !myContext.isNull() && myContext->isBound();
     if(!hasCtx || myWindow->isPaused()) {
@@ -1427,6 +1452,13 @@ void StImageViewer::doFileNext() {
     doUpdateStateLoading();
 }
 
+void StImageViewer::doPlayListTarget(const size_t ) {
+    // called from playlist parsing thread
+    if(!myLoader.isNull()) {
+        myLoader->doLoadNext();
+    }
+}
+
 bool StImageViewer::getCurrentFile(StHandle<StFileNode>&     theFileNode,
                                    StHandle<StStereoParams>& theParams,
                                    StHandle<StImageInfo>&    theInfo) {
@@ -65,6 +65,11 @@ class StImageViewer : public StApplication {
      */
     ST_CPPEXPORT virtual void beforeDraw() ST_ATTR_OVERRIDE;
 
+    /**
+     * Check new frames and GUI changes in addition to default redraw conditions.
+     */
+    ST_CPPEXPORT virtual bool isRedrawNeeded() const ST_ATTR_OVERRIDE;
+
     /**
      * Draw frame for requested view.
      */
@@ -141,6 +146,7 @@ class StImageViewer : public StApplication {
         StHandle<StBoolParamNamed>    ToShowPlayList;   //!< display playlist
         StHandle<StBoolParamNamed>    ToShowAdjustImage;//!< display image adjustment overlay
         StHandle<StBoolParamNamed>    ToShowFps;        //!< display FPS meter
+        StHandle<StBoolParamNamed>    ToShowThumbs;     //!< display thumbnails grid within open file dialog
         StHandle<StFloat32Param>      SlideShowDelay;   //!< slideshow delay
         StHandle<StBoolParamNamed>    IsMobileUI;       //!< display mobile interface (user option)
         StHandle<StBoolParam>         IsMobileUISwitch; //!< display mobile interface (actual value)
@@ -197,6 +203,7 @@ class StImageViewer : public StApplication {
     ST_LOCAL void doShowPlayList(const bool theToShow);
     ST_LOCAL void doShowAdjustImage(const bool theToShow);
     ST_LOCAL void doFileNext();
+    ST_LOCAL void doPlayListTarget(const size_t );
 
         public:
 
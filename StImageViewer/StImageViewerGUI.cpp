@@ -44,6 +44,7 @@
 #include <StGLWidgets/StGLFpsLabel.h>
 
 #include <StImage/StImageFile.h>
+#include <StImage/StJpegParser.h>
 #include <StVersion.h>
 
 #include "StImageViewerStrings.h"
@@ -402,6 +403,10 @@ void StImageViewerGUI::fillPanoramaMenu(StGLMenu* theMenu) {
                      myImage->params.ViewMode, StViewSurface_Sphere);
     theMenu->addItem(tr(MENU_VIEW_SURFACE_CUBEMAP),
                      myImage->params.ViewMode, StViewSurface_Cubemap);
+    theMenu->addItem(myImage->params.ToRayCastPanorama);
+    theMenu->addItem(myImage->params.PanoProjection, StGLImageProgram::PanoProjection_Perspective);
+    theMenu->addItem(myImage->params.PanoProjection, StGLImageProgram::PanoProjection_Stereographic);
+    theMenu->addItem(myImage->params.PanoProjection, StGLImageProgram::PanoProjection_Fisheye);
     if(myWindow->hasOrientationSensor()) {
         theMenu->addItem(tr(myWindow->isPoorOrientationSensor() ? MENU_VIEW_TRACK_HEAD_POOR : MENU_VIEW_TRACK_HEAD),
                          myPlugin->params.ToTrackHead);
@@ -603,6 +608,22 @@ void StImageViewerGUI::doAboutImage(const size_t ) {
         return;
     }
 
+    // complete EXIF (including vendor-specific Maker Notes) is decoded only on demand
+    if(!anExtraInfo->IsFullExif
+    && (anExtraInfo->ImageType == StImageFile::ST_TYPE_JPEG
+     || anExtraInfo->ImageType == StImageFile::ST_TYPE_MPO
+     || anExtraInfo->ImageType == StImageFile::ST_TYPE_JPS)) {
+        anExtraInfo->IsFullExif = true;
+        int aFileDescriptor = -1;
+        if(StFileNode::isContentProtocolPath(anExtraInfo->Path)) {
+            aFileDescriptor = myPlugin->myResMgr->openFileDescriptor(anExtraInfo->Path);
+        }
+        StJpegParser aParser;
+        if(aParser.readFile(anExtraInfo->Path, aFileDescriptor)) {
+            aParser.fillDictionary(anExtraInfo->Info, false);
+        }
+    }
+
     const StString aTitle  = tr(DIALOG_FILE_INFO);
     StInfoDialog*  aDialog = new StInfoDialog(myPlugin, this, aTitle, scale(512), scale(300));
 
@@ -1182,6 +1203,7 @@ void StImageViewerGUI::doOpenFile(const size_t ) {
 
     aDialog->setMimeList(myPlugin->myLoader->getMimeListImages(), "Images", false);
     aDialog->setMimeList(myPlugin->myLoader->getMimeListVideo(),  "Videos", true);
+    aDialog->addThumbnailsCheckbox(myPlugin->params.ToShowThumbs, "Thumbnails");
 
     if(myPlugin->params.lastFolder.isEmpty()) {
         StHandle<StFileNode> aCurrFile = myPlugin->myPlayList->getCurrentFile();
@@ -1272,6 +1294,7 @@ StImageViewerGUI::StImageViewerGUI(StImageViewer*  thePlugin,
     const GLfloat aScale = myPlugin->params.ScaleHiDPI2X->getValue() ? 2.0f : myPlugin->params.ScaleHiDPI ->getValue();
     setScale(aScale, (StGLRootWidget::ScaleAdjust )myPlugin->params.ScaleAdjust->getValue());
     setMobile(myPlugin->params.IsMobileUISwitch->getValue());
+    setCachedGui(true); // static widgets above the image are rendered once for both views
 
     myPlugin->params.ToShowFps->signals.onChanged.connect(this, &StImageViewerGUI::doShowFPS);
 
@@ -1594,6 +1617,9 @@ void StImageViewerGUI::stglDraw(unsigned int theView) {
     setLensDist(myPlugin->getMainWindow()->getLensDist());
     if((theView == ST_DRAW_LEFT || theView == ST_DRAW_MONO)
     && myFpsWidget != NULL) {
+        const StApplication::RedrawStats& aRedrawStats = myPlugin->getRedrawStats();
+        myFpsWidget->setRedrawStats(aRedrawStats.NbDrawn, aRedrawStats.NbSkipped,
+                                    aRedrawStats.PeriodMs > 0.0 ? aRedrawStats.DrawTimeMs / aRedrawStats.PeriodMs : -1.0);
         myFpsWidget->update(myPlugin->getMainWindow()->isStereoOutput(),
                             myPlugin->getMainWindow()->getTargetFps(),
                             myPlugin->getMainWindow()->getStatistics());
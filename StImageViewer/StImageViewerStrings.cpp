@@ -279,6 +279,10 @@ void loadDefaults(StLangMap& theStrings) {
                "Assign new Hot Key for action\n<i>{0}</i>");
     theStrings(DIALOG_CONFLICTS_WITH,
                "Conflicts with: <i>{0}</i>");
+    theStrings(DIALOG_SNAPSHOT_SAVED,
+               "Snapshot has been saved to\n{0}");
+    theStrings(DIALOG_SNAPSHOT_BUSY,
+               "Previous snapshots are still being saved!");
 
     theStrings(INFO_LEFT,
                "[left]");
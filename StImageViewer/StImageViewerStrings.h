@@ -161,6 +161,8 @@ namespace StImageViewerStrings {
 
         DIALOG_ASSIGN_HOT_KEY  = 2013,
         DIALOG_CONFLICTS_WITH  = 2014,
+        DIALOG_SNAPSHOT_SAVED  = 2015,
+        DIALOG_SNAPSHOT_BUSY   = 2016,
 
         // About dialog
         ABOUT_DPLUGIN_NAME     = 3000,
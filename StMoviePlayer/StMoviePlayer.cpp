@@ -29,6 +29,7 @@
 #include <StSocket/StCheckUpdates.h>
 #include <StSettings/StSettings.h>
 #include <StStrings/StStringStream.h>
+#include <StThreads/StStartupProfiler.h>
 #include <StCore/StSearchMonitors.h>
 
 #include <StGL/StGLContext.h>
@@ -116,6 +117,7 @@ void StMoviePlayer::updateStrings() {
     params.ScaleHiDPI2X->setName(tr(MENU_HELP_SCALE_HIDPI2X));
     params.SubtitlesPlace->setName(stCString("Subtitles Placement"));
     params.ToSearchSubs->setName(stCString("Search additional tracks"));
+    params.ToPlayGapless->setName(stCString("Gapless audio between files"));
     params.SubtitlesParser->setName(tr(MENU_SUBTITLES_PARSER));
     params.SubtitlesParser->defineOption(0, tr(MENU_SUBTITLES_PLAIN_TEXT));
     params.SubtitlesParser->defineOption(1, tr(MENU_SUBTITLES_LITE_HTML));
@@ -191,6 +193,7 @@ void StMoviePlayer::updateStrings() {
     params.UseGpu->setName(tr(MENU_MEDIA_GPU_DECODING) + aGpuAcc);
     params.UseOpenJpeg->setName(stCString("Use OpenJPEG instead of jpeg2000"));
     params.SnapshotImgType->setName(stCString("Snapshot Image Format"));
+    params.CaptureStep->setName(stCString("Capture every Nth frame"));
     params.Benchmark->setName(stCString("Benchmark"));
     myLangMap->params.language->setName(tr(MENU_HELP_LANGS));
 }
@@ -210,8 +213,14 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
   myToUpdateALList(false),
   myToCheckUpdates(true),
   myToCheckPoorOrient(true) {
-    mySettings = new StSettings(myResMgr, ST_DRAWER_PLUGIN_NAME);
-    myLangMap  = new StTranslations(myResMgr, StMoviePlayer::ST_DRAWER_PLUGIN_NAME);
+    {
+        StStartupProfiler::Scope aProfScope("settings");
+        mySettings = new StSettings(myResMgr, ST_DRAWER_PLUGIN_NAME);
+    }
+    {
+        StStartupProfiler::Scope aProfScope("translations");
+        myLangMap  = new StTranslations(myResMgr, StMoviePlayer::ST_DRAWER_PLUGIN_NAME);
+    }
     myOpenDialog = new StMovieOpenDialog(this);
     StMoviePlayerStrings::loadDefaults(*myLangMap);
     myLangMap->params.language->signals.onChanged += stSlot(this, &StMoviePlayer::doChangeLanguage);
@@ -246,6 +255,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     params.SubtitlesParallax->setStep(1.0f);
     params.SubtitlesParallax->setTolerance(0.1f);
     params.ToSearchSubs = new StBoolParamNamed(true, stCString("toSearchSubs"));
+    params.ToPlayGapless = new StBoolParamNamed(false, stCString("toPlayGapless"));
     params.SubtitlesParser = new StEnumParam(1, stCString("subsParser"));
     params.SubtitlesApplyStereo = new StBoolParamNamed(true, stCString("subsApplyStereo"));
     params.AudioAlDevice = new StALDeviceParam();
@@ -275,6 +285,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     params.SrcStereoFormat->signals.onChanged = stSlot(this, &StMoviePlayer::doSwitchSrcFormat);
     params.ToShowPlayList   = new StBoolParamNamed(false, stCString("showPlaylist"));
     params.ToShowPlayList->signals.onChanged = stSlot(this, &StMoviePlayer::doShowPlayList);
+    myPlayList->signals.onTargetFound += stSlot(this, &StMoviePlayer::doPlayListTarget);
     params.ToShowAdjustImage = new StBoolParamNamed(false, stCString("showAdjustImage"));
     params.ToShowAdjustImage->signals.onChanged = stSlot(this, &StMoviePlayer::doShowAdjustImage);
     params.ToSwapJPS  = new StBoolParamNamed(false, stCString("toSwapJPS"));
@@ -326,6 +337,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     // OpenJPEG seems to be faster then built-in jpeg2000 decoder
     params.UseOpenJpeg = new StBoolParamNamed(true, stCString("openJpeg"));
     params.SnapshotImgType = new StInt32ParamNamed(StImageFile::ST_TYPE_JPEG, stCString("snapImgType"));
+    params.CaptureStep = new StInt32ParamNamed(25, stCString("captureStep"));
     params.Benchmark = new StBoolParamNamed(false, stCString("benchmark"));
     params.Benchmark->signals.onChanged = stSlot(this, &StMoviePlayer::doSetBenchmark);
 
@@ -355,6 +367,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam (params.SubtitlesParser);
     mySettings->loadParam (params.SubtitlesApplyStereo);
     mySettings->loadParam (params.ToSearchSubs);
+    mySettings->loadParam (params.ToPlayGapless);
 
     myToCheckPoorOrient = !mySettings->loadParam(params.ToTrackHead);
     mySettings->loadParam (params.ToSwapJPS);
@@ -377,6 +390,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam (params.WebUIPort);
     mySettings->loadParam (params.ToPrintWebErrors);
     mySettings->loadParam (params.SnapshotImgType);
+    mySettings->loadParam (params.CaptureStep);
     mySettings->loadParam (params.BlockSleeping);
     mySettings->loadParam (params.ToHideStatusBar);
     mySettings->loadParam (params.ToHideNavBar);
@@ -397,16 +411,16 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     params.ToForceBFormat->signals.onChanged = stSlot(this, &StMoviePlayer::doSetForceBFormat);
 
 #if defined(__ANDROID__)
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
+    addRendererLazy<StOutInterlace>  ("StOutInterlace", "Interlaced Output");
+    addRendererLazy<StOutAnaglyph>   ("StOutAnaglyph",  "Anaglyph Output");
+    addRendererLazy<StOutDistorted>  ("StOutDistorted", "Distorted Output");
 #else
-    addRenderer(new StOutAnaglyph   (myResMgr, theParentWin));
-    addRenderer(new StOutDual       (myResMgr, theParentWin));
-    addRenderer(new StOutIZ3D       (myResMgr, theParentWin));
-    addRenderer(new StOutInterlace  (myResMgr, theParentWin));
-    addRenderer(new StOutDistorted  (myResMgr, theParentWin));
-    addRenderer(new StOutPageFlipExt(myResMgr, theParentWin));
+    addRendererLazy<StOutAnaglyph>   ("StOutAnaglyph",  "Anaglyph Output");
+    addRendererLazy<StOutDual>       ("StOutDual",      "Dual Output");
+    addRendererLazy<StOutIZ3D>       ("StOutIZ3D",      "iZ3D Output");
+    addRendererLazy<StOutInterlace>  ("StOutInterlace", "Interlaced Output");
+    addRendererLazy<StOutDistorted>  ("StOutDistorted", "Distorted Output");
+    addRendererLazy<StOutPageFlipExt>("StOutPageFlip",  "Shutter glasses Output");
 #endif
 
     // no need in Depth buffer
@@ -415,10 +429,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
         StWinAttr_GlStencilSize, (StWinAttr )0,
         StWinAttr_NULL
     };
-    for(size_t aRendIter = 0; aRendIter < myRenderers.size(); ++aRendIter) {
-        StHandle<StWindow>& aRend = myRenderers[aRendIter];
-        aRend->setAttributes(anAttribs);
-    }
+    setRendererAttributes(anAttribs);
 
     // create actions
     StHandle<StAction> anAction;
@@ -553,6 +564,9 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
 
     anAction = new StActionIntSlot(stCString("DoOutStereoCrossEyed"), stSlot(this, &StMoviePlayer::doSetStereoOutput), StGLImageRegion::MODE_CROSSYED);
     addAction(Action_OutStereoCrossEyed, anAction);
+
+    anAction = new StActionIntSlot(stCString("DoCaptureFrames"), stSlot(this, &StMoviePlayer::doCaptureFrames), 0);
+    addAction(Action_CaptureFrames, anAction);
     }
 }
 
@@ -579,6 +593,8 @@ void StMoviePlayer::saveGuiParams() {
     mySettings->saveParam (myGUI->myImage->params.DisplayMode);
     mySettings->saveInt32 (ST_SETTING_GAMMA,       stRound(100.0f * myGUI->myImage->params.Gamma->getValue()));
     mySettings->saveParam (myGUI->myImage->params.ToHealAnamorphicRatio);
+    mySettings->saveParam (myGUI->myImage->params.ToRayCastPanorama);
+    mySettings->saveParam (myGUI->myImage->params.PanoProjection);
     mySettings->saveInt32(myGUI->myImage->params.DisplayRatio->getKey(),
                           params.ToRestoreRatio->getValue()
                         ? myGUI->myImage->params.DisplayRatio->getValue()
@@ -600,6 +616,7 @@ void StMoviePlayer::saveAllParams() {
         mySettings->saveParam (params.SubtitlesParser);
         mySettings->saveParam (params.SubtitlesApplyStereo);
         mySettings->saveParam (params.ToSearchSubs);
+        mySettings->saveParam (params.ToPlayGapless);
         mySettings->saveParam (params.TargetFps);
         mySettings->saveString(params.AudioAlDevice->getKey(), params.AudioAlDevice->getUtfTitle());
         mySettings->saveParam (params.AudioAlHrtf);
@@ -633,6 +650,7 @@ void StMoviePlayer::saveAllParams() {
         }
         mySettings->saveParam (params.ToPrintWebErrors);
         mySettings->saveParam (params.SnapshotImgType);
+        mySettings->saveParam (params.CaptureStep);
         mySettings->saveParam (params.BlockSleeping);
         mySettings->saveParam (params.ToHideStatusBar);
         mySettings->saveParam (params.ToHideNavBar);
@@ -660,6 +678,7 @@ void StMoviePlayer::releaseDevice() {
 }
 
 StMoviePlayer::~StMoviePlayer() {
+    myPlayList->signals.onTargetFound -= stSlot(this, &StMoviePlayer::doPlayListTarget);
     doStopWebUI();
 
     myUpdates.nullify();
@@ -693,12 +712,18 @@ bool StMoviePlayer::createGui(StHandle<StGLTextureQueue>& theTextureQueue,
     myGUI = new StMoviePlayerGUI(this, myWindow.access(), myLangMap.access(), myPlayList, theTextureQueue, theSubQueue);
     myGUI->setContext(myContext);
     theTextureQueue->setDeviceCaps(myContext->getDeviceCaps());
+    if(!myVideo.isNull()
+    && myGUI->mySeekBar != NULL) {
+        myGUI->mySeekBar->setPreviewProvider(myVideo->getThumbnails());
+    }
 
     // load settings
     mySettings->loadParam (myGUI->myImage->params.DisplayMode);
     mySettings->loadParam (myGUI->myImage->params.TextureFilter);
     mySettings->loadParam (myGUI->myImage->params.DisplayRatio);
     mySettings->loadParam (myGUI->myImage->params.ToHealAnamorphicRatio);
+    mySettings->loadParam (myGUI->myImage->params.ToRayCastPanorama);
+    mySettings->loadParam (myGUI->myImage->params.PanoProjection);
     params.ToRestoreRatio->setValue(myGUI->myImage->params.DisplayRatio->getValue() != StGLImageRegion::RATIO_AUTO);
     int32_t loadedGamma = 100; // 1.0f
         mySettings->loadInt32(ST_SETTING_GAMMA, loadedGamma);
@@ -880,17 +905,21 @@ bool StMoviePlayer::init() {
     // create the video playback thread
     if(!isReset) {
         myVideo = new StVideo(params.AudioAlDevice->getCTitle(), (StAudioQueue::StAlHrtfRequest )params.AudioAlHrtf->getValue(),
-                              myResMgr, myLangMap, myPlayList, aTextureQueue, aSubQueue);
+                              myResMgr, myLangMap, myPlayList, aTextureQueue, aSubQueue, myMsgQueue);
         myVideo->signals.onError  = stSlot(myMsgQueue.access(), &StMsgQueue::doPushError);
         myVideo->signals.onLoaded = stSlot(this,                &StMoviePlayer::doLoaded);
         myVideo->params.UseGpu       = params.UseGpu;
         myVideo->params.UseOpenJpeg  = params.UseOpenJpeg;
         myVideo->params.ToSearchSubs = params.ToSearchSubs;
+        myVideo->params.ToPlayGapless = params.ToPlayGapless;
         myVideo->params.ToTrackHeadAudio = params.ToTrackHeadAudio;
         myVideo->params.SlideShowDelay = params.SlideShowDelay;
         myVideo->setSwapJPS(params.ToSwapJPS->getValue());
         myVideo->setStickPano360(params.ToStickPanorama->getValue());
         myVideo->setForceBFormat(params.ToForceBFormat->getValue());
+        if(myGUI->mySeekBar != NULL) {
+            myGUI->mySeekBar->setPreviewProvider(myVideo->getThumbnails());
+        }
         doChangeMixImagesVideos(params.ToMixImagesVideos->getValue());
 
     #ifdef ST_HAVE_MONGOOSE
@@ -1320,6 +1349,13 @@ void StMoviePlayer::doFileNext() {
     myVideo->doLoadNext();
 }
 
+void StMoviePlayer::doPlayListTarget(const size_t ) {
+    // called from playlist parsing thread
+    if(!myVideo.isNull()) {
+        myVideo->doLoadNext();
+    }
+}
+
 void StMoviePlayer::doFileDrop(const StDNDropEvent& theEvent) {
     if(theEvent.NbFiles == 0) {
         return;
@@ -1638,6 +1674,20 @@ void StMoviePlayer::doUpdateOpenALDeviceList(const size_t ) {
     myToUpdateALList = true;
 }
 
+bool StMoviePlayer::isRedrawNeeded() const {
+    if(StApplication::isRedrawNeeded()
+    || myGUI.isNull()
+    || myVideo.isNull()) {
+        return true;
+    }
+
+    // redraw continuously during playback (video frames, seek bar, subtitles),
+    // otherwise only on new frame (e.g. after seeking) or changes within GUI
+    return myVideo->isPlaying()
+        || myGUI->isDamaged()
+        || myVideo->getTextureQueue()->hasPendingUpdate();
+}
+
 void StMoviePlayer::stglDraw(unsigned int theView) {
     const bool hasCtx = !myContext.isNull() && myContext->isBound();
     if(!hasCtx || myWindow->isPaused()) {
@@ -2076,6 +2126,32 @@ void StMoviePlayer::doSnapshot(const size_t theImgType) {
     myVideo->doSaveSnapshotAs(aType);
 }
 
+void StMoviePlayer::doCaptureFrames(const size_t ) {
+    if(myVideo->isCapturing()) {
+        size_t aNbCaptured = 0, aNbSkipped = 0;
+        myVideo->stopCapture(aNbCaptured, aNbSkipped);
+        myMsgQueue->pushInfo(new StString(tr(DIALOG_CAPTURE_STOPPED).format(StString((uint64_t )aNbCaptured), StString((uint64_t )aNbSkipped))));
+        return;
+    }
+
+    StHandle<StFileNode> aFile = myPlayList->getCurrentFile();
+    if(aFile.isNull()) {
+        myMsgQueue->pushInfo(tr(DIALOG_NOTHING_TO_SAVE));
+        return;
+    }
+
+    // captured frames are written next to the video file
+    StString aFolder, aFileName, aName, anExt;
+    StFileNode::getFolderAndFile(aFile->getPath(), aFolder, aFileName);
+    StFileNode::getNameAndExtension(aFileName, aName, anExt);
+    const StString aPrefix = (!aFolder.isEmpty() ? (aFolder + ST_FILE_SPLITTER) : StString()) + aName;
+    const StImageFile::ImageType anImgType = params.SnapshotImgType->getValue() == StImageFile::ST_TYPE_PNG
+                                           ? StImageFile::ST_TYPE_PNG
+                                           : StImageFile::ST_TYPE_JPEG;
+    myVideo->startCapture(aPrefix, anImgType, params.CaptureStep->getValue());
+    myMsgQueue->pushInfo(new StString(tr(DIALOG_CAPTURE_STARTED).format(StString(params.CaptureStep->getValue()), aFolder)));
+}
+
 void StMoviePlayer::doHideSystemBars(const bool ) {
     if(myWindow.isNull()) {
         return;
@@ -2173,6 +2249,22 @@ int StMoviePlayer::beginRequest(mg_connection*         theConnection,
         myVideo->pushPlayEvent(ST_PLAYEVENT_RESUME);
         myVideo->doLoadNext();
         aContent = "open item...";
+    } else if(anURI.isEquals(stCString("/sync"))) {
+        // return Audio to Video synchronization statistics
+        StVideoSyncStats::Summary aStats;
+        StAudioQueue::OutStats    anAudioStats;
+        myVideo->getSyncStats(aStats);
+        myVideo->getAudioStats(anAudioStats);
+        char aBuffer[1024];
+        stsprintf(aBuffer, sizeof(aBuffer),
+                  "clock=%s\nerror_p50_ms=%.2f\nerror_p95_ms=%.2f\nerror_p99_ms=%.2f\n"
+                  "frames_shown=%u\nframes_dropped=%u\nframes_repeated=%u\ndrift_ppm=%.1f\n"
+                  "audio_underruns=%u\naudio_ring_ms=%.0f\naudio_ring_size_ms=%.0f\naudio_ring_blocks=%d",
+                  aStats.HasAudioClock ? "audio" : "system",
+                  aStats.SyncErrorP50, aStats.SyncErrorP95, aStats.SyncErrorP99,
+                  aStats.NbShown, aStats.NbDropped, aStats.NbRepeated, aStats.ClockDriftPpm,
+                  anAudioStats.NbUnderruns, anAudioStats.RingFillMs, anAudioStats.RingSizeMs, anAudioStats.RingBlocks);
+        aContent = aBuffer;
     } else if(anURI.isEquals(stCString("/version"))) {
         aContent = StVersionInfo::getSDKVersionString();
     } else if(anURI.isEquals(stCString("/playlist"))) {
@@ -95,6 +95,11 @@ class StMoviePlayer : public StApplication {
      */
     ST_CPPEXPORT virtual void beforeDraw() ST_ATTR_OVERRIDE;
 
+    /**
+     * Check new frames and GUI changes in addition to default redraw conditions.
+     */
+    ST_CPPEXPORT virtual bool isRedrawNeeded() const ST_ATTR_OVERRIDE;
+
     /**
      * Draw frame for requested view.
      */
@@ -128,6 +133,7 @@ class StMoviePlayer : public StApplication {
     ST_LOCAL void doQuit(const size_t dummy = 0);
 
     ST_LOCAL void doFileNext();
+    ST_LOCAL void doPlayListTarget(const size_t );
     ST_LOCAL void doOpen1FileFromGui(StHandle<StString> thePath);
     ST_LOCAL void doOpen1AudioFromGui(StHandle<StString> thePath);
     ST_LOCAL void doOpen1SubtitleFromGui(StHandle<StString> thePath);
@@ -146,6 +152,7 @@ class StMoviePlayer : public StApplication {
     ST_LOCAL void doStop(const size_t dummy = 0);
 
     ST_LOCAL void doSnapshot(const size_t theImgType);
+    ST_LOCAL void doCaptureFrames(const size_t dummy = 0);
     ST_LOCAL void doAboutFile(const size_t dummy = 0);
 
         public: //! @name Properties
@@ -187,6 +194,7 @@ class StMoviePlayer : public StApplication {
         StHandle<StFloat32Param>      SubtitlesSize;     //!< subtitles font size
         StHandle<StFloat32Param>      SubtitlesParallax; //!< subtitles parallax
         StHandle<StBoolParamNamed>    ToSearchSubs;      //!< automatically search for additional subtitles/audio track files nearby video file
+        StHandle<StBoolParamNamed>    ToPlayGapless;     //!< switch to the next file without waiting for the audio tail to be played
         StHandle<StEnumParam>         SubtitlesParser;   //!< subtitles parser
         StHandle<StBoolParamNamed>    SubtitlesApplyStereo; //!<  apply stereoscopic format of video to image subtitles
         StHandle<StALDeviceParam>     AudioAlDevice;     //!< active OpenAL device
@@ -233,6 +241,7 @@ class StMoviePlayer : public StApplication {
         StHandle<StBoolParamNamed>    ToOpenLast;        //!< option to open last file from recent list by default
         StHandle<StBoolParamNamed>    ToShowExtra;       //!< show experimental menu items
         StHandle<StInt32ParamNamed>   SnapshotImgType;   //!< default snapshot image type
+        StHandle<StInt32ParamNamed>   CaptureStep;       //!< capture every Nth frame
         StString                      lastFolder;        //!< laster folder used to open / save file
         StHandle<StInt32ParamNamed>   TargetFps;         //!< rendering FPS limit (0 - max FPS with less CPU, 1,2,3 - adjust to video FPS)
         StHandle<StBoolParamNamed>    UseGpu;            //!< use video decoding on GPU when available
@@ -365,6 +374,7 @@ class StMoviePlayer : public StApplication {
         Action_OutStereoRightView,
         Action_OutStereoParallelPair,
         Action_OutStereoCrossEyed,
+        Action_CaptureFrames,
     };
 
         private: //! @name Web UI methods
@@ -631,6 +631,10 @@ void StMoviePlayerGUI::fillPanoramaMenu(StGLMenu* theMenu) {
                      myImage->params.ViewMode, StViewSurface_Sphere);
     theMenu->addItem(tr(MENU_VIEW_SURFACE_CUBEMAP),
                      myImage->params.ViewMode, StViewSurface_Cubemap);
+    theMenu->addItem(myImage->params.ToRayCastPanorama);
+    theMenu->addItem(myImage->params.PanoProjection, StGLImageProgram::PanoProjection_Perspective);
+    theMenu->addItem(myImage->params.PanoProjection, StGLImageProgram::PanoProjection_Stereographic);
+    theMenu->addItem(myImage->params.PanoProjection, StGLImageProgram::PanoProjection_Fisheye);
     if(myWindow->hasOrientationSensor()) {
         theMenu->addItem(tr(myWindow->isPoorOrientationSensor() ? MENU_VIEW_TRACK_HEAD_POOR : MENU_VIEW_TRACK_HEAD),
                          myPlugin->params.ToTrackHead);
@@ -1645,6 +1649,7 @@ StMoviePlayerGUI::StMoviePlayerGUI(StMoviePlayer*  thePlugin,
     const GLfloat aScale = myPlugin->params.ScaleHiDPI2X->getValue() ? 2.0f : myPlugin->params.ScaleHiDPI ->getValue();
     setScale(aScale, (StGLRootWidget::ScaleAdjust )myPlugin->params.ScaleAdjust->getValue());
     setMobile(myPlugin->params.IsMobileUISwitch->getValue());
+    setCachedGui(true); // static widgets above the image are rendered once for both views
 
     myIconStep = isMobile() ? scale(56) : scale(64);
 
@@ -2248,6 +2253,13 @@ void StMoviePlayerGUI::stglDraw(unsigned int theView) {
         myImage->getTextureQueue()->getQueueInfo(myFpsWidget->changePlayQueued(),
                                                  myFpsWidget->changePlayQueueLength(),
                                                  myFpsWidget->changePlayFps());
+        const StApplication::RedrawStats& aRedrawStats = myPlugin->getRedrawStats();
+        myFpsWidget->setRedrawStats(aRedrawStats.NbDrawn, aRedrawStats.NbSkipped,
+                                    aRedrawStats.PeriodMs > 0.0 ? aRedrawStats.DrawTimeMs / aRedrawStats.PeriodMs : -1.0);
+        StVideoSyncStats::Summary aSyncStats;
+        myPlugin->myVideo->getSyncStats(aSyncStats);
+        myFpsWidget->setPlaySyncStats(aSyncStats.SyncErrorP50, aSyncStats.SyncErrorP95, aSyncStats.SyncErrorP99,
+                                      aSyncStats.NbDropped, aSyncStats.NbRepeated, aSyncStats.ClockDriftPpm);
         myFpsWidget->update(myPlugin->getMainWindow()->isStereoOutput(),
                             myPlugin->getMainWindow()->getTargetFps(),
                             myPlugin->getMainWindow()->getStatistics());
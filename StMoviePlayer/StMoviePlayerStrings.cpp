@@ -365,6 +365,14 @@ void loadDefaults(StLangMap& theStrings) {
                "Assign new Hot Key for action\n<i>{0}</i>");
     theStrings(DIALOG_CONFLICTS_WITH,
                "Conflicts with: <i>{0}</i>");
+    theStrings(DIALOG_SNAPSHOT_SAVED,
+               "Snapshot has been saved to\n{0}");
+    theStrings(DIALOG_SNAPSHOT_BUSY,
+               "Previous snapshots are still being saved!");
+    theStrings(DIALOG_CAPTURE_STARTED,
+               "Capturing every {0} frame into\n{1}");
+    theStrings(DIALOG_CAPTURE_STOPPED,
+               "Captured {0} frames, {1} frames skipped");
 
     theStrings(INFO_LEFT,
                "[left]");
@@ -657,6 +665,9 @@ void loadDefaults(StLangMap& theStrings) {
     addAction(theStrings, StMoviePlayer::Action_PanoramaOnOff,
               "DoPanoramaOnOff",
               "Enable/disable panorama mode");
+    addAction(theStrings, StMoviePlayer::Action_CaptureFrames,
+              "DoCaptureFrames",
+              "Start/stop capturing every Nth frame");
 
     theStrings.addAlias("DoOutStereoNormal",       MENU_VIEW_DISPLAY_MODE_STEREO);
     theStrings.addAlias("DoOutStereoLeftView",     MENU_VIEW_DISPLAY_MODE_LEFT);
@@ -218,6 +218,10 @@ namespace StMoviePlayerStrings {
 
         DIALOG_ASSIGN_HOT_KEY  = 2013,
         DIALOG_CONFLICTS_WITH  = 2014,
+        DIALOG_SNAPSHOT_SAVED  = 2015,
+        DIALOG_SNAPSHOT_BUSY   = 2016,
+        DIALOG_CAPTURE_STARTED = 2017,
+        DIALOG_CAPTURE_STOPPED = 2018,
 
         // About dialog
         ABOUT_DPLUGIN_NAME     = 3000,
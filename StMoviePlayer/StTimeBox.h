@@ -21,7 +21,7 @@
 
 #include <StGLWidgets/StGLTextureButton.h>
 #include <StGLWidgets/StGLTextArea.h>
-#include <StStrings/StFormatTime.h>
+#include <StStrings/StStringBuilder.h>
 
 class ST_LOCAL StTimeBox : public StGLTextureButton {
 
@@ -102,9 +102,9 @@ class ST_LOCAL StTimeBox : public StGLTextureButton {
         && (theDurationSec > 0.1 || myDurationSec < 0.0)) {
             int aWidth  = 0;
             int aHeight = 0;
-            myTextArea->computeTextWidth(StFormatTime::formatSeconds(theDurationSec) + " / "
-                                       + StFormatTime::formatSeconds(theDurationSec),
-                                        -1.0f, aWidth, aHeight);
+            StStringBuilder aText;
+            aText.appendTime(theDurationSec).append(" / ", 3).appendTime(theDurationSec);
+            myTextArea->computeTextWidth(aText.toString(), -1.0f, aWidth, aHeight);
             const int aWidthNew = aWidth + myMargins.left + myMargins.right;
             const int aWidthOld = getRectPx().width();
             const int aToler    = myRoot->scale(4);
@@ -117,11 +117,16 @@ class ST_LOCAL StTimeBox : public StGLTextureButton {
 
         myProgressSec = theProgressSec;
         myDurationSec = theDurationSec;
+
+        // called per frame - new string is created only when displayed time is changed
+        StStringBuilder aText;
         if(myToShowElapsed) {
-            myTextArea->setText(StFormatTime::formatSeconds(myProgressSec) + " / "
-                              + StFormatTime::formatSeconds(myDurationSec));
+            aText.appendTime(myProgressSec).append(" / ", 3).appendTime(myDurationSec);
         } else {
-            myTextArea->setText(StFormatTime::formatSeconds(myProgressSec - myDurationSec));
+            aText.appendTime(myProgressSec - myDurationSec);
+        }
+        if(!aText.isEquals(myTextArea->getText())) {
+            myTextArea->setText(aText.toString());
         }
     }
 
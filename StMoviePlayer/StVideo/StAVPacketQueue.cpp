@@ -18,6 +18,8 @@
 
 #include "StAVPacketQueue.h"
 
+#include <StStrings/StStringBuilder.h>
+
 namespace {
 
     const StAVPacket ST_START_PACKET(NULL, StAVPacket::START_PACKET);
@@ -197,9 +199,17 @@ void StAVPacketQueue::fillCodecInfo(const AVCodec*  theCodec,
         myCodecDesc.clear();
         myCodecStr.clear();
     } else {
+        StStringBuilder aDesc;
+        if(theCodec->long_name != NULL) {
+            aDesc << theCodec->long_name;
+        }
+        aDesc << theDescExtra;
         myCodecName = theCodec->name;
-        myCodecDesc = theCodec->long_name + theDescExtra;
-        myCodecStr  = StString("[") + myCodecName + stCString("] ") + myCodecDesc;
+        myCodecDesc = aDesc.toString();
+
+        StStringBuilder aStr;
+        aStr << "[" << myCodecName << "] " << myCodecDesc;
+        myCodecStr = aStr.toString();
     }
 }
 
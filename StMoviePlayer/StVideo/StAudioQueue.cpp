@@ -271,6 +271,7 @@ void StAudioQueue::stalOrientListener() {
 
 void StAudioQueue::stalEmpty() {
     alSourceStopv(THE_NUM_AL_SOURCES, myAlSources);
+    myIsAlStarted = false;
 
     ALint aBufQueued = 0;
     ALuint alBuffIdToUnqueue = 0;
@@ -310,14 +311,36 @@ static SV_THREAD_FUNCTION threadFunction(void* audioQueue) {
     return SV_THREAD_RETURN 0;
 }
 
+/**
+ * Simple thread function which just call outputLoop().
+ */
+static SV_THREAD_FUNCTION outThreadFunction(void* audioQueue) {
+    StAudioQueue* stAudioQueue = (StAudioQueue* )audioQueue;
+    stAudioQueue->outputLoop();
+    return SV_THREAD_RETURN 0;
+}
+
 StAudioQueue::StAudioQueue(const std::string& theAlDeviceName,
                            StAudioQueue::StAlHrtfRequest theAlHrtf)
 : StAVPacketQueue(512),
+  myRing(1.0),
+  myRingDataEv(false),
+  myRingFreeEv(false),
+  myFlushGen(0),
+  myPendingSec(0.0),
+  myPendingGen(0),
+  myAlSecondSize(0),
+  myToQuitOut(false),
+  myIsDecodeEnded(false),
+  myIsEndOfStream(false),
+  myIsAlStarted(false),
   myPlaybackTimer(false),
   myDowntimeEvent(true),
   myAvSrcFormat(-1),
   myAvSampleRate(-1),
   myAvNbChannels(-1),
+  mySeekTargetNext(-1.0),
+  mySeekTarget(-1.0),
   myBufferSrc(StPcmFormat_Int16),
   myBufferOut(StPcmFormat_Int16),
   myIsAlValid(ST_AL_INIT_NA),
@@ -341,6 +364,9 @@ StAudioQueue::StAudioQueue(const std::string& theAlDeviceName,
   myDbgPrevSrcState(-1) {
     stMemSet(myAlSources, 0, sizeof(myAlSources));
 
+    // launch thread initializing OpenAL and playing decoded blocks
+    myOutThread = new StThread(outThreadFunction, (void* )this, "StAudioOut");
+
     // launch thread parse incoming packets from queue
     myThread = new StThread(threadFunction, (void* )this, "StAudioQueue");
 }
@@ -352,6 +378,11 @@ StAudioQueue::~StAudioQueue() {
     myThread->wait();
     myThread.nullify();
 
+    myToQuitOut = true;
+    myRingDataEv.set();
+    myOutThread->wait();
+    myOutThread.nullify();
+
     deinit();
 }
 
@@ -825,10 +856,23 @@ void StAudioQueue::deinit() {
     StAVPacketQueue::deinit();
 }
 
+void StAudioQueue::checkOutLayout() {
+    if(!isInitialized()) {
+        return;
+    }
+
+    const bool toResetBuffers = (myAlIsBFormat != myToForceBFormat && myAlCanBFormat)
+                             || (myToOrientListener && !myAlSoftLayout);
+    if(toResetBuffers) {
+        myBufferSrc.clear();
+        myBufferOut.clear();
+        initBuffers();
+    }
+}
+
 bool StAudioQueue::parseEvents() {
     double aPtsSeek = 0.0;
 
-    bool toResetBuffers = false;
     if(myToSwitchDev) {
         stalReinitialize();
         return true;
@@ -837,28 +881,17 @@ bool StAudioQueue::parseEvents() {
         StMutexAuto aLock(myAlInfoMutex);
         myAlInfo.clear();
         myAlCtx.fullInfo(myAlInfo);
-    } else if(myAlIsBFormat != myToForceBFormat
-           && myAlCanBFormat) {
-        toResetBuffers = true;
     }
 
     if(myToOrientListener) {
-        if(!myAlSoftLayout) {
-            toResetBuffers = true;
-        } else {
+        // buffers with hardware layout are re-initialized by decoding thread (checkOutLayout())
+        if(myAlSoftLayout) {
             stalOrientListener();
         }
     } else if(myAlIsListOrient) {
         stalOrientListener();
     }
 
-    if(toResetBuffers) {
-        myBufferSrc.clear();
-        myBufferOut.clear();
-        initBuffers();
-        return true;
-    }
-
     if(!stAreEqual(myAlGain, myAlGainPrev, 1.e-7f)) {
         ST_DEBUG_LOG("Audio volume changed from " + myAlGainPrev + " to " + myAlGain);
         myAlGainPrev = myAlGain;
@@ -891,8 +924,8 @@ bool StAudioQueue::parseEvents() {
             stalEmpty();
             playTimerStart(aPtsSeek);
             playTimerPause();
-            myBufferSrc.setDataSize(0);
-            myBufferOut.setDataSize(0);
+            myRing.clear();
+            myRingFreeEv.set();
             // return special flag to skip "resume playback from" in loop
             return true;
         }
@@ -902,7 +935,8 @@ bool StAudioQueue::parseEvents() {
     }
 }
 
-bool StAudioQueue::stalQueue(const double thePts) {
+bool StAudioQueue::stalQueue(const StPCMBlock& theBlock) {
+    const StPCMBuffer& aBuffer = theBlock.Buffer;
     ALint aQueued = 0;
     ALint aProcessed = 0;
     ALenum aState = stalGetSourceState();
@@ -922,18 +956,18 @@ bool StAudioQueue::stalQueue(const double thePts) {
 
     if((aState == AL_PLAYING
      || aState == AL_PAUSED)
-    && (myPrevFormat    != myAlFormat
-     || myPrevFrequency != myBufferOut.getFreq()))
+    && (myPrevFormat    != theBlock.AlFormat
+     || myPrevFrequency != aBuffer.getFreq()))
     {
         return false; // wait until tail of previous stream played
     }
 
-    if(myPrevFormat    != myAlFormat
-    || myPrevFrequency != myBufferOut.getFreq()
+    if(myPrevFormat    != theBlock.AlFormat
+    || myPrevFrequency != aBuffer.getFreq()
     || (aState  == AL_STOPPED
      && aQueued == THE_NUM_AL_BUFFERS)) {
-        ST_DEBUG_LOG("AL, reinitialize buffers per source , plane size= " + myBufferOut.getPlaneSize()
-                            + "; freq= " + myBufferOut.getFreq());
+        ST_DEBUG_LOG("AL, reinitialize buffers per source , plane size= " + aBuffer.getPlaneSize()
+                            + "; freq= " + aBuffer.getFreq());
         stalEmpty();
         stalCheckErrors("reset state");
         aProcessed = 0;
@@ -943,19 +977,19 @@ bool StAudioQueue::stalQueue(const double thePts) {
     bool toTryToPlay = false;
     bool isQueued = false;
     if(aProcessed == 0 && aQueued < THE_NUM_AL_BUFFERS) {
-        if(myBufferOut.isEmpty()) {
+        if(aBuffer.isEmpty()) {
             ST_DEBUG_LOG(" EMPTY BUFFER ");
             return true;
         }
 
         stalCheckErrors("reset state");
         ///ST_DEBUG_LOG("AL, queue more buffers " + aQueued + " / " + NUM_AL_BUFFERS);
-        myPrevFormat    = myAlFormat;
-        myPrevFrequency = myBufferOut.getFreq();
-        for(size_t aSrcId = 0; aSrcId < myBufferOut.getPlanesNb(); ++aSrcId) {
-            alBufferData(myAlBuffers[aSrcId][aQueued], myAlFormat,
-                         myBufferOut.getPlane(aSrcId), (ALsizei )myBufferOut.getPlaneSize(),
-                         myBufferOut.getFreq());
+        myPrevFormat    = theBlock.AlFormat;
+        myPrevFrequency = aBuffer.getFreq();
+        for(size_t aSrcId = 0; aSrcId < aBuffer.getPlanesNb(); ++aSrcId) {
+            alBufferData(myAlBuffers[aSrcId][aQueued], theBlock.AlFormat,
+                         aBuffer.getPlane(aSrcId), (ALsizei )aBuffer.getPlaneSize(),
+                         aBuffer.getFreq());
             stalCheckErrors("alBufferData1");
             alSourceQueueBuffers(myAlSources[aSrcId], 1, &myAlBuffers[aSrcId][aQueued]);
             stalCheckErrors("alSourceQueueBuffers");
@@ -966,15 +1000,15 @@ bool StAudioQueue::stalQueue(const double thePts) {
            && (aState == AL_PLAYING
             || aState == AL_PAUSED)) {
         ALuint alBuffIdToFill = 0;
-        ///ST_DEBUG_LOG("queue buffer " + thePts + "; state= " + stalGetSourceState());
-        if(myBufferOut.isEmpty()) {
+        ///ST_DEBUG_LOG("queue buffer " + theBlock.Pts + "; state= " + stalGetSourceState());
+        if(aBuffer.isEmpty()) {
             ST_DEBUG_LOG(" EMPTY BUFFER ");
             return true;
         }
 
-        myPrevFormat    = myAlFormat;
-        myPrevFrequency = myBufferOut.getFreq();
-        for(size_t aSrcId = 0; aSrcId < myBufferOut.getPlanesNb(); ++aSrcId) {
+        myPrevFormat    = theBlock.AlFormat;
+        myPrevFrequency = aBuffer.getFreq();
+        for(size_t aSrcId = 0; aSrcId < aBuffer.getPlanesNb(); ++aSrcId) {
 
             // wait other sources for processed buffers
             if(aSrcId != 0) {
@@ -995,9 +1029,9 @@ bool StAudioQueue::stalQueue(const double thePts) {
             alSourceUnqueueBuffers(myAlSources[aSrcId], 1, &alBuffIdToFill);
             stalCheckErrors("alSourceUnqueueBuffers");
             if(alBuffIdToFill != 0) {
-                alBufferData(alBuffIdToFill, myAlFormat,
-                             myBufferOut.getPlane(aSrcId), (ALsizei )myBufferOut.getPlaneSize(),
-                             myBufferOut.getFreq());
+                alBufferData(alBuffIdToFill, theBlock.AlFormat,
+                             aBuffer.getPlane(aSrcId), (ALsizei )aBuffer.getPlaneSize(),
+                             aBuffer.getFreq());
                 stalCheckErrors("alBufferData2");
                 alSourceQueueBuffers(myAlSources[aSrcId], 1, &alBuffIdToFill);
                 stalCheckErrors("alSourceQueueBuffers");
@@ -1011,15 +1045,15 @@ bool StAudioQueue::stalQueue(const double thePts) {
 
     if(aState == AL_STOPPED
     && toTryToPlay) {
-        double diffSecs = double(myAlDataLoop.summ() + myBufferOut.getDataSizeWhole()) / double(myBufferOut.getSecondSize());
-        if((thePts - diffSecs) < 100000.0) {
-            playTimerStart(thePts - diffSecs);
+        double diffSecs = double(myAlDataLoop.summ() + aBuffer.getDataSizeWhole()) / double(aBuffer.getSecondSize());
+        if((theBlock.Pts - diffSecs) < 100000.0) {
+            playTimerStart(theBlock.Pts - diffSecs);
         } else {
             playTimerStart(0.0);
         }
         alSourcePlayv(THE_NUM_AL_SOURCES, myAlSources);
         if(stalCheckConnected()) {
-            ST_DEBUG_LOG("!!! OpenAL was in stopped state, now resume playback from " + (thePts - diffSecs));
+            ST_DEBUG_LOG("!!! OpenAL was in stopped state, now resume playback from " + (theBlock.Pts - diffSecs));
         }
 
         // pause playback if not in playing state
@@ -1047,60 +1081,218 @@ bool StAudioQueue::stalCheckConnected() {
     return false;
 }
 
-void StAudioQueue::stalFillBuffers(const double thePts,
-                                   const bool   toIgnoreEvents) {
-    if(!toIgnoreEvents) {
-        parseEvents();
+void StAudioQueue::stalSyncPlayback(const StPCMBlock& theBlock,
+                                    const bool        theToSkipPlaybackFrom) {
+    const double aSecondSize = double(theBlock.Buffer.getSecondSize());
+    if(!theToSkipPlaybackFrom && !stalIsAudioPlaying() && isPlaying()) {
+        // this position means:
+        // 1) buffers were empty and playback was stopped
+        //    now we have all buffers full and could play them
+        double diffSecs = double(myAlDataLoop.summ() + theBlock.Buffer.getDataSizeWhole()) / aSecondSize;
+        if((theBlock.Pts - diffSecs) < 100000.0) {
+            playTimerStart(theBlock.Pts - diffSecs);
+        } else {
+            playTimerStart(0.0);
+        }
+        alSourcePlayv(THE_NUM_AL_SOURCES, myAlSources);
+        if(stalCheckConnected()) {
+            ST_DEBUG_LOG("!!! OpenAL was in stopped state, now resume playback from " + (theBlock.Pts - diffSecs));
+        }
+    } else {
+        // TODO (Kirill Gavrilov#3#) often updates may prevent normal video playback
+        // on files with broken audio/video PTS
+        ALfloat aPos = 0.0f;
+        alGetSourcef(myAlSources[0], AL_SEC_OFFSET, &aPos);
+        double diffSecs = double(myAlDataLoop.summ() + theBlock.Buffer.getDataSizeWhole()) / aSecondSize;
+        diffSecs -= aPos;
+        if((theBlock.Pts - diffSecs) < 100000.0) {
+             static double oldPts = 0.0;
+             if(theBlock.Pts != oldPts) {
+                /**ST_DEBUG_LOG("set AAApts " + (theBlock.Pts - diffSecs)
+                    + " from " + getPts()
+                    + "(" + theBlock.Pts + ", " + diffSecs + ")"
+                );*/
+                playTimerStart(theBlock.Pts - diffSecs);
+                oldPts = theBlock.Pts;
+            }
+            ///playTimerStart(theBlock.Pts - diffSecs);
+        }
     }
+}
+
+void StAudioQueue::stalCheckUnderrun() {
+    const ALenum aState = stalGetSourceState();
+    if(aState == AL_PLAYING) {
+        myIsAlStarted = true;
+        return;
+    } else if(aState != AL_STOPPED
+          || !myIsAlStarted) {
+        return;
+    }
+
+    // source has been stopped by OpenAL itself - all queued buffers have been played
+    myIsAlStarted = false;
+    if(!myIsEndOfStream && isPlaying()) {
+        ST_DEBUG_LOG("OpenAL, buffers underrun; ring contains " + (myRing.getFilledDuration() * 1000.0) + " ms");
+        StMutexAuto aLock(myStatsMutex);
+        ++myOutStats.NbUnderruns;
+    }
+}
+
+int StAudioQueue::stalGetProcessedWaitMs(const StPCMBlock& theBlock) {
+    const size_t aSecondSize = theBlock.Buffer.getSecondSize();
+    if(aSecondSize == 0
+    || stalGetSourceState() != AL_PLAYING) {
+        return 10;
+    }
+
+    // the first queued buffer is processed when playback offset reaches its end
+    ALfloat aPos = 0.0f;
+    alGetSourcef(myAlSources[0], AL_SEC_OFFSET, &aPos);
+    const double aWaitMs = (double(myAlDataLoop.oldest()) / double(aSecondSize) - double(aPos)) * 1000.0;
+    return stMax(1, stMin(int(aWaitMs), 20));
+}
+
+void StAudioQueue::updateOutStats(const int32_t theGeneration) {
+    const double aFillSec = myRing.getFilledDuration();
+    double aQueuedSec = 0.0;
+    if(myAlSecondSize != 0
+    && stalGetSourceState() == AL_PLAYING) {
+        ALfloat aPos = 0.0f;
+        alGetSourcef(myAlSources[0], AL_SEC_OFFSET, &aPos);
+        aQueuedSec = stMax(double(myAlDataLoop.summ()) / double(myAlSecondSize) - double(aPos), 0.0);
+    }
+
+    StMutexAuto aLock(myStatsMutex);
+    myPendingSec = aFillSec + aQueuedSec;
+    myPendingGen = theGeneration;
+    myOutStats.RingFillMs = aFillSec * 1000.0;
+    myOutStats.RingSizeMs = myRing.getDurationLimit() * 1000.0;
+    myOutStats.RingBlocks = myRing.getNbBlocks();
+}
 
-    bool toSkipPlaybackFrom = false;
-    while(!stalQueue(thePts)) {
-        // AL queue is full
-        if(!toIgnoreEvents) {
-            toSkipPlaybackFrom = parseEvents();
+double StAudioQueue::getPendingDuration() const {
+    StMutexAuto aLock(myStatsMutex);
+    return myPendingGen == myFlushGen.getValue() ? myPendingSec : 0.0;
+}
+
+void StAudioQueue::outputLoop() {
+    myIsAlValid = (stalInit() ? ST_AL_INIT_OK : ST_AL_INIT_KO);
+
+    int32_t aGeneration = myFlushGen.getValue();
+    while(!myToQuitOut) {
+        const bool toSkipPlaybackFrom = parseEvents();
+
+        // decoding thread has been flushed - drop queued data
+        const int32_t aFlushGen = myFlushGen.getValue();
+        if(aFlushGen != aGeneration) {
+            aGeneration = aFlushGen;
+            stalEmpty();
+            myAlDataLoop.clear();
         }
-        if(myToQuit) {
-            return;
+        updateOutStats(aGeneration);
+
+        const StPCMBlock* aBlock = myRing.front();
+        if(aBlock == NULL) {
+            stalCheckUnderrun();
+            // the ring has been drained after decoding thread reached end of stream,
+            // so that stopping of OpenAL source after playing the tail is not an underrun
+            myIsEndOfStream = myIsDecodeEnded;
+            myRingDataEv.reset();
+            if(myRing.front() == NULL) {
+                myRingDataEv.wait(5);
+            }
+            continue;
+        } else if(aBlock->Generation != aGeneration) {
+            // block has been decoded before flush
+            myRing.pop();
+            myRingFreeEv.set();
+            continue;
         }
 
-        if(!toSkipPlaybackFrom && !stalIsAudioPlaying() && isPlaying()) {
-            // this position means:
-            // 1) buffers were empty and playback was stopped
-            //    now we have all buffers full and could play them
-            double diffSecs = double(myAlDataLoop.summ() + myBufferOut.getDataSizeWhole()) / double(myBufferOut.getSecondSize());
-            if((thePts - diffSecs) < 100000.0) {
-                playTimerStart(thePts - diffSecs);
-            } else {
-                playTimerStart(0.0);
-            }
-            alSourcePlayv(THE_NUM_AL_SOURCES, myAlSources);
-            if(stalCheckConnected()) {
-                ST_DEBUG_LOG("!!! OpenAL was in stopped state, now resume playback from " + (thePts - diffSecs));
-            }
-        } else {
-            // TODO (Kirill Gavrilov#3#) often updates may prevent normal video playback
-            // on files with broken audio/video PTS
-            ALfloat aPos = 0.0f;
-            alGetSourcef(myAlSources[0], AL_SEC_OFFSET, &aPos);
-            double diffSecs = double(myAlDataLoop.summ() + myBufferOut.getDataSizeWhole()) / double(myBufferOut.getSecondSize());
-            diffSecs -= aPos;
-            if((thePts - diffSecs) < 100000.0) {
-                 static double oldPts = 0.0;
-                 if(thePts != oldPts) {
-                    /**ST_DEBUG_LOG("set AAApts " + (thePts - diffSecs)
-                        + " from " + getPts()
-                        + "(" + thePts + ", " + diffSecs + ")"
-                    );*/
-                    playTimerStart(thePts - diffSecs);
-                    oldPts = thePts;
-                }
-                ///playTimerStart(thePts - diffSecs);
-            }
+        // source might be stopped while the ring still has data (e.g. playback thread was stalled)
+        myIsEndOfStream = false;
+        stalCheckUnderrun();
+        if(stalQueue(*aBlock)) {
+            // save the history for filled AL buffers sizes
+            myAlDataLoop.push(aBlock->Buffer.getDataSizeWhole());
+            myAlSecondSize = aBlock->Buffer.getSecondSize();
+            myRing.pop();
+            myRingFreeEv.set();
+            continue;
+        }
+
+        // AL queue is full - wait until the playing buffer is processed;
+        // block in another format waits for the tail of previous stream,
+        // which can not be measured in units of the new block
+        if(myPrevFormat    == aBlock->AlFormat
+        && myPrevFrequency == aBlock->Buffer.getFreq()) {
+            stalSyncPlayback(*aBlock, toSkipPlaybackFrom);
+        }
+        stalCheckUnderrun();
+        StThread::sleep(stalGetProcessedWaitMs(*aBlock));
+    }
+
+    stalDeinit(); // release OpenAL context
+}
+
+bool StAudioQueue::pushBlock(const double thePts) {
+    const int32_t aGeneration = myFlushGen.getValue();
+    for(;;) {
+        myRingFreeEv.reset();
+        if(myRing.push(myBufferOut, thePts, myAlFormat, aGeneration)) {
+            myRingDataEv.set();
+            return true;
+        } else if(myToQuit) {
+            return false;
         }
-        StThread::sleep(1);
+        myRingFreeEv.wait(10);
     }
 }
 
+bool StAudioQueue::trimToSeekTarget(const StHandle<StAVPacket>& thePacket) {
+#if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(53, 40, 0))
+    int64_t aPtsU = myFrame.Frame->pts;
+    if(aPtsU == stAV::NOPTS_VALUE) {
+        aPtsU = thePacket->getPts();
+    }
+    const int aNbSamples = myFrame.Frame->nb_samples;
+    if(aPtsU == stAV::NOPTS_VALUE
+    || aNbSamples <= 0
+    || myAvSampleRate <= 0) {
+        mySeekTarget = -1.0;
+        return true;
+    }
+
+    const double aPts    = unitsToSeconds(aPtsU) - myPtsStartBase;
+    const double aNbSkip = (mySeekTarget - aPts) * double(myAvSampleRate);
+    if(aNbSkip >= double(aNbSamples)) {
+        return false;
+    }
+
+    ST_DEBUG_LOG("Audio seek target " + mySeekTarget + " reached at " + aPts);
+    mySeekTarget = -1.0;
+    if(aNbSkip < 1.0) {
+        return true;
+    }
+
+    // drop leading samples of the frame
+    const AVSampleFormat aFormat = myCodecCtx->sample_fmt;
+    const size_t aSampleSize = size_t(av_get_bytes_per_sample(aFormat))
+                             * (av_sample_fmt_is_planar(aFormat) ? 1 : size_t(myAvNbChannels));
+    const size_t anOffset = size_t(aNbSkip) * aSampleSize;
+    for(size_t aPlaneIter = 0; aPlaneIter < myBufferSrc.getPlanesNb(); ++aPlaneIter) {
+        myBufferSrc.wrapPlane(aPlaneIter, myFrame.getPlane(aPlaneIter) + anOffset);
+    }
+    myBufferSrc.setPlaneSize(myBufferSrc.getPlaneSize() - anOffset);
+    myFrame.Frame->pts = stAV::secondsToUnits(myStream, myPtsStartBase + aPts + double(int(aNbSkip)) / double(myAvSampleRate));
+#else
+    (void )thePacket;
+    mySeekTarget = -1.0;
+#endif
+    return true;
+}
+
 void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
                                 double&                     thePts) {
     const uint8_t* anAudioPktData = thePacket->getData();
@@ -1189,6 +1381,10 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
                                                    myFrame.Frame->nb_samples,
                                                    myCodecCtx->sample_fmt, 1);
             myBufferSrc.setPlaneSize(aPlaneSize); // notice that myFrame.getLineSize(0) contains extra alignment
+            if(mySeekTarget >= 0.0
+            && !trimToSeekTarget(thePacket)) {
+                continue; // whole frame is before the seek target
+            }
         #else
             (void )isGotFrame;
             if(aDataSize <= 0) {
@@ -1223,14 +1419,10 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
                     thePts = aNewPts;
                 }
 
-                // now fill OpenAL buffers
-                stalFillBuffers(thePts, false);
-                if(myToQuit) {
+                // pass the block to playback thread
+                if(!pushBlock(thePts)) {
                     return;
                 }
-
-                // save the history for filled AL buffers sizes
-                myAlDataLoop.push(myBufferOut.getDataSizeWhole());
             }
 
             myBufferOut.setDataSize(0);                         // clear 'big' buffer
@@ -1249,15 +1441,13 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
 }
 
 void StAudioQueue::decodeLoop() {
-    myIsAlValid = (stalInit() ? ST_AL_INIT_OK : ST_AL_INIT_KO);
-
     double aPts = 0.0;
     StHandle<StAVPacket> aPacket;
     for(;;) {
         // wait for upcoming packets
         if(isEmpty()) {
             myDowntimeEvent.set();
-            parseEvents();
+            checkOutLayout();
             StThread::sleep(10);
             ///ST_DEBUG_LOG_AT("AQ is empty");
             continue;
@@ -1275,20 +1465,30 @@ void StAudioQueue::decodeLoop() {
                     avcodec_flush_buffers(myCodecCtx);
                 }
                 // at this moment we clear current data from our buffers too
+                // (OpenAL queue and decoded blocks are dropped by playback thread)
                 myBufferOut.setDataSize(0);
                 myBufferSrc.setDataSize(0);
-                stalEmpty();
+                myFlushGen.increment();
+                myRingDataEv.set();
+                mySeekTarget = mySeekTargetNext;
+                mySeekTargetNext = -1.0;
                 continue;
             }
             case StAVPacket::START_PACKET: {
-                playTimerStart(myPtsStartStream - myPtsStartBase);
+                // previous stream might be still played (gapless switching to the next file),
+                // so that the new stream starts after its tail
+                playTimerStart(myPtsStartStream - myPtsStartBase - getPendingDuration());
                 aPts = 0.0;
+                mySeekTarget = -1.0;
                 continue;
             }
             case StAVPacket::DATA_PACKET: {
+                myIsDecodeEnded = false;
                 break;
             }
             case StAVPacket::LAST_PACKET: {
+                // the target is behind the last frame - play the tail instead
+                mySeekTarget = -1.0;
             #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
                 break; // redirect NULL packet to avcodec_send_packet()
             #else
@@ -1299,23 +1499,24 @@ void StAudioQueue::decodeLoop() {
                 pushPlayEvent(ST_PLAYEVENT_NONE);
                 // TODO (Kirill Gavrilov#3#) improve file-by-file playback
                 if(!myBufferOut.isEmpty()) {
-                    stalFillBuffers(aPts, true);
+                    pushBlock(aPts);
                 }
                 myBufferOut.setDataSize(0);
                 myBufferSrc.setDataSize(0);
+                myIsDecodeEnded = true;
+                myRingDataEv.set(); // wake up playback thread to detect drained ring
                 if(myToQuit) {
-                    stalDeinit(); // release OpenAL context
-                    return;
+                    return; // OpenAL context is released by playback thread
                 }
                 continue;
             }
             case StAVPacket::QUIT_PACKET: {
-                stalDeinit(); // release OpenAL context
                 return;
             }
         }
 
         // we got the data packet, so decode it
+        checkOutLayout();
         decodePacket(aPacket, aPts);
         aPacket.nullify();
     }
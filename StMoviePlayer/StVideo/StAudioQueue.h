@@ -28,6 +28,7 @@
 
 #include "StAVPacketQueue.h"// StAVPacketQueue class
 #include "StPCMBuffer.h"    // audio PCM buffer class
+#include "StPCMRing.h"      // decoded audio blocks ring
 #include "StALContext.h"
 
 // forward declarations
@@ -41,6 +42,12 @@ ST_DEFINE_HANDLE(StAudioQueue, StAVPacketQueue);
  * This is Audio playback class (OpenAL is used)
  * which feeded with packets (StAVPacket),
  * so it also implements StAVPacketQueue.
+ *
+ * Decoding and playback are performed by two threads:
+ * decoding thread fills the ring of PCM blocks (StPCMRing) ahead of playback,
+ * while output thread owns OpenAL context and submits blocks as soon as OpenAL buffers are processed.
+ * Thus stalls in decoding (high-bitrate streams, CPU busy with video decoding)
+ * are absorbed by the ring instead of causing OpenAL buffers underrun.
  */
 class StAudioQueue : public StAVPacketQueue {
 
@@ -52,6 +59,18 @@ class StAudioQueue : public StAVPacketQueue {
         StAlHrtfRequest_ForceOff = 2,
     };
 
+    /**
+     * Playback statistics.
+     */
+    struct OutStats {
+        unsigned int NbUnderruns; //!< number of OpenAL queue underruns (playback stopped due to lack of data)
+        double       RingFillMs;  //!< duration of decoded data within the ring (in milliseconds)
+        double       RingSizeMs;  //!< ring capacity (in milliseconds)
+        int          RingBlocks;  //!< number of blocks within the ring
+
+        OutStats() : NbUnderruns(0), RingFillMs(0.0), RingSizeMs(0.0), RingBlocks(0) {}
+    };
+
         public: //! @name public API
 
     ST_LOCAL StAudioQueue(const std::string& theAlDeviceName,
@@ -83,12 +102,17 @@ class StAudioQueue : public StAVPacketQueue {
     ST_LOCAL virtual void deinit() ST_ATTR_OVERRIDE;
 
     /**
-     * Main decoding and playback loop.
-     * Give packets from queue, decode them and fill OpenAL buffers
-     * for playback.
+     * Main decoding loop.
+     * Give packets from queue, decode them and push PCM blocks into the ring.
      */
     ST_LOCAL void decodeLoop();
 
+    /**
+     * Main playback loop.
+     * Initialize OpenAL, process playback events and submit PCM blocks from the ring into OpenAL buffers.
+     */
+    ST_LOCAL void outputLoop();
+
     /**
      * @return true if audio is played.
      */
@@ -111,6 +135,17 @@ class StAudioQueue : public StAVPacketQueue {
         return aPts;
     }
 
+    /**
+     * Set exact position for the following seek.
+     * Should be called before pushing FLUSH packet;
+     * samples decoded after flush up to this position will be dropped,
+     * so that sound starts together with the first displayed video frame.
+     * @param theSeekPts target position in seconds or negative value to disable
+     */
+    ST_LOCAL void setSeekTarget(const double theSeekPts) {
+        mySeekTargetNext = theSeekPts;
+    }
+
     /**
      * Setup OpenAL HRTF mixing.
      */
@@ -176,6 +211,14 @@ class StAudioQueue : public StAVPacketQueue {
         return myIsDisconnected;
     }
 
+    /**
+     * Retrieve playback statistics.
+     */
+    ST_LOCAL void getOutStats(StAudioQueue::OutStats& theStats) const {
+        StMutexAuto aLock(myStatsMutex);
+        theStats = myOutStats;
+    }
+
     /**
      * Return OpenAL info.
      */
@@ -204,14 +247,28 @@ class StAudioQueue : public StAVPacketQueue {
     ST_LOCAL void stalConfigureSources5_1();
     ST_LOCAL void stalConfigureSources7_1();
 
-    ST_LOCAL bool stalQueue(const double thePts);
+    /**
+     * Try queueing PCM block into OpenAL buffers.
+     * @return FALSE if OpenAL queue is full
+     */
+    ST_LOCAL bool stalQueue(const StPCMBlock& theBlock);
 
     /**
-     * This function do fill OpenAL buffers.
-     * @param thePts PTS for last decoded frame
+     * (Re)start OpenAL playback or synchronize playback timer
+     * while OpenAL queue is full and the block is waiting for free buffer.
+     */
+    ST_LOCAL void stalSyncPlayback(const StPCMBlock& theBlock,
+                                   const bool        theToSkipPlaybackFrom);
+
+    /**
+     * Detect OpenAL queue underrun.
+     */
+    ST_LOCAL void stalCheckUnderrun();
+
+    /**
+     * @return time until currently played OpenAL buffer is processed (in milliseconds)
      */
-    ST_LOCAL void stalFillBuffers(const double thePts,
-                                  const bool   toIgnoreEvents);
+    ST_LOCAL int stalGetProcessedWaitMs(const StPCMBlock& theBlock);
 
     ST_LOCAL void stalEmpty();
 
@@ -219,9 +276,39 @@ class StAudioQueue : public StAVPacketQueue {
 
     ST_LOCAL bool parseEvents();
 
+    /**
+     * Drop samples of decoded frame preceding the active seek target.
+     * @return FALSE if the whole frame should be skipped
+     */
+    ST_LOCAL bool trimToSeekTarget(const StHandle<StAVPacket>& thePacket);
+
     ST_LOCAL void decodePacket(const StHandle<StAVPacket>& thePacket,
                                double& thePts);
 
+    /**
+     * Push output buffer into the ring, waiting for free space.
+     * @param thePts PTS for last decoded frame
+     * @return FALSE if waiting has been interrupted
+     */
+    ST_LOCAL bool pushBlock(const double thePts);
+
+    /**
+     * Re-initialize decoding buffers when output channels layout should be changed.
+     */
+    ST_LOCAL void checkOutLayout();
+
+    /**
+     * Update playback statistics and duration of not yet played audio.
+     * @param theGeneration flush generation of data within the ring and OpenAL queue
+     */
+    ST_LOCAL void updateOutStats(const int32_t theGeneration);
+
+    /**
+     * @return duration of not yet played audio of previous stream (decoded blocks and OpenAL queue),
+     *         or zero if it has been flushed
+     */
+    ST_LOCAL double getPendingDuration() const;
+
         private:
 
     //! Setup output format for mono source.
@@ -321,6 +408,13 @@ class StAudioQueue : public StAVPacketQueue {
             myDataSizes[myLast] = theDataSize;
         }
 
+        /**
+         * @return size of the oldest buffer
+         */
+        ST_LOCAL size_t oldest() const {
+            return myDataSizes[(myLast + 1) % THE_NUM_AL_BUFFERS];
+        }
+
         ST_LOCAL size_t summ() const {
             size_t aSumm = 0;
             for(size_t aBuffIter = 0; aBuffIter < THE_NUM_AL_BUFFERS; ++aBuffIter) {
@@ -343,12 +437,28 @@ class StAudioQueue : public StAVPacketQueue {
     } IState_t;
 
     StHandle<StThread> myThread;        //!< decoding loop thread
+    StHandle<StThread> myOutThread;     //!< playback loop thread
+    StPCMRing          myRing;          //!< decoded PCM blocks
+    StCondition        myRingDataEv;    //!< signaled when new block is pushed into the ring
+    StCondition        myRingFreeEv;    //!< signaled when block is released from the ring
+    StAtomic<int32_t>  myFlushGen;      //!< flush generation, incremented by decoding thread on FLUSH packet
+    mutable StMutex    myStatsMutex;    //!< playback statistics lock
+    OutStats           myOutStats;      //!< playback statistics
+    double             myPendingSec;    //!< duration of not yet played audio (in seconds)
+    int32_t            myPendingGen;    //!< flush generation of myPendingSec
+    size_t             myAlSecondSize;  //!< bytes per second of data within OpenAL queue
+    volatile bool      myToQuitOut;     //!< playback thread exit flag
+    volatile bool      myIsDecodeEnded; //!< decoding thread reached end of stream
+    bool               myIsEndOfStream; //!< the ring has been drained after end of stream (playback thread only)
+    bool               myIsAlStarted;   //!< OpenAL playback has been started (used to detect underruns)
     mutable StTimer    myPlaybackTimer; //!< timer used for current PTS calculation
     StCondition        myDowntimeEvent;
     StAVFrame          myFrame;         //!< decoded audio frame
     int                myAvSrcFormat;   //!< myCodecCtx->sample_fmt
     int                myAvSampleRate;  //!< myCodecCtx->sample_rate
     int                myAvNbChannels;  //!< myCodecCtx->channels
+    volatile double    mySeekTargetNext;//!< seek target to be applied on next FLUSH packet
+    double             mySeekTarget;    //!< active seek target (negative when not seeking)
     StPCMBuffer        myBufferSrc;     //!< decoded PCM audio buffer
     StPCMBuffer        myBufferOut;     //!< output  PCM audio buffer
     StTimer            myLimitTimer;
@@ -0,0 +1,244 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StKeyframeIndex.h"
+
+#include <StAV/StAVPacket.h>
+#include <StFile/StFolder.h>
+#include <StFile/StRawFile.h>
+#include <StTemplates/StHashIndex.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+    static const char     THE_CACHE_MAGIC[4] = { 'S', 'T', 'K', 'I' };
+    static const uint32_t THE_CACHE_VERSION  = 2;
+
+    /**
+     * Header of the cache file, followed by file path and key frames timestamps.
+     */
+    struct StKeyframeCacheHeader {
+        char     Magic[4];
+        uint32_t Version;
+        int64_t  FileSize;
+        int64_t  ModTime;
+        int32_t  StreamId;
+        uint32_t PathSize;
+        uint64_t NbKeys;
+    };
+
+}
+
+int StKeyframeIndex::avInterruptCallback(void* theIndex) {
+    const StKeyframeIndex* anIndex = (const StKeyframeIndex* )theIndex;
+    return anIndex != NULL && anIndex->myToAbort ? 1 : 0;
+}
+
+StKeyframeIndex::StKeyframeIndex(const StString& theFilePath,
+                                 const int       theStreamId,
+                                 const StString& theCacheFolder)
+: myFilePath(theFilePath),
+  myCacheFolder(theCacheFolder),
+  myStreamId(theStreamId),
+  myScannedTs(stAV::NOPTS_VALUE),
+  myToAbort(false),
+  myIsDone(false) {
+    myTask = new ScanTask(this);
+    StThreadPool::getDefault().push(myTask, StThreadPool::Priority_Background);
+}
+
+StKeyframeIndex::~StKeyframeIndex() {
+    myToAbort = true;
+    myTask->wait();
+    myTask.nullify();
+}
+
+bool StKeyframeIndex::findKeyframe(const int64_t theTarget,
+                                   int64_t&      theKeyTs) const {
+    StMutexAuto aLock(myMutex);
+    if(myKeys.empty()
+    || (!myIsDone && (myScannedTs == stAV::NOPTS_VALUE || theTarget > myScannedTs))) {
+        return false;
+    }
+
+    std::vector<int64_t>::const_iterator aKeyIter = std::upper_bound(myKeys.begin(), myKeys.end(), theTarget);
+    if(aKeyIter == myKeys.begin()) {
+        theKeyTs = myKeys.front();
+        return true;
+    }
+    theKeyTs = *(--aKeyIter);
+    return true;
+}
+
+StString StKeyframeIndex::getCachePath() const {
+    const size_t aHash = StHashIndex::hashBytes(myFilePath.toCString(), myFilePath.getSize(), false);
+    char aName[64];
+    stsprintf(aName, sizeof(aName), "%016llx_%d.idx", (unsigned long long )aHash, myStreamId);
+    return myCacheFolder + "keyframes" + SYS_FS_SPLITTER + aName;
+}
+
+bool StKeyframeIndex::loadCache(const int64_t theFileSize,
+                                const int64_t theModTime) {
+    if(myCacheFolder.isEmpty()) {
+        return false;
+    }
+
+    const StString aCachePath = getCachePath();
+    if(!StFileNode::isFileExists(aCachePath)) {
+        return false;
+    }
+
+    StRawFile aFile(aCachePath);
+    if(!aFile.readFile()
+    ||  aFile.getSize() < sizeof(StKeyframeCacheHeader)) {
+        return false;
+    }
+
+    StKeyframeCacheHeader aHeader;
+    std::memcpy(&aHeader, aFile.getBuffer(), sizeof(aHeader));
+    if(std::memcmp(aHeader.Magic, THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC)) != 0
+    || aHeader.Version  != THE_CACHE_VERSION
+    || aHeader.FileSize != theFileSize
+    || aHeader.ModTime  != theModTime
+    || aHeader.StreamId != myStreamId
+    || aHeader.PathSize != uint32_t(myFilePath.getSize())
+    || aFile.getSize()  != sizeof(aHeader) + aHeader.PathSize + aHeader.NbKeys * sizeof(int64_t)) {
+        return false;
+    }
+
+    // hash collision
+    const stUByte_t* aData = aFile.getBuffer() + sizeof(aHeader);
+    if(std::memcmp(aData, myFilePath.toCString(), aHeader.PathSize) != 0) {
+        return false;
+    }
+    aData += aHeader.PathSize;
+
+    std::vector<int64_t> aKeys((size_t )aHeader.NbKeys);
+    if(!aKeys.empty()) {
+        std::memcpy(&aKeys[0], aData, aKeys.size() * sizeof(int64_t));
+    }
+
+    StMutexAuto aLock(myMutex);
+    myKeys.swap(aKeys);
+    return true;
+}
+
+bool StKeyframeIndex::saveCache(const int64_t theFileSize,
+                                const int64_t theModTime) const {
+    if(myCacheFolder.isEmpty()) {
+        return false;
+    }
+
+    const StString aFolder = myCacheFolder + "keyframes";
+    if(!StFolder::isFolder(aFolder)
+    && !StFolder::createFolder(aFolder)) {
+        return false;
+    }
+
+    StKeyframeCacheHeader aHeader;
+    std::memcpy(aHeader.Magic, THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC));
+    aHeader.Version  = THE_CACHE_VERSION;
+    aHeader.FileSize = theFileSize;
+    aHeader.ModTime  = theModTime;
+    aHeader.StreamId = myStreamId;
+    aHeader.PathSize = uint32_t(myFilePath.getSize());
+    aHeader.NbKeys   = uint64_t(myKeys.size());
+
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::WRITE, getCachePath())) {
+        return false;
+    }
+
+    bool isOk = aFile.write((const char* )&aHeader, sizeof(aHeader)) == sizeof(aHeader)
+             && aFile.write(myFilePath.toCString(), myFilePath.getSize()) == myFilePath.getSize();
+    if(isOk && !myKeys.empty()) {
+        const size_t aSize = myKeys.size() * sizeof(int64_t);
+        isOk = aFile.write((const char* )&myKeys[0], aSize) == aSize;
+    }
+    aFile.closeFile();
+    return isOk;
+}
+
+void StKeyframeIndex::scan() {
+    // file size and modification time identify the file version within the cache,
+    // the index is loaded without probing the file
+    int64_t aFileSize = 0, aModTime = 0;
+    const bool hasStat = StFileNode::getFileStat(myFilePath, aFileSize, aModTime);
+    if(hasStat
+    && loadCache(aFileSize, aModTime)) {
+        myIsDone = true;
+        return;
+    }
+
+    AVFormatContext* aFormatCtx = avformat_alloc_context();
+    aFormatCtx->interrupt_callback.callback = &StKeyframeIndex::avInterruptCallback;
+    aFormatCtx->interrupt_callback.opaque   = this;
+    if(avformat_open_input(&aFormatCtx, myFilePath.toCString(), NULL, NULL) != 0) {
+        // context is freed on failure
+        ST_DEBUG_LOG("StKeyframeIndex, unable to open '" + myFilePath + "'");
+        return;
+    }
+
+    if(avformat_find_stream_info(aFormatCtx, NULL) < 0
+    || myStreamId < 0
+    || (unsigned int )myStreamId >= aFormatCtx->nb_streams) {
+        avformat_close_input(&aFormatCtx);
+        return;
+    }
+
+    // demuxer will skip packets of other streams
+    for(unsigned int aStreamIter = 0; aStreamIter < aFormatCtx->nb_streams; ++aStreamIter) {
+        aFormatCtx->streams[aStreamIter]->discard = int(aStreamIter) == myStreamId ? AVDISCARD_DEFAULT : AVDISCARD_ALL;
+    }
+
+    StAVPacket aPacket;
+    while(!myToAbort) {
+        if(av_read_frame(aFormatCtx, aPacket.getAVpkt()) < 0) {
+            myIsDone = !myToAbort;
+            break;
+        }
+        if(aPacket.getStreamId() != myStreamId) {
+            aPacket.free();
+            continue;
+        }
+
+        const int64_t aTs = aPacket.getPts() != stAV::NOPTS_VALUE ? aPacket.getPts() : aPacket.getDts();
+        if(aTs != stAV::NOPTS_VALUE) {
+            StMutexAuto aLock(myMutex);
+            if(aPacket.isKeyFrame()) {
+                // packets are stored in decoding order - keep the list sorted by presentation time
+                if(myKeys.empty() || myKeys.back() < aTs) {
+                    myKeys.push_back(aTs);
+                } else {
+                    myKeys.insert(std::upper_bound(myKeys.begin(), myKeys.end(), aTs), aTs);
+                }
+            }
+            myScannedTs = stMax(myScannedTs, aTs);
+        }
+        aPacket.free();
+    }
+    avformat_close_input(&aFormatCtx);
+
+    if(myIsDone
+    && hasStat
+    && !saveCache(aFileSize, aModTime)) {
+        ST_DEBUG_LOG("StKeyframeIndex, unable to save index for '" + myFilePath + "'");
+    }
+}
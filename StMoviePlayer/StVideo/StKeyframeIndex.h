@@ -0,0 +1,148 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StKeyframeIndex_h_
+#define __StKeyframeIndex_h_
+
+#include <StAV/stAV.h>
+#include <StStrings/StString.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThreadPool.h>
+
+#include <vector>
+
+/**
+ * Index of key frames within single video stream.
+ * The index is built by background task of the thread pool scanning packets of the file
+ * through dedicated format context (so that it does not interfere with playback)
+ * and stored into cache folder to be reused when the same file is opened next time.
+ * Until scanning is finished, the index covers only the beginning of the file.
+ */
+class StKeyframeIndex {
+
+        public:
+
+    /**
+     * Main constructor, starts background scanning.
+     * @param theFilePath    path to the media file
+     * @param theStreamId    video stream within the file
+     * @param theCacheFolder folder to store the index (empty to disable persistence)
+     */
+    ST_LOCAL StKeyframeIndex(const StString& theFilePath,
+                             const int       theStreamId,
+                             const StString& theCacheFolder);
+
+    /**
+     * Destructor, aborts scanning.
+     */
+    ST_LOCAL ~StKeyframeIndex();
+
+    /**
+     * @return indexed file path
+     */
+    ST_LOCAL const StString& getFilePath() const {
+        return myFilePath;
+    }
+
+    /**
+     * @return indexed stream id
+     */
+    ST_LOCAL int getStreamId() const {
+        return myStreamId;
+    }
+
+    /**
+     * @return TRUE if whole file has been indexed
+     */
+    ST_LOCAL bool isDone() const {
+        return myIsDone;
+    }
+
+    /**
+     * Find the closest key frame at or before specified timestamp.
+     * @param theTarget timestamp in stream time base units
+     * @param theKeyTs  found key frame timestamp in stream time base units
+     * @return FALSE if position is not (yet) covered by the index
+     */
+    ST_LOCAL bool findKeyframe(const int64_t theTarget,
+                               int64_t&      theKeyTs) const;
+
+        private:
+
+    /**
+     * Background task scanning the file.
+     */
+    class ScanTask : public StThreadPool::Task {
+
+            public:
+
+        ST_LOCAL ScanTask(StKeyframeIndex* theIndex) : myIndex(theIndex) {}
+
+        ST_LOCAL virtual void perform() {
+            myIndex->scan();
+        }
+
+            private:
+
+        StKeyframeIndex* myIndex;
+
+    };
+
+    /**
+     * Interrupt callback for blocking FFmpeg I/O.
+     */
+    ST_LOCAL static int avInterruptCallback(void* theIndex);
+
+    /**
+     * Scan the file or load the index from cache.
+     */
+    ST_LOCAL void scan();
+
+    /**
+     * @return path to the cache file
+     */
+    ST_LOCAL StString getCachePath() const;
+
+    /**
+     * Read the index from cache file.
+     */
+    ST_LOCAL bool loadCache(const int64_t theFileSize,
+                            const int64_t theModTime);
+
+    /**
+     * Write the index into cache file.
+     */
+    ST_LOCAL bool saveCache(const int64_t theFileSize,
+                            const int64_t theModTime) const;
+
+        private:
+
+    StString              myFilePath;    //!< media file path
+    StString              myCacheFolder; //!< cache folder
+    int                   myStreamId;    //!< video stream id
+    mutable StMutex       myMutex;       //!< lock for key frames list
+    std::vector<int64_t>  myKeys;        //!< sorted timestamps of key frames
+    int64_t               myScannedTs;   //!< the last scanned timestamp
+    StHandle<StThreadPool::Task>
+                          myTask;        //!< scanning task
+    volatile bool         myToAbort;     //!< flag to abort scanning
+    volatile bool         myIsDone;      //!< flag indicating that whole file has been indexed
+
+};
+
+#endif // __StKeyframeIndex_h_
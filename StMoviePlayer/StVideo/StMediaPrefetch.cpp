@@ -0,0 +1,169 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StMediaPrefetch.h"
+
+int StMediaPrefetch::avInterruptCallback(void* thePrefetch) {
+    const StMediaPrefetch* aPrefetch = (const StMediaPrefetch* )thePrefetch;
+    return aPrefetch != NULL && aPrefetch->myToStop ? 1 : 0;
+}
+
+StMediaPrefetch::StMediaPrefetch(const StHandle<StProbeCache>& theProbeCache,
+                                 const int64_t                 theProbeLimit)
+: myProbeCache(theProbeCache),
+  myProbeLimit(theProbeLimit),
+  myIsActive(false),
+  myToStop(false) {
+    myTask = new PrefetchTask(this);
+}
+
+StMediaPrefetch::~StMediaPrefetch() {
+    clear();
+}
+
+void StMediaPrefetch::closeContext(AVFormatContext*& theFormatCtx) {
+    if(theFormatCtx != NULL) {
+        avformat_close_input(&theFormatCtx);
+    }
+}
+
+void StMediaPrefetch::request(const std::vector<StString>& thePaths) {
+    if(myIsActive
+    && myEntries.size() == thePaths.size()) {
+        bool isSame = true;
+        for(size_t anIter = 0; anIter < thePaths.size() && isSame; ++anIter) {
+            isSame = myEntries[anIter].Path == thePaths[anIter];
+        }
+        if(isSame) {
+            return;
+        }
+    }
+
+    clear();
+    if(thePaths.empty()) {
+        return;
+    }
+
+    myEntries.resize(thePaths.size());
+    for(size_t anIter = 0; anIter < thePaths.size(); ++anIter) {
+        myEntries[anIter].Path      = thePaths[anIter];
+        myEntries[anIter].FormatCtx = NULL;
+    }
+    myToStop = false;
+    myIsActive = true;
+    StThreadPool::getDefault().push(myTask, StThreadPool::Priority_Background);
+}
+
+void StMediaPrefetch::waitTask() {
+    if(myIsActive) {
+        myTask->wait();
+        myIsActive = false;
+    }
+}
+
+AVFormatContext* StMediaPrefetch::take(const StString& thePath) {
+    bool isRequested = false;
+    for(size_t anIter = 0; anIter < myEntries.size(); ++anIter) {
+        if(myEntries[anIter].Path == thePath) {
+            isRequested = true;
+            break;
+        }
+    }
+    if(!isRequested) {
+        return NULL;
+    }
+
+    // wait for probing to finish - should be faster than opening the file once again
+    waitTask();
+
+    StMutexAuto aLock(myMutex);
+    for(size_t anIter = 0; anIter < myEntries.size(); ++anIter) {
+        Entry& anEntry = myEntries[anIter];
+        if(anEntry.Path != thePath) {
+            continue;
+        }
+
+        AVFormatContext* aFormatCtx = anEntry.FormatCtx;
+        anEntry.FormatCtx = NULL;
+        if(aFormatCtx != NULL) {
+            // detach from this object
+            aFormatCtx->interrupt_callback.callback = NULL;
+            aFormatCtx->interrupt_callback.opaque   = NULL;
+        }
+        return aFormatCtx;
+    }
+    return NULL;
+}
+
+bool StMediaPrefetch::isReady(const StString& thePath) const {
+    StMutexAuto aLock(myMutex);
+    for(size_t anIter = 0; anIter < myEntries.size(); ++anIter) {
+        if(myEntries[anIter].Path == thePath) {
+            return myEntries[anIter].FormatCtx != NULL;
+        }
+    }
+    return false;
+}
+
+void StMediaPrefetch::clear() {
+    if(myIsActive) {
+        myToStop = true;
+        waitTask();
+    }
+
+    StMutexAuto aLock(myMutex);
+    for(size_t anIter = 0; anIter < myEntries.size(); ++anIter) {
+        closeContext(myEntries[anIter].FormatCtx);
+    }
+    myEntries.clear();
+}
+
+void StMediaPrefetch::prefetchLoop() {
+    const StString aProbeSize = StString() + myProbeLimit;
+    for(size_t anIter = 0; anIter < myEntries.size() && !myToStop; ++anIter) {
+        const StString aPath = myEntries[anIter].Path;
+        AVFormatContext* aFormatCtx = avformat_alloc_context();
+        aFormatCtx->interrupt_callback.callback = &StMediaPrefetch::avInterruptCallback;
+        aFormatCtx->interrupt_callback.opaque   = this;
+
+        AVDictionary* anOpts = NULL;
+        av_dict_set(&anOpts, "probesize", aProbeSize.toCString(), 0);
+        av_dict_set(&anOpts, "analyzeduration", "1000000", 0); // 1 second in AV_TIME_BASE units
+        const int anErr = avformat_open_input(&aFormatCtx, aPath.toCString(), NULL, &anOpts);
+        av_dict_free(&anOpts);
+        if(anErr != 0) {
+            // context is freed on failure, error will be reported on regular opening
+            continue;
+        }
+
+        // results of probing limited by size and duration might be incomplete
+        // (missing streams or codec parameters), so that they are not stored into cache
+        // to be reused by regular opening of the same file
+        if(myProbeCache->restore(aFormatCtx, aPath)) {
+            // parameters are taken from cache
+        } else if(myToStop
+               || avformat_find_stream_info(aFormatCtx, NULL) < 0
+               || myToStop) {
+            closeContext(aFormatCtx);
+            continue;
+        }
+
+        StMutexAuto aLock(myMutex);
+        myEntries[anIter].FormatCtx = aFormatCtx;
+    }
+}
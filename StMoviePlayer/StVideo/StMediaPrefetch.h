@@ -0,0 +1,147 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StMediaPrefetch_h_
+#define __StMediaPrefetch_h_
+
+#include "StProbeCache.h"
+
+#include <StAV/stAV.h>
+#include <StStrings/StString.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThreadPool.h>
+
+#include <vector>
+
+/**
+ * Background opener of the next playlist item.
+ * Files are opened and probed (avformat_find_stream_info() decodes the first frames of each stream)
+ * in advance within background task of shared thread pool (executed by low-priority worker,
+ * so that probing does not compete with playback threads), so that switching to the next item
+ * just takes already prepared format context instead of blocking I/O.
+ * Memory usage is bounded by keeping only one playlist item (one or several files of stereo pair)
+ * and by limiting probing size of each file.
+ */
+class StMediaPrefetch {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theProbeCache probing results cache
+     * @param theProbeLimit maximum number of bytes buffered by probing each file
+     *                      (FFmpeg default is 5000000 bytes and 5 seconds of analyzed stream)
+     */
+    ST_LOCAL StMediaPrefetch(const StHandle<StProbeCache>& theProbeCache,
+                             const int64_t                 theProbeLimit = 1024 * 1024);
+
+    /**
+     * Destructor, releases prepared contexts.
+     */
+    ST_LOCAL ~StMediaPrefetch();
+
+    /**
+     * Start preparing another playlist item.
+     * Contexts prepared for other files are released.
+     * Does nothing if the same files are already requested.
+     * @param thePaths paths to local files of the item
+     */
+    ST_LOCAL void request(const std::vector<StString>& thePaths);
+
+    /**
+     * Take prepared format context for specified file.
+     * Waits for the background task if the file is still being probed.
+     * @param thePath file path
+     * @return format context (ownership is passed to the caller) or NULL if file was not requested
+     */
+    ST_LOCAL AVFormatContext* take(const StString& thePath);
+
+    /**
+     * @return TRUE if specified file has been already prepared
+     */
+    ST_LOCAL bool isReady(const StString& thePath) const;
+
+    /**
+     * Stop the task and release prepared contexts.
+     */
+    ST_LOCAL void clear();
+
+        private:
+
+    /**
+     * Pool task calling prefetchLoop().
+     */
+    class PrefetchTask : public StThreadPool::Task {
+
+            public:
+
+        ST_LOCAL PrefetchTask(StMediaPrefetch* thePrefetch) : myPrefetch(thePrefetch) {}
+
+        ST_LOCAL virtual void perform() {
+            myPrefetch->prefetchLoop();
+        }
+
+            private:
+
+        StMediaPrefetch* myPrefetch;
+
+    };
+
+    /**
+     * Wait for the active task.
+     */
+    ST_LOCAL void waitTask();
+
+    /**
+     * Interrupt callback for blocking FFmpeg I/O.
+     */
+    ST_LOCAL static int avInterruptCallback(void* thePrefetch);
+
+    /**
+     * Open and probe requested files.
+     */
+    ST_LOCAL void prefetchLoop();
+
+    /**
+     * Close format context.
+     */
+    ST_LOCAL static void closeContext(AVFormatContext*& theFormatCtx);
+
+        private:
+
+    /**
+     * Prepared file.
+     */
+    struct Entry {
+        StString         Path;      //!< file path
+        AVFormatContext* FormatCtx; //!< opened context or NULL if file has not been (successfully) opened
+    };
+
+        private:
+
+    mutable StMutex              myMutex;      //!< lock for entries list
+    std::vector<Entry>           myEntries;    //!< requested files
+    StHandle<StProbeCache>       myProbeCache; //!< probing results cache
+    StHandle<StThreadPool::Task> myTask;       //!< background task
+    int64_t                      myProbeLimit; //!< probing size limit
+    bool                         myIsActive;   //!< flag indicating that task has been pushed and not yet waited
+    volatile bool                myToStop;     //!< flag to abort probing
+
+};
+
+#endif // __StMediaPrefetch_h_
@@ -190,6 +190,17 @@ void StPCMBuffer::resize(const size_t theSizeMin,
     setupChannels(myChMap, myPlanesNb);
 }
 
+void StPCMBuffer::copyFrom(const StPCMBuffer& theBuffer) {
+    resize(theBuffer.mySizeBytes, false);
+    setFormat(theBuffer.myPCMFormat);
+    myPCMFreq = theBuffer.myPCMFreq;
+    setupChannels(theBuffer.myChMap, theBuffer.myPlanesNb);
+    myPlaneSize = theBuffer.myPlaneSize;
+    for(size_t aPlaneIter = 0; aPlaneIter < myPlanesNb; ++aPlaneIter) {
+        stMemCpy(myPlanes[aPlaneIter], theBuffer.myPlanes[aPlaneIter], myPlaneSize);
+    }
+}
+
 bool StPCMBuffer::setDataSize(const size_t theDataSize) {
     const size_t aPlaneSize    = theDataSize / myPlanesNb;
     const size_t aPlaneSizeMax = mySizeBytes / myPlanesNb;
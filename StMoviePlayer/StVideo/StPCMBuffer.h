@@ -283,6 +283,11 @@ class StPCMBuffer {
      */
     ST_LOCAL bool addData(const StPCMBuffer& theBuffer);
 
+    /**
+     * Copy data and configuration (format, frequency and channels) from another buffer.
+     */
+    ST_LOCAL void copyFrom(const StPCMBuffer& theBuffer);
+
     /**
      * This parameter measures how many samples/channel are played each second.
      * Frequency is measured in samples/second (Hz).
@@ -0,0 +1,101 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StPCMRing.h"
+
+StPCMRing::StPCMRing(const double theDurationSec)
+: myNbFilled(0),
+  myWriteIter(0),
+  myReadIter(0),
+  myDurationLimit(theDurationSec) {
+    stMemZero(mySlots, sizeof(mySlots));
+}
+
+StPCMRing::~StPCMRing() {
+    for(int aSlotIter = 0; aSlotIter < NB_SLOTS_MAX; ++aSlotIter) {
+        delete mySlots[aSlotIter];
+    }
+}
+
+bool StPCMRing::isFull() const {
+    // acquire - consumer should finish reading released slots before they are overridden
+    const int aNbFilled = myNbFilled.getValueAcquire();
+    if(aNbFilled >= NB_SLOTS_MAX) {
+        return true;
+    } else if(aNbFilled < 2) {
+        return false; // always allow double buffering
+    }
+
+    // filled slots are not modified until released by consumer
+    double aDuration = 0.0;
+    for(int aBlockIter = 1; aBlockIter <= aNbFilled; ++aBlockIter) {
+        aDuration += mySlots[(myWriteIter + NB_SLOTS_MAX - aBlockIter) % NB_SLOTS_MAX]->Duration;
+    }
+    return aDuration >= myDurationLimit;
+}
+
+bool StPCMRing::push(const StPCMBuffer& theData,
+                     const double       thePts,
+                     const int          theAlFormat,
+                     const int32_t      theGeneration) {
+    if(isFull()) {
+        return false;
+    }
+
+    StPCMBlock*& aBlock = mySlots[myWriteIter];
+    if(aBlock == NULL) {
+        aBlock = new StPCMBlock();
+    }
+    aBlock->Buffer.copyFrom(theData);
+    aBlock->Pts        = thePts;
+    aBlock->Duration   = theData.getSecondSize() != 0
+                       ? double(theData.getDataSizeWhole()) / double(theData.getSecondSize())
+                       : 0.0;
+    aBlock->AlFormat   = theAlFormat;
+    aBlock->Generation = theGeneration;
+    myWriteIter = (myWriteIter + 1) % NB_SLOTS_MAX;
+
+    // publish the block (atomic operation implies full memory barrier)
+    myNbFilled.increment();
+    return true;
+}
+
+void StPCMRing::pop() {
+    if(myNbFilled.getValue() <= 0) {
+        return;
+    }
+
+    myReadIter = (myReadIter + 1) % NB_SLOTS_MAX;
+    myNbFilled.decrement();
+}
+
+void StPCMRing::clear() {
+    for(int aNbFilled = myNbFilled.getValue(); aNbFilled > 0; --aNbFilled) {
+        pop();
+    }
+}
+
+double StPCMRing::getFilledDuration() const {
+    // acquire - durations of blocks published by producer should be visible
+    const int aNbFilled = myNbFilled.getValueAcquire();
+    double aDuration = 0.0;
+    for(int aBlockIter = 0; aBlockIter < aNbFilled; ++aBlockIter) {
+        aDuration += mySlots[(myReadIter + aBlockIter) % NB_SLOTS_MAX]->Duration;
+    }
+    return aDuration;
+}
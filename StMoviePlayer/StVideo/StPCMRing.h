@@ -0,0 +1,143 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StPCMRing_h_
+#define __StPCMRing_h_
+
+#include <StTemplates/StAtomic.h>
+
+#include "StPCMBuffer.h"
+
+/**
+ * Block of decoded PCM data ready for playback.
+ */
+struct StPCMBlock {
+
+    StPCMBuffer Buffer;     //!< PCM data in output format
+    double      Pts;        //!< PTS of the first frame following the block (in seconds)
+    double      Duration;   //!< block duration (in seconds)
+    int         AlFormat;   //!< OpenAL buffer format
+    int32_t     Generation; //!< flush generation the block has been decoded within
+
+    ST_LOCAL StPCMBlock()
+    : Buffer(StPcmFormat_Int16),
+      Pts(0.0),
+      Duration(0.0),
+      AlFormat(0),
+      Generation(0) {}
+
+};
+
+/**
+ * Lock-free ring of decoded PCM blocks between single producer (decoding thread)
+ * and single consumer (OpenAL submission thread).
+ * Ring capacity is defined by duration rather than number of blocks,
+ * so that the same amount of audio is buffered for any sample format and channels layout.
+ */
+class StPCMRing {
+
+        public:
+
+    /**
+     * Maximum number of blocks in the ring.
+     */
+    static const int NB_SLOTS_MAX = 32;
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theDurationSec ring capacity in seconds
+     */
+    ST_LOCAL StPCMRing(const double theDurationSec);
+
+    /**
+     * Destructor.
+     */
+    ST_LOCAL ~StPCMRing();
+
+    /**
+     * @return ring capacity in seconds
+     */
+    ST_LOCAL double getDurationLimit() const {
+        return myDurationLimit;
+    }
+
+    /**
+     * @return number of filled blocks
+     */
+    ST_LOCAL int getNbBlocks() const {
+        return myNbFilled.getValue();
+    }
+
+        public: //! @name producer interface
+
+    /**
+     * @return TRUE if ring has enough data and producer should wait
+     */
+    ST_LOCAL bool isFull() const;
+
+    /**
+     * Copy the data into the ring.
+     * @param theData       PCM data
+     * @param thePts        PTS of the first frame following the data
+     * @param theAlFormat   OpenAL buffer format
+     * @param theGeneration flush generation
+     * @return FALSE if ring is full
+     */
+    ST_LOCAL bool push(const StPCMBuffer& theData,
+                       const double       thePts,
+                       const int          theAlFormat,
+                       const int32_t      theGeneration);
+
+        public: //! @name consumer interface
+
+    /**
+     * @return the oldest block or NULL if ring is empty
+     */
+    ST_LOCAL const StPCMBlock* front() const {
+        // acquire - block content published by producer should be visible
+        return myNbFilled.getValueAcquire() > 0 ? mySlots[myReadIter] : NULL;
+    }
+
+    /**
+     * Release the oldest block.
+     */
+    ST_LOCAL void pop();
+
+    /**
+     * Release all filled blocks.
+     */
+    ST_LOCAL void clear();
+
+    /**
+     * @return duration of filled blocks in seconds
+     */
+    ST_LOCAL double getFilledDuration() const;
+
+        private:
+
+    StPCMBlock*       mySlots[NB_SLOTS_MAX]; //!< blocks, allocated on first use
+    StAtomic<int32_t> myNbFilled;            //!< number of filled blocks
+    int               myWriteIter;           //!< slot to write next block (producer-only)
+    int               myReadIter;            //!< slot to read next block  (consumer-only)
+    double            myDurationLimit;       //!< ring capacity in seconds
+
+};
+
+#endif // __StPCMRing_h_
@@ -0,0 +1,334 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StProbeCache.h"
+
+#include <StFile/StFolder.h>
+#include <StFile/StRawFile.h>
+#include <StTemplates/StHashIndex.h>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    static const char     THE_CACHE_MAGIC[4] = { 'S', 'T', 'P', 'C' };
+    static const uint32_t THE_CACHE_VERSION  = 1;
+
+    /**
+     * Size of the file beginning to compute content hash.
+     */
+    static const size_t THE_HASH_PREFIX = 64 * 1024;
+
+    /**
+     * Header of the cache file, followed by file path and streams.
+     */
+    struct StProbeCacheHeader {
+        char     Magic[4];
+        uint32_t Version;
+        int64_t  FileSize;
+        int64_t  ModTime;
+        uint64_t ContentHash;
+        int64_t  Duration;
+        int64_t  StartTime;
+        int64_t  BitRate;
+        uint32_t PathSize;
+        uint32_t NbStreams;
+    };
+
+    /**
+     * Probed parameters of single stream.
+     */
+    struct StProbeCacheStream {
+        int32_t  CodecType;
+        int32_t  CodecId;
+        int32_t  Format;
+        int32_t  Width;
+        int32_t  Height;
+        int32_t  SarNum;
+        int32_t  SarDen;
+        int32_t  VideoDelay;
+        int32_t  SampleRate;
+        int32_t  Channels;
+        int32_t  FrameSize;
+        int32_t  Profile;
+        int32_t  Level;
+        int32_t  AvgFpsNum;
+        int32_t  AvgFpsDen;
+        int32_t  RealFpsNum;
+        int32_t  RealFpsDen;
+        int32_t  TimeBaseNum;
+        int32_t  TimeBaseDen;
+        uint64_t ChannelLayout;
+        int64_t  BitRate;
+        int64_t  StartTime;
+        int64_t  Duration;
+        int64_t  NbFrames;
+    };
+
+}
+
+StProbeCache::StProbeCache(const StString& theCacheFolder)
+: myCacheFolder(theCacheFolder) {
+    //
+}
+
+bool StProbeCache::readFileKey(const StString& theFilePath,
+                               FileKey&        theKey) {
+    if(StFileNode::isContentProtocolPath(theFilePath)
+    || StFileNode::isRemoteProtocolPath(theFilePath)
+    || !StFileNode::getFileStat(theFilePath, theKey.Size, theKey.ModTime)) {
+        return false;
+    }
+
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::READ, theFilePath)) {
+        return false;
+    }
+
+    std::vector<char> aPrefix(THE_HASH_PREFIX);
+    const size_t aRead = aFile.read(&aPrefix[0], aPrefix.size());
+    aFile.closeFile();
+    theKey.ContentHash = uint64_t(StHashIndex::hashBytes(&aPrefix[0], aRead, false));
+    return true;
+}
+
+StString StProbeCache::getCachePath(const StString& theFilePath) const {
+    const size_t aHash = StHashIndex::hashBytes(theFilePath.toCString(), theFilePath.getSize(), false);
+    char aName[64];
+    stsprintf(aName, sizeof(aName), "%016llx.prb", (unsigned long long )aHash);
+    return myCacheFolder + "probe" + SYS_FS_SPLITTER + aName;
+}
+
+bool StProbeCache::restore(AVFormatContext* theFormatCtx,
+                           const StString&  theFilePath) const {
+#ifdef ST_AV_NEWCODECPAR
+    if(myCacheFolder.isEmpty()
+    || theFormatCtx == NULL
+    || (theFormatCtx->ctx_flags & AVFMTCTX_NOHEADER) != 0) {
+        // streams of headerless formats are not known until packets are read
+        return false;
+    }
+
+    const StString aCachePath = getCachePath(theFilePath);
+    FileKey aKey;
+    if(!StFileNode::isFileExists(aCachePath)
+    || !readFileKey(theFilePath, aKey)) {
+        return false;
+    }
+
+    StRawFile aFile(aCachePath);
+    if(!aFile.readFile()
+    ||  aFile.getSize() < sizeof(StProbeCacheHeader)) {
+        return false;
+    }
+
+    StProbeCacheHeader aHeader;
+    std::memcpy(&aHeader, aFile.getBuffer(), sizeof(aHeader));
+    if(std::memcmp(aHeader.Magic, THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC)) != 0
+    || aHeader.Version     != THE_CACHE_VERSION
+    || aHeader.FileSize    != aKey.Size
+    || aHeader.ModTime     != aKey.ModTime
+    || aHeader.ContentHash != aKey.ContentHash
+    || aHeader.PathSize    != uint32_t(theFilePath.getSize())
+    || aHeader.NbStreams   != uint32_t(theFormatCtx->nb_streams)
+    || aFile.getSize()     != sizeof(aHeader) + aHeader.PathSize + aHeader.NbStreams * sizeof(StProbeCacheStream)) {
+        return false;
+    }
+
+    const stUByte_t* aData = aFile.getBuffer() + sizeof(aHeader);
+    if(std::memcmp(aData, theFilePath.toCString(), aHeader.PathSize) != 0) {
+        return false;
+    }
+    aData += aHeader.PathSize;
+
+    // verify that container header declares the same streams
+    std::vector<StProbeCacheStream> aStreams(aHeader.NbStreams);
+    if(!aStreams.empty()) {
+        std::memcpy(&aStreams[0], aData, aStreams.size() * sizeof(StProbeCacheStream));
+    }
+    for(unsigned int aStreamId = 0; aStreamId < theFormatCtx->nb_streams; ++aStreamId) {
+        const AVCodecParameters* aPar = theFormatCtx->streams[aStreamId]->codecpar;
+        if(aStreams[aStreamId].CodecType != int32_t(aPar->codec_type)
+        || aStreams[aStreamId].CodecId   != int32_t(aPar->codec_id)) {
+            return false;
+        }
+    }
+
+    // fill in only parameters missing in container header
+    for(unsigned int aStreamId = 0; aStreamId < theFormatCtx->nb_streams; ++aStreamId) {
+        const StProbeCacheStream& aCached = aStreams[aStreamId];
+        AVStream*          aStream = theFormatCtx->streams[aStreamId];
+        AVCodecParameters* aPar    = aStream->codecpar;
+        if(aPar->format < 0) {
+            aPar->format = aCached.Format;
+        }
+        if(aPar->width == 0 || aPar->height == 0) {
+            aPar->width  = aCached.Width;
+            aPar->height = aCached.Height;
+        }
+        if(aPar->sample_aspect_ratio.num == 0) {
+            aPar->sample_aspect_ratio = av_make_q(aCached.SarNum, aCached.SarDen);
+        }
+        if(aPar->video_delay == 0) {
+            aPar->video_delay = aCached.VideoDelay;
+        }
+        if(aPar->sample_rate == 0) {
+            aPar->sample_rate = aCached.SampleRate;
+        }
+        if(aPar->channels == 0) {
+            aPar->channels = aCached.Channels;
+        }
+        if(aPar->channel_layout == 0) {
+            aPar->channel_layout = aCached.ChannelLayout;
+        }
+        if(aPar->frame_size == 0) {
+            aPar->frame_size = aCached.FrameSize;
+        }
+        if(aPar->profile == FF_PROFILE_UNKNOWN) {
+            aPar->profile = aCached.Profile;
+        }
+        if(aPar->level == FF_LEVEL_UNKNOWN) {
+            aPar->level = aCached.Level;
+        }
+        if(aPar->bit_rate == 0) {
+            aPar->bit_rate = aCached.BitRate;
+        }
+        if(aStream->avg_frame_rate.num == 0) {
+            aStream->avg_frame_rate = av_make_q(aCached.AvgFpsNum, aCached.AvgFpsDen);
+        }
+        if(aStream->r_frame_rate.num == 0) {
+            aStream->r_frame_rate = av_make_q(aCached.RealFpsNum, aCached.RealFpsDen);
+        }
+        if(aStream->start_time == stAV::NOPTS_VALUE) {
+            aStream->start_time = aCached.StartTime;
+        }
+        if(aStream->duration == stAV::NOPTS_VALUE) {
+            aStream->duration = aCached.Duration;
+        }
+        if(aStream->nb_frames == 0) {
+            aStream->nb_frames = aCached.NbFrames;
+        }
+
+        // keep deprecated codec context in sync, as done by avformat_find_stream_info()
+        AVCodecContext* aCodecCtx = stAV::getCodecCtx(aStream);
+        if(aCodecCtx != NULL
+        && avcodec_parameters_to_context(aCodecCtx, aPar) >= 0
+        && aCached.TimeBaseDen != 0) {
+            aCodecCtx->time_base = av_make_q(aCached.TimeBaseNum, aCached.TimeBaseDen);
+        }
+    }
+
+    if(theFormatCtx->duration == stAV::NOPTS_VALUE) {
+        theFormatCtx->duration = aHeader.Duration;
+    }
+    if(theFormatCtx->start_time == stAV::NOPTS_VALUE) {
+        theFormatCtx->start_time = aHeader.StartTime;
+    }
+    if(theFormatCtx->bit_rate == 0) {
+        theFormatCtx->bit_rate = aHeader.BitRate;
+    }
+    return true;
+#else
+    (void )theFormatCtx;
+    (void )theFilePath;
+    return false;
+#endif
+}
+
+bool StProbeCache::store(const AVFormatContext* theFormatCtx,
+                         const StString&        theFilePath) const {
+#ifdef ST_AV_NEWCODECPAR
+    FileKey aKey;
+    if(myCacheFolder.isEmpty()
+    || theFormatCtx == NULL
+    || (theFormatCtx->ctx_flags & AVFMTCTX_NOHEADER) != 0
+    || !readFileKey(theFilePath, aKey)) {
+        return false;
+    }
+
+    const StString aFolder = myCacheFolder + "probe";
+    if(!StFolder::isFolder(aFolder)
+    && !StFolder::createFolder(aFolder)) {
+        return false;
+    }
+
+    StProbeCacheHeader aHeader;
+    std::memcpy(aHeader.Magic, THE_CACHE_MAGIC, sizeof(THE_CACHE_MAGIC));
+    aHeader.Version     = THE_CACHE_VERSION;
+    aHeader.FileSize    = aKey.Size;
+    aHeader.ModTime     = aKey.ModTime;
+    aHeader.ContentHash = aKey.ContentHash;
+    aHeader.Duration    = theFormatCtx->duration;
+    aHeader.StartTime   = theFormatCtx->start_time;
+    aHeader.BitRate     = theFormatCtx->bit_rate;
+    aHeader.PathSize    = uint32_t(theFilePath.getSize());
+    aHeader.NbStreams   = uint32_t(theFormatCtx->nb_streams);
+
+    std::vector<StProbeCacheStream> aStreams(aHeader.NbStreams);
+    for(unsigned int aStreamId = 0; aStreamId < theFormatCtx->nb_streams; ++aStreamId) {
+        const AVStream*          aStream = theFormatCtx->streams[aStreamId];
+        const AVCodecParameters* aPar    = aStream->codecpar;
+        const AVCodecContext*    aCodecCtx = stAV::getCodecCtx(aStream);
+        StProbeCacheStream& aCached = aStreams[aStreamId];
+        std::memset(&aCached, 0, sizeof(aCached));
+        aCached.CodecType     = int32_t(aPar->codec_type);
+        aCached.CodecId       = int32_t(aPar->codec_id);
+        aCached.Format        = aPar->format;
+        aCached.Width         = aPar->width;
+        aCached.Height        = aPar->height;
+        aCached.SarNum        = aPar->sample_aspect_ratio.num;
+        aCached.SarDen        = aPar->sample_aspect_ratio.den;
+        aCached.VideoDelay    = aPar->video_delay;
+        aCached.SampleRate    = aPar->sample_rate;
+        aCached.Channels      = aPar->channels;
+        aCached.FrameSize     = aPar->frame_size;
+        aCached.Profile       = aPar->profile;
+        aCached.Level         = aPar->level;
+        aCached.AvgFpsNum     = aStream->avg_frame_rate.num;
+        aCached.AvgFpsDen     = aStream->avg_frame_rate.den;
+        aCached.RealFpsNum    = aStream->r_frame_rate.num;
+        aCached.RealFpsDen    = aStream->r_frame_rate.den;
+        aCached.TimeBaseNum   = aCodecCtx != NULL ? aCodecCtx->time_base.num : 0;
+        aCached.TimeBaseDen   = aCodecCtx != NULL ? aCodecCtx->time_base.den : 0;
+        aCached.ChannelLayout = aPar->channel_layout;
+        aCached.BitRate       = aPar->bit_rate;
+        aCached.StartTime     = aStream->start_time;
+        aCached.Duration      = aStream->duration;
+        aCached.NbFrames      = aStream->nb_frames;
+    }
+
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::WRITE, getCachePath(theFilePath))) {
+        return false;
+    }
+
+    bool isOk = aFile.write((const char* )&aHeader, sizeof(aHeader)) == sizeof(aHeader)
+             && aFile.write(theFilePath.toCString(), theFilePath.getSize()) == theFilePath.getSize();
+    if(isOk && !aStreams.empty()) {
+        const size_t aSize = aStreams.size() * sizeof(StProbeCacheStream);
+        isOk = aFile.write((const char* )&aStreams[0], aSize) == aSize;
+    }
+    aFile.closeFile();
+    return isOk;
+#else
+    (void )theFormatCtx;
+    (void )theFilePath;
+    return false;
+#endif
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StProbeCache_h_
+#define __StProbeCache_h_
+
+#include <StAV/stAV.h>
+#include <StStrings/StString.h>
+
+/**
+ * Persistent cache of media probing results.
+ * avformat_find_stream_info() reads and decodes the beginning of the file just to complete
+ * stream parameters (pixel/sample format, frame rate, duration) missing in container header.
+ * These parameters are stored into cache folder and restored on the next opening of the same file,
+ * so that only container header has to be parsed.
+ * Cache entries are validated by file size, modification time and hash of file beginning.
+ * Formats without header (like MPEG-TS) are always probed.
+ */
+class StProbeCache {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theCacheFolder folder to store cache entries (empty to disable cache)
+     */
+    ST_LOCAL StProbeCache(const StString& theCacheFolder);
+
+    /**
+     * Complete stream parameters of just opened context from cache.
+     * @param theFormatCtx format context opened by avformat_open_input()
+     * @param theFilePath  path to the local file
+     * @return TRUE if avformat_find_stream_info() can be skipped
+     */
+    ST_LOCAL bool restore(AVFormatContext* theFormatCtx,
+                          const StString&  theFilePath) const;
+
+    /**
+     * Store probing results into cache.
+     * Should be called only after probing with default limits,
+     * as results of capped probing (probesize, analyzeduration) might be incomplete.
+     * @param theFormatCtx format context after avformat_find_stream_info()
+     * @param theFilePath  path to the local file
+     */
+    ST_LOCAL bool store(const AVFormatContext* theFormatCtx,
+                        const StString&        theFilePath) const;
+
+        private:
+
+    /**
+     * Properties of the media file used to validate cache entry.
+     */
+    struct FileKey {
+        int64_t  Size;        //!< file size
+        int64_t  ModTime;     //!< file modification time
+        uint64_t ContentHash; //!< hash of file beginning
+    };
+
+    /**
+     * Compute properties of the media file.
+     */
+    ST_LOCAL static bool readFileKey(const StString& theFilePath,
+                                     FileKey&        theKey);
+
+    /**
+     * @return path to the cache entry
+     */
+    ST_LOCAL StString getCachePath(const StString& theFilePath) const;
+
+        private:
+
+    StString myCacheFolder; //!< cache folder
+
+};
+
+#endif // __StProbeCache_h_
@@ -0,0 +1,336 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StThumbnailGenerator.h"
+
+#include <StAV/StAVFrame.h>
+#include <StAV/StAVPacket.h>
+
+#include <cmath>
+
+namespace {
+
+    /**
+     * Minimal time interval between thumbnails in seconds.
+     */
+    static const double THE_MIN_INTERVAL_SEC = 2.0;
+
+    /**
+     * Maximum number of packets to read looking for decodable key frame.
+     */
+    static const int THE_MAX_PACKETS = 512;
+
+}
+
+int StThumbnailGenerator::avInterruptCallback(void* theGenerator) {
+    const StThumbnailGenerator* aGenerator = (const StThumbnailGenerator* )theGenerator;
+    return aGenerator != NULL && aGenerator->myToStop ? 1 : 0;
+}
+
+StThumbnailGenerator::StThumbnailGenerator(const StHandle<StProbeCache>& theProbeCache,
+                                           const size_t theMemLimit,
+                                           const int    theSizeX)
+: myProbeCache(theProbeCache),
+  myStreamId(-1),
+  myMemLimit(theMemLimit),
+  mySizeX(stMax(theSizeX, 16)),
+  myHoverSlot(size_t(-1)),
+  myToStop(false) {
+    //
+}
+
+StThumbnailGenerator::~StThumbnailGenerator() {
+    close();
+}
+
+void StThumbnailGenerator::open(const StString& theFilePath,
+                                const int       theStreamId) {
+    if(!myTask.isNull()
+    && myFilePath == theFilePath
+    && myStreamId == theStreamId) {
+        return;
+    }
+
+    close();
+    myFilePath  = theFilePath;
+    myStreamId  = theStreamId;
+    myToStop    = false;
+    myHoverSlot = size_t(-1);
+    myTask = new DecodeTask(this);
+    StThreadPool::getDefault().push(myTask, StThreadPool::Priority_Background);
+}
+
+void StThumbnailGenerator::close() {
+    if(!myTask.isNull()) {
+        myToStop = true;
+        myTask->wait();
+        myTask.nullify();
+    }
+
+    StMutexAuto aLock(myMutex);
+    mySlots.clear();
+    myFilePath.clear();
+    myStreamId = -1;
+}
+
+StHandle<StImage> StThumbnailGenerator::getPreview(const double thePosition) {
+    StMutexAuto aLock(myMutex);
+    if(mySlots.empty()) {
+        return StHandle<StImage>();
+    }
+
+    const size_t aNbSlots = mySlots.size();
+    const size_t aSlot    = stMin(size_t(stMax(thePosition, 0.0) * double(aNbSlots)), aNbSlots - 1);
+    if(mySlots[aSlot].isNull()) {
+        myHoverSlot = aSlot;
+    }
+
+    // show the nearest generated thumbnail until the exact one is ready
+    for(size_t aDist = 0; aDist < aNbSlots; ++aDist) {
+        if(aSlot >= aDist
+        && !mySlots[aSlot - aDist].isNull()) {
+            return mySlots[aSlot - aDist];
+        } else if(aSlot + aDist < aNbSlots
+               && !mySlots[aSlot + aDist].isNull()) {
+            return mySlots[aSlot + aDist];
+        }
+    }
+    return StHandle<StImage>();
+}
+
+StHandle<StImage> StThumbnailGenerator::decodeKeyframe(AVFormatContext* theFormatCtx,
+                                                       AVCodecContext*  theCodecCtx,
+                                                       AVFrame*         theFrame,
+                                                       SwsContext*&     theScaleCtx,
+                                                       const int64_t    theTimestamp,
+                                                       const int        theSizeY) {
+    if(av_seek_frame(theFormatCtx, myStreamId, theTimestamp, AVSEEK_FLAG_BACKWARD) < 0) {
+        return StHandle<StImage>();
+    }
+    avcodec_flush_buffers(theCodecCtx);
+
+    bool isDecoded = false;
+    StAVPacket aPacket;
+    for(int aPktIter = 0; aPktIter < THE_MAX_PACKETS && !isDecoded && !myToStop; ++aPktIter) {
+        const bool isEof = av_read_frame(theFormatCtx, aPacket.getAVpkt()) < 0;
+        if(!isEof
+        && aPacket.getStreamId() != myStreamId) {
+            aPacket.free();
+            continue;
+        }
+
+    #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
+        // on EOF, NULL packet initiates draining of delayed frames
+        avcodec_send_packet(theCodecCtx, isEof ? NULL : aPacket.getAVpkt());
+        isDecoded = avcodec_receive_frame(theCodecCtx, theFrame) == 0;
+    #else
+        int isFrameFinished = 0;
+        if(!isEof) {
+            avcodec_decode_video2(theCodecCtx, theFrame, &isFrameFinished, aPacket.getAVpkt());
+        }
+        isDecoded = isFrameFinished != 0;
+    #endif
+        aPacket.free();
+        if(isEof) {
+            break;
+        }
+    }
+    if(!isDecoded
+    || theFrame->width  <= 0
+    || theFrame->height <= 0) {
+        return StHandle<StImage>();
+    }
+
+    theScaleCtx = sws_getCachedContext(theScaleCtx,
+                                       theFrame->width, theFrame->height, (AVPixelFormat )theFrame->format,
+                                       mySizeX, theSizeY, stAV::PIX_FMT::RGB24,
+                                       SWS_FAST_BILINEAR, NULL, NULL, NULL);
+    if(theScaleCtx == NULL) {
+        return StHandle<StImage>();
+    }
+
+    StHandle<StImage> anImage = new StImage();
+    anImage->setColorModel(StImage::ImgColor_RGB);
+    anImage->setColorScale(StImage::ImgScale_Full);
+    if(!anImage->changePlane(0).initTrash(StImagePlane::ImgRGB, size_t(mySizeX), size_t(theSizeY))) {
+        return StHandle<StImage>();
+    }
+
+    uint8_t* aDstData[4]     = { anImage->changePlane(0).changeData(), NULL, NULL, NULL };
+    int      aDstLineSize[4] = { int(anImage->getPlane(0).getSizeRowBytes()), 0, 0, 0 };
+    sws_scale(theScaleCtx,
+              theFrame->data, theFrame->linesize,
+              0, theFrame->height,
+              aDstData, aDstLineSize);
+    return anImage;
+}
+
+void StThumbnailGenerator::decodeLoop() {
+    AVFormatContext* aFormatCtx = avformat_alloc_context();
+    aFormatCtx->interrupt_callback.callback = &StThumbnailGenerator::avInterruptCallback;
+    aFormatCtx->interrupt_callback.opaque   = this;
+    if(avformat_open_input(&aFormatCtx, myFilePath.toCString(), NULL, NULL) != 0) {
+        // context is freed on failure
+        return;
+    }
+
+    // the file has been just probed by player - reuse cached results
+    const bool isProbed = !myProbeCache.isNull()
+                       && myProbeCache->restore(aFormatCtx, myFilePath);
+    if((!isProbed && avformat_find_stream_info(aFormatCtx, NULL) < 0)
+    || myStreamId < 0
+    || (unsigned int )myStreamId >= aFormatCtx->nb_streams
+    || stAV::isAttachedPicture(aFormatCtx->streams[myStreamId])) {
+        avformat_close_input(&aFormatCtx);
+        return;
+    }
+
+    AVStream* aStream = aFormatCtx->streams[myStreamId];
+    double aDuration = aFormatCtx->duration != stAV::NOPTS_VALUE ? stAV::unitsToSeconds(aFormatCtx->duration) : 0.0;
+    if(aDuration <= 0.0
+    && aStream->duration != stAV::NOPTS_VALUE) {
+        aDuration = stAV::unitsToSeconds(aStream, aStream->duration);
+    }
+
+    // open dedicated single-threaded decoder
+    AVCodecContext* aCodecCtx = NULL;
+#ifdef ST_AV_NEWCODECPAR
+    const AVCodec* aCodec = avcodec_find_decoder(aStream->codecpar->codec_id);
+    aCodecCtx = avcodec_alloc_context3(NULL);
+    if(avcodec_parameters_to_context(aCodecCtx, aStream->codecpar) < 0) {
+        avcodec_free_context(&aCodecCtx);
+    }
+#else
+    AVCodecContext* aStreamCodecCtx = stAV::getCodecCtx(aStream);
+    AVCodec* aCodec = avcodec_find_decoder(aStreamCodecCtx->codec_id);
+    aCodecCtx = avcodec_alloc_context3(aCodec);
+    if(avcodec_copy_context(aCodecCtx, aStreamCodecCtx) < 0) {
+        avcodec_close(aCodecCtx);
+        av_free(aCodecCtx);
+        aCodecCtx = NULL;
+    }
+#endif
+    if(aCodecCtx != NULL) {
+        aCodecCtx->thread_count = 1;
+        aCodecCtx->skip_frame   = AVDISCARD_NONKEY;
+    }
+    if(aCodec     == NULL
+    || aCodecCtx  == NULL
+    || aDuration  <= 0.0
+    || aCodecCtx->width  <= 0
+    || aCodecCtx->height <= 0
+    || avcodec_open2(aCodecCtx, aCodec, NULL) < 0) {
+    #ifdef ST_AV_NEWCODECPAR
+        if(aCodecCtx != NULL) {
+            avcodec_free_context(&aCodecCtx);
+        }
+    #else
+        if(aCodecCtx != NULL) {
+            avcodec_close(aCodecCtx);
+            av_free(aCodecCtx);
+        }
+    #endif
+        avformat_close_input(&aFormatCtx);
+        return;
+    }
+
+    // thumbnail height respecting pixel aspect ratio
+    double aRatio = double(aCodecCtx->width) / double(aCodecCtx->height);
+    if(aStream->sample_aspect_ratio.num > 0
+    && aStream->sample_aspect_ratio.den > 0) {
+        aRatio *= av_q2d(aStream->sample_aspect_ratio);
+    } else if(aCodecCtx->sample_aspect_ratio.num > 0
+           && aCodecCtx->sample_aspect_ratio.den > 0) {
+        aRatio *= av_q2d(aCodecCtx->sample_aspect_ratio);
+    }
+    const int aSizeY = stMax(int(double(mySizeX) / aRatio + 0.5), 2);
+
+    // number of slots is limited by memory budget
+    const size_t aSlotBytes = size_t(mySizeX) * size_t(aSizeY) * 3;
+    const size_t aNbSlots   = stMax(stMin(size_t(aDuration / THE_MIN_INTERVAL_SEC), myMemLimit / aSlotBytes), size_t(1));
+    {
+        StMutexAuto aLock(myMutex);
+        mySlots.assign(aNbSlots, StHandle<StImage>());
+    }
+
+    // coarse-to-fine order - the whole strip becomes roughly covered quickly
+    std::vector<size_t> anOrder;
+    std::vector<bool>   isTried(aNbSlots, false);
+    {
+        std::vector<bool> isQueued(aNbSlots, false);
+        anOrder.reserve(aNbSlots);
+        size_t aStep = 1;
+        for(; aStep * 2 <= aNbSlots; aStep *= 2) {}
+        for(; aStep != 0; aStep /= 2) {
+            for(size_t aSlotIter = 0; aSlotIter < aNbSlots; aSlotIter += aStep) {
+                if(!isQueued[aSlotIter]) {
+                    isQueued[aSlotIter] = true;
+                    anOrder.push_back(aSlotIter);
+                }
+            }
+        }
+    }
+
+    // demuxer will skip packets of other streams
+    for(unsigned int aStreamIter = 0; aStreamIter < aFormatCtx->nb_streams; ++aStreamIter) {
+        aFormatCtx->streams[aStreamIter]->discard = int(aStreamIter) == myStreamId ? AVDISCARD_DEFAULT : AVDISCARD_ALL;
+    }
+
+    StAVFrame   aFrame;
+    SwsContext* aScaleCtx = NULL;
+    const double aStartSec = aStream->start_time != stAV::NOPTS_VALUE ? stAV::unitsToSeconds(aStream, aStream->start_time) : 0.0;
+    for(size_t anOrderIter = 0; !myToStop;) {
+        // slot under cursor has priority
+        size_t aSlot = size_t(-1);
+        {
+            StMutexAuto aLock(myMutex);
+            aSlot = myHoverSlot;
+            myHoverSlot = size_t(-1);
+        }
+        if(aSlot >= aNbSlots
+        || isTried[aSlot]) {
+            for(; anOrderIter < aNbSlots && isTried[anOrder[anOrderIter]]; ++anOrderIter) {}
+            if(anOrderIter >= aNbSlots) {
+                break;
+            }
+            aSlot = anOrder[anOrderIter];
+        }
+        isTried[aSlot] = true;
+
+        const double  aSlotSec  = aStartSec + (double(aSlot) + 0.5) * aDuration / double(aNbSlots);
+        const int64_t aSlotTs   = stAV::secondsToUnits(aStream, aSlotSec);
+        StHandle<StImage> anImage = decodeKeyframe(aFormatCtx, aCodecCtx, aFrame.Frame, aScaleCtx, aSlotTs, aSizeY);
+        aFrame.reset();
+        if(!anImage.isNull()) {
+            StMutexAuto aLock(myMutex);
+            mySlots[aSlot] = anImage;
+        }
+
+        // give way to playback threads
+        StThread::sleep(1);
+    }
+
+    sws_freeContext(aScaleCtx);
+#ifdef ST_AV_NEWCODECPAR
+    avcodec_free_context(&aCodecCtx);
+#else
+    avcodec_close(aCodecCtx);
+    av_free(aCodecCtx);
+#endif
+    avformat_close_input(&aFormatCtx);
+}
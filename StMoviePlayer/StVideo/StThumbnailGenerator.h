@@ -0,0 +1,141 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StThumbnailGenerator_h_
+#define __StThumbnailGenerator_h_
+
+#include <StAV/stAV.h>
+#include <StGLWidgets/StGLSeekBar.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThreadPool.h>
+
+#include "StProbeCache.h"
+
+#include <vector>
+
+// define StHandle template specialization
+class StThumbnailGenerator;
+ST_DEFINE_HANDLE(StThumbnailGenerator, StGLSeekBar::PreviewProvider);
+
+/**
+ * Background generator of low-resolution thumbnails for seeking bar.
+ * The file is opened by dedicated format context, only key frames are decoded
+ * (single-threaded decoder within background task of the thread pool
+ * executed by low-priority worker, so that playback is not affected)
+ * and downscaled into small RGB images.
+ * The duration is split into evenly distributed slots filled in coarse-to-fine order,
+ * number of slots is limited by memory budget;
+ * the slot under cursor is generated out of order.
+ */
+class StThumbnailGenerator : public StGLSeekBar::PreviewProvider {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theProbeCache probing results cache (the file is expected to be already probed by player)
+     * @param theMemLimit   memory limit for thumbnails in bytes
+     * @param theSizeX      thumbnail width in pixels
+     */
+    ST_LOCAL StThumbnailGenerator(const StHandle<StProbeCache>& theProbeCache,
+                                  const size_t theMemLimit = 16 * 1024 * 1024,
+                                  const int    theSizeX    = 256);
+
+    /**
+     * Destructor, stops generation.
+     */
+    ST_LOCAL virtual ~StThumbnailGenerator();
+
+    /**
+     * Start generating thumbnails for another file.
+     * Does nothing if the same file is already processed.
+     * @param theFilePath path to the media file
+     * @param theStreamId video stream within the file
+     */
+    ST_LOCAL void open(const StString& theFilePath,
+                       const int       theStreamId);
+
+    /**
+     * Stop generation and release thumbnails.
+     */
+    ST_LOCAL void close();
+
+    /**
+     * Return thumbnail nearest to specified position.
+     */
+    ST_LOCAL virtual StHandle<StImage> getPreview(const double thePosition) ST_ATTR_OVERRIDE;
+
+        private:
+
+    /**
+     * Background task performing generation loop.
+     */
+    class DecodeTask : public StThreadPool::Task {
+
+            public:
+
+        ST_LOCAL DecodeTask(StThumbnailGenerator* theGenerator) : myGenerator(theGenerator) {}
+
+        ST_LOCAL virtual void perform() {
+            myGenerator->decodeLoop();
+        }
+
+            private:
+
+        StThumbnailGenerator* myGenerator;
+
+    };
+
+    /**
+     * Interrupt callback for blocking FFmpeg I/O.
+     */
+    ST_LOCAL static int avInterruptCallback(void* theGenerator);
+
+    /**
+     * Generation loop.
+     */
+    ST_LOCAL void decodeLoop();
+
+    /**
+     * Decode the first key frame at or before specified timestamp.
+     */
+    ST_LOCAL StHandle<StImage> decodeKeyframe(AVFormatContext* theFormatCtx,
+                                              AVCodecContext*  theCodecCtx,
+                                              AVFrame*         theFrame,
+                                              SwsContext*&     theScaleCtx,
+                                              const int64_t    theTimestamp,
+                                              const int        theSizeY);
+
+        private:
+
+    StHandle<StProbeCache> myProbeCache; //!< probing results cache
+    StString               myFilePath;   //!< media file path
+    int                    myStreamId;   //!< video stream id
+    size_t                 myMemLimit;   //!< memory limit for thumbnails
+    int                    mySizeX;      //!< thumbnail width
+    StMutex                myMutex;      //!< lock for slots list and hovered slot
+    std::vector< StHandle<StImage> >
+                           mySlots;      //!< thumbnails
+    size_t                 myHoverSlot;  //!< slot requested by GUI to be generated first
+    StHandle<StThreadPool::Task>
+                           myTask;       //!< generation task
+    volatile bool          myToStop;     //!< flag to stop generation
+
+};
+
+#endif // __StThumbnailGenerator_h_
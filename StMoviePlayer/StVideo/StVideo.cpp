@@ -107,7 +107,8 @@ StVideo::StVideo(const std::string&                 theALDeviceName,
                  const StHandle<StTranslations>&    theLangMap,
                  const StHandle<StPlayList>&        thePlayList,
                  const StHandle<StGLTextureQueue>&  theTextureQueue,
-                 const StHandle<StSubQueue>&        theSubtitlesQueue)
+                 const StHandle<StSubQueue>&        theSubtitlesQueue,
+                 const StHandle<StMsgQueue>&        theMsgQueue)
 : myMimesVideo(ST_VIDEOS_MIME_STRING),
   myMimesAudio(ST_AUDIOS_MIME_STRING),
   myMimesSubs(ST_SUBTIT_MIME_STRING),
@@ -118,6 +119,7 @@ StVideo::StVideo(const std::string&                 theALDeviceName,
   mySlaveStream(-1),
   myPlayList(thePlayList),
   myTextureQueue(theTextureQueue),
+  mySaveQueue(new StImageSaveQueue(theMsgQueue, 2, 16)),
   myDuration(0.0),
   myPtsSeek(0.0),
   myToSeekBack(false),
@@ -143,6 +145,7 @@ StVideo::StVideo(const std::string&                 theALDeviceName,
     params.UseOpenJpeg     = new StBoolParam(false);
     params.activeAudio     = new StParamActiveStream();
     params.activeSubtitles = new StParamActiveStream();
+    params.ToPlayGapless   = new StBoolParam(false);
 
     myVideoMaster = new StVideoQueue(myTextureQueue);
     myVideoMaster->signals.onError.connect(this, &StVideo::doOnErrorRedirect);
@@ -156,6 +159,11 @@ StVideo::StVideo(const std::string&                 theALDeviceName,
     mySubtitles = new StSubtitleQueue(theSubtitlesQueue);
     mySubtitles->signals.onError.connect(this, &StVideo::doOnErrorRedirect);
 
+    mySyncStats  = new StVideoSyncStats();
+    myProbeCache = new StProbeCache(myResMgr->getCacheFolder());
+    myThumbnails = new StThumbnailGenerator(myProbeCache);
+    myPrefetch   = new StMediaPrefetch(myProbeCache);
+
     // launch working thread
     myThread = new StThread(threadFunction, (void* )this, "StVideo");
 }
@@ -267,6 +275,7 @@ StVideo::~StVideo() {
     myVideoMaster.nullify();
     aHangKiller.setDone();
     close(); // we must quit or flush video/audio threads before close()!
+    myPrefetch.nullify();
 }
 
 void StVideo::close() {
@@ -284,6 +293,9 @@ void StVideo::close() {
         #endif
         }
     }
+    if(!myThumbnails.isNull()) {
+        myThumbnails->close();
+    }
     myFileList.clear();
     myCtxList.clear();
     myFileIOList.clear();
@@ -343,12 +355,16 @@ bool StVideo::addFile(const StString& theFileToLoad,
     if(!anIOContext.isNull()) {
         aFormatCtx = avformat_alloc_context();
         aFormatCtx->pb = anIOContext->getAvioContext();
+    } else {
+        // take the file opened and probed in advance
+        aFormatCtx = myPrefetch->take(theFileToLoad);
     }
+    const bool isPrefetched = anIOContext.isNull() && aFormatCtx != NULL;
 
 #if(LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(53, 2, 0))
-    int avErrCode = avformat_open_input(&aFormatCtx, theFileToLoad.toCString(), NULL, NULL);
+    int avErrCode = isPrefetched ? 0 : avformat_open_input(&aFormatCtx, theFileToLoad.toCString(), NULL, NULL);
 #else
-    int avErrCode = av_open_input_file (&aFormatCtx, theFileToLoad.toCString(), NULL, 0, NULL);
+    int avErrCode = isPrefetched ? 0 : av_open_input_file (&aFormatCtx, theFileToLoad.toCString(), NULL, 0, NULL);
 #endif
     if(avErrCode != 0) {
         signals.onError(StString("FFmpeg: Couldn't open video file '") + theFileToLoad
@@ -363,11 +379,13 @@ bool StVideo::addFile(const StString& theFileToLoad,
         return false;
     }
 
-    // retrieve stream information
+    // retrieve stream information (unless it is known from the cache)
+    const bool isProbed = isPrefetched
+                      || (anIOContext.isNull() && myProbeCache->restore(aFormatCtx, theFileToLoad));
 #if(LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(53, 6, 0))
-    if(avformat_find_stream_info(aFormatCtx, NULL) < 0) {
+    if(!isProbed && avformat_find_stream_info(aFormatCtx, NULL) < 0) {
 #else
-    if(av_find_stream_info(aFormatCtx) < 0) {
+    if(!isProbed && av_find_stream_info(aFormatCtx) < 0) {
 #endif
         signals.onError(StString("FFmpeg: Couldn't find stream information in '") + theFileToLoad + "'");
         if(aFormatCtx != NULL) {
@@ -378,6 +396,8 @@ bool StVideo::addFile(const StString& theFileToLoad,
         #endif
         }
         return false;
+    } else if(!isProbed && anIOContext.isNull()) {
+        myProbeCache->store(aFormatCtx, theFileToLoad);
     }
 
 #ifdef ST_DEBUG
@@ -409,6 +429,22 @@ bool StVideo::addFile(const StString& theFileToLoad,
     const StString& aPrefLangAudio = myLangMap->getLanguageCode();
     int32_t anAudioStreamId = (int32_t )theInfo.AudioList->size();
 
+    if(!myVideoMaster->isInitialized()) {
+        // multi-view file with left and right views in separate video streams
+        int aNbVideoStreams = 0;
+        for(unsigned int aStreamId = 0; aStreamId < aFormatCtx->nb_streams; ++aStreamId) {
+            AVStream* aStream = aFormatCtx->streams[aStreamId];
+            if(stAV::getCodecType(aStream) == AVMEDIA_TYPE_VIDEO
+            && !stAV::isAttachedPicture(aStream)) {
+                ++aNbVideoStreams;
+            }
+        }
+        if(aNbVideoStreams >= 2) {
+            myVideoMaster->setNbDecoders(2);
+            myVideoSlave ->setNbDecoders(2);
+        }
+    }
+
     theInfo.Duration = stMax(theInfo.Duration, stAV::unitsToSeconds(aFormatCtx->duration));
     for(unsigned int aStreamId = 0; aStreamId < aFormatCtx->nb_streams; ++aStreamId) {
         AVStream*         aStream    = aFormatCtx->streams[aStreamId];
@@ -569,8 +605,11 @@ bool StVideo::addFile(const StString& theFileToLoad,
 bool StVideo::openSource(const StHandle<StFileNode>&     theNewSource,
                          const StHandle<StStereoParams>& theNewParams,
                          const StHandle<StFileNode>&     theNewPlsFile) {
-    // just for safe - close previously opened video
+    // just for safe - close previously opened video,
+    // but keep the last frame on the screen until the first frame of the new file is decoded
+    const bool hadVideo = myVideoMaster->isInitialized();
     close();
+    myTextureQueue->setConnectedStream(hadVideo);
 
     const bool toUseGpu      = params.UseGpu->getValue();
     const bool toUseOpenJpeg = params.UseOpenJpeg->getValue();
@@ -578,6 +617,10 @@ bool StVideo::openSource(const StHandle<StFileNode>&     theNewSource,
     myVideoSlave ->setUseGpu(toUseGpu);
     myVideoMaster->setUseOpenJpeg(toUseOpenJpeg);
     myVideoSlave ->setUseOpenJpeg(toUseOpenJpeg);
+    // left and right views stored in separate files are decoded simultaneously
+    const int aNbDecoders = theNewSource->size() > 1 ? 2 : 1;
+    myVideoMaster->setNbDecoders(aNbDecoders);
+    myVideoSlave ->setNbDecoders(aNbDecoders);
     myAudio->setTrackHeadOrientation(false);
 
     myFileInfoTmp = new StMovieInfo();
@@ -708,6 +751,62 @@ bool StVideo::openSource(const StHandle<StFileNode>&     theNewSource,
         myFileInfo = myFileInfoTmp;
     myEventMutex.unlock();
 
+    updateKeyframeIndex(myKeysMaster, myVideoMaster);
+    updateKeyframeIndex(myKeysSlave,  myVideoSlave);
+
+    const StString aThumbsPath = getLocalFilePath(myVideoMaster);
+    if(!aThumbsPath.isEmpty()) {
+        myThumbnails->open(aThumbsPath, myVideoMaster->getId());
+    }
+
+    if(!myVideoMaster->isInitialized()) {
+        myTextureQueue->setConnectedStream(false);
+    }
+    prefetchNext();
+    return true;
+}
+
+bool StVideo::getNextLocalPaths(std::vector<StString>& thePaths) const {
+    thePaths.clear();
+    const StHandle<StFileNode> aNext = myPlayList->getNextFile();
+    if(aNext.isNull()) {
+        return false;
+    }
+
+    if(aNext->isEmpty()) {
+        thePaths.push_back(aNext->getPath());
+    } else {
+        for(size_t aNodeIter = 0; aNodeIter < aNext->size(); ++aNodeIter) {
+            thePaths.push_back(aNext->getValue(aNodeIter)->getPath());
+        }
+    }
+    for(size_t aPathIter = 0; aPathIter < thePaths.size(); ++aPathIter) {
+        const StString& aPath = thePaths[aPathIter];
+        if(StFileNode::isContentProtocolPath(aPath)
+        || StFileNode::isRemoteProtocolPath(aPath)) {
+            thePaths.clear();
+            return false;
+        }
+    }
+    return !thePaths.empty();
+}
+
+void StVideo::prefetchNext() {
+    std::vector<StString> aPaths;
+    getNextLocalPaths(aPaths);
+    myPrefetch->request(aPaths);
+}
+
+bool StVideo::isNextPrefetched() const {
+    std::vector<StString> aPaths;
+    if(!getNextLocalPaths(aPaths)) {
+        return false;
+    }
+    for(size_t aPathIter = 0; aPathIter < aPaths.size(); ++aPathIter) {
+        if(!myPrefetch->isReady(aPaths[aPathIter])) {
+            return false;
+        }
+    }
     return true;
 }
 
@@ -749,16 +848,108 @@ void StVideo::doFlushSoft() {
     }
 }
 
+namespace {
+
+    /**
+     * Arguments for seeking format context within dedicated thread.
+     */
+    struct StSeekContextTask {
+        StVideo*         Video;
+        AVFormatContext* FormatCtx;
+        double           SeekPts;
+        bool             ToSeekBack;
+    };
+
+}
+
+SV_THREAD_FUNCTION StVideo::seekContextThread(void* theTask) {
+    StSeekContextTask* aTask = (StSeekContextTask* )theTask;
+    aTask->Video->doSeekContext(aTask->FormatCtx, aTask->SeekPts, aTask->ToSeekBack);
+    return SV_THREAD_RETURN 0;
+}
+
 void StVideo::doSeek(const double theSeekPts,
                      const bool   toSeekBack) {
-    for(size_t ctxId = 0; ctxId < myPlayCtxList.size(); ++ctxId) {
-        doSeekContext(myPlayCtxList[ctxId], theSeekPts, toSeekBack);
+    // seek contexts of separate files (e.g. left and right views) in parallel,
+    // the first context is handled by this thread
+    const size_t aNbCtx = myPlayCtxList.size();
+    std::vector<StSeekContextTask>    aTasks  (aNbCtx > 1 ? aNbCtx - 1 : 0);
+    std::vector< StHandle<StThread> > aThreads(aTasks.size());
+    for(size_t ctxId = 1; ctxId < aNbCtx; ++ctxId) {
+        StSeekContextTask& aTask = aTasks[ctxId - 1];
+        aTask.Video      = this;
+        aTask.FormatCtx  = myPlayCtxList[ctxId];
+        aTask.SeekPts    = theSeekPts;
+        aTask.ToSeekBack = toSeekBack;
+        aThreads[ctxId - 1] = new StThread(seekContextThread, (void* )&aTask, "StVideoSeek");
     }
+    if(aNbCtx != 0) {
+        doSeekContext(myPlayCtxList[0], theSeekPts, toSeekBack);
+    }
+    for(size_t aThreadIter = 0; aThreadIter < aThreads.size(); ++aThreadIter) {
+        aThreads[aThreadIter]->wait();
+    }
+
+    // decoders will skip frames between the key frame and the target
+    myVideoMaster->setSeekTarget(theSeekPts);
+    myVideoSlave ->setSeekTarget(theSeekPts);
+    myAudio      ->setSeekTarget(theSeekPts);
 
     // clear packet queues from obsolete data
     doFlushSoft();
 }
 
+StKeyframeIndex* StVideo::findKeyframeIndex(AVFormatContext* theFormatCtx,
+                                            const signed int theStreamId) const {
+    if(!myKeysMaster.isNull()
+    && myVideoMaster->isInContext(theFormatCtx)
+    && myVideoMaster->getId() == theStreamId) {
+        return myKeysMaster.access();
+    } else if(!myKeysSlave.isNull()
+           && myVideoSlave->isInContext(theFormatCtx)
+           && myVideoSlave->getId() == theStreamId) {
+        return myKeysSlave.access();
+    }
+    return NULL;
+}
+
+StString StVideo::getLocalFilePath(const StHandle<StVideoQueue>& theQueue) const {
+    if(!theQueue->isInitialized()
+    || theQueue->isAttachedPicture()) {
+        return StString();
+    }
+
+    for(size_t aCtxIter = 0; aCtxIter < myCtxList.size(); ++aCtxIter) {
+        if(!theQueue->isInContext(myCtxList[aCtxIter])) {
+            continue;
+        }
+
+        // reading remote stream second time would double the traffic
+        const StString& aFilePath = myFileList[aCtxIter];
+        if(StFileNode::isContentProtocolPath(aFilePath)
+        || StFileNode::isRemoteProtocolPath(aFilePath)) {
+            return StString();
+        }
+        return aFilePath;
+    }
+    return StString();
+}
+
+void StVideo::updateKeyframeIndex(StHandle<StKeyframeIndex>&    theIndex,
+                                  const StHandle<StVideoQueue>& theQueue) {
+    const StString aFilePath = getLocalFilePath(theQueue);
+    if(aFilePath.isEmpty()) {
+        theIndex.nullify();
+        return;
+    } else if(!theIndex.isNull()
+           && theIndex->getFilePath() == aFilePath
+           && theIndex->getStreamId() == theQueue->getId()) {
+        return;
+    }
+
+    theIndex = new StKeyframeIndex(aFilePath, theQueue->getId(), myResMgr->getCacheFolder());
+}
+
 void StVideo::doSeekContext(AVFormatContext* theFormatCtx,
                             const double     theSeekPts,
                             const bool       toSeekBack) {
@@ -811,6 +1002,16 @@ bool StVideo::doSeekStream(AVFormatContext* theFormatCtx,
     }
 
     int64_t aSeekTarget = stAV::secondsToUnits(aStream, theSeekPts + stAV::unitsToSeconds(aStream, aStream->start_time));
+
+    // jump directly to the key frame known from the index
+    int64_t aKeyTs = 0;
+    const StKeyframeIndex* anIndex = toSeekBack ? findKeyframeIndex(theFormatCtx, theStreamId) : NULL;
+    if(anIndex != NULL
+    && anIndex->findKeyframe(aSeekTarget, aKeyTs)
+    && av_seek_frame(theFormatCtx, theStreamId, aKeyTs, AVSEEK_FLAG_BACKWARD) >= 0) {
+        return true;
+    }
+
     bool isSeekDone = av_seek_frame(theFormatCtx, theStreamId, aSeekTarget, aFlags) >= 0;
 
     // try 10 more times in backward direction to work-around huge duration between key frames
@@ -1203,9 +1404,12 @@ void StVideo::packetsLoop() {
                 }
             }
             // If video is played - always wait until audio played
+            // (unless the next file is ready for gapless switching)
             if(myVideoMaster->isInitialized()) {
                 if(myAudio->isInitialized()) {
-                    while(myAudio->stalIsAudioPlaying()) {
+                    const bool toWaitAudio = !params.ToPlayGapless->getValue()
+                                          || !isNextPrefetched();
+                    while(toWaitAudio && myAudio->stalIsAudioPlaying()) {
                         StThread::sleep(10);
                         if(!areFlushed && (popPlayEvent(aSeekPts, toSeekBack) == ST_PLAYEVENT_NEXT)) {
                             isPendingPlayNext = true;
@@ -1271,34 +1475,38 @@ bool StVideo::saveSnapshotAs(StImageFile::ImageType theImgType) {
 
     pushPlayEvent(ST_PLAYEVENT_PAUSE);
 
-    StImage dataLeft;
+    StHandle<StImageFile> dataLeft = StImageFile::create();
+    if(dataLeft.isNull()) {
+        signals.onError(stCString("No any image library was found!"));
+        return false;
+    }
+
+    // take reference to displayed frame instead of copying it when possible
     StImage dataRight;
     int result = StGLTextureQueue::SNAPSHOT_NO_NEW;
     if(!myCurrParams->ToSwapLR) {
-        result = myTextureQueue->getSnapshot(&dataLeft, &dataRight, true);
+        result = myTextureQueue->getSnapshot(dataLeft.access(), &dataRight, true, true);
     } else {
-        result = myTextureQueue->getSnapshot(&dataRight, &dataLeft, true);
+        result = myTextureQueue->getSnapshot(&dataRight, dataLeft.access(), true, true);
     }
 
-    if(result == StGLTextureQueue::SNAPSHOT_NO_NEW || dataLeft.isNull()) {
+    if(result == StGLTextureQueue::SNAPSHOT_NO_NEW || dataLeft->isNull()) {
         stInfo(myLangMap->getValue(StMoviePlayerStrings::DIALOG_NO_SNAPSHOT));
         return false;
     }
-    StHandle<StImageFile> dataResult = StImageFile::create();
-    if(dataResult.isNull()) {
-        signals.onError(stCString("No any image library was found!"));
-        return false;
-    }
 
+    StHandle<StImageFile> dataResult = dataLeft;
     bool toSaveStereo = !dataRight.isNull();
-    if(toSaveStereo && dataResult->initSideBySide(dataLeft, dataRight,
-                                                  myCurrParams->getSeparationDx(),
-                                                  myCurrParams->getSeparationDy())) {
-        dataLeft.nullify();
-        dataRight.nullify();
-    } else {
-        dataResult->initWrapper(dataLeft);
+    if(toSaveStereo) {
+        StHandle<StImageFile> dataPair = StImageFile::create();
+        if(dataPair->initSideBySide(*dataLeft, dataRight,
+                                    myCurrParams->getSeparationDx(),
+                                    myCurrParams->getSeparationDy())) {
+            dataResult = dataPair;
+        }
     }
+    dataLeft.nullify();
+    dataRight.nullify();
 
     StOpenFileName anOpenInfo;
     anOpenInfo.Title = myLangMap->getValue(StMoviePlayerStrings::DIALOG_SAVE_SNAPSHOT);
@@ -1341,14 +1549,16 @@ bool StVideo::saveSnapshotAs(StImageFile::ImageType theImgType) {
         if(StFileNode::getExtension(fileToSave) != saveExt) {
             fileToSave += StString('.') + saveExt;
         }
-        ST_DEBUG_LOG("Save snapshot to the path '" + fileToSave + '\'');
-        if(!dataResult->save(fileToSave, theImgType,
-                             toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO)) {
-            // TODO (Kirill Gavrilov#7)
-            signals.onError(dataResult->getState());
+        // encode and write the file in background to keep demuxing
+        StImageSaveQueue::Job aJob;
+        aJob.Image   = dataResult;
+        aJob.Path    = fileToSave;
+        aJob.Type    = theImgType;
+        aJob.Format  = toSaveStereo ? StFormat_SideBySide_RL : StFormat_AUTO;
+        aJob.DoneMsg = myLangMap->getValue(StMoviePlayerStrings::DIALOG_SNAPSHOT_SAVED).format(fileToSave);
+        if(!mySaveQueue->push(aJob)) {
+            signals.onError(myLangMap->getValue(StMoviePlayerStrings::DIALOG_SNAPSHOT_BUSY));
             return false;
-        } else if(!dataResult->getState().isEmpty()) {
-            ST_DEBUG_LOG(dataResult->getState());
         }
         // TODO (Kirill Gavrilov#8) - update playlist
     }
@@ -1426,12 +1636,14 @@ void StVideo::mainLoop() {
 
         if(myVideoMaster->isInContext(myCtxList[0])) {
             myVideoTimer = new StVideoTimer(myVideoMaster, myAudio,
-                1000.0 * av_q2d(stAV::getCodecCtx(myCtxList[0]->streams[myVideoMaster->getId()])->time_base));
+                1000.0 * av_q2d(stAV::getCodecCtx(myCtxList[0]->streams[myVideoMaster->getId()])->time_base),
+                mySyncStats);
             myVideoTimer->setAudioDelay(myAudioDelayMSec);
             myVideoTimer->setBenchmark(myIsBenchmark);
         } else if(myCtxList.size() > 1 && myVideoMaster->isInContext(myCtxList[1])) {
             myVideoTimer = new StVideoTimer(myVideoMaster, myAudio,
-                1000.0 * av_q2d(stAV::getCodecCtx(myCtxList[1]->streams[myVideoMaster->getId()])->time_base));
+                1000.0 * av_q2d(stAV::getCodecCtx(myCtxList[1]->streams[myVideoMaster->getId()])->time_base),
+                mySyncStats);
             myVideoTimer->setAudioDelay(myAudioDelayMSec);
             myVideoTimer->setBenchmark(myIsBenchmark);
         } else {
@@ -1478,6 +1690,7 @@ void StVideo::mainLoop() {
                 isOpenSuccess = openSource(aFileToLoad, aFileParams, aPlsFile);
             }
             if(!isOpenSuccess) {
+                myTextureQueue->setConnectedStream(false);
                 waitEvent();
             } else {
                 break;
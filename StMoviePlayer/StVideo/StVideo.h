@@ -23,6 +23,10 @@
 #include "StAudioQueue.h"   // audio queue class
 #include "StSubtitleQueue.h"// subtitles queue class
 #include "StVideoTimer.h"   // video refresher class
+#include "StKeyframeIndex.h"
+#include "StMediaPrefetch.h"
+#include "StProbeCache.h"
+#include "StThumbnailGenerator.h"
 #include "StParamActiveStream.h"
 
 #include <StAV/StAVIOFileContext.h>
@@ -110,7 +114,8 @@ class StVideo {
                      const StHandle<StTranslations>&    theLangMap,
                      const StHandle<StPlayList>&        thePlayList,
                      const StHandle<StGLTextureQueue>&  theTextureQueue,
-                     const StHandle<StSubQueue>&        theSubtitlesQueue);
+                     const StHandle<StSubQueue>&        theSubtitlesQueue,
+                     const StHandle<StMsgQueue>&        theMsgQueue);
 
     /**
      * Destructor.
@@ -130,6 +135,13 @@ class StVideo {
         return mySubtitles->getSubtitlesQueue();
     }
 
+    /**
+     * @return thumbnails generator for seeking bar
+     */
+    ST_LOCAL const StHandle<StThumbnailGenerator>& getThumbnails() const {
+        return myThumbnails;
+    }
+
     /**
      * Ignore sync rules and perform swap when ready.
      */
@@ -139,6 +151,20 @@ class StVideo {
         return myTargetFps;
     }
 
+    /**
+     * Retrieve Audio to Video synchronization statistics of currently played file.
+     */
+    ST_LOCAL void getSyncStats(StVideoSyncStats::Summary& theSummary) const {
+        mySyncStats->getSummary(theSummary);
+    }
+
+    /**
+     * Retrieve audio playback statistics (underruns and decoded data buffered ahead of playback).
+     */
+    ST_LOCAL void getAudioStats(StAudioQueue::OutStats& theStats) const {
+        myAudio->getOutStats(theStats);
+    }
+
     /**
      * @return true if audio stream loaded
      */
@@ -200,6 +226,35 @@ class StVideo {
         pushPlayEvent(ST_PLAYEVENT_NEXT);
     }
 
+    /**
+     * Start saving every Nth decoded frame into image files (playback continues).
+     * @param thePathPrefix path prefix, frame number and extension will be appended
+     * @param theImgType    image type
+     * @param theStep       capture every Nth frame
+     */
+    ST_LOCAL void startCapture(const StString&              thePathPrefix,
+                               const StImageFile::ImageType theImgType,
+                               const int                    theStep) {
+        myVideoMaster->startCapture(mySaveQueue, thePathPrefix, theImgType, theStep);
+    }
+
+    /**
+     * Stop capturing frames.
+     * @param theNbCaptured number of captured frames
+     * @param theNbSkipped  number of frames skipped due to slow encoding
+     */
+    ST_LOCAL void stopCapture(size_t& theNbCaptured,
+                              size_t& theNbSkipped) {
+        myVideoMaster->stopCapture(theNbCaptured, theNbSkipped);
+    }
+
+    /**
+     * @return TRUE if frames capturing is active
+     */
+    ST_LOCAL bool isCapturing() const {
+        return myVideoMaster->isCapturing();
+    }
+
     /**
      * Switch audio device.
      */
@@ -266,6 +321,7 @@ class StVideo {
         StHandle<StBoolParam>         UseOpenJpeg;     //!< use OpenJPEG (libopenjpeg) instead of built-in jpeg2000 decoder
         StHandle<StBoolParam>         ToSearchSubs;    //!< automatically search for additional subtitles/audio track files nearby video file
         StHandle<StBoolParamNamed>    ToTrackHeadAudio;//!< enable/disable head-tracking for audio listener
+        StHandle<StBoolParam>         ToPlayGapless;   //!< switch to the pre-opened next file without waiting for the audio tail to be played
         StHandle<StFloat32Param>      SlideShowDelay;  //!< slideshow delay
         StHandle<StParamActiveStream> activeAudio;     //!< active Audio stream
         StHandle<StParamActiveStream> activeSubtitles; //!< active Subtitles stream
@@ -395,6 +451,46 @@ class StVideo {
                                 const signed int theStreamId,
                                 const double     theSeekPts,
                                 const bool       toSeekBack);
+
+    /**
+     * Thread function seeking one of format contexts in parallel with others.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION seekContextThread(void* theTask);
+
+    /**
+     * @return key frames index for specified stream or NULL
+     */
+    ST_LOCAL StKeyframeIndex* findKeyframeIndex(AVFormatContext* theFormatCtx,
+                                                const signed int theStreamId) const;
+
+    /**
+     * @return path to the local file played by specified video queue or empty string
+     */
+    ST_LOCAL StString getLocalFilePath(const StHandle<StVideoQueue>& theQueue) const;
+
+    /**
+     * (Re)create key frames index for the file played by specified video queue.
+     * Index is preserved when the same file is re-opened.
+     */
+    ST_LOCAL void updateKeyframeIndex(StHandle<StKeyframeIndex>&    theIndex,
+                                      const StHandle<StVideoQueue>& theQueue);
+
+    /**
+     * Fill the list of local files of the next playlist item.
+     * @return FALSE if next item is unknown or is not a local file
+     */
+    ST_LOCAL bool getNextLocalPaths(std::vector<StString>& thePaths) const;
+
+    /**
+     * Start opening the next playlist item in background.
+     */
+    ST_LOCAL void prefetchNext();
+
+    /**
+     * @return TRUE if the next playlist item has been already opened in background
+     */
+    ST_LOCAL bool isNextPrefetched() const;
+
     ST_LOCAL bool pushPacket(StHandle<StAVPacketQueue>& theAVPacketQueue,
                              StAVPacket& thePacket);
 
@@ -453,6 +549,11 @@ class StVideo {
     StHandle<StVideoQueue>        myVideoSlave;   //!< Slave  video decoding thread
     StHandle<StAudioQueue>        myAudio;        //!< audio decoding thread
     StHandle<StSubtitleQueue>     mySubtitles;    //!< subtitles decoding thread
+    StHandle<StKeyframeIndex>     myKeysMaster;   //!< key frames index of Master video stream
+    StHandle<StKeyframeIndex>     myKeysSlave;    //!< key frames index of Slave  video stream
+    StHandle<StThumbnailGenerator> myThumbnails;  //!< seeking bar thumbnails of Master video stream
+    StHandle<StMediaPrefetch>     myPrefetch;     //!< next playlist item opened in advance
+    StHandle<StProbeCache>        myProbeCache;   //!< persistent cache of probing results
     AVFormatContext*              mySlaveCtx;     //!< Slave video format context
     signed int                    mySlaveStream;  //!< Slave video stream id
 
@@ -463,6 +564,7 @@ class StVideo {
     StHandle<StStereoParams>      myCurrParams;   //!< parameters for active file node
     StHandle<StFileNode>          myCurrPlsFile;  //!< active playlist file node
     StHandle<StGLTextureQueue>    myTextureQueue; //!< decoded frames queue
+    StHandle<StImageSaveQueue>    mySaveQueue;    //!< queue encoding snapshots and captured frames in background
 
     StArrayList<StString>         myTracksExt;    //!< extra tracks extensions list
     StFolder                      myTracksFolder; //!< cached list of subtitles/audio tracks in the current folder
@@ -470,6 +572,7 @@ class StVideo {
                                   myFilesToDelete;//!< file nodes for removal
 
     StHandle<StVideoTimer>        myVideoTimer;   //!< video refresh timer (Audio -> Video sync)
+    StHandle<StVideoSyncStats>    mySyncStats;    //!< Audio -> Video sync statistics
     mutable StMutex               myEventMutex;   //!< lock for thread-safety
     double                        myDuration;     //!< active file duration in seconds
     double                        myPtsSeek;      //!< seeking target
@@ -61,17 +61,21 @@ DEFINE_GUID(DXVADDI_Intel_ModeH264_E, 0x604F8E68, 0x4951,0x4C54,0x88,0xFE,0xAB,0
 DEFINE_GUID(DXVA2_ModeVC1_D,          0x1b81beA3, 0xa0c7,0x11d3,0xb9,0x84,0x00,0xc0,0x4f,0x2e,0x73,0xc5);
 DEFINE_GUID(DXVA2_ModeVC1_D2010,      0x1b81beA4, 0xa0c7,0x11d3,0xb9,0x84,0x00,0xc0,0x4f,0x2e,0x73,0xc5);
 DEFINE_GUID(DXVA2_ModeHEVC_VLD_Main,  0x5b11d51b, 0x2f4c,0x4452,0xbc,0xc3,0x09,0xf2,0xa1,0x16,0x0c,0xc0);
+DEFINE_GUID(DXVA2_ModeHEVC_VLD_Main10,0x107af0e0, 0xef1a,0x4d19,0xab,0xa8,0x67,0xa1,0x63,0x07,0x3d,0x13);
 DEFINE_GUID(DXVA2_NoEncrypt,          0x1b81beD0, 0xa0c7,0x11d3,0xb9,0x84,0x00,0xc0,0x4f,0x2e,0x73,0xc5);
 DEFINE_GUID(GUID_NULL,                0x00000000, 0x0000,0x0000,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00);
 
 struct StDxva2Mode {
     const GUID* guid;
     AVCodecID   codec;
+    bool        is10bit; //!< mode decodes 10-bit profile into P010 surfaces
 
     StDxva2Mode(const GUID&     theGuid,
-                const AVCodecID theCodec)
+                const AVCodecID theCodec,
+                const bool      theIs10bit = false)
     : guid(&theGuid),
-      codec(theCodec) {}
+      codec(theCodec),
+      is10bit(theIs10bit) {}
 };
 
 struct StDxva2SurfaceInfo {
@@ -101,6 +105,7 @@ class StDxva2Context : public StHWAccelContext {
       mySurfInfos(NULL),
       myNbSurfaces(0),
       mySurfaceAge(0),
+      myIs10bit(false),
       myFrameTmp(NULL) {
         myD3dLib  .loadSimple("d3d9.dll");
         myDxva2Lib.loadSimple("dxva2.dll");
@@ -147,6 +152,7 @@ class StDxva2Context : public StHWAccelContext {
         av_freep(&mySurfInfos);
         myNbSurfaces = 0;
         mySurfaceAge = 0;
+        myIs10bit    = false;
 
         if(myDxvaDecoder != NULL) {
             myDxvaDecoder->Release();
@@ -174,6 +180,14 @@ class StDxva2Context : public StHWAccelContext {
 
         private:
 
+    /**
+     * Copy P010 surface into P010 frame.
+     */
+    bool retrieveFrameP010(StVideoQueue&          theVideo,
+                           AVFrame*               theFrame,
+                           IDirect3DSurface9*     theSurface,
+                           const D3DSURFACE_DESC& theSurfDesc);
+
     struct StDxva2SurfaceWrapper {
         StDxva2Context*       ctx;
         LPDIRECT3DSURFACE9    surface;
@@ -219,6 +233,7 @@ class StDxva2Context : public StHWAccelContext {
     StDxva2SurfaceInfo*          mySurfInfos;
     uint32_t                     myNbSurfaces;
     uint64_t                     mySurfaceAge;
+    bool                         myIs10bit;      //!< decoder outputs P010 surfaces
 
     StAVBufferPool               myPoolsTmp[3];
     AVFrame*                     myFrameTmp;
@@ -360,6 +375,7 @@ bool StDxva2Context::create(StVideoQueue& theVideo) {
     myDxvaModes.push_back(StDxva2Mode(DXVA2_ModeVC1_D,          theVideo.CodecIdWMV3));
     // HEVC/H.265
     myDxvaModes.push_back(StDxva2Mode(DXVA2_ModeHEVC_VLD_Main,  theVideo.CodecIdHEVC));
+    myDxvaModes.push_back(StDxva2Mode(DXVA2_ModeHEVC_VLD_Main10,theVideo.CodecIdHEVC, true));
     return true;
 }
 
@@ -425,6 +441,10 @@ bool StDxva2Context::retrieveFrame(StVideoQueue& theVideo,
     av_frame_unref(myFrameTmp);
     myFrameTmp->width  = theFrame->width;
     myFrameTmp->height = theFrame->height;
+    if(myIs10bit) {
+        return retrieveFrameP010(theVideo, theFrame, aSurface, aSurfDesc);
+    }
+
     //myFrameTmp->format = stAV::PIX_FMT::NV12;
     myFrameTmp->format = stAV::PIX_FMT::YUV420P;
     const int aHeightUV   = theFrame->height / 2;
@@ -494,6 +514,60 @@ bool StDxva2Context::retrieveFrame(StVideoQueue& theVideo,
     return true;
 }
 
+bool StDxva2Context::retrieveFrameP010(StVideoQueue&          theVideo,
+                                       AVFrame*               theFrame,
+                                       IDirect3DSurface9*     theSurface,
+                                       const D3DSURFACE_DESC& theSurfDesc) {
+    // P010 surface has the same layout as P010 frame (16-bit Y plane followed by interleaved 16-bit UV plane),
+    // so that planes are copied as is and uploaded to GPU without conversion
+    myFrameTmp->format = stAV::PIX_FMT::P010;
+    const int aHeightUV = theFrame->height / 2;
+    myFrameTmp->linesize[0] = (int )getAligned(theFrame->width * 2, 32);
+    myFrameTmp->linesize[1] = (int )getAligned(theFrame->width * 2, 32);
+
+    const int aBufSizeY  = myFrameTmp->linesize[0] * theFrame->height;
+    const int aBufSizeUV = myFrameTmp->linesize[1] * aHeightUV;
+    if(myPoolsTmp[0].init(aBufSizeY)
+    && myPoolsTmp[1].init(aBufSizeUV)) {
+        myFrameTmp->buf[0] = myPoolsTmp[0].getBuffer();
+        myFrameTmp->buf[1] = myPoolsTmp[1].getBuffer();
+        if(myFrameTmp->buf[0] == NULL
+        || myFrameTmp->buf[1] == NULL) {
+            ST_ERROR_LOG("StDxva2Context: unable to allocate P010 frame buffers");
+            return false;
+        }
+
+        myFrameTmp->data[0] = myFrameTmp->buf[0]->data;
+        myFrameTmp->data[1] = myFrameTmp->buf[1]->data;
+    } else if(av_frame_get_buffer(myFrameTmp, 32) < 0) {
+        ST_ERROR_LOG("StDxva2Context: unable to allocate P010 frame buffers");
+        return false;
+    }
+
+    D3DLOCKED_RECT aLockRect;
+    if(theSurface->LockRect(&aLockRect, NULL, D3DLOCK_READONLY) != D3D_OK) {
+        theVideo.signals.onError(stCString("StVideoQueue: Unable to lock DXVA2 surface"));
+        return false;
+    }
+
+    av_image_copy_plane(myFrameTmp->data[0], myFrameTmp->linesize[0],
+                        (const uint8_t* )aLockRect.pBits,
+                        aLockRect.Pitch, theFrame->width * 2, theFrame->height);
+    av_image_copy_plane(myFrameTmp->data[1], myFrameTmp->linesize[1],
+                        (const uint8_t* )aLockRect.pBits + aLockRect.Pitch * theSurfDesc.Height,
+                        aLockRect.Pitch, theFrame->width * 2, aHeightUV);
+    theSurface->UnlockRect();
+
+    if(av_frame_copy_props(myFrameTmp, theFrame) < 0) {
+        av_frame_unref(myFrameTmp);
+        return false;
+    }
+
+    av_frame_unref   (theFrame);
+    av_frame_move_ref(theFrame, myFrameTmp);
+    return true;
+}
+
 bool StDxva2Context::decoderCreate(StVideoQueue&   theVideo,
                                    AVCodecContext* theCodecCtx) {
     const StSignal<void (const StCString& )>& onError = theVideo.signals.onError;
@@ -508,12 +582,17 @@ bool StDxva2Context::decoderCreate(StVideoQueue&   theVideo,
         return false;
     }
 
+    // 10-bit HEVC is decoded into P010 surfaces by dedicated mode
+    const bool is10bit = theCodecCtx->codec_id == theVideo.CodecIdHEVC
+                      && theCodecCtx->profile  == FF_PROFILE_HEVC_MAIN_10;
+    const D3DFORMAT aSurfFormat = is10bit ? (D3DFORMAT )MKTAG('P','0','1','0') : (D3DFORMAT )MKTAG('N','V','1','2');
     GUID      aDeviceGuid      = GUID_NULL;
     D3DFORMAT aTargetD3dFormat = D3DFMT_UNKNOWN;
     for(std::vector<StDxva2Mode>::const_iterator aModeIter = myDxvaModes.begin();
         aModeIter != myDxvaModes.end(); ++aModeIter) {
         const StDxva2Mode& aMode = *aModeIter;
-        if(aMode.codec != theCodecCtx->codec_id) {
+        if(aMode.codec   != theCodecCtx->codec_id
+        || aMode.is10bit != is10bit) {
             continue;
         }
 
@@ -535,7 +614,7 @@ bool StDxva2Context::decoderCreate(StVideoQueue&   theVideo,
 
         for(uint32_t aTargetIter = 0; aTargetIter < aNbD3dTargets; ++aTargetIter) {
             const D3DFORMAT aD3dFormat = aD3dTargetList[aTargetIter];
-            if(aD3dFormat == MKTAG('N','V','1','2')) {
+            if(aD3dFormat == aSurfFormat) {
                 aTargetD3dFormat = aD3dFormat;
                 break;
             }
@@ -655,6 +734,7 @@ bool StDxva2Context::decoderCreate(StVideoQueue&   theVideo,
 
     myDecoderGuid   = aDeviceGuid;
     myDecoderConfig = aBestCfg;
+    myIs10bit       = is10bit;
 
     theCodecCtx->hwaccel_context = &myDxvaCtxAV;
     stMemZero(&myDxvaCtxAV, sizeof(myDxvaCtxAV));
@@ -20,12 +20,18 @@
 
 #include <StStrings/StStringStream.h>
 #include <StThreads/StThread.h>
+#include <StThreads/StThreadPool.h>
 
 #if (defined(_WIN64) || defined(__WIN64__))\
  || (defined(_LP64)  || defined(__LP64__))
     #define ST_USE64PTR
 #endif
 
+#if !defined(AV_CODEC_CAP_FRAME_THREADS) && defined(CODEC_CAP_FRAME_THREADS)
+    #define AV_CODEC_CAP_FRAME_THREADS CODEC_CAP_FRAME_THREADS
+    #define AV_CODEC_CAP_SLICE_THREADS CODEC_CAP_SLICE_THREADS
+#endif
+
 namespace {
 
 #if(LIBAVCODEC_VERSION_INT < AV_VERSION_INT(55, 0, 0))
@@ -164,12 +170,21 @@ StVideoQueue::StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
   myUseGpu(false),
   myIsGpuFailed(false),
   myUseOpenJpeg(false),
+  myNbDecoders(1),
+  myThreadsBudget(1),
+  myThreadsCount(1),
+  myThreadsType(0),
+  myThreadsAdapted(0),
+  myThreadsToApply(false),
+  myDecodeNbFrames(0),
   //
   myToRgbCtx(NULL),
   myToRgbPixFmt(stAV::PIX_FMT::NONE),
   myToRgbIsBroken(false),
   //
   myAvDiscard(AVDISCARD_DEFAULT),
+  mySeekTargetNext(-1.0),
+  mySeekTarget(-1.0),
   myFramePts(0.0),
   myPixelRatio(1.0f),
   myHParallax(0),
@@ -187,7 +202,12 @@ StVideoQueue::StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
   myStFormatByName(StFormat_AUTO),
   myStFormatInStream(StFormat_AUTO),
   myToStickPano360(false),
-  myToSwapJps(false) {
+  myToSwapJps(false),
+  myCaptureType(StImageFile::ST_TYPE_NONE),
+  myCaptureStep(1),
+  myCaptureFrame(0),
+  myCaptureNb(0),
+  myCaptureSkipped(0) {
 #ifdef ST_USE64PTR
     myFrame.Frame->opaque = (void* )stAV::NOPTS_VALUE;
 #else
@@ -289,13 +309,14 @@ bool StVideoQueue::initCodec(AVCodec*   theCodec,
     av_dict_set(&anOpts, "refcounted_frames", "1", 0);
 #endif
 
-    // attached pics are sparse, therefore we would not want to delay their decoding till EOF
-    int aNbThreads = theToUseGpu || isAttachedPicture()
-                   ? 1
-                   : StThread::countLogicalProcessors();
-    myCodecCtx->thread_count = aNbThreads;
+    chooseThreading(theCodec, theToUseGpu);
+    myCodecCtx->thread_count = myThreadsCount;
 #if(LIBAVCODEC_VERSION_INT < AV_VERSION_INT(52, 112, 0))
-    avcodec_thread_init(myCodecCtx, aNbThreads);
+    avcodec_thread_init(myCodecCtx, myThreadsCount);
+#elif defined(FF_THREAD_FRAME)
+    if(myThreadsType != 0) {
+        myCodecCtx->thread_type = myThreadsType;
+    }
 #endif
 
     // open codec
@@ -309,14 +330,149 @@ bool StVideoQueue::initCodec(AVCodec*   theCodec,
 
     myCodec = theCodec;
     fillCodecInfo(theCodec);
-    ST_DEBUG_LOG("FFmpeg: Setup AVcodec to use " + aNbThreads + " threads");
+    const StString aThreadsInfo = formatThreading();
+    {
+        StMutexAuto aLock(myMutexInfo);
+        myCodecStr += StString("\n[Threads] ") + aThreadsInfo;
+    }
+    StLogger::GetDefault().write(StString("FFmpeg: Setup '") + theCodec->name + "' decoder to use " + aThreadsInfo,
+                                 StLogger::ST_INFO);
     return true;
 }
 
+void StVideoQueue::chooseThreading(const AVCodec* theCodec,
+                                   const bool     theToUseGpu) {
+    myThreadsToApply = false;
+    myThreadsType    = 0;
+    myDecodeNbFrames = 0;
+    myDecodeTimer.stop();
+    if(theToUseGpu || isAttachedPicture()) {
+        // attached pics are sparse, therefore we would not want to delay their decoding till EOF
+        myThreadsBudget = 1;
+        myThreadsCount  = 1;
+        return;
+    }
+
+    myThreadsBudget = StThreadPool::getDefault().getCodecThreads(myNbDecoders);
+    if(myThreadsAdapted > 0) {
+        myThreadsCount = stMin(myThreadsAdapted, myThreadsBudget);
+    } else {
+        // frame threading delays output by the number of threads and holds a frame per thread,
+        // so that small frames are decoded by a few threads; adaptThreading() adds more if needed
+        const int aNbPixels = myCodecCtx->width * myCodecCtx->height;
+        const int aNbNeeded = aNbPixels <= 1280 * 720
+                            ? 2
+                            : (aNbPixels <= 1920 * 1080 ? 4 : myThreadsBudget);
+        myThreadsCount = stMin(aNbNeeded, myThreadsBudget);
+    }
+
+#if defined(FF_THREAD_FRAME) && defined(AV_CODEC_CAP_FRAME_THREADS)
+    const bool hasFrameThreads = (theCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) != 0;
+    const bool hasSliceThreads = (theCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) != 0;
+    bool isIntraOnly = false;
+#ifdef AV_CODEC_PROP_INTRA_ONLY
+    const AVCodecDescriptor* aCodecDesc = avcodec_descriptor_get(theCodec->id);
+    isIntraOnly = aCodecDesc != NULL
+              && (aCodecDesc->props & AV_CODEC_PROP_INTRA_ONLY) != 0;
+#endif
+    if(hasSliceThreads
+    && (isIntraOnly || !hasFrameThreads)) {
+        // slices of the same frame are decoded in parallel without extra latency
+        myThreadsType = FF_THREAD_SLICE;
+    } else if(hasFrameThreads) {
+        myThreadsType = FF_THREAD_FRAME;
+    } else {
+        myThreadsBudget = 1;
+        myThreadsCount  = 1;
+    }
+#else
+    (void )theCodec;
+#endif
+}
+
+void StVideoQueue::adaptThreading(const double theFrameDurSec) {
+    static const int    THE_WINDOW_FRAMES = 48;   // measurement window
+    static const double THE_LOAD_HIGH     = 0.75; // decoding takes too large part of frame interval
+    static const double THE_LOAD_LOW      = 0.25; // decoding has a large reserve
+    if(myThreadsBudget <= 1
+    || myThreadsToApply
+    || ++myDecodeNbFrames < THE_WINDOW_FRAMES) {
+        return;
+    }
+
+    const double aDecodeSec = myDecodeTimer.getElapsedTimeInSec() / double(myDecodeNbFrames);
+    myDecodeNbFrames = 0;
+    myDecodeTimer.stop();
+    if(theFrameDurSec <= 0.0
+    || theFrameDurSec >= 1.0) {
+        return;
+    }
+
+    const double aLoad = aDecodeSec / theFrameDurSec;
+    int aNbThreads = myThreadsCount;
+    if(aLoad > THE_LOAD_HIGH
+    && myThreadsCount < myThreadsBudget) {
+        aNbThreads = stMin(myThreadsCount * 2, myThreadsBudget);
+    }
+#ifdef FF_THREAD_FRAME
+    else if(aLoad < THE_LOAD_LOW
+         && myThreadsCount > 1
+         && myThreadsType == FF_THREAD_FRAME) {
+        aNbThreads = stMax(myThreadsCount / 2, 1);
+    }
+#endif
+    if(aNbThreads == myThreadsCount) {
+        return;
+    }
+
+    StLogger::GetDefault().write(StString("FFmpeg: decoding takes ") + (aDecodeSec * 1000.0) + " ms per "
+                               + (theFrameDurSec * 1000.0) + " ms frame interval, switching decoder from "
+                               + myThreadsCount + " to " + aNbThreads + " threads",
+                                 StLogger::ST_INFO);
+    myThreadsAdapted = aNbThreads;
+    myThreadsToApply = true;
+}
+
+bool StVideoQueue::applyThreading() {
+    myThreadsToApply = false;
+    AVCodec* aCodec = myCodec;
+    if(aCodec == NULL) {
+        return false;
+    }
+
+    if(!initCodec(aCodec, false)) {
+        signals.onError(stCString("FFmpeg: Could not re-open video codec"));
+        deinit();
+        return false;
+    }
+    return true;
+}
+
+StString StVideoQueue::formatThreading() const {
+    if(myThreadsCount <= 1) {
+        return stCString("single thread");
+    }
+
+    StString anInfo = StString() + myThreadsCount;
+#ifdef FF_THREAD_SLICE
+    anInfo += myThreadsType == FF_THREAD_SLICE ? " slice" : " frame";
+#endif
+    anInfo += StString(" threads (budget ") + myThreadsBudget;
+    if(myNbDecoders > 1) {
+        anInfo += StString(" per each of ") + myNbDecoders + " decoders";
+    }
+    if(myThreadsAdapted > 0) {
+        anInfo += ", adapted";
+    }
+    anInfo += ")";
+    return anInfo;
+}
+
 bool StVideoQueue::init(AVFormatContext*   theFormatCtx,
                         const unsigned int theStreamId,
                         const StString&    theFileName,
                         const StHandle<StStereoParams>& theNewParams) {
+    myThreadsAdapted = 0;
     if(!StAVPacketQueue::init(theFormatCtx, theStreamId, theFileName)) {
         signals.onError(stCString("FFmpeg: invalid stream"));
         deinit();
@@ -633,6 +789,29 @@ void StVideoQueue::prepareFrame(const StFormat theSrcFormat) {
         myDataAdp.changePlane(1).initWrapper(StImagePlane::ImgUV, myFrame.getPlane(1),
                                              size_t(aFrameSizeX / 2), size_t(aFrameSizeY / 2), myFrame.getLineSize(1));
 
+        myFrameBufRef->moveReferenceFrom(myFrame.Frame);
+        myDataAdp.setBufferCounter(myFrameBufRef);
+        return;
+    } else if(aPixFmt == stAV::PIX_FMT::P010
+           && aPixFmt != stAV::PIX_FMT::NONE
+           && myTextureQueue->getDeviceCaps().isSupportedFormat(StImagePlane::ImgGray16)
+           && myTextureQueue->getDeviceCaps().isSupportedFormat(StImagePlane::ImgUV16)) {
+        // P010 frames come from DXVA2 copy-back of 10-bit HEVC surfaces;
+        // upload 16-bit Y and interleaved UV planes as is (R16 + RG16), without conversion into RGB24
+        aDimsYUV.isFullScale = false;
+    #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(52, 29, 0))
+        if(myCodecCtx->color_range == AVCOL_RANGE_JPEG) {
+            aDimsYUV.isFullScale = true;
+        }
+    #endif
+        myDataAdp.setColorScale(aDimsYUV.isFullScale ? StImage::ImgScale_Nv10Full : StImage::ImgScale_Nv10Mpeg);
+        myDataAdp.setColorModel(StImage::ImgColor_YUV);
+        myDataAdp.setPixelRatio(getPixelRatio());
+        myDataAdp.changePlane(0).initWrapper(StImagePlane::ImgGray16, myFrame.getPlane(0),
+                                             size_t(aFrameSizeX), size_t(aFrameSizeY), myFrame.getLineSize(0));
+        myDataAdp.changePlane(1).initWrapper(StImagePlane::ImgUV16, myFrame.getPlane(1),
+                                             size_t(aFrameSizeX / 2), size_t(aFrameSizeY / 2), myFrame.getLineSize(1));
+
         myFrameBufRef->moveReferenceFrom(myFrame.Frame);
         myDataAdp.setBufferCounter(myFrameBufRef);
         return;
@@ -737,6 +916,7 @@ void StVideoQueue::pushFrame(const StImage&     theSrcDataLeft,
         theStParams->ViewingMode = StStereoParams::getViewSurfaceForPanoramaSource(aPano, true);
     }
 
+    captureFrame(theSrcDataLeft, theSrcDataRight);
     myTextureQueue->push(theSrcDataLeft, theSrcDataRight, theStParams, theSrcFormat, theCubemapFormat, theSrcPTS);
     myTextureQueue->setConnectedStream(true);
     if(myWasFlushed) {
@@ -746,6 +926,77 @@ void StVideoQueue::pushFrame(const StImage&     theSrcDataLeft,
     }
 }
 
+void StVideoQueue::startCapture(const StHandle<StImageSaveQueue>& theSaveQueue,
+                                const StString&                   thePathPrefix,
+                                const StImageFile::ImageType      theImgType,
+                                const int                         theStep) {
+    StMutexAuto aLock(myCaptureLock);
+    myCaptureQueue   = theSaveQueue;
+    myCapturePrefix  = thePathPrefix;
+    myCaptureType    = theImgType;
+    myCaptureStep    = stMax(theStep, 1);
+    myCaptureFrame   = 0;
+    myCaptureNb      = 0;
+    myCaptureSkipped = 0;
+}
+
+void StVideoQueue::stopCapture(size_t& theNbCaptured,
+                               size_t& theNbSkipped) {
+    StMutexAuto aLock(myCaptureLock);
+    myCaptureQueue.nullify();
+    theNbCaptured = myCaptureNb;
+    theNbSkipped  = myCaptureSkipped;
+}
+
+void StVideoQueue::captureFrame(const StImage& theSrcDataLeft,
+                                const StImage& theSrcDataRight) {
+    StMutexAuto aLock(myCaptureLock);
+    if(myCaptureQueue.isNull()
+    || theSrcDataLeft.isNull()) {
+        return;
+    }
+
+    const size_t aFrameId = myCaptureFrame++;
+    if(aFrameId % size_t(myCaptureStep) != 0) {
+        return;
+    }
+
+    // check capacity before copying the frame on decoding thread
+    if(myCaptureQueue->isFull()) {
+        ++myCaptureSkipped; // never block decoding - skip the frame from capturing instead
+        return;
+    }
+
+    StHandle<StImageFile> anImage = StImageFile::create();
+    if(anImage.isNull()) {
+        return;
+    }
+
+    StImageSaveQueue::Job aJob;
+    if(!theSrcDataRight.isNull()
+    && anImage->initSideBySide(theSrcDataLeft, theSrcDataRight, 0, 0)) {
+        aJob.Format = StFormat_SideBySide_RL;
+    } else if(!anImage->initCopy(theSrcDataLeft, false)) {
+        // decoded frame reference is moved (not shared) into texture queue, so the frame is copied
+        return;
+    }
+
+    char aNumBuff[32];
+    stsprintf(aNumBuff, sizeof(aNumBuff), "_%06u.", (unsigned int )aFrameId);
+    const bool isStereo = aJob.Format != StFormat_AUTO;
+    aJob.Image = anImage;
+    aJob.Type  = myCaptureType;
+    aJob.Path  = myCapturePrefix + aNumBuff
+               + (myCaptureType == StImageFile::ST_TYPE_PNG
+                ? (isStereo ? "pns" : "png")
+                : (isStereo ? "jps" : "jpg"));
+    if(myCaptureQueue->push(aJob)) {
+        ++myCaptureNb;
+    } else {
+        ++myCaptureSkipped; // never block decoding - skip the frame from capturing instead
+    }
+}
+
 void StVideoQueue::decodeLoop() {
     double anAverageDelaySec = 40.0;
     double aPrevPts  = 0.0;
@@ -768,7 +1019,10 @@ void StVideoQueue::decodeLoop() {
         switch(aPacket->getType()) {
             case StAVPacket::FLUSH_PACKET: {
                 // got the special FLUSH packet - flush FFMPEG codec buffers
-                if(myCodecCtx != NULL && myCodec != NULL) {
+                if(myThreadsToApply) {
+                    // nothing is lost by re-opening codec at this point
+                    applyThreading();
+                } else if(myCodecCtx != NULL && myCodec != NULL) {
                     avcodec_flush_buffers(myCodecCtx);
                 }
                 // now we clear our sttextures buffer
@@ -779,6 +1033,8 @@ void StVideoQueue::decodeLoop() {
                 myVideoClock = 0.0;
                 myToFlush    = false;
                 myWasFlushed = true;
+                mySeekTarget = mySeekTargetNext;
+                mySeekTargetNext = -1.0;
                 continue;
             }
             case StAVPacket::START_PACKET: {
@@ -788,12 +1044,15 @@ void StVideoQueue::decodeLoop() {
                 isStarted = true;
                 aPrevPts = 0.0;
                 myWasFlushed = true; // force displaying the first frame
+                mySeekTarget = -1.0;
                 continue;
             }
             case StAVPacket::DATA_PACKET: {
                 break;
             }
             case StAVPacket::LAST_PACKET: {
+                // the target is behind the last frame - show the tail instead
+                mySeekTarget = -1.0;
             #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
                 break; // redirect NULL packet to avcodec_send_packet()break;
             #else
@@ -837,6 +1096,24 @@ void StVideoQueue::decodeLoop() {
             //
         }
 
+    #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
+        if(myThreadsToApply
+        && aPacket->getType() == StAVPacket::DATA_PACKET
+        && aPacket->isKeyFrame()) {
+            // frame-threaded decoder holds several frames - drain them before re-opening codec
+            // with new threads number, so that decoding continues from key frame without losing pictures
+            StHandle<StAVPacket> aDrainPacket = new StAVPacket(aPacket->getSource(), StAVPacket::LAST_PACKET);
+            bool toSendDrain = true;
+            while(decodeFrame(aDrainPacket, toSendDrain, isStarted, aTagValue, anAverageDelaySec, aPrevPts)) {
+                //
+            }
+            if(!applyThreading()) {
+                aPacket.nullify();
+                continue;
+            }
+        }
+    #endif
+
         bool toSendPacket = true;
         for(;;) {
             if(!decodeFrame(aPacket, toSendPacket, isStarted, aTagValue, anAverageDelaySec, aPrevPts)) {
@@ -857,6 +1134,7 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
     (void )theToSendPacket;
     const bool toTryGpu = myUseGpu && !myIsGpuFailed;
 #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
+    myDecodeTimer.resume();
     if(theToSendPacket) {
         theToSendPacket = false;
         const int aRes = avcodec_send_packet(myCodecCtx, thePacket->getType() == StAVPacket::DATA_PACKET ? thePacket->getAVpkt() : NULL);
@@ -864,11 +1142,13 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
             // special case used by some hardware decoders - new packet cannot be sent until decoded frame is retrieved
             theToSendPacket = true;
         } else if(aRes < 0 && aRes != AVERROR_EOF) {
+            myDecodeTimer.pause();
             return false;
         }
     }
 
     const int aRes2 = avcodec_receive_frame(myCodecCtx, myFrame.Frame);
+    myDecodeTimer.pause();
     const bool isGpuUsed = myUseGpu && !myIsGpuFailed;
     if(isGpuUsed != toTryGpu) {
         if(!initCodec(myCodecAuto, isGpuUsed)) {
@@ -890,7 +1170,9 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
     toTryMoreFrames = true;
 #elif(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(52, 23, 0))
     int isFrameFinished = 0;
+    myDecodeTimer.resume();
     avcodec_decode_video2(myCodecCtx, myFrame.Frame, &isFrameFinished, thePacket->getAVpkt());
+    myDecodeTimer.pause();
     const bool isGpuUsed = myUseGpu && !myIsGpuFailed;
     if(isGpuUsed != toTryGpu) {
         if(!initCodec(myCodecAuto, isGpuUsed)) {
@@ -961,6 +1243,28 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
         theAverageDelaySec = aDelay;
     }
     thePrevPts = myFramePts;
+    adaptThreading(theAverageDelaySec);
+
+    // accurate seeking - decoding starts from the key frame before the target,
+    // so that frames up to the target should be decoded but not displayed
+    if(mySeekTarget >= 0.0) {
+        const double aFrameDur = theAverageDelaySec < 1.0 ? theAverageDelaySec : 0.04;
+        const AVDiscard aDiscardDef = myMaster.isNull() ? myAvDiscard : myMaster->myAvDiscard;
+        if(myFramePts + 0.5 * aFrameDur < mySeekTarget) {
+            // non-reference frames are not needed for decoding following frames,
+            // but keep them near the target to not miss the exact frame
+            const AVDiscard aDiscard = (mySeekTarget - myFramePts) > 4.0 * aFrameDur ? AVDISCARD_NONREF : aDiscardDef;
+            if(myCodecCtx->skip_frame != aDiscard) {
+                myCodecCtx->skip_frame = aDiscard;
+            }
+            myFrame.reset();
+            return toTryMoreFrames;
+        }
+
+        ST_DEBUG_LOG("Seek target " + mySeekTarget + " reached at " + myFramePts);
+        mySeekTarget = -1.0;
+        myCodecCtx->skip_frame = aDiscardDef;
+    }
 
     // do we need to skip frames or not
     static const double OVERR_LIMIT = 0.2;
@@ -23,6 +23,8 @@
 
 #include "StAVPacketQueue.h"
 #include <StAV/StAVImage.h>
+#include <StImage/StImageSaveQueue.h>
+#include <StThreads/StTimer.h>
 
 // forward declarations
 class StVideoQueue;
@@ -123,6 +125,15 @@ class StVideoQueue : public StAVPacketQueue {
         myIsGpuFailed = theIsGpuFailed;
     }
 
+    /**
+     * Setup the number of decoders to be active simultaneously (e.g. left and right views in separate streams),
+     * used to split concurrency budget of thread pool between codecs.
+     * Requires re-initialization to take effect!
+     */
+    ST_LOCAL void setNbDecoders(const int theNbDecoders) {
+        myNbDecoders = theNbDecoders;
+    }
+
     /**
      * Setup OpenJPEG usage. Requires re-initialization to take effect!
      */
@@ -168,6 +179,17 @@ class StVideoQueue : public StAVPacketQueue {
         myAudioDelayMSec = theDelayMSec;
     }
 
+    /**
+     * Set exact position for the following seek.
+     * Should be called before pushing FLUSH packet;
+     * frames decoded after flush up to this position will be skipped (not displayed),
+     * and non-reference frames will be discarded by decoder while the target is far ahead.
+     * @param theSeekPts target position in seconds or negative value to disable
+     */
+    ST_LOCAL void setSeekTarget(const double theSeekPts) {
+        mySeekTargetNext = theSeekPts;
+    }
+
     ST_LOCAL StCString getPixelFormatString() const {
         return stAV::PIX_FMT::getString(myCodecCtx->pix_fmt);
     }
@@ -209,6 +231,36 @@ class StVideoQueue : public StAVPacketQueue {
      */
     ST_LOCAL void setSwapJPS(bool theToSwap) { myToSwapJps = theToSwap; }
 
+    /**
+     * Start saving every Nth decoded frame into image files.
+     * Frames are copied and encoded by the save queue in background,
+     * and frames are skipped from capturing (not from playback) when the queue is full.
+     * @param theSaveQueue  queue encoding images
+     * @param thePathPrefix path prefix, frame number and extension will be appended
+     * @param theImgType    image type
+     * @param theStep       capture every Nth frame
+     */
+    ST_LOCAL void startCapture(const StHandle<StImageSaveQueue>& theSaveQueue,
+                               const StString&                   thePathPrefix,
+                               const StImageFile::ImageType      theImgType,
+                               const int                         theStep);
+
+    /**
+     * Stop capturing frames.
+     * @param theNbCaptured number of frames passed to the save queue
+     * @param theNbSkipped  number of frames skipped due to full save queue
+     */
+    ST_LOCAL void stopCapture(size_t& theNbCaptured,
+                              size_t& theNbSkipped);
+
+    /**
+     * @return TRUE if frames capturing is active
+     */
+    ST_LOCAL bool isCapturing() const {
+        StMutexAuto aLock(myCaptureLock);
+        return !myCaptureQueue.isNull();
+    }
+
     ST_LOCAL StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
                           const StHandle<StVideoQueue>&     theMaster = StHandle<StVideoQueue>());
     ST_LOCAL virtual ~StVideoQueue();
@@ -333,6 +385,32 @@ class StVideoQueue : public StAVPacketQueue {
     ST_LOCAL bool initCodec(AVCodec*   theCodec,
                             const bool theToUseGpu);
 
+    /**
+     * Select the number of codec threads and threading type (frame or slice)
+     * from the concurrency budget, codec capabilities, frame resolution
+     * and from the number of threads requested by runtime adaptation.
+     */
+    ST_LOCAL void chooseThreading(const AVCodec* theCodec,
+                                  const bool     theToUseGpu);
+
+    /**
+     * Count decoded frame and compare average decoding time with frame interval
+     * within measurement window to schedule more threads (decoder is too slow)
+     * or less threads (to reduce latency and memory usage of frame threading).
+     */
+    ST_LOCAL void adaptThreading(const double theFrameDurSec);
+
+    /**
+     * Re-open codec with the number of threads scheduled by adaptThreading().
+     * Frames buffered by decoder are lost, hence it should be called on flush or after draining decoder.
+     */
+    ST_LOCAL bool applyThreading();
+
+    /**
+     * @return threading description
+     */
+    ST_LOCAL StString formatThreading() const;
+
     /**
      * Select frame format from the list.
      */
@@ -379,6 +457,12 @@ private:
                             const StCubemap    theCubemapFormat,
                             const double       theSrcPTS);
 
+    /**
+     * Pass the frame to the save queue if capturing is active.
+     */
+    ST_LOCAL void captureFrame(const StImage& theSrcDataLeft,
+                               const StImage& theSrcDataRight);
+
         private:
 
     StHandle<StThread>         myThread;          //!< decoding loop thread
@@ -397,6 +481,14 @@ private:
     bool                       myUseGpu;          //!< activate decoding on GPU when possible
     bool                       myIsGpuFailed;     //!< flag indicating that GPU decoder can not handle input data
     bool                       myUseOpenJpeg;     //!< use OpenJPEG (libopenjpeg) instead of built-in jpeg2000 decoder
+    int                        myNbDecoders;      //!< number of simultaneously active decoders sharing concurrency budget
+    int                        myThreadsBudget;   //!< maximum number of codec threads for this decoder
+    int                        myThreadsCount;    //!< active number of codec threads
+    int                        myThreadsType;     //!< active codec threading type (FF_THREAD_FRAME or FF_THREAD_SLICE)
+    int                        myThreadsAdapted;  //!< number of threads requested by runtime adaptation, 0 if none
+    bool                       myThreadsToApply;  //!< flag to re-open codec with adapted number of threads
+    StTimer                    myDecodeTimer;     //!< cumulative time spent within codec calls in measurement window
+    int                        myDecodeNbFrames;  //!< number of decoded frames in measurement window
 
     StAVFrame                  myFrameRGB;        //!< frame, converted to RGB (soft)
     StImagePlane               myDataRGB;         //!< RGB buffer data (for swscale)
@@ -408,6 +500,8 @@ private:
     StHandle<StAVFrameCounter> myFrameBufRef;
     StImage                    myDataAdp;         //!< buffer data adaptor
     AVDiscard                  myAvDiscard;       //!< discard parameter (to skip or not frames)
+    volatile double            mySeekTargetNext;  //!< seek target to be applied on next FLUSH packet
+    double                     mySeekTarget;      //!< active seek target (negative when not seeking)
 
     double                     myFramePts;
     GLfloat                    myPixelRatio;      //!< pixel aspect ratio
@@ -433,6 +527,15 @@ private:
     volatile bool              myToStickPano360;  //!< stick to panorama 360 mode
     volatile bool              myToSwapJps;       //!< read JPS as Left/Right instead of Right/Left
 
+    mutable StMutex            myCaptureLock;     //!< lock for frames capturing parameters
+    StHandle<StImageSaveQueue> myCaptureQueue;    //!< save queue for captured frames, NULL when capturing is inactive
+    StString                   myCapturePrefix;   //!< path prefix for captured frames
+    StImageFile::ImageType     myCaptureType;     //!< image type for captured frames
+    int                        myCaptureStep;     //!< capture every Nth frame
+    size_t                     myCaptureFrame;    //!< number of frames passed since capturing start
+    size_t                     myCaptureNb;       //!< number of captured frames
+    size_t                     myCaptureSkipped;  //!< number of frames skipped due to full save queue
+
 };
 
 #endif // __StVideoQueue_h_
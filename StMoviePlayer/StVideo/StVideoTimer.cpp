@@ -20,6 +20,64 @@
 
 #include <StThreads/StThread.h>
 
+#include <algorithm>
+#include <cmath>
+
+StVideoSyncStats::StVideoSyncStats() {
+    reset();
+}
+
+void StVideoSyncStats::reset() {
+    StMutexAuto aLock(myMutex);
+    stMemZero(mySamples, sizeof(mySamples));
+    mySampleIter = 0;
+    myNbSamples  = 0;
+    myCounters   = Summary();
+}
+
+void StVideoSyncStats::addFrame(const double theErrorMs,
+                                const bool   theIsAudioClock) {
+    StMutexAuto aLock(myMutex);
+    mySamples[mySampleIter] = float(std::abs(theErrorMs));
+    mySampleIter = (mySampleIter + 1) % NB_SAMPLES;
+    myNbSamples  = stMin(myNbSamples + 1, NB_SAMPLES);
+    ++myCounters.NbShown;
+    myCounters.HasAudioClock = theIsAudioClock;
+}
+
+void StVideoSyncStats::addDropped(const unsigned int theNbFrames) {
+    StMutexAuto aLock(myMutex);
+    myCounters.NbDropped += theNbFrames;
+}
+
+void StVideoSyncStats::addRepeated() {
+    StMutexAuto aLock(myMutex);
+    ++myCounters.NbRepeated;
+}
+
+void StVideoSyncStats::setClockDrift(const double theDriftPpm) {
+    StMutexAuto aLock(myMutex);
+    myCounters.ClockDriftPpm = theDriftPpm;
+}
+
+void StVideoSyncStats::getSummary(StVideoSyncStats::Summary& theSummary) const {
+    float  aSorted[NB_SAMPLES];
+    size_t aNbSamples = 0;
+    myMutex.lock();
+    theSummary = myCounters;
+    aNbSamples = myNbSamples;
+    stMemCpy(aSorted, mySamples, sizeof(float) * aNbSamples);
+    myMutex.unlock();
+    if(aNbSamples == 0) {
+        return;
+    }
+
+    std::sort(aSorted, aSorted + aNbSamples);
+    theSummary.SyncErrorP50 = aSorted[(aNbSamples - 1) * 50 / 100];
+    theSummary.SyncErrorP95 = aSorted[(aNbSamples - 1) * 95 / 100];
+    theSummary.SyncErrorP99 = aSorted[(aNbSamples - 1) * 99 / 100];
+}
+
 /**
  * Thread just call mainLoop() function.
  */
@@ -29,11 +87,13 @@ static SV_THREAD_FUNCTION refreshThread(void* videoTimer) {
     return SV_THREAD_RETURN 0;
 }
 
-StVideoTimer::StVideoTimer(const StHandle<StVideoQueue>& theVideo,
-                           const StHandle<StAudioQueue>& theAudio,
-                           const double                  theDelayVVFixedMs)
+StVideoTimer::StVideoTimer(const StHandle<StVideoQueue>&     theVideo,
+                           const StHandle<StAudioQueue>&     theAudio,
+                           const double                      theDelayVVFixedMs,
+                           const StHandle<StVideoSyncStats>& theStats)
 : myVideo(theVideo),
   myAudio(theAudio),
+  myStats(theStats),
   myToQuitEv(false),
   myTimer(false),
   myTimerThrCurr(theDelayVVFixedMs),
@@ -52,8 +112,11 @@ StVideoTimer::StVideoTimer(const StHandle<StVideoQueue>& theVideo,
   mySpeedFastRev(1.0 / mySpeedFast),
   mySpeedSlow(0.4),
   mySpeedSlowRev(1.0 / mySpeedSlow),
+  myDriftClockSec(-1.0),
+  myDriftTimerMs(0.0),
   myIsBenchmark(false) {
     stMemZero(mySpeedDesc, sizeof(mySpeedDesc));
+    myStats->reset();
     myThread = new StThread(refreshThread, (void* )this, "StVideoTimer");
 }
 
@@ -71,13 +134,54 @@ bool StVideoTimer::isQuitMessage() {
             StThread::sleep(10);
             ///ST_DEBUG_LOG_AT("Not played!");
             myTimer.restart();
-            myTimerThrNext = 0.0;
+            myTimerThrNext  = 0.0;
+            myDriftClockSec = -1.0;
         } else {
             return false;
         }
     }
 }
 
+void StVideoTimer::waitDeadline(const double theDeadlineMs) {
+    for(;;) {
+        const double aRemainMs = theDeadlineMs - myTimer.getElapsedTimeInMilliSec();
+        if(aRemainMs <= 0.0) {
+            return;
+        } else if(aRemainMs > 2.0) {
+            // sleep until the last 1-2 milliseconds (system timer granularity);
+            // the wait is interrupted by quit request
+            if(myToQuitEv.wait(size_t(aRemainMs - 1.0))) {
+                return;
+            }
+        } else {
+            // just yield the thread close to the deadline
+            StThread::sleep(0);
+        }
+    }
+}
+
+void StVideoTimer::updateClockDrift(const double theClockSec) {
+    const double aTimerMs = myTimer.getElapsedTimeInMilliSec();
+    if(myDriftClockSec < 0.0) {
+        myDriftClockSec = theClockSec;
+        myDriftTimerMs  = aTimerMs;
+        return;
+    }
+
+    const double aClockDeltaMs = getDelayMsec(theClockSec, myDriftClockSec);
+    const double aTimerDeltaMs = aTimerMs - myDriftTimerMs;
+    if(std::abs(aClockDeltaMs - aTimerDeltaMs) > 500.0) {
+        // discontinuity (seeking or audio stall) - restart measurement
+        myDriftClockSec = theClockSec;
+        myDriftTimerMs  = aTimerMs;
+        return;
+    } else if(aTimerDeltaMs < 2000.0) {
+        return; // interval is too short for meaningful estimation
+    }
+
+    myStats->setClockDrift((aClockDeltaMs / aTimerDeltaMs - 1.0) * 1000000.0);
+}
+
 void StVideoTimer::mainLoop() {
     if(myVideo->getId() < 0) {
         return; // nothing to refresh
@@ -98,17 +202,33 @@ void StVideoTimer::mainLoop() {
                 StThread::sleep(1);
             }
 
+            // measure sync error of just swapped frame
+            if(myVideoPtsNextSec >= 0.0) {
+                const double anAudioPts = myAudio->getId() >= 0 ? myAudio->getPts() : -1.0;
+                if(anAudioPts > 0.0) {
+                    myStats->addFrame(getDelayMsec(myVideoPtsNextSec, anAudioPts) - double(myDelayVAFixed), true);
+                } else {
+                    myStats->addFrame(myTimer.getElapsedTimeInMilliSec() - myTimerThrNext, false);
+                }
+            }
+
             // store old timer threshold value to check diff at the end
             myTimerThrCurr = myTimerThrNext;
 
             // we got Video PTS for NEXT shown frame
             // so we need to compute time it will be shown
             myVideoPtsCurrSec = myVideoPtsNextSec; // just store for some conditions checks
-            while(!myVideo->getTextureQueue()->popPTSNext(myVideoPtsNextSec)) {
-                if(isQuitMessage()) {
-                    return;
+            if(!myVideo->getTextureQueue()->popPTSNext(myVideoPtsNextSec)) {
+                // decoder is late - current frame will be displayed longer
+                if(myVideoPtsCurrSec >= 0.0) {
+                    myStats->addRepeated();
                 }
-                StThread::sleep(1);
+                do {
+                    if(isQuitMessage()) {
+                        return;
+                    }
+                    StThread::sleep(1);
+                } while(!myVideo->getTextureQueue()->popPTSNext(myVideoPtsNextSec));
             }
 
             myDelayVV = getDelayMsec(myVideoPtsNextSec, myVideoPtsCurrSec);
@@ -124,6 +244,7 @@ void StVideoTimer::mainLoop() {
                     myAudioPtsCurrSec = myAudio->getPts();
                     if(myAudioPtsCurrSec > 0.0) {
                         myVideo->setAClock(myAudioPtsCurrSec);
+                        updateClockDrift(myAudioPtsCurrSec);
                         myDiffVA = getDelayMsec(myVideoPtsNextSec, myAudioPtsCurrSec);
                         myDelayTimer = myDiffVA - double(myDelayVAFixed);
                     }
@@ -141,6 +262,7 @@ void StVideoTimer::mainLoop() {
                 } else if(mySpeedFastSkip * myDelayTimer < myDelayVVAver) {
                     //myVideo->getTextureQueue()->drop(2, myVideoPtsNextSec);
                     myVideo->getTextureQueue()->drop(1, myVideoPtsNextSec);
+                    myStats->addDropped(1);
                     myDelayTimer = mySpeedFastRev * myDelayVVAver;
                 } else if(mySpeedFast * myDelayTimer < myDelayVVAver) {
                     myDelayTimer = mySpeedFastRev * myDelayVVAver;
@@ -156,6 +278,10 @@ void StVideoTimer::mainLoop() {
                 myTimerThrNext = 0.0;
             }
         }
-        StThread::sleep(1);
+        if(myToQuitEv.check() || myIsBenchmark) {
+            StThread::sleep(1);
+        } else {
+            waitDeadline(myTimerThrNext);
+        }
     }
 }
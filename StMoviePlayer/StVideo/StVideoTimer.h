@@ -22,6 +22,93 @@
 #include "StVideoQueue.h"   // video queue class
 #include "StAudioQueue.h"   // audio queue class
 
+/**
+ * Audio to Video synchronization statistics.
+ * Filled by StVideoTimer thread and read from GUI / Web UI threads.
+ */
+class StVideoSyncStats {
+
+        public:
+
+    /**
+     * Statistics summary.
+     */
+    struct Summary {
+        double       SyncErrorP50;  //!< median of absolute sync error (in milliseconds)
+        double       SyncErrorP95;  //!< 95th percentile of absolute sync error (in milliseconds)
+        double       SyncErrorP99;  //!< 99th percentile of absolute sync error (in milliseconds)
+        double       ClockDriftPpm; //!< drift of master clock relative to system timer (in ppm)
+        unsigned int NbShown;       //!< number of shown frames
+        unsigned int NbDropped;     //!< number of frames dropped to catch up master clock
+        unsigned int NbRepeated;    //!< number of frames displayed longer since next one was not decoded in time
+        bool         HasAudioClock; //!< indicates that sync error is measured against audio clock (scheduling lateness otherwise)
+
+        Summary()
+        : SyncErrorP50(0.0),
+          SyncErrorP95(0.0),
+          SyncErrorP99(0.0),
+          ClockDriftPpm(0.0),
+          NbShown(0),
+          NbDropped(0),
+          NbRepeated(0),
+          HasAudioClock(false) {}
+    };
+
+    /**
+     * Number of last frames to compute sync error percentiles.
+     */
+    static const size_t NB_SAMPLES = 512;
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_LOCAL StVideoSyncStats();
+
+    /**
+     * Reset statistics.
+     */
+    ST_LOCAL void reset();
+
+    /**
+     * Register shown frame.
+     * @param theErrorMs      sync error of the frame (in milliseconds)
+     * @param theIsAudioClock sync error is measured against audio clock
+     */
+    ST_LOCAL void addFrame(const double theErrorMs,
+                           const bool   theIsAudioClock);
+
+    /**
+     * Register dropped frames.
+     */
+    ST_LOCAL void addDropped(const unsigned int theNbFrames);
+
+    /**
+     * Register repeated frame.
+     */
+    ST_LOCAL void addRepeated();
+
+    /**
+     * Setup clock drift.
+     */
+    ST_LOCAL void setClockDrift(const double theDriftPpm);
+
+    /**
+     * Compute statistics summary.
+     */
+    ST_LOCAL void getSummary(StVideoSyncStats::Summary& theSummary) const;
+
+        private:
+
+    mutable StMutex myMutex;                //!< lock for thread-safety
+    float           mySamples[NB_SAMPLES];  //!< ring buffer of absolute sync errors (in milliseconds)
+    size_t          mySampleIter;           //!< position to write next sample
+    size_t          myNbSamples;            //!< number of filled samples
+    Summary         myCounters;             //!< counters (percentiles are computed on request)
+
+};
+
 /**
  * This class represents video refresher
  * and Audio to Video sync.
@@ -35,10 +122,12 @@ class StVideoTimer {
      * @param theVideo master video stream to trigger frame update
      * @param theAudio audio stream to synchronize from
      * @param theDelayVVFixedMs default video frame delay for streams with fixed FPS
+     * @param theStats   statistics to fill in (reset by constructor)
      */
-    ST_LOCAL StVideoTimer(const StHandle<StVideoQueue>& theVideo,
-                          const StHandle<StAudioQueue>& theAudio,
-                          const double                  theDelayVVFixedMs = 40.0);
+    ST_LOCAL StVideoTimer(const StHandle<StVideoQueue>&     theVideo,
+                          const StHandle<StAudioQueue>&     theAudio,
+                          const double                      theDelayVVFixedMs,
+                          const StHandle<StVideoSyncStats>& theStats);
 
     /**
      * Destructor.
@@ -98,11 +187,24 @@ class StVideoTimer {
 
     ST_LOCAL bool isQuitMessage();
 
+    /**
+     * Wait until specified timer value.
+     * Thread sleeps most of the time and yields only within the last milliseconds before deadline,
+     * so that frame is swapped close to its presentation time without polling the clock every millisecond.
+     */
+    ST_LOCAL void waitDeadline(const double theDeadlineMs);
+
+    /**
+     * Update master clock drift estimation.
+     */
+    ST_LOCAL void updateClockDrift(const double theClockSec);
+
         private:
 
     StHandle<StThread>     myThread;          //!< timer loop thread
     StHandle<StVideoQueue> myVideo;           //!< video queue to sync
     StHandle<StAudioQueue> myAudio;           //!< audio queue to sync from
+    StHandle<StVideoSyncStats> myStats;       //!< sync statistics
     mutable StMutex        myInfoLock;        //!< lock to retrieve information from other threads
     StCondition            myToQuitEv;        //!< thread exit event
     StTimer                myTimer;           //!< timer to refresh frames
@@ -127,6 +229,9 @@ class StVideoTimer {
     double                 mySpeedSlow;       //!< video playback too FAST, so we speed up to this value
     double                 mySpeedSlowRev;
 
+    double                 myDriftClockSec;   //!< master clock value at drift measurement start (in seconds)
+    double                 myDriftTimerMs;    //!< timer value at drift measurement start (in milliseconds)
+
     char                   mySpeedDesc[256];
 
     bool                   myIsBenchmark;
@@ -131,9 +131,13 @@ StOutAnaglyph::StOutAnaglyph(const StHandle<StResourceManager>& theResMgr,
   myYellowAnaglyph("Anaglyph Yellow"),
   myYellowDubiosAnaglyph("Anaglyph Yellow Dubios"),
   myGreenAnaglyph("Anaglyph Green"),
+  myToDrawDirect(true),
   myToCompressMem(myInstancesNb.increment() > 1),
   myIsBroken(false) {
     myStereoProgram = &mySimpleAnaglyph;
+    myMaskLeft[0] = true;
+    myMaskLeft[1] = false;
+    myMaskLeft[2] = false;
 
     // devices list
     StHandle<StOutDevice> aDevice = new StOutDevice();
@@ -335,6 +339,32 @@ void StOutAnaglyph::stglDraw() {
         return;
     }
 
+    if(myToDrawDirect) {
+        // simple anaglyph programs just pick color channels from each view,
+        // so that views can be drawn directly into window buffer through color write masks -
+        // clearing and blending respect the mask, thus result is the same as with compositing pass
+        if(myFrBuffer->isValid()) {
+            myFrBuffer->release(*myContext);
+        }
+        myContext->stglResizeViewport(aVPort);
+        myContext->core20fwd->glColorMask(myMaskLeft[0] ? GL_TRUE : GL_FALSE,
+                                          myMaskLeft[1] ? GL_TRUE : GL_FALSE,
+                                          myMaskLeft[2] ? GL_TRUE : GL_FALSE,
+                                          GL_TRUE);
+        StWindow::signals.onRedraw(ST_DRAW_LEFT);
+        myContext->core20fwd->glColorMask(myMaskLeft[0] ? GL_FALSE : GL_TRUE,
+                                          myMaskLeft[1] ? GL_FALSE : GL_TRUE,
+                                          myMaskLeft[2] ? GL_FALSE : GL_TRUE,
+                                          GL_TRUE);
+        StWindow::signals.onRedraw(ST_DRAW_RIGHT);
+        myContext->core20fwd->glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        myFPSControl.sleepToTarget(); // decrease FPS to target by thread sleeps
+        StWindow::stglSwap(ST_WIN_MASTER);
+        ++myFPSControl;
+        return;
+    }
+
     // resize FBO
     if(!myFrBuffer->initLazy(*myContext, aVPort.width(), aVPort.height(), StWindow::hasDepthBuffer())) {
         myMsgQueue->pushError(stCString("Anaglyph output - critical error:\nFrame Buffer Object resize failed!"));
@@ -388,6 +418,18 @@ void StOutAnaglyph::doSetShader(const int32_t ) {
         }
         case GLASSES_TYPE_GREEN: myStereoProgram = &myGreenAnaglyph; break;
     }
+
+    // channel-select programs can be replaced by direct drawing with color masks
+    myToDrawDirect = true;
+    if(myStereoProgram == &mySimpleAnaglyph) {
+        myMaskLeft[0] = true;  myMaskLeft[1] = false; myMaskLeft[2] = false;
+    } else if(myStereoProgram == &myYellowAnaglyph) {
+        myMaskLeft[0] = true;  myMaskLeft[1] = true;  myMaskLeft[2] = false;
+    } else if(myStereoProgram == &myGreenAnaglyph) {
+        myMaskLeft[0] = false; myMaskLeft[1] = true;  myMaskLeft[2] = false;
+    } else {
+        myToDrawDirect = false;
+    }
 }
 
 void StOutAnaglyph::doSwitchVSync(const int32_t theValue) {
@@ -174,6 +174,8 @@ class StOutAnaglyph : public StWindow {
     StStereoProgram_t               myGreenAnaglyph;
 
     StFPSControl                    myFPSControl;
+    bool                            myMaskLeft[3];          //!< color channels (RGB) taken from the left view by channel-select program
+    bool                            myToDrawDirect;         //!< draw views directly into window buffer through color write masks
     bool                            myToCompressMem;        //!< reduce memory usage
     bool                            myIsBroken;             //!< special flag for broke state - when FBO can not be allocated
 
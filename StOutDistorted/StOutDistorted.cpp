@@ -805,6 +805,15 @@ void StOutDistorted::setTrackOrientation(const bool theToTrack) {
     StWindow::setTrackOrientation(theToTrack);
 }
 
+bool StOutDistorted::toDrawContinuously() const {
+#if defined(ST_HAVE_OPENVR) || defined(ST_HAVE_LIBOVR)
+    if(myVrHmd != NULL) {
+        return true;
+    }
+#endif
+    return StWindow::toDrawContinuously();
+}
+
 StQuaternion<double> StOutDistorted::getDeviceOrientation() const {
     if(myVrTrackOrient
     && !myIsBroken) {
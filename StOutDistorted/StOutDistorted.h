@@ -151,6 +151,12 @@ class StOutDistorted : public StWindow {
      */
     ST_CPPEXPORT virtual void setTrackOrientation(const bool theToTrack) ST_ATTR_OVERRIDE;
 
+    /**
+     * Return TRUE if HMD is active (VR compositor expects new frames continuously)
+     * or orientation tracking has been activated.
+     */
+    ST_CPPEXPORT virtual bool toDrawContinuously() const ST_ATTR_OVERRIDE;
+
     /**
      * Get head orientation.
      */
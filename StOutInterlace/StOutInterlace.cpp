@@ -963,13 +963,6 @@ void StOutInterlace::stglDraw() {
     aBackStore.height() = aWinRect.height();
     convertRectToBacking(aBackStore, ST_WIN_MASTER);
 
-    // resize FBO
-    if(!myFrmBuffer->initLazy(*myContext, GL_RGBA8, aVPort.width(), aVPort.height(), StWindow::hasDepthBuffer())) {
-        myMsgQueue->pushError(stCString("Interlace output - critical error:\nFrame Buffer Object resize failed!"));
-        myIsBroken = true;
-        return;
-    }
-
     int aDevice = myDevice;
 
     // handle portrait orientation
@@ -1021,8 +1014,41 @@ void StOutInterlace::stglDraw() {
         isPixelReverse = !isPixelReverse;
     }
 
-    // initialize mask texture
+    // only every second row (column) of the RIGHT view reaches the screen,
+    // so that it is rendered at half resolution to halve fill rate and FBO memory;
+    // chessboard and mask texture need full-resolution view
     const bool toUseTexMask = params.ToUseMask->getValue();
+    GLsizei aFrmSizeX = aVPort.width();
+    GLsizei aFrmSizeY = aVPort.height();
+    bool isHalfRows = false, isHalfCols = false;
+    if(!toUseTexMask) {
+        switch(aDevice) {
+            case DEVICE_ROW_INTERLACED:
+            case DEVICE_ROW_INTERLACED_ED:
+                isHalfRows = true;
+                aFrmSizeY  = (aFrmSizeY + 1) / 2;
+                break;
+            case DEVICE_COL_INTERLACED:
+                isHalfCols = true;
+                aFrmSizeX  = (aFrmSizeX + 1) / 2;
+                break;
+        }
+    }
+
+    // resize FBO
+    if(!myFrmBuffer->initLazy(*myContext, GL_RGBA8, aFrmSizeX, aFrmSizeY, StWindow::hasDepthBuffer())) {
+        myMsgQueue->pushError(stCString("Interlace output - critical error:\nFrame Buffer Object resize failed!"));
+        myIsBroken = true;
+        return;
+    }
+
+    // each row (column) of half-resolution view should cover exactly two screen rows (columns)
+    const bool isHalfRes = isHalfRows || isHalfCols;
+    myFrmBuffer->getTextureColor()->setMinMagFilter(*myContext,
+                                                    isHalfRes ? GL_NEAREST : GL_LINEAR,
+                                                    isHalfRes ? GL_NEAREST : GL_LINEAR);
+
+    // initialize mask texture
     if(toUseTexMask) {
         if(!initTextureMask(aDevice, isPixelReverse, myFrmBuffer->getSizeX(), myFrmBuffer->getSizeY())) {
             return;
@@ -1032,8 +1058,12 @@ void StOutInterlace::stglDraw() {
     }
 
     // reduce viewport to avoid additional aliasing of narrow lines
-    GLfloat aDX = GLfloat(myFrmBuffer->getVPSizeX()) / GLfloat(myFrmBuffer->getSizeX());
-    GLfloat aDY = GLfloat(myFrmBuffer->getVPSizeY()) / GLfloat(myFrmBuffer->getSizeY());
+    GLfloat aDX = isHalfCols
+                ? GLfloat(aVPort.width())  * 0.5f / GLfloat(myFrmBuffer->getSizeX())
+                : GLfloat(myFrmBuffer->getVPSizeX()) / GLfloat(myFrmBuffer->getSizeX());
+    GLfloat aDY = isHalfRows
+                ? GLfloat(aVPort.height()) * 0.5f / GLfloat(myFrmBuffer->getSizeY())
+                : GLfloat(myFrmBuffer->getVPSizeY()) / GLfloat(myFrmBuffer->getSizeY());
     StArray<StGLVec2> aTCoords(4);
     aTCoords[0] = StGLVec2(aDX,  0.0f);
     aTCoords[1] = StGLVec2(aDX,  aDY);
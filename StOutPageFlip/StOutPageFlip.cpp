@@ -388,6 +388,11 @@ bool StOutPageFlip::isLostDevice() const {
     return myToResetDevice || StWindow::isLostDevice();
 }
 
+bool StOutPageFlip::toDrawContinuously() const {
+    return params.QuadBuffer->getValue() != QUADBUFFER_HARD_OPENGL
+        || StWindow::toDrawContinuously();
+}
+
 bool StOutPageFlip::setDevice(const StString& theDevice) {
     const int aPrevValue = myDevice;
     if(theDevice == "Shutters") {
@@ -79,6 +79,11 @@ class StOutPageFlip : public StWindow {
      */
     ST_CPPEXPORT virtual bool isLostDevice() const ST_ATTR_OVERRIDE;
 
+    /**
+     * Emulated and D3D page flipping require frames to be swapped continuously.
+     */
+    ST_CPPEXPORT virtual bool toDrawContinuously() const ST_ATTR_OVERRIDE;
+
     /**
      * Activate Device.
      */
@@ -45,15 +45,17 @@ namespace {
 
 }
 
-StAVIOContext::StAVIOContext()
+StAVIOContext::StAVIOContext(const int  theBufferSize,
+                             const bool theToWrite)
 : myAvioCtx(NULL) {
-    const int aBufferSize = 32768;
-    unsigned char* aBufferIO = (unsigned char* )av_malloc(aBufferSize + AV_INPUT_BUFFER_PADDING_SIZE);
-    myAvioCtx = avio_alloc_context(aBufferIO, aBufferSize, 0, this, readCallback, writeCallback, seekCallback);
+    unsigned char* aBufferIO = (unsigned char* )av_malloc(theBufferSize + AV_INPUT_BUFFER_PADDING_SIZE);
+    myAvioCtx = avio_alloc_context(aBufferIO, theBufferSize, theToWrite ? 1 : 0, this, readCallback, writeCallback, seekCallback);
 }
 
 StAVIOContext::~StAVIOContext() {
     if(myAvioCtx != NULL) {
+        // buffer might be re-allocated by libavformat, so release the current one
+        av_freep(&myAvioCtx->buffer);
         av_free(myAvioCtx);
     }
 }
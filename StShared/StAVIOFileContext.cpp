@@ -17,6 +17,13 @@ StAVIOFileContext::StAVIOFileContext()
     //
 }
 
+StAVIOFileContext::StAVIOFileContext(const int  theBufferSize,
+                                     const bool theToWrite)
+: StAVIOContext(theBufferSize, theToWrite),
+  myFile(NULL) {
+    //
+}
+
 StAVIOFileContext::~StAVIOFileContext() {
     close();
 }
@@ -38,6 +45,20 @@ bool StAVIOFileContext::openFromDescriptor(int theFD, const char* theMode) {
     return myFile != NULL;
 }
 
+bool StAVIOFileContext::open(const StString& thePath,
+                             const char*     theMode) {
+    close();
+#ifdef _WIN32
+    StStringUtfWide aPathWide, aModeWide;
+    aPathWide.fromUnicode(thePath);
+    aModeWide.fromUnicode(StString(theMode));
+    myFile = ::_wfopen(aPathWide.toCString(), aModeWide.toCString());
+#else
+    myFile =   ::fopen(thePath.toCString(), theMode);
+#endif
+    return myFile != NULL;
+}
+
 int StAVIOFileContext::read(uint8_t* theBuf,
                             int      theBufSize) {
 
@@ -23,7 +23,8 @@ StAVImage::StAVImage()
 : myImageFormat(NULL),
   myFormatCtx(NULL),
   myCodecCtx(NULL),
-  myCodec(NULL) {
+  myCodec(NULL),
+  myLowRes(0) {
     StAVImage::init();
     myImageFormat = av_find_input_format("image2");
 }
@@ -51,6 +52,8 @@ int StAVImage::getAVPixelFormat(const StImage& theImage) {
             size_t aDelimY = (theImage.getPlane(1).getSizeY() > 0) ? (aPlane0.getSizeY() / theImage.getPlane(1).getSizeY()) : 1;
             if(theImage.getPlane(1).getFormat() == StImagePlane::ImgUV) {
                 return stAV::PIX_FMT::NV12;
+            } else if(theImage.getPlane(1).getFormat() == StImagePlane::ImgUV16) {
+                return stAV::PIX_FMT::P010;
             } else if(aDelimX == 1 && aDelimY == 1) {
                 switch(theImage.getColorScale()) {
                     case StImage::ImgScale_Mpeg:
@@ -320,6 +323,11 @@ bool StAVImage::loadExtra(const StString& theFilePath,
         return false;
     }
 
+    if(myLowRes > 0
+    && myCodec->max_lowres > 0) {
+        myCodecCtx->lowres = stMin(myLowRes, int(myCodec->max_lowres));
+    }
+
     // open VIDEO codec
 #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(53, 8, 0))
     if(avcodec_open2(myCodecCtx, myCodec, NULL) < 0) {
@@ -655,6 +663,11 @@ bool StAVImage::save(const StString& theFilePath,
             return false;
     }
 
+    if(myLowRes > 0
+    && myCodec->max_lowres > 0) {
+        myCodecCtx->lowres = stMin(myLowRes, int(myCodec->max_lowres));
+    }
+
     // open VIDEO codec
 #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(53, 8, 0))
     if(avcodec_open2(myCodecCtx, myCodec, NULL) < 0) {
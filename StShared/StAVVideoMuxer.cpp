@@ -8,14 +8,211 @@
 
 #include <StAV/StAVVideoMuxer.h>
 
+#include <StAV/StAVIOFileContext.h>
 #include <StAV/StAVPacket.h>
 #include <StStrings/StLogger.h>
 #include <StFile/StFileNode.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StThread.h>
+#include <StThreads/StTimer.h>
 
+#include <deque>
 #include <vector>
 
+namespace {
+
+    /**
+     * Size of output buffer - large enough to write in big chunks.
+     */
+    static const int THE_OUTPUT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * Maximum number of read-ahead packets per input (limits overhead for tiny packets).
+     */
+    static const size_t THE_READ_AHEAD_MAX_PACKETS = 8192;
+
+    /**
+     * Interval for progress reports in seconds.
+     */
+    static const double THE_PROGRESS_INTERVAL = 0.5;
+
+}
+
+/**
+ * Read-ahead thread for single input.
+ * Packets of not muxed streams are dropped immediately,
+ * other ones are queued until the limit of queued data is reached.
+ */
+class StAVReadAheadQueue {
+
+        public:
+
+    /**
+     * Main constructor, starts the thread.
+     * @param theContext  opened input
+     * @param theStreams  mapping of input streams to output ones, (unsigned int )-1 for skipped streams
+     * @param theLimit    maximum size of queued packets in bytes
+     * @param theToCancel external cancellation flag
+     */
+    StAVReadAheadQueue(AVFormatContext*                 theContext,
+                       const StArrayList<unsigned int>& theStreams,
+                       const size_t                     theLimit,
+                       volatile bool&                   theToCancel)
+    : myContext(theContext),
+      myStreams(theStreams),
+      myLimit(theLimit),
+      myToCancel(theToCancel),
+      myEventData(false),
+      myEventSpace(true),
+      myQueuedBytes(0),
+      myBytesRead(0),
+      myIsEof(false),
+      myToStop(false) {
+        myThread = new StThread(threadFunction, this, "StAVReadAhead");
+    }
+
+    /**
+     * Destructor, stops the thread.
+     */
+    ~StAVReadAheadQueue() {
+        myToStop = true;
+        myEventSpace.set();
+        myThread->wait();
+        myThread.nullify();
+    }
+
+    /**
+     * Return the input.
+     */
+    AVFormatContext* getContext() const { return myContext; }
+
+    /**
+     * Return number of bytes read from the input.
+     */
+    int64_t getBytesRead() const {
+        StMutexAuto aLock(myMutex);
+        return myBytesRead;
+    }
+
+    /**
+     * Wait for the next packet.
+     * @return NULL if end of input has been reached
+     */
+    StHandle<StAVPacket> waitFront() {
+        for(;;) {
+            myMutex.lock();
+            if(!myQueue.empty()) {
+                StHandle<StAVPacket> aPacket = myQueue.front();
+                myMutex.unlock();
+                return aPacket;
+            } else if(myIsEof) {
+                myMutex.unlock();
+                return StHandle<StAVPacket>();
+            }
+            myEventData.reset();
+            myMutex.unlock();
+            myEventData.wait();
+        }
+    }
+
+    /**
+     * Remove the next packet from the queue (should be called after waitFront()).
+     */
+    StHandle<StAVPacket> pop() {
+        StMutexAuto aLock(myMutex);
+        StHandle<StAVPacket> aPacket = myQueue.front();
+        myQueue.pop_front();
+        myQueuedBytes -= size_t(aPacket->getSize());
+        myEventSpace.set();
+        return aPacket;
+    }
+
+        private:
+
+    /**
+     * Thread function.
+     */
+    static SV_THREAD_FUNCTION threadFunction(void* theQueue) {
+        ((StAVReadAheadQueue* )theQueue)->readLoop();
+        return SV_THREAD_RETURN 0;
+    }
+
+    /**
+     * Read packets until end of input or until stop request.
+     */
+    void readLoop() {
+        StAVPacket aPacket;
+        for(;;) {
+            // wait for free space
+            myMutex.lock();
+            if(myQueuedBytes >= myLimit
+            || myQueue.size() >= THE_READ_AHEAD_MAX_PACKETS) {
+                myEventSpace.reset();
+                myMutex.unlock();
+                if(!myToStop && !myToCancel) {
+                    myEventSpace.wait();
+                    continue;
+                }
+                myMutex.lock();
+            }
+            myMutex.unlock();
+            if(myToStop || myToCancel) {
+                break;
+            }
+
+            if(av_read_frame(myContext, aPacket.getAVpkt()) < 0) {
+                break;
+            }
+
+            const int aStreamId = aPacket.getStreamId();
+            if(aStreamId < 0
+            || size_t(aStreamId) >= myStreams.size()
+            || myStreams[aStreamId] == (unsigned int )-1) {
+                aPacket.free();
+                continue;
+            }
+
+            // copy constructor takes reference on data (or makes a copy for old libavcodec)
+            StHandle<StAVPacket> aCopy = new StAVPacket(aPacket);
+            aPacket.free();
+
+            const int64_t aPos = myContext->pb != NULL ? avio_tell(myContext->pb) : -1;
+            StMutexAuto aLock(myMutex);
+            myQueue.push_back(aCopy);
+            myQueuedBytes += size_t(aCopy->getSize());
+            if(aPos > 0) {
+                myBytesRead = aPos;
+            }
+            myEventData.set();
+        }
+
+        StMutexAuto aLock(myMutex);
+        myIsEof = true;
+        myEventData.set();
+    }
+
+        private:
+
+    AVFormatContext*                    myContext;     //!< input
+    StArrayList<unsigned int>           myStreams;     //!< streams mapping
+    size_t                              myLimit;       //!< limit of queued data in bytes
+    volatile bool&                      myToCancel;    //!< external cancellation flag
+    mutable StMutex                     myMutex;       //!< lock for the queue
+    StCondition                         myEventData;   //!< event signaling that queue is not empty (or end of input)
+    StCondition                         myEventSpace;  //!< event signaling that queue has free space
+    std::deque< StHandle<StAVPacket> >  myQueue;       //!< queued packets
+    size_t                              myQueuedBytes; //!< size of queued packets
+    int64_t                             myBytesRead;   //!< position within the input
+    bool                                myIsEof;       //!< end of input flag
+    volatile bool                       myToStop;      //!< stop request
+    StHandle<StThread>                  myThread;      //!< reading thread
+
+};
+
 StAVVideoMuxer::StAVVideoMuxer()
-: myStereoFormat(StFormat_Mono) {
+: myStereoFormat(StFormat_Mono),
+  myReadAheadLimit(64 * 1024 * 1024),
+  myToCancel(false) {
     //
 }
 
@@ -93,7 +290,8 @@ class StAVOutContext {
 
         public:
 
-    AVFormatContext* Context;
+    AVFormatContext*            Context;
+    StHandle<StAVIOFileContext> FileCtx; //!< custom output with large buffer
 
     /**
      * Empty constructor.
@@ -155,7 +353,9 @@ class StAVOutContext {
             return;
         }
 
-        if(!(Context->oformat->flags & AVFMT_NOFILE)) {
+        if(!FileCtx.isNull()) {
+            Context->pb = NULL; // released by FileCtx
+        } else if(!(Context->oformat->flags & AVFMT_NOFILE)) {
             avio_close(Context->pb);
         }
         avformat_free_context(Context);
@@ -224,6 +424,16 @@ bool StAVVideoMuxer::addStream(AVFormatContext* theContext,
     return true;
 }
 
+StAVVideoMuxer::Progress StAVVideoMuxer::getProgress() const {
+    StMutexAuto aLock(myProgressLock);
+    return myProgress;
+}
+
+void StAVVideoMuxer::setProgress(const Progress& theProgress) {
+    StMutexAuto aLock(myProgressLock);
+    myProgress = theProgress;
+}
+
 bool StAVVideoMuxer::save(const StString& theFile) {
     if(myCtxListSrc.isEmpty()
     || theFile.isEmpty()) {
@@ -292,11 +502,14 @@ bool StAVVideoMuxer::save(const StString& theFile) {
 
     av_dump_format(aCtxOut.Context, 0, theFile.toCString(), 1);
     if(!(aCtxOut.Context->oformat->flags & AVFMT_NOFILE)) {
-        const int aState = avio_open2(&aCtxOut.Context->pb, theFile.toCString(), AVIO_FLAG_WRITE, NULL, NULL);
-        if(aState < 0) {
-            signals.onError(StString("Could not open output file '") + theFile + "' (" + stAV::getAVErrorDescription(aState) + ")");
+        aCtxOut.FileCtx = new StAVIOFileContext(THE_OUTPUT_BUFFER_SIZE, true);
+        if(!aCtxOut.FileCtx->open(theFile, "wb")) {
+            aCtxOut.FileCtx.nullify();
+            signals.onError(StString("Could not open output file '") + theFile + "'");
             return false;
         }
+        aCtxOut.Context->pb     = aCtxOut.FileCtx->getAvioContext();
+        aCtxOut.Context->flags |= AVFMT_FLAG_CUSTOM_IO;
     }
 
     int aState = avformat_write_header(aCtxOut.Context, NULL);
@@ -305,51 +518,121 @@ bool StAVVideoMuxer::save(const StString& theFile) {
         return false;
     }
 
-    StAVPacket aPacket;
+    myToCancel = false;
+    setProgress(Progress());
+
+    int64_t aTotalSize = 0;
+    std::vector< StHandle<StAVReadAheadQueue> > aReaders;
+    for(size_t aCtxId = 0; aCtxId < aSrcCtxList.size(); ++aCtxId) {
+        const StRemuxContext& aCtxSrc = aSrcCtxList[aCtxId];
+        const int64_t aSize = aCtxSrc.Context->pb != NULL ? avio_size(aCtxSrc.Context->pb) : -1;
+        if(aSize > 0) {
+            aTotalSize += aSize;
+        }
+        aReaders.push_back(new StAVReadAheadQueue(aCtxSrc.Context, aCtxSrc.Streams, myReadAheadLimit, myToCancel));
+    }
+
+#ifdef ST_LIBAV_FORK
+    const AVRounding aRoundParams = AV_ROUND_NEAR_INF;
+#else
+    const AVRounding aRoundParams = AVRounding(AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX);
+#endif
+    const AVRational aTimeBaseQ = { 1, AV_TIME_BASE };
+
+    bool     isOk = true;
+    Progress aProgress;
+    StTimer  aTimer(true);
+    double   aLastReport = 0.0;
     for(;;) {
-        size_t aNbEmpty = 0;
-        for(size_t aCtxId = 0; aCtxId < aSrcCtxList.size(); ++aCtxId) {
-            StRemuxContext& aCtxSrc = aSrcCtxList[aCtxId];
-            if(!aCtxSrc.State) {
-                ++aNbEmpty;
-                continue;
-            }
+        if(myToCancel) {
+            isOk = false;
+            break;
+        }
 
-            if(av_read_frame(aCtxSrc.Context, aPacket.getAVpkt()) < 0) {
-                aCtxSrc.State = false;
-                ++aNbEmpty;
+        // take the packet with smallest DTS among all inputs
+        size_t  aNextCtxId = size_t(-1);
+        int64_t aNextDts   = 0;
+        for(size_t aCtxId = 0; aCtxId < aReaders.size(); ++aCtxId) {
+            StHandle<StAVPacket> aFront = aReaders[aCtxId]->waitFront();
+            if(aFront.isNull()) {
                 continue;
             }
 
-            unsigned int aStreamOutIndex = aCtxSrc.Streams[aPacket.getStreamId()];
-            if(aStreamOutIndex == (unsigned int )-1) {
-                continue;
+            AVStream* aStreamIn = aReaders[aCtxId]->getContext()->streams[aFront->getStreamId()];
+            const int64_t aDts = aFront->getDts() != stAV::NOPTS_VALUE
+                               ? av_rescale_q(aFront->getDts(), aStreamIn->time_base, aTimeBaseQ)
+                               : stAV::NOPTS_VALUE; // undefined DTS goes first
+            if(aNextCtxId == size_t(-1)
+            || aDts < aNextDts) {
+                aNextCtxId = aCtxId;
+                aNextDts   = aDts;
             }
+        }
+        if(aNextCtxId == size_t(-1)) {
+            break;
+        }
 
-            AVStream* aStreamIn  = aCtxSrc.Context->streams[aPacket.getStreamId()];
-            AVStream* aStreamOut = aCtxOut.Context->streams[aStreamOutIndex];
+        StHandle<StAVPacket> aPacket = aReaders[aNextCtxId]->pop();
+        const StRemuxContext& aCtxSrc = aSrcCtxList[aNextCtxId];
+        const unsigned int aStreamOutIndex = aCtxSrc.Streams[aPacket->getStreamId()];
+        AVStream* aStreamIn  = aCtxSrc.Context->streams[aPacket->getStreamId()];
+        AVStream* aStreamOut = aCtxOut.Context->streams[aStreamOutIndex];
 
-        #ifdef ST_LIBAV_FORK
-            const AVRounding aRoundParams = AV_ROUND_NEAR_INF;
-        #else
-            const AVRounding aRoundParams = AVRounding(AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX);
-        #endif
-            aPacket.getAVpkt()->pts      = av_rescale_q_rnd(aPacket.getPts(), aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
-            aPacket.getAVpkt()->dts      = av_rescale_q_rnd(aPacket.getDts(), aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
-            aPacket.getAVpkt()->duration = static_cast<int >(av_rescale_q(aPacket.getDuration(), aStreamIn->time_base, aStreamOut->time_base));
-            aPacket.getAVpkt()->pos      = -1;
-
-            aState = av_interleaved_write_frame(aCtxOut.Context, aPacket.getAVpkt());
-            if(aState < 0) {
-                signals.onError(StString("Error muxing packet (") + stAV::getAVErrorDescription(aState) + ").");
-                return false;
-            }
-            aPacket.free();
-        }
-        if(aNbEmpty == aSrcCtxList.size()) {
+        aPacket->getAVpkt()->stream_index = int(aStreamOutIndex);
+        aPacket->getAVpkt()->pts      = av_rescale_q_rnd(aPacket->getPts(), aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
+        aPacket->getAVpkt()->dts      = av_rescale_q_rnd(aPacket->getDts(), aStreamIn->time_base, aStreamOut->time_base, aRoundParams);
+        aPacket->getAVpkt()->duration = static_cast<int >(av_rescale_q(aPacket->getDuration(), aStreamIn->time_base, aStreamOut->time_base));
+        aPacket->getAVpkt()->pos      = -1;
+
+        aState = av_interleaved_write_frame(aCtxOut.Context, aPacket->getAVpkt());
+        if(aState < 0) {
+            signals.onError(StString("Error muxing packet (") + stAV::getAVErrorDescription(aState) + ").");
+            isOk = false;
             break;
         }
+        aPacket->free();
+        ++aProgress.NbPackets;
+
+        const double anElapsed = aTimer.getElapsedTimeInSec();
+        if(anElapsed - aLastReport >= THE_PROGRESS_INTERVAL) {
+            aLastReport = anElapsed;
+            aProgress.ElapsedSec = anElapsed;
+            aProgress.BytesRead  = 0;
+            for(size_t aCtxId = 0; aCtxId < aReaders.size(); ++aCtxId) {
+                aProgress.BytesRead += aReaders[aCtxId]->getBytesRead();
+            }
+            aProgress.BytesWritten = avio_tell(aCtxOut.Context->pb);
+            aProgress.Ratio = aTotalSize > 0 ? stMin(double(aProgress.BytesRead) / double(aTotalSize), 1.0) : 0.0;
+            setProgress(aProgress);
+            signals.onProgress(aProgress.Ratio);
+        }
     }
-    av_write_trailer(aCtxOut.Context);
-    return true;
+
+    aProgress.BytesRead = 0;
+    for(size_t aCtxId = 0; aCtxId < aReaders.size(); ++aCtxId) {
+        aProgress.BytesRead += aReaders[aCtxId]->getBytesRead();
+    }
+    aReaders.clear(); // stop reading threads
+
+    if(isOk) {
+        av_write_trailer(aCtxOut.Context);
+        aProgress.Ratio = 1.0;
+    }
+    aProgress.ElapsedSec   = aTimer.getElapsedTimeInSec();
+    aProgress.BytesWritten = aCtxOut.Context->pb != NULL ? avio_tell(aCtxOut.Context->pb) : 0;
+    setProgress(aProgress);
+    if(isOk) {
+        signals.onProgress(1.0);
+        ST_DEBUG_LOG("StAVVideoMuxer, '" + theFile + "' written in " + aProgress.ElapsedSec + " s ("
+                   + aProgress.getThroughput() + " MiB/s)");
+        return true;
+    }
+
+    if(myToCancel) {
+        // remove incomplete file
+        aCtxOut.Context->pb = NULL;
+        aCtxOut.FileCtx.nullify();
+        StFileNode::removeFile(theFile);
+    }
+    return false;
 }
@@ -15,6 +15,28 @@ const StString StDictEntry::ST_ARG_FALSE("false");
 
 namespace {
     static const StDictEntry THE_NULL_ENTRY;
+
+    /**
+     * Case-insensitive hash of the key, consistent with StString::isEqualsIgnoreCase().
+     */
+    inline size_t hashKey(const StString& theKey) {
+        return StHashIndex::hashBytes(theKey.toCString(), theKey.getSize(), true);
+    }
+
+    /**
+     * Functor comparing the key of dictionary entry.
+     */
+    struct StDictKeyEqual {
+        const StDictionary& Dict;
+        const StString&     Key;
+
+        StDictKeyEqual(const StDictionary& theDict,
+                       const StString&     theKey) : Dict(theDict), Key(theKey) {}
+
+        bool operator()(const size_t thePos) const {
+            return Dict.getFromIndex(thePos).getKey().isEqualsIgnoreCase(Key);
+        }
+    };
 }
 
 StDictEntry::StDictEntry() {}
@@ -103,34 +125,92 @@ void StDictionary::parseString(const StString& theString) {
     }
 }
 
-const StDictEntry& StDictionary::operator[](const StString& theKey) const {
+void StDictionary::updateIndex() {
+    if(isIndexed()) {
+        return;
+    }
+
+    // entries might be modified in arbitrary way through base class interface
+    myIndex.clear();
     for(size_t anId = 0; anId < size(); ++anId) {
-        const StDictEntry& anArg = getValue(anId);
-        if(anArg.getKey().isEqualsIgnoreCase(theKey)) {
-            return anArg;
-        }
+        myIndex.add(hashKey(getValue(anId).getKey()), anId);
     }
-    return THE_NULL_ENTRY;
 }
 
-StDictEntry& StDictionary::addChange(const StString& theKey) {
+size_t StDictionary::find(const StString& theKey) const {
+    if(isIndexed()) {
+        return myIndex.find(hashKey(theKey), StDictKeyEqual(*this, theKey));
+    }
+
+    // entries have been modified through base class interface - never update index from const method
     for(size_t anId = 0; anId < size(); ++anId) {
-        StDictEntry& anArg = changeValue(anId);
-        if(anArg.getKey().isEqualsIgnoreCase(theKey)) {
-            return anArg;
+        if(getValue(anId).getKey().isEqualsIgnoreCase(theKey)) {
+            return anId;
         }
     }
+    return size_t(-1);
+}
+
+const StDictEntry& StDictionary::operator[](const StString& theKey) const {
+    const size_t anId = find(theKey);
+    return anId != size_t(-1) ? getValue(anId) : THE_NULL_ENTRY;
+}
+
+StDictionary& StDictionary::add(const StDictEntry& theEntry) {
+    const bool wasIndexed = isIndexed();
+    StArrayList<StDictEntry>::add(theEntry);
+    if(wasIndexed) {
+        myIndex.add(hashKey(getLast().getKey()), size() - 1);
+    } else {
+        updateIndex();
+    }
+    return *this;
+}
+
+StDictionary& StDictionary::add(const size_t       theIndex,
+                                const StDictEntry& theEntry) {
+    if(theIndex < size()) {
+        myIndex.clear(); // key of existing entry is replaced
+    }
+    StArrayList<StDictEntry>::add(theIndex, theEntry);
+    updateIndex();
+    return *this;
+}
+
+StDictionary& StDictionary::remove(const size_t theIndex) {
+    StArrayList<StDictEntry>::remove(theIndex);
+    myIndex.clear(); // positions have been shifted
+    updateIndex();
+    return *this;
+}
+
+void StDictionary::sort() {
+    StArrayList<StDictEntry>::sort();
+    myIndex.clear();
+    updateIndex();
+}
+
+StArrayList<StDictEntry>& StDictionary::clear() {
+    myIndex.clear();
+    return StArrayList<StDictEntry>::clear();
+}
+
+StDictEntry& StDictionary::addChange(const StString& theKey) {
+    updateIndex();
+    const size_t anId = find(theKey);
+    if(anId != size_t(-1)) {
+        return changeValue(anId);
+    }
     add(StDictEntry(theKey));
     return changeLast();
 }
 
 void StDictionary::set(const StDictEntry& thePair) {
-    for(size_t anId = 0; anId < size(); ++anId) {
-        StDictEntry& anArg = changeValue(anId);
-        if(anArg.getKey().isEqualsIgnoreCase(thePair.getKey())) {
-            anArg.setValue(thePair.getValue());
-            return;
-        }
+    updateIndex();
+    const size_t anId = find(thePair.getKey());
+    if(anId != size_t(-1)) {
+        changeValue(anId).setValue(thePair.getValue());
+        return;
     }
     add(thePair);
 }
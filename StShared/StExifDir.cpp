@@ -7,6 +7,7 @@
  */
 
 #include <StImage/StExifDir.h>
+#include <StImage/StExifReader.h>
 #include <StImage/StExifTags.h>
 
 #include <StStrings/StDictionary.h>
@@ -254,18 +255,7 @@ bool StExifDir::readDirectory(StExifDir::List& theParentList,
                 break;
             }
             case TAG_USER_COMMENT: {
-                // custom block with undefined type
-                if(anEntry.getBytes() < 9) {
-                    break;
-                }
-
-                if(stAreEqual(anEntry.ValuePtr, "ASCII\0\0\0", 8)) {
-                    const char* aStart = (const char* )anEntry.ValuePtr + 8;
-                    UserComment = StString(aStart, anEntry.getBytes() - 8);
-                    ST_DEBUG_LOG("StExifDir, UserComment= '" + UserComment + "'");
-                } else if(stAreEqual(anEntry.ValuePtr, "UNICODE\0",   8)) {
-                    const char* aStart = (const char* )anEntry.ValuePtr + 8;
-                    UserComment = StString((stUtf16_t *)aStart, (anEntry.getBytes() - 8) / 2);
+                if(StExifReader::decodeUserComment(anEntry, UserComment)) {
                     ST_DEBUG_LOG("StExifDir, UserComment= '" + UserComment + "'");
                 }
                 break;
@@ -311,69 +301,10 @@ bool StExifDir::readDirectory(StExifDir::List& theParentList,
 
 void StExifDir::format(const StExifEntry& theEntry,
                        StString&          theString) const {
-    switch(theEntry.Format) {
-        case StExifEntry::FMT_BYTE: {
-            theString = get8u(theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_STRING: {
-            theString = StString((char *)theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_USHORT: {
-            theString = get16u(theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_ULONG: {
-            theString = get32u(theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_URATIONAL: {
-            const uint32_t aNum = get32u(theEntry.ValuePtr);
-            const uint32_t aDen = get32u(theEntry.ValuePtr + 4);
-            theString = StString() + aNum + "/" + aDen;
-            if(aDen != 0
-            && aDen != 1) {
-                theString += StString(" (") + (double(aNum) / double(aDen)) + ")";
-            }
-            return;
-        }
-        case StExifEntry::FMT_SBYTE: {
-            theString = get8s(theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_SSHORT: {
-            theString = get16s(theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_SLONG: {
-            theString = get32s(theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_SRATIONAL: {
-            const int32_t aNum = get32s(theEntry.ValuePtr);
-            const int32_t aDen = get32s(theEntry.ValuePtr + 4);
-            theString = StString() + aNum + "/" + aDen;
-            if(aDen != 0
-            && aDen != 1) {
-                theString += StString(" (") + (double(aNum) / double(aDen)) + ")";
-            }
-            return;
-        }
-        case StExifEntry::FMT_SINGLE: {
-            theString = StString(*(float* )theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_DOUBLE: {
-            theString = StString(*(double* )theEntry.ValuePtr);
-            return;
-        }
-        case StExifEntry::FMT_UNDEFINED:
-        default: {
-            theString = stCString("N/A");
-            return;
-        }
-    }
+    StExifReader::Entry anEntry;
+    anEntry.Value    = theEntry;
+    anEntry.IsFileBE = IsFileBE;
+    StExifReader::format(anEntry, theString);
 }
 
 inline void formatTag(const uint16_t theTag,
@@ -0,0 +1,364 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StImage/StExifReader.h>
+#include <StImage/StExifTags.h>
+
+namespace {
+
+    enum {
+        TAG_MAKE           = 0x010F,
+        TAG_EXIF_OFFSET    = 0x8769,
+        TAG_MAKER_NOTE     = 0x927C,
+        TAG_INTEROP_OFFSET = 0xA005,
+    };
+
+    /**
+     * Maximum number of scanned directories per request (protection from cyclic links).
+     */
+    static const int THE_MAX_DIRS = 64;
+
+    /**
+     * Compare NULL-terminated string within the buffer.
+     */
+    inline bool isMakerEqual(const stUByte_t* theMaker,
+                             const size_t     theMakerLen,
+                             const char*      thePrefix,
+                             const size_t     thePrefixLen,
+                             const bool       theToMatchAll) {
+        if(theMaker == NULL
+        || theMakerLen < thePrefixLen
+        || !stAreEqual(theMaker, thePrefix, thePrefixLen)) {
+            return false;
+        }
+        return !theToMatchAll
+             || theMakerLen == thePrefixLen
+             || theMaker[thePrefixLen] == '\0';
+    }
+
+    /**
+     * Read one entry in the EXIF directory, the same as StExifDir::readEntry().
+     */
+    inline bool readEntry(stUByte_t*   theEntryAddress,
+                          stUByte_t*   theOffsetBase,
+                          const size_t theExifLength,
+                          const bool   theIsFileBE,
+                          StExifEntry& theEntry) {
+        theEntry.Tag        = StAlienData::Get16u(theEntryAddress,     theIsFileBE);
+        theEntry.Format     = StAlienData::Get16u(theEntryAddress + 2, theIsFileBE);
+        theEntry.Components = StAlienData::Get32u(theEntryAddress + 4, theIsFileBE);
+        if((theEntry.Format - 1) >= StExifEntry::NUM_FORMATS
+        || (unsigned int )theEntry.Components > 0x10000) {
+            return false;
+        }
+
+        const size_t aBytesCount = theEntry.getBytes();
+        if(aBytesCount > 4) {
+            const size_t anOffsetVal = size_t(StAlienData::Get32u(theEntryAddress + 8, theIsFileBE));
+            if(anOffsetVal + aBytesCount > theExifLength) {
+                return false;
+            }
+            theEntry.ValuePtr = theOffsetBase + anOffsetVal;
+        } else {
+            theEntry.ValuePtr = theEntryAddress + 8;
+        }
+        return true;
+    }
+
+    /**
+     * Return TRUE for Maker Note directory types.
+     */
+    inline bool isMakerNote(const StExifDir::DirType theType) {
+        return theType == StExifDir::DType_MakerOlypm
+            || theType == StExifDir::DType_MakerCanon
+            || theType == StExifDir::DType_MakerFuji;
+    }
+
+}
+
+/**
+ * Search request.
+ */
+struct StExifReader::Query {
+    StExifReader::Entry Result;   //!< found entry
+    const stUByte_t*    Maker;    //!< camera maker string within the buffer
+    size_t              MakerLen; //!< camera maker string length
+    StExifDir::DirType  Type;     //!< directory filter
+    uint16_t            Tag;      //!< requested tag
+    int                 NbDirs;   //!< number of scanned directories
+
+    Query(const StExifDir::DirType theType,
+          const uint16_t           theTag)
+    : Maker(NULL),
+      MakerLen(0),
+      Type(theType),
+      Tag(theTag),
+      NbDirs(0) {}
+};
+
+StExifReader::StExifReader()
+: myData(NULL),
+  myLength(0),
+  myFirstOffset(0),
+  myType(StExifDir::DType_General),
+  myIsFileBE(true) {
+    //
+}
+
+bool StExifReader::init(stUByte_t*               theExifSection,
+                        const size_t             theLength,
+                        const StExifDir::DirType theType) {
+    myData = NULL;
+    if(theExifSection == NULL
+    || theLength < 10) {
+        return false;
+    }
+
+    if(stAreEqual(theExifSection, "II", 2)) {
+        myIsFileBE = false;
+    } else if(stAreEqual(theExifSection, "MM", 2)) {
+        myIsFileBE = true;
+    } else {
+        return false;
+    }
+
+    if(StAlienData::Get16u(theExifSection + 2, myIsFileBE) != 0x2A) {
+        return false;
+    }
+
+    const size_t aFirstOffset = size_t(StAlienData::Get32u(theExifSection + 4, myIsFileBE));
+    if(aFirstOffset < 8
+    || aFirstOffset >= theLength - 8 - 2) {
+        return false;
+    }
+
+    myData        = theExifSection;
+    myLength      = theLength;
+    myFirstOffset = aFirstOffset;
+    myType        = theType;
+    return true;
+}
+
+bool StExifReader::findEntry(const StExifDir::DirType theType,
+                             const uint16_t           theTag,
+                             StExifReader::Entry&     theEntry) const {
+    if(myData == NULL) {
+        return false;
+    }
+
+    Query aQuery(theType, theTag);
+    if(!scanDirectory(aQuery, myData + myFirstOffset, myData, myLength, myIsFileBE, myType, 0)) {
+        return false;
+    }
+    theEntry = aQuery.Result;
+    return true;
+}
+
+bool StExifReader::scanDirectory(Query&                   theQuery,
+                                 stUByte_t*               theDirStart,
+                                 stUByte_t*               theOffsetBase,
+                                 const size_t             theExifLength,
+                                 const bool               theIsFileBE,
+                                 const StExifDir::DirType theType,
+                                 const int                theNestingLevel) {
+    if(theNestingLevel > 4
+    || ++theQuery.NbDirs > THE_MAX_DIRS
+    || theDirStart + 2 > theOffsetBase + theExifLength) {
+        return false;
+    }
+
+    const uint16_t   anEntriesNb = StAlienData::Get16u(theDirStart, theIsFileBE);
+    const stUByte_t* aDirEnd     = theDirStart + 2 + size_t(anEntriesNb) * 12;
+    if(aDirEnd > theOffsetBase + theExifLength) {
+        return false;
+    }
+
+    // only directories with matching type and links to sub-directories are of interest
+    const bool toMatch = theType == theQuery.Type;
+    StExifEntry anEntry;
+    for(uint16_t anEntryId = 0; anEntryId < anEntriesNb; ++anEntryId) {
+        stUByte_t* anEntryAddress = theDirStart + 2 + size_t(anEntryId) * 12;
+        const uint16_t aTag = StAlienData::Get16u(anEntryAddress, theIsFileBE);
+        if(aTag != theQuery.Tag
+        && aTag != TAG_MAKE
+        && aTag != TAG_EXIF_OFFSET
+        && aTag != TAG_INTEROP_OFFSET
+        && aTag != TAG_MAKER_NOTE) {
+            continue;
+        } else if(!readEntry(anEntryAddress, theOffsetBase, theExifLength, theIsFileBE, anEntry)) {
+            continue;
+        }
+
+        if(toMatch
+        && anEntry.Tag == theQuery.Tag) {
+            theQuery.Result.Value    = anEntry;
+            theQuery.Result.IsFileBE = theIsFileBE;
+            return true;
+        }
+
+        switch(anEntry.Tag) {
+            case TAG_MAKE: {
+                if(anEntry.Format == StExifEntry::FMT_STRING) {
+                    theQuery.Maker    = anEntry.ValuePtr;
+                    theQuery.MakerLen = anEntry.getBytes();
+                }
+                break;
+            }
+            case TAG_EXIF_OFFSET:
+            case TAG_INTEROP_OFFSET: {
+                stUByte_t* aSubdirStart = theOffsetBase + size_t(StAlienData::Get32u(anEntry.ValuePtr, theIsFileBE));
+                if(aSubdirStart >= theOffsetBase
+                && aSubdirStart <= theOffsetBase + theExifLength
+                && scanDirectory(theQuery, aSubdirStart, theOffsetBase, theExifLength,
+                                 theIsFileBE, StExifDir::DType_General, theNestingLevel + 1)) {
+                    return true;
+                }
+                break;
+            }
+            case TAG_MAKER_NOTE: {
+                if(!isMakerNote(theQuery.Type)) {
+                    break;
+                }
+
+                // the same rules as within StExifDir::readDirectory()
+                stUByte_t*         aSubdirStart  = anEntry.ValuePtr;
+                stUByte_t*         anOffsetBase  = theOffsetBase;
+                size_t             anOffsetLimit = theExifLength;
+                bool               anIsFileBE    = theIsFileBE;
+                StExifDir::DirType aSubType      = StExifDir::DType_General;
+                if(isMakerEqual(theQuery.Maker, theQuery.MakerLen, "FUJIFILM", 8, true)) {
+                    anIsFileBE = false;
+                    aSubType   = StExifDir::DType_MakerFuji;
+                    if(anEntry.getBytes() >= 10
+                    && stAreEqual(anEntry.ValuePtr, "FUJIFILM", 8)) {
+                        aSubdirStart += size_t(StAlienData::Get16uLE(anEntry.ValuePtr + 8));
+                        anOffsetBase  = anEntry.ValuePtr;
+                        anOffsetLimit = theOffsetBase + theExifLength - anOffsetBase;
+                    }
+                } else if(isMakerEqual(theQuery.Maker, theQuery.MakerLen, "OLYMP", 5, false)) {
+                    aSubType = StExifDir::DType_MakerOlypm;
+                    if(anEntry.getBytes() >= 5
+                    && stAreEqual(anEntry.ValuePtr, "OLYMP", 5)) {
+                        aSubdirStart += 8;
+                    }
+                } else if(isMakerEqual(theQuery.Maker, theQuery.MakerLen, "Canon", 5, false)) {
+                    anIsFileBE = false;
+                    aSubType   = StExifDir::DType_MakerCanon;
+                }
+                if(aSubType == theQuery.Type
+                && aSubdirStart >= theOffsetBase
+                && aSubdirStart <= theOffsetBase + theExifLength
+                && scanDirectory(theQuery, aSubdirStart, anOffsetBase, anOffsetLimit,
+                                 anIsFileBE, aSubType, theNestingLevel + 1)) {
+                    return true;
+                }
+                break;
+            }
+        }
+    }
+
+    // continued directory
+    if(aDirEnd + 4 <= theOffsetBase + theExifLength) {
+        const size_t anOffset = size_t(StAlienData::Get32u(aDirEnd, theIsFileBE));
+        stUByte_t* aSubdirStart = theOffsetBase + anOffset;
+        if(anOffset != 0
+        && aSubdirStart >= theOffsetBase
+        && aSubdirStart <= theOffsetBase + theExifLength) {
+            return scanDirectory(theQuery, aSubdirStart, theOffsetBase, theExifLength,
+                                 theIsFileBE, theType, theNestingLevel);
+        }
+    }
+    return false;
+}
+
+void StExifReader::format(const StExifReader::Entry& theEntry,
+                          StString&                  theString) {
+    const stUByte_t* aValue = theEntry.Value.ValuePtr;
+    switch(theEntry.Value.Format) {
+        case StExifEntry::FMT_BYTE: {
+            theString = StAlienData::Get8u(aValue);
+            return;
+        }
+        case StExifEntry::FMT_STRING: {
+            theString = StString((char* )aValue);
+            return;
+        }
+        case StExifEntry::FMT_USHORT: {
+            theString = theEntry.get16u(aValue);
+            return;
+        }
+        case StExifEntry::FMT_ULONG: {
+            theString = theEntry.get32u(aValue);
+            return;
+        }
+        case StExifEntry::FMT_URATIONAL: {
+            const uint32_t aNum = theEntry.get32u(aValue);
+            const uint32_t aDen = theEntry.get32u(aValue + 4);
+            theString = StString() + aNum + "/" + aDen;
+            if(aDen != 0
+            && aDen != 1) {
+                theString += StString(" (") + (double(aNum) / double(aDen)) + ")";
+            }
+            return;
+        }
+        case StExifEntry::FMT_SBYTE: {
+            theString = StAlienData::Get8s(aValue);
+            return;
+        }
+        case StExifEntry::FMT_SSHORT: {
+            theString = theEntry.get16s(aValue);
+            return;
+        }
+        case StExifEntry::FMT_SLONG: {
+            theString = theEntry.get32s(aValue);
+            return;
+        }
+        case StExifEntry::FMT_SRATIONAL: {
+            const int32_t aNum = theEntry.get32s(aValue);
+            const int32_t aDen = theEntry.get32s(aValue + 4);
+            theString = StString() + aNum + "/" + aDen;
+            if(aDen != 0
+            && aDen != 1) {
+                theString += StString(" (") + (double(aNum) / double(aDen)) + ")";
+            }
+            return;
+        }
+        case StExifEntry::FMT_SINGLE: {
+            theString = StString(*(float* )aValue);
+            return;
+        }
+        case StExifEntry::FMT_DOUBLE: {
+            theString = StString(*(double* )aValue);
+            return;
+        }
+        case StExifEntry::FMT_UNDEFINED:
+        default: {
+            theString = stCString("N/A");
+            return;
+        }
+    }
+}
+
+bool StExifReader::decodeUserComment(const StExifEntry& theEntry,
+                                     StString&          theComment) {
+    // custom block with undefined type
+    if(theEntry.getBytes() < 9) {
+        return false;
+    }
+
+    if(stAreEqual(theEntry.ValuePtr, "ASCII\0\0\0", 8)) {
+        const char* aStart = (const char* )theEntry.ValuePtr + 8;
+        theComment = StString(aStart, theEntry.getBytes() - 8);
+        return true;
+    } else if(stAreEqual(theEntry.ValuePtr, "UNICODE\0", 8)) {
+        const char* aStart = (const char* )theEntry.ValuePtr + 8;
+        theComment = StString((stUtf16_t* )aStart, (theEntry.getBytes() - 8) / 2);
+        return true;
+    }
+    return false;
+}
@@ -9,10 +9,15 @@
 #include <StFT/StFTFontRegistry.h>
 
 #include <StFile/StFolder.h>
+#include <StFile/StRawFile.h>
 #include <StStrings/StLogger.h>
 #include <StThreads/StProcess.h>
+#include <StThreads/StThreadPool.h>
 #include <stAssert.h>
 
+#include <cstdlib>
+#include <string>
+
 #if !defined(_WIN32) && !defined(__ANDROID__) && !defined(__APPLE__) && !defined(__EMSCRIPTEN__)
   // use fontconfig library on Linux
   #include <fontconfig/fontconfig.h>
@@ -20,8 +25,74 @@
 
 namespace {
     static const StFTFontFamily THE_NO_FAMILY;
+
+    static const char THE_INDEX_HEADER[] = "StFontIndex 1";
+
+    /**
+     * Characters used to detect Unicode subsets covered by the font.
+     */
+    static const stUtf32_t THE_SUBSET_CHARS[StFTFont::SubsetsNB] = {
+        0x00041, // Subset_General,     Latin A
+        0x0AC00, // Subset_Korean,      Hangul syllable GA
+        0x04E00, // Subset_CJK,         CJK ideograph "one"
+        0x00627, // Subset_Arabic,      Arabic letter ALEF
+        0x02600, // Subset_MiscSymbols, black sun with rays
+    };
+
+    /**
+     * Split the line into fields separated by tabulation.
+     */
+    static void splitFields(const std::string&        theLine,
+                            std::vector<std::string>& theFields) {
+        theFields.clear();
+        for(size_t aStart = 0;;) {
+            const size_t anEnd = theLine.find('\t', aStart);
+            if(anEnd == std::string::npos) {
+                theFields.push_back(theLine.substr(aStart));
+                return;
+            }
+            theFields.push_back(theLine.substr(aStart, anEnd - aStart));
+            aStart = anEnd + 1;
+        }
+    }
+
 }
 
+/**
+ * Background task rebuilding outdated fonts index.
+ * The task holds its own copy of search parameters and FreeType library instance,
+ * so that it does not depend on registry lifetime.
+ */
+class StFTFontRegistry::IndexTask : public StThreadPool::Task {
+
+        public:
+
+    ST_LOCAL IndexTask(const StFTFontRegistry& theRegistry)
+    : myIndexPath(theRegistry.myIndexPath),
+      myExtensions(theRegistry.myExtensions),
+      myFolders(theRegistry.myFolders),
+      myFilesMajor(theRegistry.myFilesMajor),
+      myFilesMinor(theRegistry.myFilesMinor) {}
+
+    ST_LOCAL virtual void perform() {
+        StHandle<StFTLibrary> aFTLib = new StFTLibrary();
+        FontIndex anIndex;
+        StFTFontRegistry::scanFonts(aFTLib, myFolders, myExtensions, myFilesMajor, myFilesMinor, anIndex);
+        if(StFTFontRegistry::writeIndex(myIndexPath, anIndex)) {
+            ST_DEBUG_LOG("StFTFontRegistry, fonts index '" + myIndexPath + "' has been updated");
+        }
+    }
+
+        private:
+
+    StString              myIndexPath;
+    StArrayList<StString> myExtensions;
+    StArrayList<StString> myFolders;
+    StArrayList<StString> myFilesMajor;
+    StArrayList<StString> myFilesMinor;
+
+};
+
 StFTFontRegistry::StFTFontRegistry() {
     myFTLib = new StFTLibrary();
     myExtensions.add("ttf");
@@ -175,15 +246,40 @@ void StFTFontRegistry::appendSearchPath(const StString& theFolder) {
     myFolders.add(theFolder);
 }
 
-void StFTFontRegistry::searchFiles(const StArrayList<StString>& theNames,
-                                   const bool                   theIsMajor) {
+void StFTFontRegistry::addFolders(const StFolder& theFolder,
+                                  const bool      theIsRoot,
+                                  FontIndex&      theIndex) {
+    FolderEntry aFolder;
+    aFolder.Path   = theFolder.getPath();
+    aFolder.IsRoot = theIsRoot;
+    int64_t aSize = 0;
+    StFileNode::getFileStat(aFolder.Path, aSize, aFolder.ModTime);
+    theIndex.Folders.push_back(aFolder);
+    for(size_t aNodeIter = 0; aNodeIter < theFolder.size(); ++aNodeIter) {
+        const StFileNode* aNode = theFolder.getValue(aNodeIter);
+        if(aNode->isFolder()) {
+            addFolders(*(const StFolder* )aNode, false, theIndex);
+        }
+    }
+}
+
+void StFTFontRegistry::searchFiles(const StHandle<StFTLibrary>& theFTLib,
+                                   const StFolder&              theFoldersRoot,
+                                   const StArrayList<StString>& theNames,
+                                   const bool                   theIsMajor,
+                                   FontIndex&                   theIndex) {
     for(size_t aNameIter = 0; aNameIter < theNames.size(); ++aNameIter) {
         const StString& aName = theNames.getValue(aNameIter);
+        theIndex.Fonts.push_back(FontEntry());
+        FontEntry& anEntry = theIndex.Fonts.back();
+        anEntry.Name    = aName;
+        anEntry.IsMajor = theIsMajor;
+
         StString aPath;
         if(StFileNode::isAbsolutePath(aName)) {
             aPath = aName;
         } else {
-            const StFileNode* aNode = myFoldersRoot.findValue(aName);
+            const StFileNode* aNode = theFoldersRoot.findValue(aName);
             if(aNode != NULL) {
                 aPath = aNode->getPath();
             }
@@ -196,7 +292,7 @@ void StFTFontRegistry::searchFiles(const StArrayList<StString>& theNames,
         }
 
         FT_Face aFace = NULL;
-        if(FT_New_Face(myFTLib->getInstance(), aPath.toCString(), 0, &aFace) != 0) {
+        if(FT_New_Face(theFTLib->getInstance(), aPath.toCString(), anEntry.FaceId, &aFace) != 0) {
             if(theIsMajor) {
                 ST_ERROR_LOG("StFTFontRegistry, major font file '" + aName + "' fail to load"
                             + " from path '" + aPath + "'!");
@@ -207,34 +303,229 @@ void StFTFontRegistry::searchFiles(const StArrayList<StString>& theNames,
             continue;
         }
 
-        StFTFontFamily& aFamily = myFonts[aFace->family_name];
-        aFamily.FamilyName = aFace->family_name;
-        if(aFace->style_flags == (FT_STYLE_FLAG_ITALIC | FT_STYLE_FLAG_BOLD)) {
-            aFamily.BoldItalic = aPath;
-        } else if(aFace->style_flags == FT_STYLE_FLAG_BOLD) {
-            aFamily.Bold = aPath;
-        } else if(aFace->style_flags == FT_STYLE_FLAG_ITALIC) {
-            aFamily.Italic = aPath;
-        } else {
-            aFamily.Regular = aPath;
+        anEntry.Path       = aPath;
+        anEntry.FamilyName = aFace->family_name;
+        anEntry.StyleFlags = int(aFace->style_flags);
+        anEntry.NbGlyphs   = int(aFace->num_glyphs);
+        for(int aSubset = 0; aSubset < StFTFont::SubsetsNB; ++aSubset) {
+            if(FT_Get_Char_Index(aFace, THE_SUBSET_CHARS[aSubset]) != 0) {
+                anEntry.Subsets |= (1 << aSubset);
+            }
         }
-        //ST_DEBUG_LOG("StFTFontRegistry, font file '" + aName + "', family '" + aFamily.FamilyName + "', contains " + aFace->num_glyphs + " glyphs!");
+        //ST_DEBUG_LOG("StFTFontRegistry, font file '" + aName + "', family '" + anEntry.FamilyName + "', contains " + anEntry.NbGlyphs + " glyphs!");
 
         FT_Done_Face(aFace);
     }
 }
 
+void StFTFontRegistry::scanFonts(const StHandle<StFTLibrary>& theFTLib,
+                                 const StArrayList<StString>& theFolders,
+                                 const StArrayList<StString>& theExtensions,
+                                 const StArrayList<StString>& theFilesMajor,
+                                 const StArrayList<StString>& theFilesMinor,
+                                 FontIndex&                   theIndex) {
+    StFolder aFoldersRoot;
+    for(size_t aFolderIter = 0; aFolderIter < theFolders.size(); ++aFolderIter) {
+        StFolder* aSubFolder = new StFolder(theFolders.getValue(aFolderIter), &aFoldersRoot);
+        // keep empty folders to track fonts added into them
+        aSubFolder->init(theExtensions, 4, true);
+        aFoldersRoot.add(aSubFolder);
+        addFolders(*aSubFolder, true, theIndex);
+    }
+
+    searchFiles(theFTLib, aFoldersRoot, theFilesMajor, true,  theIndex);
+    searchFiles(theFTLib, aFoldersRoot, theFilesMinor, false, theIndex);
+}
+
+bool StFTFontRegistry::readIndex(const StString& thePath,
+                                 FontIndex&      theIndex) {
+    StRawFile aFile(thePath);
+    if(thePath.isEmpty()
+    || !StFileNode::isFileExists(thePath)
+    || !aFile.readFile()) {
+        return false;
+    }
+
+    const std::string aData((const char* )aFile.getBuffer(), aFile.getSize());
+    std::vector<std::string> aFields;
+    bool isFirstLine = true;
+    for(size_t aStart = 0; aStart < aData.size();) {
+        size_t anEnd = aData.find('\n', aStart);
+        if(anEnd == std::string::npos) {
+            anEnd = aData.size();
+        }
+        const std::string aLine = aData.substr(aStart, anEnd - aStart);
+        aStart = anEnd + 1;
+        if(isFirstLine) {
+            if(aLine != THE_INDEX_HEADER) {
+                return false;
+            }
+            isFirstLine = false;
+            continue;
+        } else if(aLine.empty()) {
+            continue;
+        }
+
+        splitFields(aLine, aFields);
+        if(aFields[0] == "D"
+        && aFields.size() == 4) {
+            FolderEntry aFolder;
+            aFolder.IsRoot  = aFields[1] == "1";
+            aFolder.ModTime = std::strtoll(aFields[2].c_str(), NULL, 10);
+            aFolder.Path    = aFields[3].c_str();
+            theIndex.Folders.push_back(aFolder);
+        } else if(aFields[0] == "F"
+               && aFields.size() == 9) {
+            FontEntry anEntry;
+            anEntry.IsMajor    = aFields[1] == "1";
+            anEntry.FaceId     = std::atoi(aFields[2].c_str());
+            anEntry.StyleFlags = std::atoi(aFields[3].c_str());
+            anEntry.NbGlyphs   = std::atoi(aFields[4].c_str());
+            anEntry.Subsets    = std::atoi(aFields[5].c_str());
+            anEntry.Name       = aFields[6].c_str();
+            anEntry.Path       = aFields[7].c_str();
+            anEntry.FamilyName = aFields[8].c_str();
+            theIndex.Fonts.push_back(anEntry);
+        } else {
+            return false;
+        }
+    }
+    return !isFirstLine;
+}
+
+bool StFTFontRegistry::writeIndex(const StString&  thePath,
+                                  const FontIndex& theIndex) {
+    if(thePath.isEmpty()) {
+        return false;
+    }
+
+    // write into temporary file to avoid reading incomplete index by another process
+    const StString aTmpPath = thePath + ".tmp";
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::WRITE, aTmpPath)) {
+        return false;
+    }
+
+    bool isOk = aFile.write(StString(THE_INDEX_HEADER) + "\n") != 0;
+    for(size_t aFolderIter = 0; isOk && aFolderIter < theIndex.Folders.size(); ++aFolderIter) {
+        const FolderEntry& aFolder = theIndex.Folders[aFolderIter];
+        const StString aLine = StString("D\t") + (aFolder.IsRoot ? "1" : "0")
+                             + "\t" + aFolder.ModTime
+                             + "\t" + aFolder.Path + "\n";
+        isOk = aFile.write(aLine) == aLine.getSize();
+    }
+    for(size_t aFontIter = 0; isOk && aFontIter < theIndex.Fonts.size(); ++aFontIter) {
+        const FontEntry& anEntry = theIndex.Fonts[aFontIter];
+        const StString aLine = StString("F\t") + (anEntry.IsMajor ? "1" : "0")
+                             + "\t" + anEntry.FaceId
+                             + "\t" + anEntry.StyleFlags
+                             + "\t" + anEntry.NbGlyphs
+                             + "\t" + anEntry.Subsets
+                             + "\t" + anEntry.Name
+                             + "\t" + anEntry.Path
+                             + "\t" + anEntry.FamilyName + "\n";
+        isOk = aFile.write(aLine) == aLine.getSize();
+    }
+    aFile.closeFile();
+
+    if(!isOk) {
+        StFileNode::removeFile(aTmpPath);
+        return false;
+    }
+    StFileNode::removeFile(thePath);
+    return StFileNode::moveFile(aTmpPath, thePath);
+}
+
+StFTFontRegistry::IndexState StFTFontRegistry::checkIndex(const FontIndex& theIndex) const {
+    // index should cover the same search paths and font files
+    size_t aNbRoots = 0;
+    for(size_t aFolderIter = 0; aFolderIter < theIndex.Folders.size(); ++aFolderIter) {
+        const FolderEntry& aFolder = theIndex.Folders[aFolderIter];
+        if(aFolder.IsRoot) {
+            if(aNbRoots >= myFolders.size()
+            || aFolder.Path != myFolders.getValue(aNbRoots)) {
+                return IndexState_Missing;
+            }
+            ++aNbRoots;
+        }
+    }
+    if(aNbRoots != myFolders.size()
+    || theIndex.Fonts.size() != myFilesMajor.size() + myFilesMinor.size()) {
+        return IndexState_Missing;
+    }
+    for(size_t aFontIter = 0; aFontIter < theIndex.Fonts.size(); ++aFontIter) {
+        const FontEntry& anEntry = theIndex.Fonts[aFontIter];
+        const StString&  aName   = aFontIter < myFilesMajor.size()
+                                 ? myFilesMajor.getValue(aFontIter)
+                                 : myFilesMinor.getValue(aFontIter - myFilesMajor.size());
+        if(anEntry.Name != aName) {
+            return IndexState_Missing;
+        }
+    }
+
+    // fonts might be added, removed or replaced within any scanned folder
+    for(size_t aFolderIter = 0; aFolderIter < theIndex.Folders.size(); ++aFolderIter) {
+        const FolderEntry& aFolder = theIndex.Folders[aFolderIter];
+        int64_t aSize = 0, aModTime = 0;
+        StFileNode::getFileStat(aFolder.Path, aSize, aModTime);
+        if(aModTime != aFolder.ModTime) {
+            return IndexState_Stale;
+        }
+    }
+    return IndexState_Valid;
+}
+
+void StFTFontRegistry::registerFonts(const FontIndex& theIndex,
+                                     const bool       theToCheckFiles) {
+    for(size_t aFontIter = 0; aFontIter < theIndex.Fonts.size(); ++aFontIter) {
+        const FontEntry& anEntry = theIndex.Fonts[aFontIter];
+        if(anEntry.Path.isEmpty()
+        || (theToCheckFiles && !StFileNode::isFileExists(anEntry.Path))) {
+            continue;
+        }
+
+        StFTFontFamily& aFamily = myFonts[anEntry.FamilyName];
+        aFamily.FamilyName = anEntry.FamilyName;
+        if(anEntry.StyleFlags == (FT_STYLE_FLAG_ITALIC | FT_STYLE_FLAG_BOLD)) {
+            aFamily.BoldItalic = anEntry.Path;
+        } else if(anEntry.StyleFlags == FT_STYLE_FLAG_BOLD) {
+            aFamily.Bold = anEntry.Path;
+        } else if(anEntry.StyleFlags == FT_STYLE_FLAG_ITALIC) {
+            aFamily.Italic = anEntry.Path;
+        } else {
+            aFamily.Regular = anEntry.Path;
+        }
+    }
+}
+
 void StFTFontRegistry::init(const bool theToSearchAll) {
-    myFoldersRoot.clear();
     myFonts.clear();
-    for(size_t aFolderIter = 0; aFolderIter < myFolders.size(); ++aFolderIter) {
-        StFolder* aSubFolder = new StFolder(myFolders.getValue(aFolderIter), &myFoldersRoot);
-        aSubFolder->init(myExtensions, 4);
-        myFoldersRoot.add(aSubFolder);
-    }
 
-    searchFiles(myFilesMajor, true);
-    searchFiles(myFilesMinor, false);
+    FontIndex anIndex;
+    const IndexState aState = readIndex(myIndexPath, anIndex)
+                            ? checkIndex(anIndex)
+                            : IndexState_Missing;
+    switch(aState) {
+        case IndexState_Valid: {
+            registerFonts(anIndex, false);
+            break;
+        }
+        case IndexState_Stale: {
+            // use outdated index within this session and rebuild it in background
+            ST_DEBUG_LOG("StFTFontRegistry, fonts index '" + myIndexPath + "' is outdated");
+            registerFonts(anIndex, true);
+            StThreadPool::getDefault().push(new IndexTask(*this), StThreadPool::Priority_Background);
+            break;
+        }
+        case IndexState_Missing: {
+            // nothing to show without fonts - perform full scan right now
+            anIndex = FontIndex();
+            scanFonts(myFTLib, myFolders, myExtensions, myFilesMajor, myFilesMinor, anIndex);
+            registerFonts(anIndex, false);
+            writeIndex(myIndexPath, anIndex);
+            break;
+        }
+    }
 
     if(theToSearchAll) {
         //
@@ -81,6 +81,32 @@ bool StFileNode::isFileExists(const StCString& thePath) {
 #endif
 }
 
+bool StFileNode::getFileStat(const StCString& thePath,
+                             int64_t&         theSize,
+                             int64_t&         theModTime) {
+#ifdef _WIN32
+    StStringUtfWide aPath;
+    aPath.fromUnicode(thePath);
+    struct __stat64 aStatBuffer;
+    if(_wstat64(aPath.toCString(), &aStatBuffer) != 0) {
+        return false;
+    }
+#elif (defined(__APPLE__))
+    struct stat aStatBuffer;
+    if(stat(thePath.toCString(), &aStatBuffer) != 0) {
+        return false;
+    }
+#else
+    struct stat64 aStatBuffer;
+    if(stat64(thePath.toCString(), &aStatBuffer) != 0) {
+        return false;
+    }
+#endif
+    theSize    = int64_t(aStatBuffer.st_size);
+    theModTime = int64_t(aStatBuffer.st_mtime);
+    return true;
+}
+
 bool StFileNode::isFileReadOnly(const StCString& thePath) {
 #ifdef _WIN32
     StStringUtfWide aPath;
@@ -77,8 +77,12 @@ StGLContext::StGLContext(const StHandle<StResourceManager>& theResMgr)
   myWasInit(false),
   myFramebufferDraw(0),
   myFramebufferRead(0),
+  myActiveProgram(0),
+  myDeferredDraw(NULL),
+  myIsPremultTarget(false),
   myIsBound(false) {
     stMemZero(&(*myFuncs),   sizeof(StGLFunctions));
+    stMemZero(&myFrameStats, sizeof(FrameStats));
     extAll = &(*myFuncs);
     stMemZero(&myViewport,   sizeof(StGLBoxPx));
     stMemZero(&myWindowBits, sizeof(BufferBits));
@@ -136,8 +140,12 @@ StGLContext::StGLContext(const bool theToInitialize)
   myWasInit(false),
   myFramebufferDraw(0),
   myFramebufferRead(0),
+  myActiveProgram(0),
+  myDeferredDraw(NULL),
+  myIsPremultTarget(false),
   myIsBound(false) {
     stMemZero(&(*myFuncs),   sizeof(StGLFunctions));
+    stMemZero(&myFrameStats, sizeof(FrameStats));
     extAll = &(*myFuncs);
     stMemZero(&myViewport,   sizeof(StGLBoxPx));
     stMemZero(&myWindowBits, sizeof(BufferBits));
@@ -565,6 +573,10 @@ void StGLContext::stglSyncState() {
         myScissorStack.pop();
     }
 
+    GLint aProgram = 0;
+    core11fwd->glGetIntegerv(GL_CURRENT_PROGRAM, &aProgram);
+    myActiveProgram = GLuint(aProgram);
+
     if(core11fwd->glIsEnabled(GL_SCISSOR_TEST)) {
         StGLBoxPx aRect;
         core11fwd->glGetIntegerv(GL_SCISSOR_BOX, aRect.v);
@@ -572,8 +584,29 @@ void StGLContext::stglSyncState() {
     }
 }
 
+void StGLContext::stglSetBlendAlpha() {
+    if(myIsPremultTarget) {
+        // accumulate coverage in alpha channel so that result can be composited later with premultiplied blending
+        core20fwd->glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        core20fwd->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+void StGLContext::stglUseProgram(const GLuint theProgram) {
+    if(myActiveProgram == theProgram) {
+        ++myFrameStats.NbProgramSkips;
+        return;
+    }
+
+    myActiveProgram = theProgram;
+    ++myFrameStats.NbProgramBinds;
+    core20fwd->glUseProgram(theProgram);
+}
+
 void StGLContext::stglSetScissorRect(const StGLBoxPx& theRect,
                                      const bool       thePushStack) {
+    stglFlushDeferred();
     if(myScissorStack.empty()) {
         core11fwd->glEnable(GL_SCISSOR_TEST);
     }
@@ -588,6 +621,7 @@ void StGLContext::stglSetScissorRect(const StGLBoxPx& theRect,
 }
 
 void StGLContext::stglResetScissorRect() {
+    stglFlushDeferred();
     if(!myScissorStack.empty()) {
         myScissorStack.pop();
     }
@@ -608,6 +642,7 @@ void StGLContext::stglResizeViewport(const StGLBoxPx& theRect) {
 }
 
 void StGLContext::stglBindFramebufferDraw(const GLuint theFramebuffer) {
+    stglFlushDeferred();
     myFramebufferDraw = theFramebuffer;
 #if defined(GL_ES_VERSION_2_0)
     arbFbo->glBindFramebuffer(GL_FRAMEBUFFER,      theFramebuffer);
@@ -617,6 +652,7 @@ void StGLContext::stglBindFramebufferDraw(const GLuint theFramebuffer) {
 }
 
 void StGLContext::stglBindFramebufferRead(const GLuint theFramebuffer) {
+    stglFlushDeferred();
     myFramebufferRead = theFramebuffer;
 #if defined(GL_ES_VERSION_2_0)
     arbFbo->glBindFramebuffer(GL_FRAMEBUFFER,      theFramebuffer);
@@ -626,6 +662,7 @@ void StGLContext::stglBindFramebufferRead(const GLuint theFramebuffer) {
 }
 
 void StGLContext::stglBindFramebuffer(const GLuint theFramebuffer) {
+    stglFlushDeferred();
     myFramebufferDraw = theFramebuffer;
     myFramebufferRead = theFramebuffer;
     arbFbo->glBindFramebuffer(GL_FRAMEBUFFER, theFramebuffer);
@@ -9,6 +9,7 @@
 #include <StGL/StGLFontManager.h>
 
 #include <StStrings/StLogger.h>
+#include <StThreads/StStartupProfiler.h>
 #include <stAssert.h>
 
 namespace {
@@ -18,10 +19,15 @@ namespace {
 
 }
 
-StGLFontManager::StGLFontManager(const unsigned int theResolution)
+StGLFontManager::StGLFontManager(const unsigned int theResolution,
+                                 const StString&    theCacheFolder)
 : myFTLib(new StFTLibrary()),
   myResolution(theResolution) {
+    StStartupProfiler::Scope aProfScope("font registry");
     myRegistry = new StFTFontRegistry();
+    if(!theCacheFolder.isEmpty()) {
+        myRegistry->setIndexPath(theCacheFolder + "fonts.idx");
+    }
     myRegistry->init(false);
 }
 
@@ -30,6 +30,9 @@ const StString& StGLProgram::getTitle() const {
 
 void StGLProgram::release(StGLContext& theCtx) {
     if(isValid()) {
+        if(theCtx.stglActiveProgram() == myProgramId) {
+            unuseGlobal(theCtx); // program ID might be reused by driver
+        }
         theCtx.core20fwd->glDeleteProgram(myProgramId);
         myProgramId = NO_PROGRAM;
     }
@@ -126,7 +129,8 @@ StGLProgram& StGLProgram::bindAttribLocation(StGLContext&    theCtx,
 
 void StGLProgram::use(StGLContext& theCtx) const {
     if(isValid()) {
-        theCtx.core20fwd->glUseProgram(myProgramId); // use our shader
+        theCtx.stglFlushDeferred();
+        theCtx.stglUseProgram(myProgramId); // use our shader
     }
 }
 
@@ -136,7 +140,7 @@ void StGLProgram::unuse(StGLContext& theCtx) const {
 
 void StGLProgram::unuseGlobal(StGLContext& theCtx) {
     if(theCtx.core20fwd != NULL) {
-        theCtx.core20fwd->glUseProgram(NO_PROGRAM); // use fixed instructions
+        theCtx.stglUseProgram(NO_PROGRAM); // use fixed instructions
     }
 }
 
@@ -141,9 +141,13 @@ bool StGLTexture::getInternalFormat(const StGLContext& theCtx,
         #endif
             return true;
         case StImagePlane::ImgUV:
-            //theInternalFormat = theCtx.arbTexRG ? GL_RG8 : GL_LUMINANCE_ALPHA; // OpenGL3+
-            theInternalFormat = GL_LUMINANCE_ALPHA;
+            // GL_LUMINANCE_ALPHA is unavailable in core profile
+            theInternalFormat = theCtx.arbTexRG ? GL_RG8 : GL_LUMINANCE_ALPHA;
             return true;
+        case StImagePlane::ImgUV16:
+            // there is GL_LUMINANCE16_ALPHA16 on old desktop OpenGL, but it is not worth supporting
+            theInternalFormat = GL_RG16; // equals to GL_RG16_EXT on OpenGL ES extension
+            return theCtx.arbTexRG && theCtx.extTexR16;
         default:
             return false;
     }
@@ -167,11 +171,15 @@ bool StGLTexture::getDataFormat(const StGLContext&  theCtx,
             return true;
         }
         case StImagePlane::ImgUV: {
-            //thePixelFormat = theCtx.arbTexRG ? GL_RG : GL_LUMINANCE_ALPHA;
-            thePixelFormat = GL_LUMINANCE_ALPHA;
+            thePixelFormat = theCtx.arbTexRG ? GL_RG : GL_LUMINANCE_ALPHA;
             theDataType = GL_UNSIGNED_BYTE;
             return true;
         }
+        case StImagePlane::ImgUV16: {
+            thePixelFormat = GL_RG;
+            theDataType = GL_UNSIGNED_SHORT;
+            return theCtx.arbTexRG;
+        }
         case StImagePlane::ImgRGB: {
             thePixelFormat = GL_RGB;
             theDataType = GL_UNSIGNED_BYTE;
@@ -281,6 +289,10 @@ ST_LOCAL inline StString formatInternalFormat(const GLint theInternalFormat) {
         case GL_R16:      return "GL_R16";
         case GL_R16F:     return "GL_R16F"; // half-float
         case GL_R32F:     return "GL_R32F"; // float
+        // RG variations (GL_RG, OpenGL 3.0+)
+        case GL_RG:       return "GL_RG";
+        case GL_RG8:      return "GL_RG8";
+        case GL_RG16:     return "GL_RG16";
         // RGB variations
         case GL_RGB:      return "GL_RGB";
         case GL_RGB4:     return "GL_RGB4";
@@ -321,6 +333,11 @@ static inline GLenum getDataFormat(const GLint theInternalFormat) {
         case GL_R16F:
         case GL_R32F:
             return GL_RED;
+        // RG variations (GL_RG, OpenGL 3.0+)
+        case GL_RG:
+        case GL_RG8:
+        case GL_RG16:
+            return GL_RG;
         // RGB variations
         case GL_RGB:
         case GL_RGB4:
@@ -365,6 +382,8 @@ static GLenum getDataType(GLint theInternalFormat) {
     switch(theInternalFormat) {
         case GL_RED:
         case GL_R8:
+        case GL_RG:
+        case GL_RG8:
         case GL_RGB:
         case GL_RGB8:
         case GL_RGBA:
@@ -376,6 +395,7 @@ static GLenum getDataType(GLint theInternalFormat) {
         case GL_LUMINANCE_ALPHA:
             return GL_UNSIGNED_BYTE;
         case GL_R16:
+        case GL_RG16:
         case GL_RGB16:
         case GL_RGBA16:
         case GL_ALPHA16:
@@ -770,6 +790,47 @@ bool StGLTexture::fillPatch(StGLContext&        theCtx,
     return true;
 }
 
+bool StGLTexture::fillRegion(StGLContext&        theCtx,
+                             const StImagePlane& theData,
+                             const GLsizei       theOffsetX,
+                             const GLsizei       theOffsetY) {
+    if(theData.isNull()
+    || !isValid()
+    || theOffsetX < 0 || theOffsetY < 0
+    || GLsizei(theData.getSizeX()) + theOffsetX > getSizeX()
+    || GLsizei(theData.getSizeY()) + theOffsetY > getSizeY()) {
+        return false;
+    }
+
+    GLenum aPixelFormat, aDataType;
+    if(!getDataFormat(theCtx, theData, aPixelFormat, aDataType)) {
+        return false;
+    }
+
+    myHasMipMaps = 0;
+    bind(theCtx);
+
+    const size_t anAligment = stMin(theData.getMaxRowAligment(), size_t(8)); // limit to 8 bytes for OpenGL
+    theCtx.core20fwd->glPixelStorei(GL_UNPACK_ALIGNMENT, GLint(anAligment));
+    const size_t aSizeRowBytesEstim = getAligned(theData.getSizePixelBytes() * theData.getSizeX(), anAligment);
+    if(aSizeRowBytesEstim == theData.getSizeRowBytes()) {
+        // single call for tightly packed rows
+        theCtx.core20fwd->glTexSubImage2D(myTarget, 0, theOffsetX, theOffsetY,
+                                          GLsizei(theData.getSizeX()), GLsizei(theData.getSizeY()),
+                                          aPixelFormat, aDataType, theData.getData());
+    } else {
+        for(size_t aRow = 0; aRow < theData.getSizeY(); ++aRow) {
+            theCtx.core20fwd->glTexSubImage2D(myTarget, 0, theOffsetX, theOffsetY + GLsizei(aRow),
+                                              GLsizei(theData.getSizeX()), 1,
+                                              aPixelFormat, aDataType, theData.getData(aRow, 0));
+        }
+    }
+    theCtx.core20fwd->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    unbind(theCtx);
+    return true;
+}
+
 StGLNamedTexture::StGLNamedTexture() {
     //
 }
@@ -854,3 +854,15 @@ void StGLTextureData::getCopy(StImage* theDataL,
         theDataR->initCopy(myDataR, true);
     }
 }
+
+void StGLTextureData::getReference(StImage* theDataL,
+                                   StImage* theDataR) const {
+    if(theDataL != NULL
+    && !theDataL->initReference(myDataL)) {
+        theDataL->initCopy(myDataL, true);
+    }
+    if(theDataR != NULL
+    && !theDataR->initReference(myDataR)) {
+        theDataR->initCopy(myDataR, true);
+    }
+}
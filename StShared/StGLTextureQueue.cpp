@@ -224,7 +224,8 @@ void StGLTextureQueue::drop(const size_t theCount,
 
 int StGLTextureQueue::getSnapshot(StImage* theOutDataLeft,
                                   StImage* theOutDataRight,
-                                  bool     theToForce) {
+                                  bool     theToForce,
+                                  bool     theToReference) {
     if(!myNewShotEvent.check() && !theToForce) {
         return SNAPSHOT_NO_NEW;
     }
@@ -233,7 +234,11 @@ int StGLTextureQueue::getSnapshot(StImage* theOutDataLeft,
         myMutexPop.unlock();
         return SNAPSHOT_NO_NEW;
     }
-    myDataSnap->getCopy(theOutDataLeft, theOutDataRight);
+    if(theToReference) {
+        myDataSnap->getReference(theOutDataLeft, theOutDataRight);
+    } else {
+        myDataSnap->getCopy(theOutDataLeft, theOutDataRight);
+    }
     myNewShotEvent.reset();
     myMutexPop.unlock();
     return SNAPSHOT_SUCCESS;
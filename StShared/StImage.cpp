@@ -58,6 +58,7 @@ const char* StImage::formatImgPixelFormat() const {
                 case StImagePlane::ImgRGBAF:   return "rgbaf";
                 case StImagePlane::ImgBGRAF:   return "bgraf";
                 case StImagePlane::ImgUV:      return "uv";
+                case StImagePlane::ImgUV16:    return "uv16";
                 case StImagePlane::ImgUNKNOWN: return "unknown";
             }
             return "invalid_rgb";
@@ -76,6 +77,8 @@ const char* StImage::formatImgPixelFormat() const {
             const size_t aDelimY = (myPlanes[1].getSizeY() > 0) ? (myPlanes[0].getSizeY() / myPlanes[1].getSizeY()) : 1;
             if(myPlanes[1].getFormat() == StImagePlane::ImgUV) {
                 return "nv12";
+            } else if(myPlanes[1].getFormat() == StImagePlane::ImgUV16) {
+                return "p010";
             } else if(aDelimX == 1 && aDelimY == 1) {
                 switch(myColorScale) {
                     case StImage::ImgScale_Mpeg:
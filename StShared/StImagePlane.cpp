@@ -26,6 +26,7 @@ StString StImagePlane::formatImgFormat(ImgFormat theImgFormat) {
         case ImgRGBAF:   return "ImgRGBAF";
         case ImgBGRAF:   return "ImgBGRAF";
         case ImgUV:      return "ImgUV";
+        case ImgUV16:    return "ImgUV16";
         case ImgUNKNOWN: return "ImgUNKNOWN";
     }
     return "unknown";
@@ -86,6 +87,9 @@ void StImagePlane::setFormat(StImagePlane::ImgFormat thePixelFormat) {
         case ImgUV:
             mySizeBPP = 2;
             break;
+        case ImgUV16:
+            mySizeBPP = 4;
+            break;
         case ImgGray:
         default:
             mySizeBPP = 1;
@@ -0,0 +1,139 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StImage/StImageSaveQueue.h>
+
+#include <StStrings/StLogger.h>
+
+StImageSaveQueue::StImageSaveQueue(const StHandle<StMsgQueue>& theMsgQueue,
+                                   const int                   theNbThreads,
+                                   const size_t                theMaxJobs)
+: myMsgQueue(theMsgQueue),
+  myNbThreads(stMax(theNbThreads, 1)),
+  myNbActive(0),
+  myMaxJobs(stMax(theMaxJobs, size_t(1))),
+  myEventIdle(true),
+  myNbBusy(0),
+  myNbSaved(0),
+  myNbFailed(0) {
+    //
+}
+
+StImageSaveQueue::~StImageSaveQueue() {
+    myEventIdle.wait();
+    for(size_t aTaskIter = 0; aTaskIter < myTasks.size(); ++aTaskIter) {
+        myTasks[aTaskIter]->wait();
+    }
+    myTasks.clear();
+}
+
+bool StImageSaveQueue::push(const Job& theJob) {
+    if(theJob.Image.isNull()
+    || theJob.Path.isEmpty()) {
+        return false;
+    }
+
+    StMutexAuto aLock(myMutex);
+    if(myJobs.size() >= myMaxJobs) {
+        return false;
+    }
+
+    myJobs.push_back(theJob);
+    myEventIdle.reset();
+    if(myNbActive < myNbThreads) {
+        // release finished tasks
+        for(size_t aTaskIter = 0; aTaskIter < myTasks.size();) {
+            if(myTasks[aTaskIter]->isDone()) {
+                myTasks.erase(myTasks.begin() + aTaskIter);
+            } else {
+                ++aTaskIter;
+            }
+        }
+
+        ++myNbActive;
+        StHandle<StThreadPool::Task> aTask = new SaveTask(this);
+        myTasks.push_back(aTask);
+        StThreadPool::getDefault().push(aTask, StThreadPool::Priority_Background);
+    }
+    return true;
+}
+
+void StImageSaveQueue::waitAll() {
+    myEventIdle.wait();
+}
+
+bool StImageSaveQueue::isFull() const {
+    StMutexAuto aLock(myMutex);
+    return myJobs.size() >= myMaxJobs;
+}
+
+size_t StImageSaveQueue::getNbPending() const {
+    StMutexAuto aLock(myMutex);
+    return myJobs.size() + myNbBusy;
+}
+
+size_t StImageSaveQueue::getNbSaved() const {
+    StMutexAuto aLock(myMutex);
+    return myNbSaved;
+}
+
+size_t StImageSaveQueue::getNbFailed() const {
+    StMutexAuto aLock(myMutex);
+    return myNbFailed;
+}
+
+void StImageSaveQueue::saveLoop() {
+    for(;;) {
+        myMutex.lock();
+        if(myJobs.empty()) {
+            --myNbActive;
+            myMutex.unlock();
+            return;
+        }
+
+        Job aJob = myJobs.front();
+        myJobs.pop_front();
+        ++myNbBusy;
+        myMutex.unlock();
+
+        save(aJob);
+    }
+}
+
+void StImageSaveQueue::save(Job& theJob) {
+    ST_DEBUG_LOG("Save image to the path '" + theJob.Path + '\'');
+    const bool isSaved = theJob.Image->save(theJob.Path, theJob.Type, theJob.Format);
+    if(!isSaved) {
+        if(!myMsgQueue.isNull()) {
+            myMsgQueue->pushError(new StString(StString("Image '") + theJob.Path + "' can not be saved\n" + theJob.Image->getState()));
+        }
+    } else {
+        if(!theJob.Image->getState().isEmpty()) {
+            ST_DEBUG_LOG(theJob.Image->getState());
+        }
+        if(!theJob.DoneMsg.isEmpty()
+        && !myMsgQueue.isNull()) {
+            myMsgQueue->pushInfo(new StString(theJob.DoneMsg));
+        }
+    }
+
+    // release image data before reporting idle state
+    theJob.Image.nullify();
+
+    StMutexAuto aLock(myMutex);
+    --myNbBusy;
+    if(isSaved) {
+        ++myNbSaved;
+    } else {
+        ++myNbFailed;
+    }
+    if(myJobs.empty()
+    && myNbBusy == 0) {
+        myEventIdle.set();
+    }
+}
@@ -354,18 +354,15 @@ StHandle<StJpegParser::Image> StJpegParser::parseImage(const int      theImgCoun
                 // there can be different section using the same marker
                 if(stAreEqual(aData + 2, "Exif\0\0", 6)) {
                     //ST_DEBUG_LOG("Exif section...");
-                    StHandle<StExifDir> aSubDir = new StExifDir();
-                    anImg->Exif.add(aSubDir);
-                    if(!aSubDir->parseExif(anImg->Exif, aData + 8, anItemLen - 8)) {
-                        //
+                    StExifReader aReader;
+                    if(aReader.init(aData + 8, anItemLen - 8)) {
+                        anImg->ExifRaw.add(aReader);
                     }
                 } else if(stAreEqual(aData + 2, "MPF\0", 4)) {
                     // MP Extensions (MPO)
-                    StHandle<StExifDir> aSubDir = new StExifDir();
-                    aSubDir->Type = StExifDir::DType_MPO;
-                    anImg->Exif.add(aSubDir);
-                    if(!aSubDir->parseExif(anImg->Exif, aData + 6, anItemLen - 6)) {
-                        //
+                    StExifReader aReader;
+                    if(aReader.init(aData + 6, anItemLen - 6, StExifDir::DType_MPO)) {
+                        anImg->ExifRaw.add(aReader);
                     }
                 } else if(stAreEqual(aData + 2, "http:", 5)) {
                     //ST_DEBUG_LOG("Image cotains XMP section");
@@ -591,10 +588,56 @@ StJpegParser::Image::~Image() {
     //
 }
 
+void StJpegParser::Image::decodeExif() {
+    if(!Exif.isEmpty()) {
+        return;
+    }
+
+    for(size_t aSectId = 0; aSectId < ExifRaw.size(); ++aSectId) {
+        const StExifReader& aReader = ExifRaw.getValue(aSectId);
+        StHandle<StExifDir> aSubDir = new StExifDir();
+        aSubDir->Type = aReader.getType();
+        Exif.add(aSubDir);
+        if(!aSubDir->parseExif(Exif, aReader.getData(), aReader.getLength())) {
+            //
+        }
+    }
+}
+
+bool StJpegParser::Image::findExifEntry(const StExifDir::DirType theType,
+                                        const uint16_t           theTag,
+                                        StExifReader::Entry&     theEntry) const {
+    for(size_t aSectId = 0; aSectId < ExifRaw.size(); ++aSectId) {
+        if(ExifRaw.getValue(aSectId).findEntry(theType, theTag, theEntry)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StJpegParser::Image::getExifString(const StExifDir::DirType theType,
+                                        const uint16_t           theTag,
+                                        StString&                theValue) const {
+    StExifReader::Entry anEntry;
+    if(!findExifEntry(theType, theTag, anEntry)
+    ||  anEntry.Value.Format != StExifEntry::FMT_STRING) {
+        return false;
+    }
+
+    // string might be not NULL-terminated within broken file
+    const size_t aLen = anEntry.Value.getBytes();
+    const char*  aStr = (const char* )anEntry.Value.ValuePtr;
+    size_t aStrLen = 0;
+    for(; aStrLen < aLen && aStr[aStrLen] != '\0'; ++aStrLen) {}
+    theValue = StString(aStr, aStrLen);
+    return true;
+}
+
 void StJpegParser::fillDictionary(StDictionary& theDict,
                                   const bool    theToShowUnknown) const {
     for(StHandle<StJpegParser::Image> anImg = myImages;
         !anImg.isNull(); anImg = anImg->Next) {
+        anImg->decodeExif();
         for(size_t anExifId = 0; anExifId < anImg->Exif.size(); ++anExifId) {
             anImg->Exif[anExifId]->fillDictionary(theDict, theToShowUnknown);
         }
@@ -603,22 +646,22 @@ void StJpegParser::fillDictionary(StDictionary& theDict,
 
 StString StJpegParser::Image::getDateTime() const {
     StString aString;
-    StExifDir::Query aQuery(StExifDir::DType_General, StExifTags::Image_DateTime);
-    if(StExifDir::findEntry(Exif, aQuery)) {
-        aQuery.Folder->format(aQuery.Entry, aString);
+    StExifReader::Entry anEntry;
+    if(findExifEntry(StExifDir::DType_General, StExifTags::Image_DateTime, anEntry)) {
+        StExifReader::format(anEntry, aString);
     }
     return aString;
 }
 
 bool StJpegParser::Image::getParallax(double& theParallax) const {
-    StExifDir::Query aQuery(StExifDir::DType_MakerFuji, StExifTags::Fuji_Parallax);
-    if(!StExifDir::findEntry(Exif, aQuery)
-    ||  aQuery.Entry.Format != StExifEntry::FMT_SRATIONAL) {
+    StExifReader::Entry anEntry;
+    if(!findExifEntry(StExifDir::DType_MakerFuji, StExifTags::Fuji_Parallax, anEntry)
+    ||  anEntry.Value.Format != StExifEntry::FMT_SRATIONAL) {
         return false;
     }
 
-    const int32_t aNumerator   = aQuery.Folder->get32s(aQuery.Entry.ValuePtr);
-    const int32_t aDenominator = aQuery.Folder->get32s(aQuery.Entry.ValuePtr + 4);
+    const int32_t aNumerator   = anEntry.get32s(anEntry.Value.ValuePtr);
+    const int32_t aDenominator = anEntry.get32s(anEntry.Value.ValuePtr + 4);
     if(aDenominator != 0) {
         theParallax = double(aNumerator) / double(aDenominator);
         return true;
@@ -627,12 +670,12 @@ bool StJpegParser::Image::getParallax(double& theParallax) const {
 }
 
 StJpegParser::Orient StJpegParser::Image::getOrientation() const {
-    StExifDir::Query aQuery(StExifDir::DType_General, StExifTags::Image_Orientation);
-    if(!StExifDir::findEntry(Exif, aQuery)
-    ||  aQuery.Entry.Format != StExifEntry::FMT_USHORT) {
+    StExifReader::Entry anEntry;
+    if(!findExifEntry(StExifDir::DType_General, StExifTags::Image_Orientation, anEntry)
+    ||  anEntry.Value.Format != StExifEntry::FMT_USHORT) {
         return StJpegParser::ORIENT_NORM;
     }
 
-    const int16_t aValue = aQuery.Folder->get16u(aQuery.Entry.ValuePtr);
+    const int16_t aValue = anEntry.get16u(anEntry.Value.ValuePtr);
     return (StJpegParser::Orient )aValue;
 }
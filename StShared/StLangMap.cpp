@@ -26,6 +26,40 @@ namespace {
             }
         }
     }
+
+    /**
+     * Functor comparing int keys.
+     */
+    struct StIdEqual {
+        const std::vector<size_t>& Keys;
+        const size_t               Key;
+
+        StIdEqual(const std::vector<size_t>& theKeys,
+                  const size_t               theKey) : Keys(theKeys), Key(theKey) {}
+
+        bool operator()(const size_t thePos) const {
+            return Keys[thePos] == Key;
+        }
+    };
+
+    /**
+     * Functor comparing string keys (case-sensitive).
+     */
+    struct StStrEqual {
+        const std::vector<StString>& Keys;
+        const StString&              Key;
+
+        StStrEqual(const std::vector<StString>& theKeys,
+                   const StString&              theKey) : Keys(theKeys), Key(theKey) {}
+
+        bool operator()(const size_t thePos) const {
+            return Keys[thePos] == Key;
+        }
+    };
+
+    inline size_t hashString(const StString& theKey) {
+        return StHashIndex::hashBytes(theKey.toCString(), theKey.getSize(), false);
+    }
 }
 
 StLangMap::StLangMap()
@@ -100,23 +134,42 @@ bool StLangMap::read(const char* theContent,
         }
         StString aValue(aValuePos.getBufferHere(), aValueLen);
         aValue.replaceFast(ST_NEWLINE2, ST_NEWLINE_REPLACEMENT);
-        myMap.insert(std::pair<size_t, StString>(aKey, aValue));
+        if(findValue(aKey) == StHashIndex::NOT_FOUND()) {
+            addValue(aKey, aValue);
+        }
     }
     return true;
 }
 
+size_t StLangMap::findValue(const size_t theId) const {
+    return myIndex.find(StHashIndex::hashInteger(theId), StIdEqual(myKeys, theId));
+}
+
+StString& StLangMap::addValue(const size_t    theId,
+                              const StString& theValue) {
+    myIndex.add(StHashIndex::hashInteger(theId), myValues.size());
+    myKeys.push_back(theId);
+    myValues.push_back(theValue);
+    return myValues.back();
+}
+
 StString& StLangMap::changeValue(const size_t theId) {
-    return myMap[theId];
+    const size_t aPos = findValue(theId);
+    return aPos != StHashIndex::NOT_FOUND()
+         ? myValues[aPos]
+         : addValue(theId, StString());
 }
 
 const StString& StLangMap::getValue(const size_t theId) const {
-    const std::map<size_t, StString>::const_iterator anIter = myMap.find(theId);
-    return (anIter != myMap.end()) ? anIter->second : myEmptyStr;
+    const size_t aPos = findValue(theId);
+    return aPos != StHashIndex::NOT_FOUND()
+         ? myValues[aPos]
+         : myEmptyStr;
 }
 
 StString& StLangMap::changeValueId(const size_t theId,
                                    const char*  theDefaultValue) {
-    StString& aValue = myMap[theId];
+    StString& aValue = changeValue(theId);
     if(aValue.isEmpty()) {
         if(myToShowId) {
             aValue = StString('[') + theId + ']' + theDefaultValue;
@@ -134,20 +187,31 @@ StString& StLangMap::operator()(const size_t theId,
 
 void StLangMap::addAlias(const StString& theStringKey,
                          const size_t    theIntKey) {
-    myMapStrKeys[theStringKey] = theIntKey;
+    const size_t aHash = hashString(theStringKey);
+    const size_t aPos  = myStrIndex.find(aHash, StStrEqual(myStrKeys, theStringKey));
+    if(aPos != StHashIndex::NOT_FOUND()) {
+        myStrKeyIds[aPos] = theIntKey;
+        return;
+    }
+
+    myStrIndex.add(aHash, myStrKeys.size());
+    myStrKeys.push_back(theStringKey);
+    myStrKeyIds.push_back(theIntKey);
 }
 
 const StString& StLangMap::getValue(const StString& theStringKey) const {
-    const std::map<StString, size_t>::const_iterator anIter = myMapStrKeys.find(theStringKey);
-    return anIter != myMapStrKeys.end()
-         ? getValue(anIter->second)
+    const size_t aPos = myStrIndex.find(hashString(theStringKey), StStrEqual(myStrKeys, theStringKey));
+    return aPos != StHashIndex::NOT_FOUND()
+         ? getValue(myStrKeyIds[aPos])
          : myEmptyStr;
 }
 
 size_t StLangMap::size() const {
-    return myMap.size();
+    return myValues.size();
 }
 
 void StLangMap::clear() {
-    myMap.clear();
+    myValues.clear();
+    myKeys.clear();
+    myIndex.clear();
 }
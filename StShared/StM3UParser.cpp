@@ -0,0 +1,146 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StFile/StM3UParser.h>
+
+#include <cstring>
+
+StM3UParser::StM3UParser(const size_t theChunkSize)
+: myChunkSize(stMax(theChunkSize, size_t(256))),
+  myStart(0),
+  myEnd(0),
+  myNbLines(0),
+  myIsEof(true),
+  myIsFirst(true) {
+    //
+}
+
+StM3UParser::~StM3UParser() {
+    close();
+}
+
+bool StM3UParser::open(const StCString& thePath) {
+    close();
+    if(!myFile.openFile(StRawFile::READ, thePath)) {
+        return false;
+    }
+
+    myBuffer.resize(myChunkSize + 1);
+    myIsEof   = false;
+    myIsFirst = true;
+    return true;
+}
+
+void StM3UParser::close() {
+    myFile.closeFile();
+    myStart   = 0;
+    myEnd     = 0;
+    myNbLines = 0;
+    myIsEof   = true;
+}
+
+bool StM3UParser::isPlayListPath(const StString& thePath) {
+    const StString anExt = StFileNode::getExtension(thePath);
+    return anExt.isEqualsIgnoreCase(stCString("m3u"))
+        || anExt.isEqualsIgnoreCase(stCString("m3u8"));
+}
+
+bool StM3UParser::fillBuffer() {
+    // move the tail of incomplete line to the beginning
+    const size_t aTail = myEnd - myStart;
+    if(myStart != 0 && aTail != 0) {
+        std::memmove(&myBuffer[0], &myBuffer[myStart], aTail);
+    }
+    myStart = 0;
+    myEnd   = aTail;
+
+    // the buffer grows only for lines longer than the chunk
+    if(myBuffer.size() < myEnd + myChunkSize + 1) {
+        myBuffer.resize(myEnd + myChunkSize + 1);
+    }
+
+    const size_t aRead = myFile.read(&myBuffer[myEnd], myChunkSize);
+    myEnd += aRead;
+    if(aRead == 0) {
+        myIsEof = true;
+        myFile.closeFile();
+    }
+    return aRead != 0;
+}
+
+char* StM3UParser::readLine() {
+    if(myBuffer.empty()) {
+        return NULL;
+    }
+
+    size_t aScanned = 0; // bytes already checked for line break after myStart
+    char*  aLine    = NULL;
+    size_t aLen     = 0;
+    for(;;) {
+        const char* aBreak = (const char* )std::memchr(&myBuffer[myStart + aScanned], '\n', myEnd - myStart - aScanned);
+        if(aBreak != NULL) {
+            aLine = &myBuffer[myStart];
+            aLen  = size_t(aBreak - aLine);
+            myStart += aLen + 1;
+            break;
+        }
+
+        aScanned = myEnd - myStart;
+        if(myIsEof || !fillBuffer()) {
+            if(myStart == myEnd) {
+                return NULL;
+            }
+            // last line without line break
+            aLine = &myBuffer[myStart];
+            aLen  = myEnd - myStart;
+            myStart = myEnd;
+            break;
+        }
+    }
+    ++myNbLines;
+
+    // replace LF or CRLF with '\0' and skip trailing spaces
+    aLine[aLen] = '\0';
+    for(; aLen != 0 && (aLine[aLen - 1] == '\x0D' || aLine[aLen - 1] == ' '); --aLen) {
+        aLine[aLen - 1] = '\0';
+    }
+
+    // skip BOM for UTF8 written by some weird programs
+    if(myIsFirst) {
+        myIsFirst = false;
+        if(aLen >= 3
+        && aLine[0] == '\xEF'
+        && aLine[1] == '\xBB'
+        && aLine[2] == '\xBF') {
+            aLine += 3;
+        }
+    }
+    return aLine;
+}
+
+bool StM3UParser::readNext(Entry& theEntry) {
+    StString aTitle;
+    for(char* aLine = readLine(); aLine != NULL; aLine = readLine()) {
+        if(*aLine == '\0') {
+            continue; // skip empty lines
+        } else if(*aLine != '#') {
+            theEntry.Path  = StString(aLine);
+            theEntry.Title = aTitle;
+            return true;
+        } else if(stAreEqual(aLine, "#EXTINF:", 8)) {
+            const char* aComma = std::strchr(aLine + 8, ',');
+            if(aComma != NULL) {
+                for(++aComma; *aComma == ' '; ++aComma) {
+                    // skip spaces in the beginning
+                }
+                aTitle = StString(aComma);
+            }
+        }
+    }
+    return false;
+}
@@ -8,7 +8,11 @@
 
 #include <StStrings/StMsgQueue.h>
 
-StMsgQueue::StMsgQueue() {
+StMsgQueue::StMsgQueue(const size_t theMaxSize)
+: myRepeatWindow(2.0),
+  myMaxSize(stMax(theMaxSize, size_t(1))),
+  myNbDropRep(0),
+  myNbCoalRep(0) {
     //
 }
 
@@ -17,24 +21,23 @@ StMsgQueue::~StMsgQueue() {
 }
 
 void StMsgQueue::popAll() {
-    myMutex.lock();
+    std::deque<StMsg> aBatch;
+    popBatch(aBatch);
+
     StString aText;
     bool hasErrors = false;
     bool isFirst   = true;
-    while(!myQueue.empty()) {
-        const StMsg& aMsg = myQueue.front();
+    for(std::deque<StMsg>::const_iterator aMsgIter = aBatch.begin(); aMsgIter != aBatch.end(); ++aMsgIter) {
         if(!isFirst) {
             aText += "\n\n";
         }
-        aText += *aMsg.Text;
+        aText += aMsgIter->getText();
         isFirst = false;
 
-        if(aMsg.Level == StLogger::ST_ERROR) {
+        if(aMsgIter->Level == StLogger::ST_ERROR) {
             hasErrors = true;
         }
-        myQueue.pop_front();
     }
-    myMutex.unlock();
     if(aText.isEmpty()) {
         return;
     }
@@ -55,13 +58,77 @@ bool StMsgQueue::pop(StMsg& theMessage) {
 
     theMessage = myQueue.front();
     myQueue.pop_front();
+    if(Drained* aDrained = findDrained(theMessage.Level)) {
+        aDrained->Msg = theMessage;
+        aDrained->Timer.restart();
+    }
     myMutex.unlock();
     return true;
 }
 
+size_t StMsgQueue::popBatch(std::deque<StMsg>& theBatch) {
+    // swap the queue to keep the lock short - producers are not blocked while messages are processed
+    theBatch.clear();
+    myMutex.lock();
+    theBatch.swap(myQueue);
+    for(std::deque<StMsg>::const_iterator aMsgIter = theBatch.begin(); aMsgIter != theBatch.end(); ++aMsgIter) {
+        if(Drained* aDrained = findDrained(aMsgIter->Level)) {
+            aDrained->Msg = *aMsgIter;
+            aDrained->Timer.restart();
+        }
+    }
+    const Stats  aStats     = myStats;
+    const size_t aNbDropped = myStats.NbDropped   - myNbDropRep;
+    const size_t aNbFolded  = myStats.NbCoalesced - myNbCoalRep;
+    myNbDropRep = myStats.NbDropped;
+    myNbCoalRep = myStats.NbCoalesced;
+    myMutex.unlock();
+    if(aNbDropped != 0) {
+        ST_ERROR_LOG("StMsgQueue, " + aNbDropped + " messages have been dropped due to queue overflow (" + aStats.toString() + ")");
+    } else if(aNbFolded != 0) {
+        ST_DEBUG_LOG("StMsgQueue, " + aNbFolded + " repeated messages have been folded (" + aStats.toString() + ")");
+    }
+    return theBatch.size();
+}
+
+StMsgQueue::Stats StMsgQueue::getStats() const {
+    myMutex.lock();
+    const Stats aStats = myStats;
+    myMutex.unlock();
+    return aStats;
+}
+
 void StMsgQueue::doPush(const StMsg& theMessage) {
     myMutex.lock();
+    ++myStats.NbPushed;
+
+    // fold identical message, recent messages are checked first
+    for(std::deque<StMsg>::reverse_iterator aMsgIter = myQueue.rbegin(); aMsgIter != myQueue.rend(); ++aMsgIter) {
+        if(aMsgIter->isSame(theMessage)) {
+            aMsgIter->NbRepeats += theMessage.NbRepeats;
+            ++myStats.NbCoalesced;
+            myMutex.unlock();
+            return;
+        }
+    }
+
+    if(myQueue.size() >= myMaxSize) {
+        ++myStats.NbDropped;
+        myMutex.unlock();
+        return;
+    }
+
+    // GUI drains the queue every frame, so that repeated message is usually already shown;
+    // mark it so that GUI would increment the counter of displayed message instead of showing a new one
     myQueue.push_back(theMessage);
+    Drained* aDrained = findDrained(theMessage.Level);
+    if(aDrained != NULL
+    && aDrained->Timer.isOn()
+    && aDrained->Timer.getElapsedTimeInSec() < myRepeatWindow
+    && aDrained->Msg.isSame(theMessage)) {
+        myQueue.back().IsRepeat = true;
+        ++myStats.NbCoalesced;
+    }
     myMutex.unlock();
 }
 
@@ -15,6 +15,13 @@
 
 namespace {
     static size_t THE_UNDO_LIMIT = 1024;
+
+    /**
+     * Number of M3U entries parsed synchronously within open().
+     * Following chunks are parsed in background with growing size up to THE_M3U_CHUNK_MAX.
+     */
+    static const size_t THE_M3U_CHUNK_FIRST = 256;
+    static const size_t THE_M3U_CHUNK_MAX   = 16384;
 }
 
 StPlayItem::StPlayItem(StFileNode* theFileNode,
@@ -167,7 +174,9 @@ StPlayList::StPlayList(const int  theRecursionDeep,
   myIsLoopFlag(theIsLoop),
   myRecentLimit(10),
   myIsNewRecent(false),
-  myWasCleared(false) {
+  myWasCleared(false),
+  myParseGen(0),
+  myIsParsing(false) {
     //
 }
 
@@ -179,9 +188,32 @@ void StPlayList::setExtensions(const StArrayList<StString>& theExtensions) {
             --anExtId;
         }
     }
+
+    StMutexAuto anAutoLock(myMutex);
+    myExtCache.clear();
+}
+
+bool StPlayList::isSupportedExtension(const StString& theExtension) {
+    StString aKey = theExtension;
+    aKey.toLowerCase();
+
+    StMutexAuto anAutoLock(myMutex);
+    std::map<StString, bool>::const_iterator aCached = myExtCache.find(aKey);
+    if(aCached != myExtCache.end()) {
+        return aCached->second;
+    }
+
+    bool isSupported = false;
+    for(size_t anExtId = 0; anExtId < myExtensions.size() && !isSupported; ++anExtId) {
+        isSupported = theExtension.isEqualsIgnoreCase(myExtensions[anExtId]);
+    }
+    myExtCache[aKey] = isSupported;
+    return isSupported;
 }
 
 StPlayList::~StPlayList() {
+    stopParsing();
+    signals.onTargetFound.disconnect();
     signals.onTitleChange.disconnect();
     signals.onPositionChange.disconnect();
     signals.onPlaylistChange.disconnect();
@@ -225,6 +257,8 @@ int32_t StPlayList::getSerial() {
 
 void StPlayList::clear() {
     StMutexAuto anAutoLock(myMutex);
+    ++myParseGen; // cancel background parsing
+    myIsParsing = false;
     if(myFirst != NULL) {
         myWasCleared = true;
         mySerial.increment();
@@ -476,6 +510,30 @@ bool StPlayList::walkToNext(const bool theToForce) {
     return false;
 }
 
+StHandle<StFileNode> StPlayList::getNextFile() {
+    StMutexAuto anAutoLock(myMutex);
+    StPlayItem* aNext = NULL;
+    if(myCurrent == NULL) {
+        return StHandle<StFileNode>();
+    } else if(myToLoopSingle) {
+        aNext = myCurrent;
+    } else if(myIsShuffle && myItemsCount >= 3) {
+        if(!myStackNext.empty()) {
+            aNext = myStackNext.front();
+        }
+    } else if(myCurrent != myLast) {
+        aNext = myCurrent->getNext();
+    } else if(myIsLoopFlag) {
+        aNext = myFirst;
+    }
+
+    StFileNode* aFileNode = aNext != NULL ? aNext->getFileNode() : NULL;
+    if(aFileNode == NULL) {
+        return StHandle<StFileNode>();
+    }
+    return aFileNode->detach();
+}
+
 StHandle<StFileNode> StPlayList::getCurrentFile() {
     StMutexAuto anAutoLock(myMutex);
     if(myCurrent == NULL) {
@@ -615,16 +673,9 @@ bool StPlayList::checkExtension(const StString& thePath) {
         // just folder
         return true;
     }
-    StString anExtension = StFileNode::getExtension(thePath);
-    for(size_t anExtId = 0; anExtId < myExtensions.size(); ++anExtId) {
-        if(anExtension.isEqualsIgnoreCase(myExtensions[anExtId])) {
-            return true;
-        }
-    }
-    if(anExtension.isEqualsIgnoreCase(stCString("m3u"))) {
-        return true;
-    }
-    return false;
+    const StString anExtension = StFileNode::getExtension(thePath);
+    return isSupportedExtension(anExtension)
+        || anExtension.isEqualsIgnoreCase(stCString("m3u"));
 }
 
 void StPlayList::addOneFile(const StString& theFilePath,
@@ -656,69 +707,116 @@ void StPlayList::addOneFile(const StString& theFilePathLeft,
     signals.onPlaylistChange();
 }
 
-static char* nextLine(char* theLine) {
-    for(char* anIter = theLine;; ++anIter) {
-        if(*anIter == '\0') {
-            return anIter;
-        } else if(*anIter == '\n') {
-            return ++anIter;
+bool StPlayList::isParsing() const {
+    StMutexAuto anAutoLock(myMutex);
+    return myIsParsing;
+}
+
+void StPlayList::stopParsing() {
+    myMutex.lock();
+    ++myParseGen;
+    myIsParsing = false;
+    myMutex.unlock();
+    if(!myParseThread.isNull()) {
+        myParseThread->wait();
+        myParseThread.nullify();
+    }
+    myParseTask.nullify();
+}
+
+SV_THREAD_FUNCTION StPlayList::parseM3UThread(void* thePlayList) {
+    StPlayList* aPlayList = (StPlayList* )thePlayList;
+    StM3UTask&  aTask     = *aPlayList->myParseTask;
+    aTask.IsAsync = true;
+    for(size_t aLimit = THE_M3U_CHUNK_FIRST * 2;; aLimit = stMin(aLimit * 2, THE_M3U_CHUNK_MAX)) {
+        if(!aPlayList->parseM3UChunk(aTask, aLimit)) {
+            break;
         }
     }
+    return SV_THREAD_RETURN 0;
 }
 
-char* StPlayList::parseM3UIter(char*     theIter,
-                               StFolder* theFolder,
-                               StString& theTitle) {
-    if(*theIter == '\0') {
-        return NULL;
-    }
-
-    char* aNextLine = nextLine(theIter);
-    if(aNextLine > theIter + 1) {
-        // replace LF or CRLF with '\0'
-        *(aNextLine - 1) = '\0';
-        char* aTail = aNextLine - 2;
-        if(*(aNextLine - 2) == '\x0D') {
-            *(aNextLine - 2) = '\0';
-            --aTail;
+bool StPlayList::parseM3UChunk(StM3UTask&   theTask,
+                               const size_t theLimit) {
+    std::vector<StPlayItem*> aChunk;
+    aChunk.reserve(theLimit);
+    StM3UParser::Entry anEntry;
+    bool isDone = false;
+    for(;;) {
+        if(aChunk.size() >= theLimit) {
+            break;
+        } else if(theTask.Parser.readNext(anEntry)) {
+            StFolder* aFolder = theTask.Folder != NULL
+                             && StFileNode::isRelativePath(anEntry.Path)
+                              ? theTask.Folder
+                              : &myFoldersRoot;
+            StPlayItem* anItem = new StPlayItem(new StFileNode(anEntry.Path, aFolder), theTask.DefParams);
+            anItem->setTitle(anEntry.Title);
+            aChunk.push_back(anItem);
+            continue;
         }
 
-        // skip trailing spaces
-        for(; *aTail == ' ' && aTail >= theIter; --aTail) {
-            *aTail = '\0';
+        // playlist consisting of single playlist item - open nested one
+        if(!theTask.IsNested
+        &&  theTask.NbEntries == 0
+        &&  aChunk.size() == 1
+        &&  StM3UParser::isPlayListPath(aChunk[0]->getPath())
+        &&  theTask.Parser.open(aChunk[0]->getPath())) {
+            delete aChunk[0]->getFileNode();
+            delete aChunk[0];
+            aChunk.clear();
+            theTask.IsNested = true;
+            theTask.Folder   = NULL;
+            continue;
         }
-    }
-    if(*theIter == '\0') {
-        return aNextLine; // skip empty lines
+        isDone = true;
+        break;
     }
 
-    if(*theIter != '#') {
-        StString    anItemPath = theIter;
-        StFolder*   aFolder    = theFolder != NULL
-                              && StFileNode::isRelativePath(anItemPath)
-                               ? theFolder
-                               : &myFoldersRoot;
-        StFileNode* aFileNode  = new StFileNode(anItemPath, aFolder);
-        aFolder->add(aFileNode);
+    StMutexAuto anAutoLock(myMutex);
+    if(theTask.Generation != myParseGen) {
+        // playlist has been cleared or re-opened meanwhile
+        anAutoLock.unlock();
+        for(size_t anIter = 0; anIter < aChunk.size(); ++anIter) {
+            delete aChunk[anIter]->getFileNode();
+            delete aChunk[anIter];
+        }
+        return false;
+    }
 
-        StPlayItem* anItem = new StPlayItem(aFileNode, myDefStParams);
-        anItem->setTitle(theTitle);
+    StPlayItem* aCurrent = myCurrent;
+    bool isTargetFound = false;
+    for(size_t anIter = 0; anIter < aChunk.size(); ++anIter) {
+        StPlayItem* anItem = aChunk[anIter];
+        anItem->getFileNode()->getParent()->add(anItem->getFileNode());
         addPlayItem(anItem);
-        theTitle = "";
-    } else if(stAreEqual(theIter, "#EXTINF:", 8)) {
-        theIter += 8;
-        for(; *theIter != '\0'; ++theIter) {
-            if(*theIter == ',') {
-                for(; *theIter == ' '; ++theIter) {
-                    // skip spaces in the beginning
-                }
-
-                theTitle = ++theIter;
-                break;
-            }
+        if(theTask.HasTarget
+        && aCurrent == NULL
+        && anItem->getPath() == theTask.Target) {
+            aCurrent = anItem;
+            theTask.HasTarget = false;
+            isTargetFound = true;
         }
     }
-    return aNextLine;
+    theTask.NbEntries += aChunk.size();
+    if(aCurrent == NULL
+    && (!theTask.HasTarget || isDone)) {
+        // no target requested or it does not exist in the playlist
+        aCurrent = myFirst;
+        theTask.HasTarget = false;
+        isTargetFound = aCurrent != NULL;
+    }
+    myCurrent = aCurrent;
+    myIsParsing = !isDone;
+
+    const size_t aTargetPos = isTargetFound ? myCurrent->getPosition() : 0;
+    anAutoLock.unlock();
+    signals.onPlaylistChange();
+    if(isTargetFound
+    && theTask.IsAsync) {
+        signals.onTargetFound(aTargetPos);
+    }
+    return !isDone;
 }
 
 bool StPlayList::saveM3U(const StCString& thePath) {
@@ -1010,20 +1108,9 @@ void StPlayList::loadRecentList(const StString theString) {
     }
 }
 
-/**
- * Skip BOM for UTF8 written by some weird programs
- */
-static inline char* skipBOM(char* thePos) {
-    if(thePos[0] == '\xEF'
-    && thePos[1] == '\xBB'
-    && thePos[2] == '\xBF') {
-        return thePos + 3;
-    }
-    return thePos;
-}
-
 void StPlayList::open(const StCString& thePath,
                       const StCString& theItem) {
+    stopParsing();
     StMutexAuto anAutoLock(myMutex);
 
     // check if it is recently played playlist
@@ -1058,56 +1145,28 @@ void StPlayList::open(const StCString& thePath,
         // search only current folder
         StFileNode::getFolderAndFile(thePath, aFolderPath, aFileName);
         aSearchDeep = 1;
-        bool hasSupportedExt = false;
-        StString anExt = StFileNode::getExtension(aFileName);
-        for(size_t anExtId = 0; anExtId < myExtensions.size() && !hasSupportedExt; ++anExtId) {
-            hasSupportedExt = anExt.isEqualsIgnoreCase(myExtensions[anExtId]);
-        }
+        const bool hasSupportedExt = isSupportedExtension(StFileNode::getExtension(aFileName));
 
         // parse m3u playlist
-        if(anExt.isEqualsIgnoreCase(stCString("m3u"))
-        || anExt.isEqualsIgnoreCase(stCString("m3u8"))) {
-            StHandle<StRawFile> aRawFile = new StRawFile(thePath);
-            if(aRawFile->readFile()) {
+        if(StM3UParser::isPlayListPath(aFileName)) {
+            StHandle<StM3UTask> aTask = new StM3UTask();
+            if(aTask->Parser.open(thePath)) {
                 StFolder* aPlsFolder = new StFolder(aFolderPath, &myFoldersRoot);
                 myFoldersRoot.add(aPlsFolder);
-
-                StString aTitle;
-                for(char* anIter = skipBOM((char* )aRawFile->getBuffer()); anIter != NULL;) {
-                    anIter = parseM3UIter(anIter, aPlsFolder, aTitle);
-                }
-                aRawFile.nullify();
-
-                if(myFirst != nullptr
-                && myFirst->getNext() == nullptr) {
-                    const StString aFirstPath = myFirst->getPath();
-                    StString anItemExt = StFileNode::getExtension(aFirstPath);
-                    if(anItemExt.isEqualsIgnoreCase(stCString("m3u"))
-                    || anItemExt.isEqualsIgnoreCase(stCString("m3u8"))) {
-                        aRawFile = new StRawFile(aFirstPath);
-                        if(aRawFile->readFile()) {
-                            for(char* anIter = skipBOM((char* )aRawFile->getBuffer()); anIter != NULL;) {
-                                anIter = parseM3UIter(anIter, NULL, aTitle);
-                            }
-                            remove(aFirstPath, false);
-                        }
-                        aRawFile.nullify();
-                    }
-                }
-
+                aTask->Folder     = aPlsFolder;
+                aTask->Target     = aTarget;
+                aTask->HasTarget  = hasTarget;
+                aTask->DefParams  = myDefStParams;
+                aTask->Generation = myParseGen;
                 myPlsFile = addRecentFile(StFileNode(thePath)); // append to recent files list
-                if(hasTarget) {
-                    // set current item
-                    for(StPlayItem* anItem = myFirst; anItem != NULL; anItem = anItem->getNext()) {
-                        if(anItem->getPath() == aTarget) {
-                            myCurrent = anItem;
-                            break;
-                        }
-                    }
-                }
-
                 anAutoLock.unlock();
-                signals.onPlaylistChange();
+
+                // parse the first portion synchronously, so that the playlist is not empty on return,
+                // and the rest in background
+                if(parseM3UChunk(*aTask, THE_M3U_CHUNK_FIRST)) {
+                    myParseTask   = aTask;
+                    myParseThread = new StThread(parseM3UThread, (void* )this, "StPlayList");
+                }
                 return;
             }
         }
@@ -316,6 +316,31 @@ size_t StRawFile::write(const char*  theBuffer,
     return fwrite(theBuffer, 1, theBytes, myFileHandle);
 }
 
+size_t StRawFile::read(char*        theBuffer,
+                       const size_t theBytes) {
+    if(!isOpen()
+    || theBytes == 0) {
+        return 0;
+    }
+
+    if(myContextIO != NULL) {
+        stUByte_t*   aBufferIter = (stUByte_t* )theBuffer;
+        size_t       aBytesLeft  = theBytes;
+        const size_t aChunkLimit = size_t(std::numeric_limits<int>::max());
+        while(aBytesLeft != 0) {
+            const int aResult = avio_read(myContextIO, aBufferIter, int(stMin(aBytesLeft, aChunkLimit)));
+            if(aResult <= 0) {
+                break;
+            }
+            aBufferIter += aResult;
+            aBytesLeft  -= size_t(aResult);
+        }
+        return theBytes - aBytesLeft;
+    }
+
+    return fread(theBuffer, 1, theBytes, myFileHandle);
+}
+
 size_t StRawFile::writeFile(size_t theBytes) {
     if(myBuffSize == 0) {
         return 0;
@@ -0,0 +1,157 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StThreads/StStartupProfiler.h>
+
+#include <StFile/StRawFile.h>
+#include <StStrings/StLogger.h>
+
+namespace {
+
+    // create profiler on library load, so that time is measured since process start
+    static StStartupProfiler& THE_PROFILER_INIT = StStartupProfiler::getDefault();
+
+    /**
+     * Format time in milliseconds.
+     */
+    static StString formatMs(const double theTimeMs) {
+        char aBuffer[64];
+        stsprintf(aBuffer, 64, "%.3f", theTimeMs);
+        return StString(aBuffer);
+    }
+
+}
+
+StStartupProfiler& StStartupProfiler::getDefault() {
+    static StStartupProfiler THE_PROFILER;
+    return THE_PROFILER;
+}
+
+StStartupProfiler::StStartupProfiler()
+: myTimer(true),
+  myDepth(0),
+  myIsRecording(true) {
+    myPhases.reserve(32);
+}
+
+int StStartupProfiler::begin(const char* thePhase) {
+    StMutexAuto aLock(myMutex);
+    if(!myIsRecording) {
+        return -1;
+    }
+
+    Phase aPhase;
+    aPhase.Name     = thePhase;
+    aPhase.StartMs  = myTimer.getElapsedTimeInMilliSec();
+    aPhase.TimeMs   = 0.0;
+    aPhase.Depth    = myDepth++;
+    aPhase.IsOpened = true;
+    myPhases.push_back(aPhase);
+    return int(myPhases.size() - 1);
+}
+
+void StStartupProfiler::end(const int thePhase) {
+    StMutexAuto aLock(myMutex);
+    if(thePhase < 0
+    || size_t(thePhase) >= myPhases.size()
+    || !myPhases[thePhase].IsOpened) {
+        return;
+    }
+
+    Phase& aPhase = myPhases[thePhase];
+    aPhase.TimeMs   = myTimer.getElapsedTimeInMilliSec() - aPhase.StartMs;
+    aPhase.IsOpened = false;
+    if(myDepth > 0) {
+        --myDepth;
+    }
+}
+
+void StStartupProfiler::mark(const char* theEvent) {
+    StMutexAuto aLock(myMutex);
+    if(!myIsRecording) {
+        return;
+    }
+
+    Phase aPhase;
+    aPhase.Name     = theEvent;
+    aPhase.StartMs  = myTimer.getElapsedTimeInMilliSec();
+    aPhase.TimeMs   = 0.0;
+    aPhase.Depth    = myDepth;
+    aPhase.IsOpened = false;
+    myPhases.push_back(aPhase);
+}
+
+bool StStartupProfiler::finish() {
+    StMutexAuto aLock(myMutex);
+    const bool wasRecording = myIsRecording;
+    myIsRecording = false;
+    return wasRecording;
+}
+
+bool StStartupProfiler::isRecording() const {
+    StMutexAuto aLock(myMutex);
+    return myIsRecording;
+}
+
+StString StStartupProfiler::toString() const {
+    StMutexAuto aLock(myMutex);
+    StString aText = "Startup profile (ms since start / duration):";
+    for(size_t aPhaseIter = 0; aPhaseIter < myPhases.size(); ++aPhaseIter) {
+        const Phase& aPhase = myPhases[aPhaseIter];
+        aText += "\n";
+        for(size_t aDepthIter = 0; aDepthIter < aPhase.Depth; ++aDepthIter) {
+            aText += "  ";
+        }
+        aText += StString(aPhase.Name) + ": " + formatMs(aPhase.StartMs);
+        if(aPhase.IsOpened) {
+            aText += " / not finished";
+        } else if(aPhase.TimeMs > 0.0) {
+            aText += StString(" / ") + formatMs(aPhase.TimeMs);
+        }
+    }
+    return aText;
+}
+
+StString StStartupProfiler::toJson() const {
+    // Trace Event Format, which can be opened by chrome://tracing
+    StMutexAuto aLock(myMutex);
+    StString aJson = "{\"traceEvents\":[";
+    for(size_t aPhaseIter = 0; aPhaseIter < myPhases.size(); ++aPhaseIter) {
+        const Phase& aPhase = myPhases[aPhaseIter];
+        const bool isInstant = aPhase.TimeMs <= 0.0 && !aPhase.IsOpened;
+        if(aPhaseIter != 0) {
+            aJson += ",";
+        }
+        aJson += StString("\n{\"name\":\"") + aPhase.Name
+               + "\",\"ph\":\"" + (isInstant ? "i" : "X")
+               + "\",\"ts\":" + formatMs(aPhase.StartMs * 1000.0);
+        if(!isInstant) {
+            aJson += StString(",\"dur\":") + formatMs(aPhase.TimeMs * 1000.0);
+        }
+        aJson += ",\"pid\":0,\"tid\":0}";
+    }
+    aJson += "\n]}\n";
+    return aJson;
+}
+
+void StStartupProfiler::dumpToLog() const {
+    StLogger::GetDefault().write(toString(), StLogger::ST_INFO);
+}
+
+bool StStartupProfiler::dumpToJson(const StString& thePath) const {
+    StRawFile aFile(thePath);
+    if(!aFile.openFile(StRawFile::WRITE)) {
+        ST_ERROR_LOG("Can not write startup profile into '" + thePath + "'");
+        return false;
+    }
+
+    const StString aJson = toJson();
+    aFile.write(aJson);
+    aFile.closeFile();
+    return true;
+}
@@ -0,0 +1,641 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StImage/StStereoConverter.h>
+
+#include <StAV/StAVVideoMuxer.h>
+#include <StFile/StFileNode.h>
+#include <StGL/StGLDeviceCaps.h>
+#include <StGLStereo/StGLTextureData.h>
+#include <StGLStereo/StGLTextureUploadParams.h>
+#include <StImage/StJpegParser.h>
+#include <StThreads/StThreadPool.h>
+#include <StThreads/StTimer.h>
+
+namespace {
+
+    /**
+     * Return TRUE if file extension belongs to video container.
+     */
+    static bool isVideoPath(const StString& thePath) {
+        static const char* THE_VIDEO_EXT[] = {
+            "mkv", "mk3d", "webm", "mp4", "m4v", "mov", "avi", "wmv",
+            "ts", "m2ts", "mts", "mpg", "mpeg", "flv", "ogv", NULL
+        };
+        const StString anExt = StFileNode::getExtension(thePath);
+        for(const char** anExtIter = THE_VIDEO_EXT; *anExtIter != NULL; ++anExtIter) {
+            if(anExt.isEqualsIgnoreCase(StString(*anExtIter))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Return path with suffix inserted before extension.
+     */
+    static StString pathWithSuffix(const StString&  thePath,
+                                   const StCString& theSuffix) {
+        StString aName, anExt;
+        StFileNode::getNameAndExtension(thePath, aName, anExt);
+        return anExt.isEmpty()
+             ? aName + theSuffix
+             : aName + theSuffix + "." + anExt;
+    }
+
+    /**
+     * Return offsets of red, green and blue components within the pixel or FALSE for unsupported format.
+     */
+    static bool getRgbOffsets(const StImagePlane::ImgFormat theFormat,
+                              size_t                        theOffsets[3]) {
+        switch(theFormat) {
+            case StImagePlane::ImgRGB:
+            case StImagePlane::ImgRGB32:
+            case StImagePlane::ImgRGBA:
+                theOffsets[0] = 0; theOffsets[1] = 1; theOffsets[2] = 2;
+                return true;
+            case StImagePlane::ImgBGR:
+            case StImagePlane::ImgBGR32:
+            case StImagePlane::ImgBGRA:
+                theOffsets[0] = 2; theOffsets[1] = 1; theOffsets[2] = 0;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Copy the whole source plane into destination plane at specified position.
+     */
+    static void copyPlane(const StImagePlane& theSrc,
+                          StImagePlane&       theDst,
+                          const size_t        theRow,
+                          const size_t        theCol) {
+        const size_t aRowBytes = theSrc.getSizeX() * theSrc.getSizePixelBytes();
+        for(size_t aRow = 0; aRow < theSrc.getSizeY(); ++aRow) {
+            stMemCpy(theDst.changeData(theRow + aRow, theCol), theSrc.getData(aRow, 0), aRowBytes);
+        }
+    }
+
+}
+
+StString StStereoConverter::Report::toString() const {
+    const size_t aNbJobs = NbDone + NbFailed;
+    StString aText = StString("Converted ") + NbDone + " of " + aNbJobs + " file(s) within " + WallSec + " s using " + NbThreads + " thread(s)\n";
+    if(WallSec > 0.0) {
+        aText += StString("Throughput: ") + (double(aNbJobs) / WallSec) + " files/s, "
+               + (NbMegaPixels / WallSec) + " MPixels/s\n";
+    }
+    aText += StString("Stages time: decode ") + DecodeSec + " s, transform " + TransformSec + " s, encode " + EncodeSec + " s\n";
+    return aText;
+}
+
+bool StStereoConverter::layoutFromString(const StString& theString,
+                                         Layout&         theLayout) {
+    if(theString.isEqualsIgnoreCase(stCString("sbs"))
+    || theString.isEqualsIgnoreCase(stCString("lr"))) {
+        theLayout = Layout_SideBySide_LR;
+    } else if(theString.isEqualsIgnoreCase(stCString("sbsrl"))
+           || theString.isEqualsIgnoreCase(stCString("rl"))) {
+        theLayout = Layout_SideBySide_RL;
+    } else if(theString.isEqualsIgnoreCase(stCString("ou"))
+           || theString.isEqualsIgnoreCase(stCString("tb"))) {
+        theLayout = Layout_TopBottom_LR;
+    } else if(theString.isEqualsIgnoreCase(stCString("separate"))) {
+        theLayout = Layout_SeparateFrames;
+    } else if(theString.isEqualsIgnoreCase(stCString("rows"))) {
+        theLayout = Layout_Rows;
+    } else if(theString.isEqualsIgnoreCase(stCString("columns"))) {
+        theLayout = Layout_Columns;
+    } else if(theString.isEqualsIgnoreCase(stCString("anaglyph"))
+           || theString.isEqualsIgnoreCase(stCString("anaglyphRC"))) {
+        theLayout = Layout_AnaglyphRedCyan;
+    } else if(theString.isEqualsIgnoreCase(stCString("anaglyphYB"))) {
+        theLayout = Layout_AnaglyphYellowBlue;
+    } else if(theString.isEqualsIgnoreCase(stCString("anaglyphGM"))) {
+        theLayout = Layout_AnaglyphGreenMagenta;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+StFormat StStereoConverter::layoutToFormat(const Layout theLayout) {
+    switch(theLayout) {
+        case Layout_SideBySide_LR:        return StFormat_SideBySide_LR;
+        case Layout_SideBySide_RL:        return StFormat_SideBySide_RL;
+        case Layout_TopBottom_LR:         return StFormat_TopBottom_LR;
+        case Layout_SeparateFrames:       return StFormat_SeparateFrames;
+        case Layout_Rows:                 return StFormat_Rows;
+        case Layout_Columns:              return StFormat_Columns;
+        case Layout_AnaglyphRedCyan:      return StFormat_AnaglyphRedCyan;
+        case Layout_AnaglyphYellowBlue:   return StFormat_AnaglyphYellowBlue;
+        case Layout_AnaglyphGreenMagenta: return StFormat_AnaglyphGreenMagenta;
+    }
+    return StFormat_AUTO;
+}
+
+bool StStereoConverter::splitViews(const StImage& theSrcL,
+                                   const StImage& theSrcR,
+                                   const StFormat theFormat,
+                                   StImage&       theViewL,
+                                   StImage&       theViewR) {
+    switch(theFormat) {
+        case StFormat_AUTO:
+        case StFormat_Mono:
+        case StFormat_AnaglyphRedCyan:
+        case StFormat_AnaglyphGreenMagenta:
+        case StFormat_AnaglyphYellowBlue:
+        case StFormat_NB:
+            return false;
+        case StFormat_SeparateFrames:
+        case StFormat_FrameSequence:
+            if(theSrcR.isNull()) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // re-use splitters preparing views for texture upload
+    StGLDeviceCaps  aCaps;
+    StGLTextureData aData(new StGLTextureUploadParams());
+    aData.updateData(aCaps, theSrcL, theSrcR, StHandle<StStereoParams>(), theFormat, StCubemap_OFF, 0.0);
+    aData.getCopy(&theViewL, &theViewR);
+    return !theViewL.isNull()
+        && !theViewR.isNull();
+}
+
+bool StStereoConverter::composeViews(const StImage& theViewL,
+                                     const StImage& theViewR,
+                                     const Layout   theLayout,
+                                     StImage&       theResult) {
+    theResult.nullify();
+    if(theViewL.isNull()
+    || theViewR.isNull()
+    || !theViewL.isPacked()
+    || !theViewR.isPacked()) {
+        return false;
+    }
+
+    const StImagePlane& aPlaneL = theViewL.getPlane();
+    const StImagePlane& aPlaneR = theViewR.getPlane();
+    if(aPlaneL.getFormat() != aPlaneR.getFormat()
+    || aPlaneL.getSizeX()  != aPlaneR.getSizeX()
+    || aPlaneL.getSizeY()  != aPlaneR.getSizeY()) {
+        return false;
+    }
+
+    const StImagePlane::ImgFormat aFormat = aPlaneL.getFormat();
+    const size_t aSizeX      = aPlaneL.getSizeX();
+    const size_t aSizeY      = aPlaneL.getSizeY();
+    const size_t aPixelBytes = aPlaneL.getSizePixelBytes();
+    const bool   isTopDown   = aPlaneL.isTopDown();
+    StImagePlane& aPlaneOut  = theResult.changePlane();
+    switch(theLayout) {
+        case Layout_SideBySide_LR:
+        case Layout_SideBySide_RL: {
+            if(!aPlaneOut.initTrash(aFormat, aSizeX * 2, aSizeY)) {
+                return false;
+            }
+            const bool isLR = theLayout == Layout_SideBySide_LR;
+            copyPlane(isLR ? aPlaneL : aPlaneR, aPlaneOut, 0, 0);
+            copyPlane(isLR ? aPlaneR : aPlaneL, aPlaneOut, 0, aSizeX);
+            break;
+        }
+        case Layout_TopBottom_LR: {
+            if(!aPlaneOut.initTrash(aFormat, aSizeX, aSizeY * 2)) {
+                return false;
+            }
+            // rows in memory might be stored in bottom-up order
+            copyPlane(isTopDown ? aPlaneL : aPlaneR, aPlaneOut, 0,      0);
+            copyPlane(isTopDown ? aPlaneR : aPlaneL, aPlaneOut, aSizeY, 0);
+            break;
+        }
+        case Layout_Rows: {
+            if(!aPlaneOut.initTrash(aFormat, aSizeX, aSizeY)) {
+                return false;
+            }
+            for(size_t aRow = 0; aRow < aSizeY; ++aRow) {
+                const size_t aRowTop = isTopDown ? aRow : (aSizeY - 1 - aRow);
+                const StImagePlane& aFrom = (aRowTop % 2 == 0) ? aPlaneL : aPlaneR;
+                stMemCpy(aPlaneOut.changeData(aRow, 0), aFrom.getData(aRow, 0), aSizeX * aPixelBytes);
+            }
+            break;
+        }
+        case Layout_Columns: {
+            if(!aPlaneOut.initTrash(aFormat, aSizeX, aSizeY)) {
+                return false;
+            }
+            for(size_t aRow = 0; aRow < aSizeY; ++aRow) {
+                for(size_t aCol = 0; aCol < aSizeX; ++aCol) {
+                    const StImagePlane& aFrom = (aCol % 2 == 0) ? aPlaneL : aPlaneR;
+                    stMemCpy(aPlaneOut.changeData(aRow, aCol), aFrom.getData(aRow, aCol), aPixelBytes);
+                }
+            }
+            break;
+        }
+        case Layout_AnaglyphRedCyan:
+        case Layout_AnaglyphYellowBlue:
+        case Layout_AnaglyphGreenMagenta: {
+            size_t anOffsets[3] = { 0, 1, 2 };
+            if(!getRgbOffsets(aFormat, anOffsets)
+            || !aPlaneOut.initTrash(aFormat, aSizeX, aSizeY)) {
+                return false;
+            }
+
+            // channels taken from the right view, the same as simple anaglyph programs do
+            bool toTakeR[3] = { true, true, true };
+            switch(theLayout) {
+                case Layout_AnaglyphRedCyan:      toTakeR[0] = false; break;
+                case Layout_AnaglyphYellowBlue:   toTakeR[0] = false; toTakeR[1] = false; break;
+                case Layout_AnaglyphGreenMagenta: toTakeR[1] = false; break;
+                default: break;
+            }
+            copyPlane(aPlaneL, aPlaneOut, 0, 0);
+            for(size_t aRow = 0; aRow < aSizeY; ++aRow) {
+                const GLubyte* aSrcR = aPlaneR.getData(aRow, 0);
+                GLubyte*       aDst  = aPlaneOut.changeData(aRow, 0);
+                for(size_t aCol = 0; aCol < aSizeX; ++aCol, aSrcR += aPixelBytes, aDst += aPixelBytes) {
+                    for(size_t aCompIter = 0; aCompIter < 3; ++aCompIter) {
+                        if(toTakeR[aCompIter]) {
+                            aDst[anOffsets[aCompIter]] = aSrcR[anOffsets[aCompIter]];
+                        }
+                    }
+                }
+            }
+            break;
+        }
+        case Layout_SeparateFrames: {
+            return false;
+        }
+    }
+
+    aPlaneOut.setTopDown(isTopDown);
+    theResult.setColorModel(theViewL.getColorModel());
+    theResult.setColorScale(theViewL.getColorScale());
+    theResult.setPixelRatio(theViewL.getPixelRatio());
+    return true;
+}
+
+StStereoConverter::StStereoConverter(const StImageFile::ImageClass theImageLib,
+                                     const Layout                  theLayout,
+                                     const int                     theNbThreads)
+: myImageLib(theImageLib),
+  myLayout(theLayout),
+  myNbThreads(theNbThreads > 0 ? theNbThreads : StThreadPool::getDefault().getConcurrencyBudget()),
+  myMaxDecoded(0),
+  myEventChanged(false),
+  myNextDecode(0),
+  myNbDecoded(0),
+  myNbFinished(0) {
+    // keep enough decoded images to feed all threads, but do not decode the whole batch ahead
+    myMaxDecoded = size_t(myNbThreads) * 2;
+}
+
+StStereoConverter::~StStereoConverter() {
+    //
+}
+
+void StStereoConverter::addJob(const Job& theJob) {
+    StHandle<Item> anItem = new Item();
+    anItem->Task    = theJob;
+    anItem->IsVideo = isVideoPath(theJob.SrcPath);
+    myItems.push_back(anItem);
+}
+
+bool StStereoConverter::perform() {
+    myReport = Report();
+    myReport.NbThreads = myNbThreads;
+    myNextDecode = 0;
+    myNbDecoded  = 0;
+    myNbFinished = 0;
+    myEventChanged.reset();
+
+    StTimer aWallTimer(true);
+    // calling thread takes part in conversion, so that jobs are processed even when pool is busy
+    std::vector< StHandle<StThreadPool::Task> > aTasks;
+    for(int aTaskIter = 1; aTaskIter < myNbThreads; ++aTaskIter) {
+        aTasks.push_back(new WorkerTask(this));
+        StThreadPool::getDefault().push(aTasks.back());
+    }
+    workerLoop();
+    for(size_t aTaskIter = 0; aTaskIter < aTasks.size(); ++aTaskIter) {
+        aTasks[aTaskIter]->wait();
+    }
+    myReport.WallSec = aWallTimer.getElapsedTimeInSec();
+
+    myItems.clear();
+    return myReport.NbFailed == 0;
+}
+
+void StStereoConverter::workerLoop() {
+    for(;;) {
+        StHandle<Item> anItem;
+        {
+            StMutexAuto aLock(myMutex);
+            if(myNbFinished >= myItems.size()) {
+                myEventChanged.set(); // wake up other threads to exit
+                return;
+            }
+
+            // prefer the most advanced stage to release memory as soon as possible
+            for(size_t anIter = 0; anIter < myNextDecode && anItem.isNull(); ++anIter) {
+                const StHandle<Item>& aCand = myItems[anIter];
+                if(!aCand->IsBusy
+                && aCand->State == Stage_Encode) {
+                    anItem = aCand;
+                }
+            }
+            for(size_t anIter = 0; anIter < myNextDecode && anItem.isNull(); ++anIter) {
+                const StHandle<Item>& aCand = myItems[anIter];
+                if(!aCand->IsBusy
+                && aCand->State == Stage_Transform) {
+                    anItem = aCand;
+                }
+            }
+            if(anItem.isNull()
+            && myNextDecode < myItems.size()
+            && myNbDecoded  < myMaxDecoded) {
+                anItem = myItems[myNextDecode++];
+                ++myNbDecoded;
+            }
+
+            if(anItem.isNull()) {
+                myEventChanged.reset();
+            } else {
+                anItem->IsBusy = true;
+            }
+        }
+        if(anItem.isNull()) {
+            myEventChanged.wait();
+            continue;
+        }
+
+        StTimer aStageTimer(true);
+        const Stage aStage = anItem->State;
+        bool isDone = false;
+        switch(aStage) {
+            case Stage_Decode:    isDone = decode(*anItem);    break;
+            case Stage_Transform: isDone = transform(*anItem); break;
+            case Stage_Encode:    isDone = encode(*anItem);    break;
+            case Stage_Finished:  break;
+        }
+        const double aStageSec = aStageTimer.getElapsedTimeInSec();
+
+        bool isFinished = false;
+        {
+            StMutexAuto aLock(myMutex);
+            switch(aStage) {
+                case Stage_Decode:    myReport.DecodeSec    += aStageSec; break;
+                case Stage_Transform: myReport.TransformSec += aStageSec; break;
+                case Stage_Encode:    myReport.EncodeSec    += aStageSec; break;
+                case Stage_Finished:  break;
+            }
+
+            anItem->IsBusy = false;
+            if(!isDone
+            || aStage == Stage_Encode) {
+                isFinished = true;
+                anItem->State = Stage_Finished;
+                --myNbDecoded;
+                ++myNbFinished;
+                if(isDone) {
+                    ++myReport.NbDone;
+                } else {
+                    ++myReport.NbFailed;
+                }
+            } else {
+                anItem->State = Stage(aStage + 1);
+            }
+            myEventChanged.set();
+        }
+
+        if(isFinished) {
+            if(isDone) {
+                signals.onDone(anItem->Task.DstPath);
+            } else {
+                signals.onError(anItem->Task.SrcPath + ": " + anItem->Error);
+            }
+
+            // release memory
+            anItem->FrameL.nullify();
+            anItem->FrameR.nullify();
+            anItem->ViewL.nullify();
+            anItem->ViewR.nullify();
+            anItem->Result.nullify();
+            anItem->ResultR.nullify();
+        }
+    }
+}
+
+bool StStereoConverter::decode(Item& theItem) {
+    theItem.Format = theItem.Task.SrcFormat;
+    if(theItem.IsVideo) {
+        // video is remuxed as is within encode stage
+        if(theItem.Format == StFormat_AUTO) {
+            StString aFolder, aFileName;
+            StFileNode::getFolderAndFile(theItem.Task.SrcPath, aFolder, aFileName);
+            bool isAnamorph = false;
+            theItem.Format = st::formatFromName(aFileName, false, isAnamorph);
+        }
+        if(!theItem.Task.SrcPathR.isEmpty()) {
+            theItem.Format = StFormat_SeparateFrames;
+        }
+        return true;
+    }
+
+    if(!decodeImage(theItem)) {
+        return false;
+    }
+
+    const StImage& aFrame = *theItem.FrameL;
+    if(theItem.Format == StFormat_AUTO) {
+        StString aFolder, aFileName;
+        StFileNode::getFolderAndFile(theItem.Task.SrcPath, aFolder, aFileName);
+        bool isAnamorph = false;
+        theItem.Format = st::formatFromName(aFileName, false, isAnamorph);
+    }
+    if(theItem.Format == StFormat_AUTO) {
+        theItem.Format = st::formatFromRatio(aFrame.getRatio());
+    }
+
+    myMutex.lock();
+    myReport.NbMegaPixels += double(aFrame.getSizeX() * aFrame.getSizeY()) * 0.000001;
+    if(!theItem.FrameR.isNull()) {
+        myReport.NbMegaPixels += double(theItem.FrameR->getSizeX() * theItem.FrameR->getSizeY()) * 0.000001;
+    }
+    myMutex.unlock();
+    return true;
+}
+
+bool StStereoConverter::decodeImage(Item& theItem) {
+    const StString& aPath = theItem.Task.SrcPath;
+    const StImageFile::ImageType anImgType = StImageFile::guessImageType(aPath, StMIME());
+    theItem.FrameL = StImageFile::create(myImageLib, anImgType);
+    if(theItem.FrameL.isNull()) {
+        theItem.Error = "no image library";
+        return false;
+    }
+
+    if(anImgType == StImageFile::ST_TYPE_MPO
+    || anImgType == StImageFile::ST_TYPE_JPEG
+    || anImgType == StImageFile::ST_TYPE_JPS) {
+        // the pair of largest images within MPO is a stereopair
+        StJpegParser aParser;
+        if(!aParser.readFile(aPath)) {
+            theItem.Error = "file can not be read";
+            return false;
+        }
+
+        StHandle<StJpegParser::Image> anImg1, anImg2;
+        size_t aMaxSizeX = 0, aMaxSizeY = 0;
+        for(StHandle<StJpegParser::Image> anImgIter = aParser.getImage(0); !anImgIter.isNull(); anImgIter = anImgIter->Next) {
+            aMaxSizeX = stMax(aMaxSizeX, anImgIter->SizeX);
+            aMaxSizeY = stMax(aMaxSizeY, anImgIter->SizeY);
+        }
+        for(StHandle<StJpegParser::Image> anImgIter = aParser.getImage(0); !anImgIter.isNull(); anImgIter = anImgIter->Next) {
+            if(anImgIter->SizeX != aMaxSizeX
+            || anImgIter->SizeY != aMaxSizeY) {
+                continue;
+            } else if(anImg1.isNull()) {
+                anImg1 = anImgIter;
+            } else if(anImg2.isNull()) {
+                anImg2 = anImgIter;
+            }
+        }
+        if(theItem.Format == StFormat_AUTO) {
+            theItem.Format = aParser.getSrcFormat();
+        }
+
+        if(anImg1.isNull()
+        || !theItem.FrameL->loadExtra(aPath, StImageFile::ST_TYPE_JPEG, (uint8_t* )anImg1->Data, (int )anImg1->Length, true)) {
+            theItem.Error = theItem.FrameL->getState();
+            return false;
+        }
+        if(!anImg2.isNull()) {
+            theItem.FrameR = StImageFile::create(myImageLib, StImageFile::ST_TYPE_JPEG);
+            if(theItem.FrameR.isNull()
+            || !theItem.FrameR->loadExtra(aPath, StImageFile::ST_TYPE_JPEG, (uint8_t* )anImg2->Data, (int )anImg2->Length, true)) {
+                theItem.Error = !theItem.FrameR.isNull() ? theItem.FrameR->getState() : StString("no image library");
+                return false;
+            }
+            theItem.Format = StFormat_SeparateFrames;
+        }
+    } else if(!theItem.FrameL->loadExtra(aPath, anImgType, NULL, 0, true)) {
+        theItem.Error = theItem.FrameL->getState();
+        return false;
+    } else if(theItem.Format == StFormat_AUTO) {
+        theItem.Format = theItem.FrameL->getFormat();
+    }
+
+    if(!theItem.Task.SrcPathR.isEmpty()) {
+        const StImageFile::ImageType anImgTypeR = StImageFile::guessImageType(theItem.Task.SrcPathR, StMIME());
+        theItem.FrameR = StImageFile::create(myImageLib, anImgTypeR);
+        if(theItem.FrameR.isNull()
+        || !theItem.FrameR->loadExtra(theItem.Task.SrcPathR, anImgTypeR, NULL, 0, true)) {
+            theItem.Error = !theItem.FrameR.isNull() ? theItem.FrameR->getState() : StString("no image library");
+            return false;
+        }
+        theItem.Format = StFormat_SeparateFrames;
+    }
+    return true;
+}
+
+bool StStereoConverter::transform(Item& theItem) {
+    if(theItem.IsVideo) {
+        return true;
+    }
+
+    const StImage anEmpty;
+    const bool isSplit = splitViews(*theItem.FrameL,
+                                    !theItem.FrameR.isNull() ? (const StImage& )*theItem.FrameR : anEmpty,
+                                    theItem.Format, theItem.ViewL, theItem.ViewR);
+    theItem.FrameL.nullify();
+    theItem.FrameR.nullify();
+    if(!isSplit) {
+        theItem.Error = StString("unable to extract views from ") + st::formatToString(theItem.Format) + " source";
+        return false;
+    }
+
+    const StImageFile::ImageType anImgType = StImageFile::guessImageType(theItem.Task.DstPath, StMIME());
+    theItem.Result = StImageFile::create(myImageLib, anImgType);
+    if(theItem.Result.isNull()) {
+        theItem.Error = "no image library";
+        return false;
+    }
+
+    if(myLayout == Layout_SeparateFrames) {
+        theItem.ResultR = StImageFile::create(myImageLib, anImgType);
+        if(theItem.ResultR.isNull()) {
+            theItem.Error = "no image library";
+            return false;
+        }
+        theItem.Result ->initWrapper(theItem.ViewL);
+        theItem.ResultR->initWrapper(theItem.ViewR);
+        return true;
+    }
+
+    if(!composeViews(theItem.ViewL, theItem.ViewR, myLayout, *theItem.Result)) {
+        theItem.Error = StString("unable to compose views in ") + theItem.ViewL.getPlane().formatImgFormat() + " format";
+        return false;
+    }
+    theItem.ViewL.nullify();
+    theItem.ViewR.nullify();
+    return true;
+}
+
+void StStereoConverter::doMuxerError(const StCString& theMsg) {
+    signals.onError(theMsg);
+}
+
+bool StStereoConverter::encode(Item& theItem) {
+    if(theItem.IsVideo) {
+        const StFormat aLayoutFormat = layoutToFormat(myLayout);
+        if(theItem.Format != aLayoutFormat) {
+            theItem.Error = "re-layout of video frames requires re-encoding, which is not supported - only remuxing of "
+                          + st::formatToString(aLayoutFormat) + " source is possible";
+            return false;
+        }
+
+        StAVVideoMuxer aMuxer;
+        aMuxer.signals.onError.connect(this, &StStereoConverter::doMuxerError);
+        if(!aMuxer.addFile(theItem.Task.SrcPath)
+        || (!theItem.Task.SrcPathR.isEmpty() && !aMuxer.addFile(theItem.Task.SrcPathR))) {
+            theItem.Error = "file can not be opened";
+            return false;
+        }
+        aMuxer.setStereoFormat(theItem.Format);
+        if(!aMuxer.save(theItem.Task.DstPath)) {
+            theItem.Error = "remuxing has failed";
+            return false;
+        }
+        return true;
+    }
+
+    const StImageFile::ImageType anImgType = StImageFile::guessImageType(theItem.Task.DstPath, StMIME());
+    if(myLayout == Layout_SeparateFrames) {
+        const StString aPathL = pathWithSuffix(theItem.Task.DstPath, stCString("-L"));
+        const StString aPathR = pathWithSuffix(theItem.Task.DstPath, stCString("-R"));
+        if(!theItem.Result->save(aPathL, anImgType, StFormat_Mono)) {
+            theItem.Error = theItem.Result->getState();
+            return false;
+        } else if(!theItem.ResultR->save(aPathR, anImgType, StFormat_Mono)) {
+            theItem.Error = theItem.ResultR->getState();
+            return false;
+        }
+        return true;
+    }
+
+    if(!theItem.Result->save(theItem.Task.DstPath, anImgType, layoutToFormat(myLayout))) {
+        theItem.Error = theItem.Result->getState();
+        return false;
+    }
+    return true;
+}
@@ -35,6 +35,10 @@
     #else
         #include <sched.h>
     #endif
+    #if defined(__linux__)
+        #include <sys/resource.h>
+        #include <sys/syscall.h>
+    #endif
 #endif
 
 #include <StFile/StRawFile.h>
@@ -113,6 +117,50 @@ void StThread::setCurrentThreadName(const char* theName) {
 #endif
 }
 
+void StThread::setCurrentThreadLowPriority() {
+#ifdef _WIN32
+    ::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+    // Linux applies nice value to individual threads
+    if(setpriority(PRIO_PROCESS, (id_t )syscall(SYS_gettid), 10) != 0) {
+        ST_DEBUG_LOG("StThread, unable to lower thread priority");
+    }
+#else
+    sched_param aParams;
+    int aPolicy = SCHED_OTHER;
+    if(pthread_getschedparam(pthread_self(), &aPolicy, &aParams) == 0) {
+        aParams.sched_priority = sched_get_priority_min(aPolicy);
+        pthread_setschedparam(pthread_self(), aPolicy, &aParams);
+    }
+#endif
+}
+
+bool StThread::setCurrentThreadAffinity(const int theCpuIndex) {
+    if(theCpuIndex < 0) {
+        return false;
+    }
+#ifdef _WIN32
+    if(theCpuIndex >= int(sizeof(DWORD_PTR) * 8)) {
+        return false;
+    }
+    return ::SetThreadAffinityMask(::GetCurrentThread(), DWORD_PTR(1) << theCpuIndex) != 0;
+#elif defined(__ANDROID__)
+    cpu_set_t aCpuSet;
+    CPU_ZERO(&aCpuSet);
+    CPU_SET(theCpuIndex, &aCpuSet);
+    return sched_setaffinity(0, sizeof(aCpuSet), &aCpuSet) == 0;
+#elif defined(__linux__)
+    cpu_set_t aCpuSet;
+    CPU_ZERO(&aCpuSet);
+    CPU_SET(theCpuIndex, &aCpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(aCpuSet), &aCpuSet) == 0;
+#else
+    // thread affinity is not exposed (macOS provides only affinity hints)
+    (void )theCpuIndex;
+    return false;
+#endif
+}
+
 bool StThread::wait() {
     if(!isValid()) {
         return false;
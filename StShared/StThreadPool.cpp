@@ -0,0 +1,327 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StThreads/StThreadPool.h>
+
+namespace {
+    static StMutex                THE_POOL_MUTEX;
+    static StHandle<StThreadPool> THE_POOL;
+}
+
+StThreadPool::Task::Task()
+: myEventDone(true) {
+    //
+}
+
+StThreadPool::Task::~Task() {
+    //
+}
+
+StString StThreadPool::Stats::toString() const {
+    return StString("threads: ") + NbThreads
+         + "+"                   + NbBgThreads
+         + ", budget: "          + Budget
+         + ", queued: "          + (uint64_t )NbQueued[Priority_Realtime]
+         + "/"                   + (uint64_t )NbQueued[Priority_Normal]
+         + "/"                   + (uint64_t )NbQueued[Priority_Background]
+         + " (max "              + (uint64_t )MaxQueued
+         + "), executed: "       + (uint64_t )NbExecuted
+         + ", stolen: "          + (uint64_t )NbStolen;
+}
+
+StThreadPool& StThreadPool::getDefault() {
+    StMutexAuto aLock(THE_POOL_MUTEX);
+    if(THE_POOL.isNull()) {
+        THE_POOL = new StThreadPool();
+    }
+    return *THE_POOL;
+}
+
+void StThreadPool::releaseDefault() {
+    StMutexAuto aLock(THE_POOL_MUTEX);
+    THE_POOL.nullify();
+}
+
+StThreadPool::StThreadPool(const int      theNbThreads,
+                           const Affinity theAffinity)
+: myEventWake(false),
+  myEventWakeBg(false),
+  myNbQueued(0),
+  myNbQueuedBg(0),
+  myNbExecuted(0),
+  myNbStolen(0),
+  myNextQueue(0),
+  myMaxQueued(0),
+  myNbThreads(theNbThreads > 0 ? theNbThreads : stMax(StThread::countLogicalProcessors(), 1)),
+  myNbBgThreads(1),
+  myBudget(stMax(StThread::countLogicalProcessors(), 1)),
+  myAffinity(theAffinity),
+  myIsStarted(false),
+  myToQuit(false) {
+    // background tasks are mostly I/O bound - keep at least two of them progressing
+    myNbBgThreads = stMax(myNbThreads / 2, 2);
+    for(int aWorkerIter = 0; aWorkerIter < myNbThreads; ++aWorkerIter) {
+        myWorkers.push_back(new Worker(this, aWorkerIter));
+    }
+}
+
+StThreadPool::~StThreadPool() {
+    stopThreads();
+}
+
+void StThreadPool::startThreads() {
+    StMutexAuto aLock(myMutex);
+    if(myIsStarted) {
+        return;
+    }
+
+    for(int aWorkerIter = 0; aWorkerIter < myNbThreads; ++aWorkerIter) {
+        myThreads.push_back(new StThread(threadFunction, myWorkers[aWorkerIter].access(), "StThreadPool"));
+    }
+    for(int aWorkerIter = 0; aWorkerIter < myNbBgThreads; ++aWorkerIter) {
+        myThreads.push_back(new StThread(threadFunctionBg, this, "StThreadPoolBg"));
+    }
+    myIsStarted = true;
+}
+
+void StThreadPool::stopThreads() {
+    StMutexAuto aLock(myMutex);
+    myToQuit = true;
+    myEventWake.set();
+    myEventWakeBg.set();
+    for(size_t aThreadIter = 0; aThreadIter < myThreads.size(); ++aThreadIter) {
+        myThreads[aThreadIter]->wait();
+    }
+    myThreads.clear();
+}
+
+void StThreadPool::push(const StHandle<Task>& theTask,
+                        const Priority        thePriority) {
+    if(theTask.isNull()) {
+        return;
+    }
+
+    if(!myIsStarted) {
+        startThreads();
+    }
+
+    theTask->myEventDone.reset();
+    switch(thePriority) {
+        case Priority_Realtime: {
+            myRtMutex.lock();
+            myRealtime.push_back(theTask);
+            myRtMutex.unlock();
+            myNbQueued.increment();
+            myEventWake.set();
+            break;
+        }
+        case Priority_Background: {
+            myBgMutex.lock();
+            myBackground.push_back(theTask);
+            myBgMutex.unlock();
+            myNbQueuedBg.increment();
+            myEventWakeBg.set();
+            break;
+        }
+        case Priority_Normal:
+        default: {
+            // keep tasks spawned by worker within its own queue (better cache locality)
+            int aWorkerIndex = findWorker(StThread::getCurrentThreadId());
+            if(aWorkerIndex < 0) {
+                aWorkerIndex = int(size_t(myNextQueue.increment() & 0x7FFFFFFF) % myWorkers.size());
+            }
+            Worker& aWorker = *myWorkers[aWorkerIndex];
+            aWorker.Mutex.lock();
+            aWorker.Queue.push_back(theTask);
+            aWorker.Mutex.unlock();
+            myNbQueued.increment();
+            myEventWake.set();
+            break;
+        }
+    }
+    updateMaxQueued();
+}
+
+void StThreadPool::updateMaxQueued() {
+    // approximate value - concurrent pushes may lose an update
+    const size_t aNbQueued = size_t(stMax(myNbQueued.getValue(), 0) + stMax(myNbQueuedBg.getValue(), 0));
+    if(aNbQueued > myMaxQueued) {
+        myMaxQueued = aNbQueued;
+    }
+}
+
+StThreadPool::Stats StThreadPool::getStats() const {
+    Stats aStats;
+    aStats.NbThreads   = myNbThreads;
+    aStats.NbBgThreads = myNbBgThreads;
+    aStats.Budget      = myBudget;
+    myRtMutex.lock();
+    aStats.NbQueued[Priority_Realtime] = myRealtime.size();
+    myRtMutex.unlock();
+    myBgMutex.lock();
+    aStats.NbQueued[Priority_Background] = myBackground.size();
+    myBgMutex.unlock();
+    for(size_t aWorkerIter = 0; aWorkerIter < myWorkers.size(); ++aWorkerIter) {
+        const Worker& aWorker = *myWorkers[aWorkerIter];
+        StMutexAuto aLock(aWorker.Mutex);
+        aStats.NbQueued[Priority_Normal] += aWorker.Queue.size();
+    }
+    aStats.MaxQueued  = myMaxQueued;
+    aStats.NbExecuted = size_t(myNbExecuted.getValue());
+    aStats.NbStolen   = size_t(myNbStolen.getValue());
+    return aStats;
+}
+
+int StThreadPool::getConcurrencyBudget() const {
+    return myBudget;
+}
+
+void StThreadPool::setConcurrencyBudget(const int theBudget) {
+    StMutexAuto aLock(myMutex);
+    myBudget = theBudget > 0 ? theBudget : stMax(StThread::countLogicalProcessors(), 1);
+}
+
+int StThreadPool::getCodecThreads(const int theNbDecoders) const {
+    return stMax(getConcurrencyBudget() / stMax(theNbDecoders, 1), 1);
+}
+
+SV_THREAD_FUNCTION StThreadPool::threadFunction(void* theWorker) {
+    Worker* aWorker = (Worker* )theWorker;
+    aWorker->Pool->workerLoop(aWorker->Index);
+    return SV_THREAD_RETURN 0;
+}
+
+SV_THREAD_FUNCTION StThreadPool::threadFunctionBg(void* thePool) {
+    StThread::setCurrentThreadLowPriority();
+    StThreadPool* aPool = (StThreadPool* )thePool;
+    aPool->workerLoopBg();
+    return SV_THREAD_RETURN 0;
+}
+
+int StThreadPool::findWorker(const size_t theThreadId) const {
+    for(size_t aWorkerIter = 0; aWorkerIter < myWorkers.size(); ++aWorkerIter) {
+        if(myWorkers[aWorkerIter]->ThreadId == theThreadId) {
+            return int(aWorkerIter);
+        }
+    }
+    return -1;
+}
+
+bool StThreadPool::popTask(TaskQueue&      theQueue,
+                           StMutex&        theMutex,
+                           const bool      theToFront,
+                           StHandle<Task>& theTask) {
+    StMutexAuto aLock(theMutex);
+    if(theQueue.empty()) {
+        return false;
+    }
+
+    if(theToFront) {
+        theTask = theQueue.front();
+        theQueue.pop_front();
+    } else {
+        theTask = theQueue.back();
+        theQueue.pop_back();
+    }
+    return true;
+}
+
+bool StThreadPool::pickTask(const int       theWorker,
+                            StHandle<Task>& theTask) {
+    if(popTask(myRealtime, myRtMutex, true, theTask)) {
+        return true;
+    }
+
+    // own queue - take the newest task
+    Worker& anOwn = *myWorkers[theWorker];
+    if(popTask(anOwn.Queue, anOwn.Mutex, false, theTask)) {
+        return true;
+    }
+
+    // steal the oldest task from other workers, skipping queues locked right now;
+    // the queue is checked only under the lock as it is modified by other threads
+    for(size_t anOffset = 1; anOffset < myWorkers.size(); ++anOffset) {
+        Worker& aVictim = *myWorkers[(size_t(theWorker) + anOffset) % myWorkers.size()];
+        if(!aVictim.Mutex.tryLock()) {
+            continue;
+        }
+
+        const bool isStolen = !aVictim.Queue.empty();
+        if(isStolen) {
+            theTask = aVictim.Queue.front();
+            aVictim.Queue.pop_front();
+        }
+        aVictim.Mutex.unlock();
+        if(isStolen) {
+            myNbStolen.increment();
+            return true;
+        }
+    }
+    return false;
+}
+
+void StThreadPool::workerLoop(const int theWorker) {
+    myWorkers[theWorker]->ThreadId = StThread::getCurrentThreadId();
+    if(myAffinity == Affinity_PerCore) {
+        StThread::setCurrentThreadAffinity(theWorker % stMax(StThread::countLogicalProcessors(), 1));
+    }
+
+    for(;;) {
+        StHandle<Task> aTask;
+        if(!pickTask(theWorker, aTask)) {
+            if(myToQuit
+            && myNbQueued.getValue() == 0) {
+                return;
+            }
+
+            // reset the event before re-checking the counter, so that concurrent push is not missed
+            myEventWake.reset();
+            if(myNbQueued.getValue() == 0
+            && !myToQuit) {
+                myEventWake.wait();
+            }
+            continue;
+        }
+
+        // wake up another idle worker for the remaining tasks
+        if(myNbQueued.decrement() > 0) {
+            myEventWake.set();
+        }
+
+        aTask->perform();
+        myNbExecuted.increment();
+        aTask->myEventDone.set();
+    }
+}
+
+void StThreadPool::workerLoopBg() {
+    for(;;) {
+        StHandle<Task> aTask;
+        if(!popTask(myBackground, myBgMutex, true, aTask)) {
+            if(myToQuit
+            && myNbQueuedBg.getValue() == 0) {
+                return;
+            }
+
+            myEventWakeBg.reset();
+            if(myNbQueuedBg.getValue() == 0
+            && !myToQuit) {
+                myEventWakeBg.wait();
+            }
+            continue;
+        }
+
+        if(myNbQueuedBg.decrement() > 0) {
+            myEventWakeBg.set();
+        }
+
+        aTask->perform();
+        myNbExecuted.increment();
+        aTask->myEventDone.set();
+    }
+}
@@ -0,0 +1,552 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StImage/StThumbnailCache.h>
+
+#include <StAV/StAVImage.h>
+#include <StImage/StImageFile.h>
+#include <StFile/StFolder.h>
+#include <StFile/StRawFile.h>
+#include <StTemplates/StHashIndex.h>
+#include <StStrings/StLogger.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+    static const char     THE_THUMB_MAGIC[4] = { 'S', 'T', 'T', 'H' };
+    static const uint32_t THE_THUMB_VERSION  = 1;
+
+    /**
+     * Size of the file beginning to look for EXIF thumbnail (APP1 section is limited to 64 KiB).
+     */
+    static const size_t THE_EXIF_READ_MAX = 256 * 1024;
+
+    /**
+     * Header of the cached thumbnail, followed by file path and RGB pixels.
+     */
+    struct StThumbCacheHeader {
+        char     Magic[4];
+        uint32_t Version;
+        int64_t  FileSize;
+        int64_t  ModTime;
+        uint32_t SizeX;
+        uint32_t SizeY;
+        uint32_t PathSize;
+        uint32_t Reserved;
+    };
+
+    /**
+     * Read the pixel as 8-bit RGB.
+     * @return FALSE if pixel format is not supported
+     */
+    inline bool readPixel(const StImagePlane& thePlane,
+                          const size_t        theRow,
+                          const size_t        theCol,
+                          unsigned int        theRgb[3]) {
+        const GLubyte* aData = thePlane.getData(theRow, theCol);
+        switch(thePlane.getFormat()) {
+            case StImagePlane::ImgGray: {
+                theRgb[0] = theRgb[1] = theRgb[2] = aData[0];
+                return true;
+            }
+            case StImagePlane::ImgGray16: {
+                theRgb[0] = theRgb[1] = theRgb[2] = (*(const uint16_t* )aData) >> 8;
+                return true;
+            }
+            case StImagePlane::ImgRGB:
+            case StImagePlane::ImgRGB32:
+            case StImagePlane::ImgRGBA: {
+                theRgb[0] = aData[0];
+                theRgb[1] = aData[1];
+                theRgb[2] = aData[2];
+                return true;
+            }
+            case StImagePlane::ImgBGR:
+            case StImagePlane::ImgBGR32:
+            case StImagePlane::ImgBGRA: {
+                theRgb[0] = aData[2];
+                theRgb[1] = aData[1];
+                theRgb[2] = aData[0];
+                return true;
+            }
+            case StImagePlane::ImgRGB48:
+            case StImagePlane::ImgRGBA64: {
+                const uint16_t* aData16 = (const uint16_t* )aData;
+                theRgb[0] = aData16[0] >> 8;
+                theRgb[1] = aData16[1] >> 8;
+                theRgb[2] = aData16[2] >> 8;
+                return true;
+            }
+            case StImagePlane::ImgGrayF: {
+                const GLfloat* aDataF = (const GLfloat* )aData;
+                theRgb[0] = theRgb[1] = theRgb[2] = (unsigned int )(stMin(stMax(aDataF[0], 0.0f), 1.0f) * 255.0f);
+                return true;
+            }
+            case StImagePlane::ImgRGBF:
+            case StImagePlane::ImgRGBAF:
+            case StImagePlane::ImgBGRF:
+            case StImagePlane::ImgBGRAF: {
+                const bool isBgr = thePlane.getFormat() == StImagePlane::ImgBGRF
+                                || thePlane.getFormat() == StImagePlane::ImgBGRAF;
+                const GLfloat* aDataF = (const GLfloat* )aData;
+                for(int aCompIter = 0; aCompIter < 3; ++aCompIter) {
+                    const GLfloat aVal = aDataF[isBgr ? (2 - aCompIter) : aCompIter];
+                    theRgb[aCompIter] = (unsigned int )(stMin(stMax(aVal, 0.0f), 1.0f) * 255.0f);
+                }
+                return true;
+            }
+            case StImagePlane::ImgUV:
+            case StImagePlane::ImgUNKNOWN:
+            default: {
+                return false;
+            }
+        }
+    }
+
+}
+
+StThumbnailCache::StThumbnailCache(const StString& theCacheFolder,
+                                   const int       theSize,
+                                   const int64_t   theCacheLimit)
+: myCacheFolder(theCacheFolder),
+  mySize(stMax(theSize, 8)),
+  myCacheLimit(theCacheLimit),
+  myCacheUsed(theCacheLimit + 1), // folder is scanned on the first write
+  myGeneration(0),
+  myIsActive(false) {
+    //
+}
+
+StThumbnailCache::~StThumbnailCache() {
+    myMutex.lock();
+    myRequests.clear();
+    myResults.clear();
+    ++myGeneration;
+    StHandle<StThreadPool::Task> aTask = myTask;
+    myMutex.unlock();
+    if(!aTask.isNull()) {
+        aTask->wait();
+    }
+}
+
+void StThumbnailCache::request(const size_t    theId,
+                               const StString& thePath,
+                               const int       thePriority) {
+    StMutexAuto aLock(myMutex);
+    bool isFound = false;
+    for(size_t aReqIter = 0; aReqIter < myRequests.size(); ++aReqIter) {
+        Request& aReq = myRequests[aReqIter];
+        if(aReq.Id == theId) {
+            aReq.Path     = thePath;
+            aReq.Priority = thePriority;
+            isFound = true;
+            break;
+        }
+    }
+    if(!isFound) {
+        Request aReq;
+        aReq.Id       = theId;
+        aReq.Path     = thePath;
+        aReq.Priority = thePriority;
+        myRequests.push_back(aReq);
+    }
+
+    if(!myIsActive) {
+        myIsActive = true;
+        myTask = new WorkTask(this);
+        StThreadPool::getDefault().push(myTask, StThreadPool::Priority_Background);
+    }
+}
+
+void StThumbnailCache::clear() {
+    StMutexAuto aLock(myMutex);
+    myRequests.clear();
+    myResults.clear();
+    ++myGeneration;
+}
+
+bool StThumbnailCache::pop(Thumbnail& theThumb) {
+    StMutexAuto aLock(myMutex);
+    if(myResults.empty()) {
+        return false;
+    }
+
+    theThumb = myResults.front();
+    myResults.pop_front();
+    return true;
+}
+
+bool StThumbnailCache::hasResults() const {
+    StMutexAuto aLock(myMutex);
+    return !myResults.empty();
+}
+
+size_t StThumbnailCache::getNbPending() const {
+    StMutexAuto aLock(myMutex);
+    return myRequests.size();
+}
+
+void StThumbnailCache::workLoop() {
+    for(;;) {
+        myMutex.lock();
+        if(myRequests.empty()) {
+            myIsActive = false;
+            myMutex.unlock();
+            return;
+        }
+
+        // take the request with highest priority, the oldest one among equal
+        size_t aBestIter = 0;
+        for(size_t aReqIter = 1; aReqIter < myRequests.size(); ++aReqIter) {
+            if(myRequests[aReqIter].Priority > myRequests[aBestIter].Priority) {
+                aBestIter = aReqIter;
+            }
+        }
+        const Request aReq = myRequests[aBestIter];
+        myRequests.erase(myRequests.begin() + aBestIter);
+        const size_t aGeneration = myGeneration;
+        myMutex.unlock();
+
+        Thumbnail aThumb;
+        aThumb.Id    = aReq.Id;
+        aThumb.Image = generate(aReq.Path);
+
+        StMutexAuto aLock(myMutex);
+        if(aGeneration == myGeneration) {
+            myResults.push_back(aThumb);
+        }
+    }
+}
+
+StHandle<StImagePlane> StThumbnailCache::generate(const StString& thePath) {
+    int64_t aFileSize = 0, aModTime = 0;
+    if(!StFileNode::getFileStat(thePath, aFileSize, aModTime)) {
+        return StHandle<StImagePlane>();
+    }
+
+    StHandle<StImagePlane> aThumb = readCached(thePath, aFileSize, aModTime);
+    if(!aThumb.isNull()) {
+        return aThumb;
+    }
+
+    const StImageFile::ImageType anImgType = StImageFile::guessImageType(thePath, StMIME());
+    if(anImgType == StImageFile::ST_TYPE_NONE) {
+        return StHandle<StImagePlane>();
+    }
+
+    // parse JPEG structure once - for embedded thumbnail, orientation and dimensions
+    StJpegParser aParser;
+    StHandle<StJpegParser::Image> aJpegImg;
+    if(anImgType == StImageFile::ST_TYPE_JPEG
+    || anImgType == StImageFile::ST_TYPE_JPS
+    || anImgType == StImageFile::ST_TYPE_MPO) {
+        if(aParser.readFile(thePath, -1, THE_EXIF_READ_MAX)) {
+            aJpegImg = aParser.getImage(0);
+        }
+    }
+
+    aThumb = decodeEmbedded(thePath, aJpegImg);
+    if(aThumb.isNull()) {
+        aThumb = decodeImage(thePath, anImgType, aJpegImg);
+    }
+    if(!aThumb.isNull()) {
+        writeCached(thePath, aFileSize, aModTime, *aThumb);
+    }
+    return aThumb;
+}
+
+StHandle<StImagePlane> StThumbnailCache::decodeEmbedded(const StString& thePath,
+                                                        const StHandle<StJpegParser::Image>& theJpegImg) const {
+    if(theJpegImg.isNull()
+    || theJpegImg->Thumb.isNull()
+    || theJpegImg->Thumb->Length < 4) {
+        return StHandle<StImagePlane>();
+    }
+
+    StHandle<StImageFile> aDecoder = StImageFile::create(StImageFile::ST_LIBAV, StImageFile::ST_TYPE_JPEG);
+    if(aDecoder.isNull()
+    || !aDecoder->loadExtra(thePath, StImageFile::ST_TYPE_JPEG,
+                            theJpegImg->Thumb->Data, int(theJpegImg->Thumb->Length), true)) {
+        return StHandle<StImagePlane>();
+    }
+    return reduceImage(*aDecoder, theJpegImg->getOrientation());
+}
+
+StHandle<StImagePlane> StThumbnailCache::decodeImage(const StString&                      thePath,
+                                                     const StImageFile::ImageType         theImgType,
+                                                     const StHandle<StJpegParser::Image>& theJpegImg) const {
+    StHandle<StAVImage> aDecoder = new StAVImage();
+    if(!theJpegImg.isNull()
+    &&  theJpegImg->SizeX != 0
+    &&  theJpegImg->SizeY != 0) {
+        // mjpeg decoder can skip fine DCT coefficients - decode at the smallest scale still covering thumbnail size
+        const size_t aMaxDim = stMax(theJpegImg->SizeX, theJpegImg->SizeY);
+        int aLowRes = 0;
+        while(aLowRes < 3
+           && (aMaxDim >> (aLowRes + 1)) >= size_t(mySize)) {
+            ++aLowRes;
+        }
+        aDecoder->setLowResolution(aLowRes);
+    }
+    if(!aDecoder->loadExtra(thePath, theImgType, NULL, 0, true)) {
+        ST_DEBUG_LOG("StThumbnailCache, unable to decode '" + thePath + "'\n" + aDecoder->getState());
+        return StHandle<StImagePlane>();
+    }
+
+    // orientation is defined by EXIF of JPEG files only (stereo pairs in JPS are not rotated)
+    int anOrient = StJpegParser::ORIENT_NORM;
+    if(!theJpegImg.isNull()
+    &&  theImgType != StImageFile::ST_TYPE_JPS) {
+        anOrient = theJpegImg->getOrientation();
+    }
+
+    StHandle<StImagePlane> aThumb = reduceImage(*aDecoder, anOrient);
+    aDecoder->close();
+    return aThumb;
+}
+
+StHandle<StImagePlane> StThumbnailCache::reduceImage(const StImage& theImage,
+                                                     const int      theOrient) const {
+    // planar (YUV) images are reduced by luminance plane only
+    const StImagePlane& aSrc = theImage.getPlane(0);
+    const size_t aSrcSizeX = aSrc.getSizeX();
+    const size_t aSrcSizeY = aSrc.getSizeY();
+    if(aSrc.isNull()
+    || aSrcSizeX == 0
+    || aSrcSizeY == 0) {
+        return StHandle<StImagePlane>();
+    }
+
+    const double aScale    = stMin(1.0, stMin(double(mySize) / double(aSrcSizeX), double(mySize) / double(aSrcSizeY)));
+    const size_t aDstSizeX = stMax(size_t(double(aSrcSizeX) * aScale + 0.5), size_t(1));
+    const size_t aDstSizeY = stMax(size_t(double(aSrcSizeY) * aScale + 0.5), size_t(1));
+
+    // box filter - average all source pixels covered by destination pixel
+    StImagePlane aReduced;
+    if(!aReduced.initTrash(StImagePlane::ImgRGB, aDstSizeX, aDstSizeY, aDstSizeX * 3)) {
+        return StHandle<StImagePlane>();
+    }
+    const bool isPlanar = theImage.isPlanar();
+    std::vector<unsigned int> aRowSum(aDstSizeX * 3);
+    std::vector<unsigned int> aNbSamples(aDstSizeX);
+    for(size_t aDstRow = 0; aDstRow < aDstSizeY; ++aDstRow) {
+        const size_t aSrcRowFrom = aDstRow * aSrcSizeY / aDstSizeY;
+        const size_t aSrcRowTo   = stMax((aDstRow + 1) * aSrcSizeY / aDstSizeY, aSrcRowFrom + 1);
+        std::fill(aRowSum.begin(),    aRowSum.end(),    0u);
+        std::fill(aNbSamples.begin(), aNbSamples.end(), 0u);
+        for(size_t aSrcRow = aSrcRowFrom; aSrcRow < aSrcRowTo; ++aSrcRow) {
+            const size_t aSrcRowData = aSrc.isTopDown() ? aSrcRow : (aSrcSizeY - 1 - aSrcRow);
+            for(size_t aDstCol = 0; aDstCol < aDstSizeX; ++aDstCol) {
+                const size_t aSrcColFrom = aDstCol * aSrcSizeX / aDstSizeX;
+                const size_t aSrcColTo   = stMax((aDstCol + 1) * aSrcSizeX / aDstSizeX, aSrcColFrom + 1);
+                for(size_t aSrcCol = aSrcColFrom; aSrcCol < aSrcColTo; ++aSrcCol) {
+                    unsigned int aRgb[3];
+                    if(!readPixel(aSrc, aSrcRowData, aSrcCol, aRgb)) {
+                        return StHandle<StImagePlane>();
+                    }
+                    if(isPlanar) {
+                        aRgb[1] = aRgb[2] = aRgb[0];
+                    }
+                    aRowSum[aDstCol * 3 + 0] += aRgb[0];
+                    aRowSum[aDstCol * 3 + 1] += aRgb[1];
+                    aRowSum[aDstCol * 3 + 2] += aRgb[2];
+                    ++aNbSamples[aDstCol];
+                }
+            }
+        }
+        GLubyte* aDstData = aReduced.changeData(aDstRow, 0);
+        for(size_t aDstCol = 0; aDstCol < aDstSizeX; ++aDstCol) {
+            const unsigned int aNb = aNbSamples[aDstCol];
+            aDstData[aDstCol * 3 + 0] = GLubyte(aRowSum[aDstCol * 3 + 0] / aNb);
+            aDstData[aDstCol * 3 + 1] = GLubyte(aRowSum[aDstCol * 3 + 1] / aNb);
+            aDstData[aDstCol * 3 + 2] = GLubyte(aRowSum[aDstCol * 3 + 2] / aNb);
+        }
+    }
+
+    // apply orientation on reduced image (mirrored variants are shown without flipping)
+    const bool toTranspose = theOrient == StJpegParser::ORIENT_ROT90
+                          || theOrient == StJpegParser::ORIENT_ROT270
+                          || theOrient == StJpegParser::ORIENT_ROT90_FLIPX
+                          || theOrient == StJpegParser::ORIENT_ROT270_FLIPX;
+    const bool toRotate180 = theOrient == StJpegParser::ORIENT_ROT180
+                          || theOrient == StJpegParser::ORIENT_ROT180_FLIPX;
+    const size_t aThumbSizeX = toTranspose ? aDstSizeY : aDstSizeX;
+    const size_t aThumbSizeY = toTranspose ? aDstSizeX : aDstSizeY;
+    StHandle<StImagePlane> aThumb = new StImagePlane();
+    if(!aThumb->initTrash(StImagePlane::ImgRGB, aThumbSizeX, aThumbSizeY, aThumbSizeX * 3)) {
+        return StHandle<StImagePlane>();
+    }
+    for(size_t aRow = 0; aRow < aThumbSizeY; ++aRow) {
+        for(size_t aCol = 0; aCol < aThumbSizeX; ++aCol) {
+            size_t aSrcRow = aRow, aSrcCol = aCol;
+            if(theOrient == StJpegParser::ORIENT_ROT270
+            || theOrient == StJpegParser::ORIENT_ROT270_FLIPX) {
+                // rotate 90 degrees clockwise
+                aSrcRow = aDstSizeY - 1 - aCol;
+                aSrcCol = aRow;
+            } else if(toTranspose) {
+                // rotate 90 degrees counterclockwise
+                aSrcRow = aCol;
+                aSrcCol = aDstSizeX - 1 - aRow;
+            } else if(toRotate180) {
+                aSrcRow = aDstSizeY - 1 - aRow;
+                aSrcCol = aDstSizeX - 1 - aCol;
+            }
+            std::memcpy(aThumb->changeData(aRow, aCol), aReduced.getData(aSrcRow, aSrcCol), 3);
+        }
+    }
+    return aThumb;
+}
+
+StString StThumbnailCache::getCachePath(const StString& thePath) const {
+    const size_t aHash = StHashIndex::hashBytes(thePath.toCString(), thePath.getSize(), false);
+    char aName[64];
+    stsprintf(aName, sizeof(aName), "%016llx_%d.thb", (unsigned long long )aHash, mySize);
+    return myCacheFolder + "thumbs" + SYS_FS_SPLITTER + aName;
+}
+
+StHandle<StImagePlane> StThumbnailCache::readCached(const StString& thePath,
+                                                    const int64_t   theFileSize,
+                                                    const int64_t   theModTime) const {
+    if(myCacheFolder.isEmpty()) {
+        return StHandle<StImagePlane>();
+    }
+
+    const StString aCachePath = getCachePath(thePath);
+    if(!StFileNode::isFileExists(aCachePath)) {
+        return StHandle<StImagePlane>();
+    }
+
+    StRawFile aFile(aCachePath);
+    if(!aFile.readFile()
+    ||  aFile.getSize() < sizeof(StThumbCacheHeader)) {
+        return StHandle<StImagePlane>();
+    }
+
+    StThumbCacheHeader aHeader;
+    std::memcpy(&aHeader, aFile.getBuffer(), sizeof(aHeader));
+    const size_t aDataSize = size_t(aHeader.SizeX) * size_t(aHeader.SizeY) * 3;
+    if(std::memcmp(aHeader.Magic, THE_THUMB_MAGIC, sizeof(THE_THUMB_MAGIC)) != 0
+    || aHeader.Version  != THE_THUMB_VERSION
+    || aHeader.FileSize != theFileSize
+    || aHeader.ModTime  != theModTime
+    || aHeader.PathSize != thePath.getSize()
+    || aHeader.SizeX == 0 || aHeader.SizeY == 0
+    || aFile.getSize() != sizeof(aHeader) + aHeader.PathSize + aDataSize
+    || std::memcmp(aFile.getBuffer() + sizeof(aHeader), thePath.toCString(), aHeader.PathSize) != 0) {
+        return StHandle<StImagePlane>();
+    }
+
+    StHandle<StImagePlane> aThumb = new StImagePlane();
+    if(!aThumb->initTrash(StImagePlane::ImgRGB, aHeader.SizeX, aHeader.SizeY, size_t(aHeader.SizeX) * 3)) {
+        return StHandle<StImagePlane>();
+    }
+    std::memcpy(aThumb->changeData(), aFile.getBuffer() + sizeof(aHeader) + aHeader.PathSize, aDataSize);
+    return aThumb;
+}
+
+bool StThumbnailCache::writeCached(const StString&     thePath,
+                                   const int64_t       theFileSize,
+                                   const int64_t       theModTime,
+                                   const StImagePlane& theThumb) {
+    if(myCacheFolder.isEmpty()
+    || theThumb.getFormat() != StImagePlane::ImgRGB
+    || theThumb.getSizeRowBytes() != theThumb.getSizeX() * 3) {
+        return false;
+    }
+
+    const StString aFolder = myCacheFolder + "thumbs";
+    if(!StFolder::isFolder(aFolder)
+    && !StFolder::createFolder(aFolder)) {
+        return false;
+    }
+
+    StThumbCacheHeader aHeader;
+    std::memset(&aHeader, 0, sizeof(aHeader));
+    std::memcpy(aHeader.Magic, THE_THUMB_MAGIC, sizeof(THE_THUMB_MAGIC));
+    aHeader.Version  = THE_THUMB_VERSION;
+    aHeader.FileSize = theFileSize;
+    aHeader.ModTime  = theModTime;
+    aHeader.SizeX    = uint32_t(theThumb.getSizeX());
+    aHeader.SizeY    = uint32_t(theThumb.getSizeY());
+    aHeader.PathSize = uint32_t(thePath.getSize());
+
+    // write into temporary file first, so that concurrent reader never sees incomplete thumbnail
+    const StString aCachePath = getCachePath(thePath);
+    const StString aTmpPath   = aCachePath + ".tmp";
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::WRITE, aTmpPath)) {
+        return false;
+    }
+
+    const size_t aDataSize = theThumb.getSizeX() * theThumb.getSizeY() * 3;
+    const bool isOk = aFile.write((const char* )&aHeader, sizeof(aHeader)) == sizeof(aHeader)
+                   && aFile.write(thePath.toCString(), thePath.getSize()) == thePath.getSize()
+                   && aFile.write((const char* )theThumb.getData(), aDataSize) == aDataSize;
+    aFile.closeFile();
+    if(!isOk) {
+        StFileNode::removeFile(aTmpPath);
+        return false;
+    }
+
+    int64_t anOldSize = 0, anOldTime = 0;
+    if(StFileNode::getFileStat(aCachePath, anOldSize, anOldTime)) {
+        StFileNode::removeFile(aCachePath);
+        myCacheUsed -= anOldSize;
+    }
+    if(!StFileNode::moveFile(aTmpPath, aCachePath)) {
+        return false;
+    }
+
+    myCacheUsed += int64_t(sizeof(aHeader) + thePath.getSize() + aDataSize);
+    if(myCacheUsed > myCacheLimit) {
+        trimCache();
+    }
+    return true;
+}
+
+void StThumbnailCache::trimCache() {
+    struct CacheFile {
+        StString Path;
+        int64_t  Size;
+        int64_t  ModTime;
+
+        bool operator<(const CacheFile& theOther) const {
+            return ModTime < theOther.ModTime;
+        }
+    };
+
+    StArrayList<StString> anExtensions(1);
+    anExtensions.add(stCString("thb"));
+    StFolder aFolder(myCacheFolder + "thumbs");
+    aFolder.init(anExtensions, 1);
+
+    std::vector<CacheFile> aFiles;
+    aFiles.reserve(aFolder.size());
+    int64_t aTotal = 0;
+    for(size_t anItemIter = 0; anItemIter < aFolder.size(); ++anItemIter) {
+        CacheFile aFile;
+        aFile.Path = aFolder.getValue(anItemIter)->getPath();
+        if(StFileNode::getFileStat(aFile.Path, aFile.Size, aFile.ModTime)) {
+            aTotal += aFile.Size;
+            aFiles.push_back(aFile);
+        }
+    }
+
+    // remove the oldest thumbnails with some reserve, so that folder is not scanned on every write
+    std::sort(aFiles.begin(), aFiles.end());
+    const int64_t aTarget = myCacheLimit / 4 * 3;
+    for(size_t aFileIter = 0; aFileIter < aFiles.size() && aTotal > aTarget; ++aFileIter) {
+        if(StFileNode::removeFile(aFiles[aFileIter].Path)) {
+            aTotal -= aFiles[aFileIter].Size;
+        }
+    }
+    myCacheUsed = aTotal;
+}
@@ -114,6 +114,7 @@ const AVPixelFormat stAV::PIX_FMT::YUV410P    = ST_AV_GETPIXFMT("yuv410p");
 const AVPixelFormat stAV::PIX_FMT::YUV411P    = ST_AV_GETPIXFMT("yuv411p");
 const AVPixelFormat stAV::PIX_FMT::YUV440P    = ST_AV_GETPIXFMT("yuv440p");
 const AVPixelFormat stAV::PIX_FMT::NV12       = ST_AV_GETPIXFMT("nv12");
+const AVPixelFormat stAV::PIX_FMT::P010       = ST_AV_GETPIXFMT("p010le");
 const AVPixelFormat stAV::PIX_FMT::YUV420P9   = ST_AV_GETPIXFMT("yuv420p9");
 const AVPixelFormat stAV::PIX_FMT::YUV422P9   = ST_AV_GETPIXFMT("yuv422p9");
 const AVPixelFormat stAV::PIX_FMT::YUV444P9   = ST_AV_GETPIXFMT("yuv444p9");
@@ -215,6 +216,8 @@ StCString stAV::PIX_FMT::getString(const AVPixelFormat theFrmt) {
         return stCString("bgra64");
     } else if(theFrmt == stAV::PIX_FMT::NV12) {
         return stCString("nv12");
+    } else if(theFrmt == stAV::PIX_FMT::P010) {
+        return stCString("p010le");
     } else if(theFrmt == stAV::PIX_FMT::XYZ12) {
         return stCString("xyz12");
     } else if(theFrmt == stAV::PIX_FMT::DXVA2_VLD) {
@@ -8,8 +8,11 @@
 
 #include <StStrings/StString.h>
 #include <StStrings/stUtfTools.h>
+#include <StThreads/StAtomicOp.h>
 
 namespace {
+    static volatile int32_t THE_STR_ALLOC_COUNTER = 0;
+
     static const stUtf32_t ST_NUMBERS_ARRAY[10] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
     bool isNumChar(const stUtf32_t theChar) {
         for(size_t aNumId = 0; aNumId < 10; ++aNumId) {
@@ -21,6 +24,14 @@ namespace {
     }
 };
 
+void stStrAllocCounterIncrement() {
+    StAtomicOp::Increment(THE_STR_ALLOC_COUNTER);
+}
+
+uint32_t stStrAllocCounter() {
+    return uint32_t(THE_STR_ALLOC_COUNTER);
+}
+
 bool stUtfTools::isInteger(const StString& theString) {
     StUtf8Iter anIter = theString.iterator();
     // TODO (Kirill Gavrilov#9) + and - should be followed by numbers!
@@ -0,0 +1,176 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov
+ *
+ * StStereoConvert program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StStereoConvert program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <StImage/StStereoConverter.h>
+#include <StFile/StFolder.h>
+#include <StThreads/StProcess.h>
+#include <StThreads/StThreadPool.h>
+#include <StStrings/stConsole.h>
+#include <StVersion.h>
+
+namespace {
+
+static StMutex THE_CONSOLE_MUTEX;
+
+/**
+ * Print error (callback might be called from any worker thread).
+ */
+class StConverterLog {
+
+        public:
+
+    void doError(const StCString& theMsg) {
+        StMutexAuto aLock(THE_CONSOLE_MUTEX);
+        st::cout << st::COLOR_FOR_RED << stostream_text("Error: ") << theMsg << stostream_text("\n") << st::COLOR_FOR_WHITE;
+    }
+
+    void doDone(const StCString& thePath) {
+        StMutexAuto aLock(THE_CONSOLE_MUTEX);
+        st::cout << stostream_text("Saved ") << thePath << stostream_text("\n");
+    }
+
+};
+
+/**
+ * Append all images and videos within the folder into the list.
+ */
+static void listFolder(const StString&        thePath,
+                       StArrayList<StString>& theList) {
+    StArrayList<StString> anExtList(16);
+    const char* THE_EXT[] = {
+        "jpg", "jpeg", "jps", "mpo", "png", "pns", "webp", "tif", "tiff", "bmp",
+        "mkv", "mk3d", "webm", "mp4", "m4v", "mov", "avi", "wmv", "ts", "m2ts", NULL
+    };
+    for(const char** anExtIter = THE_EXT; *anExtIter != NULL; ++anExtIter) {
+        anExtList.add(StString(*anExtIter));
+    }
+
+    StFolder aFolder(thePath);
+    aFolder.init(anExtList, 1);
+    for(size_t anIter = 0; anIter < aFolder.size(); ++anIter) {
+        const StFileNode* aNode = aFolder.getValue(anIter);
+        if(!aNode->isFolder()) {
+            theList.add(aNode->getPath());
+        }
+    }
+}
+
+}
+
+int main(int , char** ) {
+#ifdef _WIN32
+    setlocale(LC_ALL, ".OCP"); // we set default locale for console output (useful only for debug)
+#endif
+
+    const StString ARGUMENT_ANY        = "--";
+    const StString ARGUMENT_OUT        = "out";
+    const StString ARGUMENT_LAYOUT     = "layout";
+    const StString ARGUMENT_SRC_FORMAT = "srcFormat";
+    const StString ARGUMENT_EXT        = "ext";
+    const StString ARGUMENT_THREADS    = "threads";
+    const StString ARGUMENT_IMAGE_LIB  = "imageLib";
+    const StString ARGUMENT_HELP       = "help";
+
+    StString anOutFolder, anOutExt, anImageLib;
+    StFormat aSrcFormat  = StFormat_AUTO;
+    StStereoConverter::Layout aLayout = StStereoConverter::Layout_SideBySide_LR;
+    int      aNbThreads  = 0;
+    StArrayList<StString> anInputs;
+
+    StArrayList<StString> anArgs = StProcess::getArguments();
+    for(size_t aParamIter = 1; aParamIter < anArgs.size(); ++aParamIter) {
+        StString aParam = anArgs[aParamIter];
+        if(!aParam.isStartsWith(ARGUMENT_ANY)) {
+            if(StFolder::isFolder(aParam)) {
+                listFolder(aParam, anInputs);
+            } else {
+                anInputs.add(aParam);
+            }
+            continue;
+        }
+        StArgument anArg; anArg.parseString(aParam.subString(2, aParam.getLength())); // cut suffix --
+        if(anArg.getKey().isEqualsIgnoreCase(ARGUMENT_OUT)) {
+            anOutFolder = anArg.getValue();
+        } else if(anArg.getKey().isEqualsIgnoreCase(ARGUMENT_LAYOUT)) {
+            if(!StStereoConverter::layoutFromString(anArg.getValue(), aLayout)) {
+                st::cout << stostream_text("Unknown layout '") << anArg.getValue() << stostream_text("'\n");
+                return -1;
+            }
+        } else if(anArg.getKey().isEqualsIgnoreCase(ARGUMENT_SRC_FORMAT)) {
+            aSrcFormat = st::formatFromString(anArg.getValue());
+        } else if(anArg.getKey().isEqualsIgnoreCase(ARGUMENT_EXT)) {
+            anOutExt = anArg.getValue();
+        } else if(anArg.getKey().isEqualsIgnoreCase(ARGUMENT_THREADS)) {
+            aNbThreads = std::atoi(anArg.getValue().toCString());
+        } else if(anArg.getKey().isEqualsIgnoreCase(ARGUMENT_IMAGE_LIB)) {
+            anImageLib = anArg.getValue();
+        } else if(anArg.getKey().isEqualsIgnoreCase(ARGUMENT_HELP)) {
+            st::cout << stostream_text("Usage: StStereoConvert [options] file1 [file2 | folder ...]\n")
+                     << stostream_text("  --help             Show this help\n")
+                     << stostream_text("  --out=folder       Output folder (required)\n")
+                     << stostream_text("  --layout=sbs       Output layout: sbs, sbsrl, ou, separate, rows, columns,\n")
+                     << stostream_text("                     anaglyph, anaglyphYB, anaglyphGM\n")
+                     << stostream_text("  --srcFormat=name   Source layout (detected from metadata and file name by default)\n")
+                     << stostream_text("  --ext=png          Output image type (source extension by default)\n")
+                     << stostream_text("  --threads=N        Number of worker threads (concurrency budget by default)\n")
+                     << stostream_text("  --imageLib=name    Image library (FFmpeg, FreeImage, DevIL, WebP, stb)\n");
+            return 0;
+        }
+    }
+
+    StString aWelcomeMsg = StString("StStereoConvert ")
+                         + StVersionInfo::getSDKVersionString()
+                         + " by Kirill Gavrilov (kirill@sview.ru)\n\n";
+    st::cout << st::COLOR_FOR_GREEN << aWelcomeMsg << st::COLOR_FOR_WHITE;
+    if(anInputs.isEmpty()
+    || anOutFolder.isEmpty()) {
+        st::cout << stostream_text("Nothing to convert, see --help\n");
+        return -1;
+    } else if(!StFolder::isFolder(anOutFolder)
+           && !StFolder::createFolder(anOutFolder)) {
+        st::cout << stostream_text("Output folder '") << anOutFolder << stostream_text("' can not be created\n");
+        return -1;
+    }
+
+    const StImageFile::ImageClass anImgLib = !anImageLib.isEmpty()
+                                           ? StImageFile::imgLibFromString(anImageLib)
+                                           : StImageFile::ST_LIBAV;
+    StStereoConverter aConverter(anImgLib, aLayout, aNbThreads);
+    StConverterLog    aLog;
+    aConverter.signals.onError.connect(&aLog, &StConverterLog::doError);
+    aConverter.signals.onDone .connect(&aLog, &StConverterLog::doDone);
+    for(size_t anIter = 0; anIter < anInputs.size(); ++anIter) {
+        StString aFolder, aFileName, aName, anExt;
+        StFileNode::getFolderAndFile(anInputs[anIter], aFolder, aFileName);
+        StFileNode::getNameAndExtension(aFileName, aName, anExt);
+        if(anExt.isEqualsIgnoreCase(stCString("mpo"))) {
+            anExt = "jpg"; // MPO can not be written
+        }
+
+        StStereoConverter::Job aJob;
+        aJob.SrcPath   = anInputs[anIter];
+        aJob.SrcFormat = aSrcFormat;
+        aJob.DstPath   = anOutFolder + ST_FILE_SPLITTER + aName + "." + (!anOutExt.isEmpty() ? anOutExt : anExt);
+        aConverter.addJob(aJob);
+    }
+
+    const bool isOk = aConverter.perform();
+    st::cout << st::COLOR_FOR_GREEN << aConverter.getReport().toString() << st::COLOR_FOR_WHITE;
+    StThreadPool::releaseDefault();
+    return isOk ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestDictionary.h"
+
+#include <StStrings/StDictionary.h>
+#include <StStrings/StLangMap.h>
+#include <StStrings/stConsole.h>
+
+#include <vector>
+
+namespace {
+
+    /**
+     * Total number of operations per measurement, split into repeats for small sizes.
+     */
+    static const size_t THE_NB_OPERATIONS = 1000000;
+
+    /**
+     * Generate EXIF-like key.
+     */
+    inline StString generateKey(const size_t theIndex) {
+        return StString("Exif.MakerNote.Tag") + theIndex;
+    }
+
+    /**
+     * Linear search as reference.
+     */
+    inline size_t findLinear(const StArrayList<StDictEntry>& theList,
+                             const StString&                 theKey) {
+        for(size_t anIter = 0; anIter < theList.size(); ++anIter) {
+            if(theList.getValue(anIter).getKey().isEqualsIgnoreCase(theKey)) {
+                return anIter;
+            }
+        }
+        return size_t(-1);
+    }
+
+};
+
+void StTestDictionary::testDictionary(const size_t theNbEntries) {
+    std::vector<StString> aKeys(theNbEntries);
+    for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+        aKeys[anIter] = generateKey(anIter);
+    }
+    const size_t aNbRepeats = stMax(THE_NB_OPERATIONS / theNbEntries / 10, size_t(1));
+
+    // insertion through addChange() - each insertion performs lookup as well
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats; ++aRepeat) {
+        StDictionary aDict;
+        for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+            aDict.addChange(aKeys[anIter]).setValue(aKeys[anIter]);
+        }
+    }
+    const double anInsertNSec = 1000000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats * theNbEntries);
+
+    StDictionary aDict;
+    for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+        aDict.addChange(aKeys[anIter]).setValue(aKeys[anIter]);
+    }
+
+    // lookup of existing keys in different case
+    std::vector<StString> aKeysUpper(theNbEntries);
+    for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+        aKeysUpper[anIter] = StString("EXIF.MAKERNOTE.TAG") + anIter;
+    }
+
+    size_t aNbFound = 0;
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats * 10; ++aRepeat) {
+        for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+            aNbFound += aDict[aKeysUpper[anIter]].isValid() ? 1 : 0;
+        }
+    }
+    const double aLookupNSec = 1000000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats * 10 * theNbEntries);
+
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats; ++aRepeat) {
+        for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+            aNbFound += findLinear(aDict, aKeysUpper[anIter]) != size_t(-1) ? 1 : 0;
+        }
+    }
+    const double aLinearNSec = 1000000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats * theNbEntries);
+
+    st::cout << stostream_text("  StDictionary ") << theNbEntries << stostream_text(" entries:")
+             << stostream_text("\tinsert ")       << anInsertNSec << stostream_text(" nsec")
+             << stostream_text(",\tlookup ")      << aLookupNSec  << stostream_text(" nsec")
+             << stostream_text(" (linear scan ")  << aLinearNSec  << stostream_text(" nsec)")
+             << (aNbFound == aNbRepeats * 11 * theNbEntries ? stostream_text("\n") : stostream_text(" FAILED\n"));
+}
+
+void StTestDictionary::testLangMap(const size_t theNbEntries) {
+    const size_t aNbRepeats = stMax(THE_NB_OPERATIONS / theNbEntries / 10, size_t(1));
+    const size_t aKeyBase   = 1000; // translation keys are grouped by thousands
+    const StString aValue("Translated string");
+
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats; ++aRepeat) {
+        StLangMap aMap;
+        for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+            aMap.changeValue(aKeyBase + anIter) = aValue;
+        }
+    }
+    const double anInsertNSec = 1000000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats * theNbEntries);
+
+    StLangMap aMap;
+    std::vector<StString> anAliases(theNbEntries);
+    for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+        aMap.changeValue(aKeyBase + anIter) = aValue;
+        anAliases[anIter] = generateKey(anIter);
+        aMap.addAlias(anAliases[anIter], aKeyBase + anIter);
+    }
+
+    size_t aNbFound = 0;
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats * 10; ++aRepeat) {
+        for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+            aNbFound += aMap.getValue(aKeyBase + anIter).isEmpty() ? 0 : 1;
+        }
+    }
+    const double aLookupNSec = 1000000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats * 10 * theNbEntries);
+
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats * 10; ++aRepeat) {
+        for(size_t anIter = 0; anIter < theNbEntries; ++anIter) {
+            aNbFound += aMap.getValue(anAliases[anIter]).isEmpty() ? 0 : 1;
+        }
+    }
+    const double anAliasNSec = 1000000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats * 10 * theNbEntries);
+
+    st::cout << stostream_text("  StLangMap    ") << theNbEntries << stostream_text(" entries:")
+             << stostream_text("\tinsert ")       << anInsertNSec << stostream_text(" nsec")
+             << stostream_text(",\tlookup ")      << aLookupNSec  << stostream_text(" nsec")
+             << stostream_text(" (alias ")        << anAliasNSec  << stostream_text(" nsec)")
+             << (aNbFound == aNbRepeats * 20 * theNbEntries ? stostream_text("\n") : stostream_text(" FAILED\n"));
+}
+
+void StTestDictionary::perform() {
+    st::cout << stostream_text("Dictionary tests (time per operation).\n");
+    const size_t THE_SIZES[3] = { 10, 100, 1000 };
+    for(size_t aSizeIter = 0; aSizeIter < 3; ++aSizeIter) {
+        testDictionary(THE_SIZES[aSizeIter]);
+    }
+    for(size_t aSizeIter = 0; aSizeIter < 3; ++aSizeIter) {
+        testLangMap(THE_SIZES[aSizeIter]);
+    }
+}
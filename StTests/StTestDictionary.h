@@ -0,0 +1,47 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestDictionary_h_
+#define __StTestDictionary_h_
+
+#include "StTest.h"
+
+/**
+ * Tests StDictionary and StLangMap insert and lookup performance.
+ */
+class ST_LOCAL StTestDictionary : public StTest {
+
+        public:
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    /**
+     * Measure dictionary with specified number of entries.
+     */
+    void testDictionary(const size_t theNbEntries);
+
+    /**
+     * Measure translation map with specified number of entries.
+     */
+    void testLangMap(const size_t theNbEntries);
+
+};
+
+#endif // __StTestDictionary_h_
@@ -0,0 +1,181 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestExif.h"
+
+#include <StImage/StExifTags.h>
+#include <StImage/StJpegParser.h>
+#include <StStrings/stConsole.h>
+
+#include <vector>
+
+namespace {
+
+    /**
+     * Total number of decoded entries per measurement, split into repeats for small sections.
+     */
+    static const size_t THE_NB_ENTRIES = 2000000;
+
+    /**
+     * Write IFD entry in Little-Endian order.
+     */
+    inline void writeEntry(stUByte_t*     theEntry,
+                           const uint16_t theTag,
+                           const uint16_t theFormat,
+                           const uint32_t theComponents,
+                           const uint32_t theValue) {
+        StAlienData::Set16uLE(theEntry,     theTag);
+        StAlienData::Set16uLE(theEntry + 2, theFormat);
+        StAlienData::Set32uLE(theEntry + 4, theComponents);
+        StAlienData::Set32uLE(theEntry + 8, theValue);
+    }
+
+    /**
+     * Generate EXIF section mimicking Fujifilm camera:
+     * IFD0 (Make, Orientation) -> Exif IFD (UserComment, MakerNote) -> Maker Note IFD with Parallax as last tag.
+     */
+    inline void generateSection(std::vector<stUByte_t>& theData,
+                                const uint16_t          theNbMakerTags) {
+        const size_t anExifIfd  = 60;
+        const size_t aComment   = 90;
+        const size_t aMakerNote = 104;
+        const size_t aMakerIfd  = 12;
+        const size_t aParallax  = aMakerIfd + 2 + size_t(theNbMakerTags) * 12 + 4;
+        const size_t aMakerLen  = aParallax + 8;
+        theData.assign(aMakerNote + aMakerLen, 0);
+        stUByte_t* aData = &theData[0];
+
+        // TIFF header and IFD0
+        memcpy(aData, "II", 2);
+        StAlienData::Set16uLE(aData + 2, 0x2A);
+        StAlienData::Set32uLE(aData + 4, 8);
+        StAlienData::Set16uLE(aData + 8, 3);
+        writeEntry(aData + 10, StExifTags::Image_Make,        StExifEntry::FMT_STRING, 9, 50);
+        writeEntry(aData + 22, StExifTags::Image_Orientation, StExifEntry::FMT_USHORT, 1, 6);
+        writeEntry(aData + 34, 0x8769,                        StExifEntry::FMT_ULONG,  1, uint32_t(anExifIfd));
+        memcpy(aData + 50, "FUJIFILM", 9);
+
+        // Exif IFD
+        StAlienData::Set16uLE(aData + anExifIfd, 2);
+        writeEntry(aData + anExifIfd + 2,  StExifTags::Photo_UserComment, StExifEntry::FMT_UNDEFINED, 13, uint32_t(aComment));
+        writeEntry(aData + anExifIfd + 14, 0x927C,                        StExifEntry::FMT_UNDEFINED, uint32_t(aMakerLen), uint32_t(aMakerNote));
+        memcpy(aData + aComment, "ASCII\0\0\0sview", 13);
+
+        // Maker Note with offsets relative to its start
+        stUByte_t* aMaker = aData + aMakerNote;
+        memcpy(aMaker, "FUJIFILM", 8);
+        StAlienData::Set16uLE(aMaker + 8, uint16_t(aMakerIfd));
+        StAlienData::Set16uLE(aMaker + aMakerIfd, theNbMakerTags);
+        for(uint16_t aTagIter = 0; aTagIter + 1 < theNbMakerTags; ++aTagIter) {
+            writeEntry(aMaker + aMakerIfd + 2 + size_t(aTagIter) * 12, uint16_t(0x1000 + aTagIter), StExifEntry::FMT_USHORT, 1, aTagIter);
+        }
+        writeEntry(aMaker + aMakerIfd + 2 + size_t(theNbMakerTags - 1) * 12,
+                   StExifTags::Fuji_Parallax, StExifEntry::FMT_SRATIONAL, 1, uint32_t(aParallax));
+        StAlienData::Set32uLE(aMaker + aParallax,     uint32_t(-150));
+        StAlienData::Set32uLE(aMaker + aParallax + 4, 100);
+    }
+
+};
+
+void StTestExif::testSections(const StString&                  theName,
+                              const StArrayList<StExifReader>& theSections) {
+    size_t aNbBytes = 0;
+    for(size_t aSectIter = 0; aSectIter < theSections.size(); ++aSectIter) {
+        aNbBytes += theSections.getValue(aSectIter).getLength();
+    }
+    const size_t aNbRepeats = stMax(THE_NB_ENTRIES / stMax(aNbBytes / 12, size_t(1)), size_t(10));
+
+    // complete decoding, as has been done for each opened image
+    size_t aNbFound = 0;
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats; ++aRepeat) {
+        StExifDir::List aList;
+        for(size_t aSectIter = 0; aSectIter < theSections.size(); ++aSectIter) {
+            const StExifReader& aSection = theSections.getValue(aSectIter);
+            StHandle<StExifDir> aDir = new StExifDir();
+            aDir->Type = aSection.getType();
+            aList.add(aDir);
+            aDir->parseExif(aList, aSection.getData(), aSection.getLength());
+        }
+
+        StExifDir::Query anOrient  (StExifDir::DType_General,   StExifTags::Image_Orientation);
+        StExifDir::Query aParallax (StExifDir::DType_MakerFuji, StExifTags::Fuji_Parallax);
+        aNbFound += StExifDir::findEntry(aList, anOrient)  ? 1 : 0;
+        aNbFound += StExifDir::findEntry(aList, aParallax) ? 1 : 0;
+    }
+    const double aFullUSec = 1000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats);
+
+    // in-place lookup of the same tags
+    size_t aNbFoundFast = 0;
+    myTimer.restart();
+    for(size_t aRepeat = 0; aRepeat < aNbRepeats; ++aRepeat) {
+        StExifReader::Entry anEntry;
+        for(size_t aSectIter = 0; aSectIter < theSections.size(); ++aSectIter) {
+            if(theSections.getValue(aSectIter).findEntry(StExifDir::DType_General, StExifTags::Image_Orientation, anEntry)) {
+                ++aNbFoundFast;
+                break;
+            }
+        }
+        for(size_t aSectIter = 0; aSectIter < theSections.size(); ++aSectIter) {
+            if(theSections.getValue(aSectIter).findEntry(StExifDir::DType_MakerFuji, StExifTags::Fuji_Parallax, anEntry)) {
+                ++aNbFoundFast;
+                break;
+            }
+        }
+    }
+    const double aFastUSec = 1000.0 * myTimer.getElapsedTimeInMilliSec() / double(aNbRepeats);
+
+    st::cout << stostream_text("  ")              << theName
+             << stostream_text(" (")              << aNbBytes  << stostream_text(" bytes):")
+             << stostream_text("\tfull decoding ") << aFullUSec << stostream_text(" usec")
+             << stostream_text(",\tlookup ")       << aFastUSec << stostream_text(" usec")
+             << (aNbFound == aNbFoundFast ? stostream_text("\n") : stostream_text(" FAILED\n"));
+}
+
+void StTestExif::perform() {
+    st::cout << stostream_text("EXIF tests (time to read orientation and parallax per image).\n");
+    if(!myFilePath.isEmpty()) {
+        StJpegParser aParser;
+        if(!aParser.readFile(myFilePath)) {
+            st::cout << stostream_text("  file '") << myFilePath << stostream_text("' can not be read\n");
+            return;
+        }
+
+        size_t anImgIter = 0;
+        for(StHandle<StJpegParser::Image> anImg = aParser.getImage(0);
+            !anImg.isNull(); anImg = anImg->Next, ++anImgIter) {
+            testSections(StString("image #") + anImgIter, anImg->ExifRaw);
+        }
+        return;
+    }
+
+    const uint16_t THE_SIZES[3] = { 50, 500, 5000 };
+    for(size_t aSizeIter = 0; aSizeIter < 3; ++aSizeIter) {
+        std::vector<stUByte_t> aData;
+        generateSection(aData, THE_SIZES[aSizeIter]);
+
+        StArrayList<StExifReader> aSections;
+        StExifReader aReader;
+        if(!aReader.init(&aData[0], aData.size())) {
+            st::cout << stostream_text("  synthetic section is invalid FAILED\n");
+            return;
+        }
+        aSections.add(aReader);
+        testSections(StString("Maker Note ") + int(THE_SIZES[aSizeIter]) + " tags", aSections);
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestExif_h_
+#define __StTestExif_h_
+
+#include "StTest.h"
+
+#include <StImage/StExifReader.h>
+
+/**
+ * Compares complete EXIF decoding (StExifDir) with in-place lookup of few tags (StExifReader)
+ * on synthetic sections with Maker Notes of different size or on specified JPEG file.
+ */
+class ST_LOCAL StTestExif : public StTest {
+
+        public:
+
+    /**
+     * @param theFilePath JPEG/MPO file to measure, empty to use synthetic sections
+     */
+    StTestExif(const StString& theFilePath = StString()) : myFilePath(theFilePath) {}
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    /**
+     * Measure EXIF sections of one image.
+     */
+    void testSections(const StString&                  theName,
+                      const StArrayList<StExifReader>& theSections);
+
+        private:
+
+    StString myFilePath;
+
+};
+
+#endif // __StTestExif_h_
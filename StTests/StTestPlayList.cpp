@@ -0,0 +1,95 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestPlayList.h"
+
+#include <StFile/StM3UParser.h>
+#include <StFile/StRawFile.h>
+#include <StGL/StPlayList.h>
+#include <StStrings/stConsole.h>
+#include <StThreads/StProcess.h>
+
+#include <cstdio>
+
+namespace {
+
+    static const size_t THE_NB_ITEMS = 200000;
+
+};
+
+size_t StTestPlayList::generate(const StString& thePath,
+                                const size_t    theNbItems) {
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::WRITE, thePath)) {
+        return 0;
+    }
+
+    char aLine[256];
+    aFile.write(stCString("#EXTM3U\n"));
+    for(size_t anIter = 0; anIter < theNbItems; ++anIter) {
+        const int aLen = std::sprintf(aLine, "#EXTINF:-1, Item %u\nfolder%u/file%u.mkv\n",
+                                      (unsigned int )anIter, (unsigned int )(anIter / 100), (unsigned int )anIter);
+        aFile.write(aLine, size_t(aLen));
+    }
+    aFile.closeFile();
+    return theNbItems * 2 + 1;
+}
+
+void StTestPlayList::perform() {
+    const StString aPath = StProcess::getTempFolder() + "sviewTestPlayList.m3u";
+    const size_t aNbLines = generate(aPath, THE_NB_ITEMS);
+    if(aNbLines == 0) {
+        st::cout << stostream_text("Unable to write playlist '") << aPath << stostream_text("'\n");
+        return;
+    }
+    st::cout << stostream_text("M3U parsing tests (") << aNbLines << stostream_text(" lines).\n");
+
+    // raw parser throughput
+    {
+        StM3UParser aParser;
+        StM3UParser::Entry anEntry;
+        size_t aNbEntries = 0;
+        myTimer.restart();
+        aParser.open(aPath);
+        while(aParser.readNext(anEntry)) {
+            ++aNbEntries;
+        }
+        const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+        st::cout << stostream_text("  parser:\t")  << aTimeMSec << stostream_text(" msec")
+                 << stostream_text(" (")           << (1000.0 * double(aParser.getNbLines()) / aTimeMSec) << stostream_text(" lines/s, ")
+                 << aNbEntries << stostream_text(" entries)\n");
+    }
+
+    // playlist population - time to the first chunk and to the complete list
+    {
+        StPlayList aPlayList(1, false);
+        myTimer.restart();
+        aPlayList.open(aPath);
+        const double aFirstMSec = myTimer.getElapsedTimeInMilliSec();
+        while(aPlayList.isParsing()) {
+            StThread::sleep(1);
+        }
+        const double aTimeMSec = myTimer.getElapsedTimeInMilliSec();
+        st::cout << stostream_text("  playlist:\t") << aTimeMSec << stostream_text(" msec")
+                 << stostream_text(" (")            << (1000.0 * double(aNbLines) / aTimeMSec) << stostream_text(" lines/s, ")
+                 << aPlayList.getItemsCount()       << stostream_text(" items, first chunk in ")
+                 << aFirstMSec                      << stostream_text(" msec)\n");
+    }
+
+    StFileNode::removeFile(aPath);
+}
@@ -0,0 +1,46 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestPlayList_h_
+#define __StTestPlayList_h_
+
+#include "StTest.h"
+
+#include <StStrings/StString.h>
+
+/**
+ * Tests M3U playlist parsing performance.
+ */
+class ST_LOCAL StTestPlayList : public StTest {
+
+        public:
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    /**
+     * Generate playlist file with specified number of items.
+     * @return number of lines written
+     */
+    static size_t generate(const StString& thePath,
+                           const size_t    theNbItems);
+
+};
+
+#endif // __StTestPlayList_h_
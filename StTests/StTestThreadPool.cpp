@@ -0,0 +1,211 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestThreadPool.h"
+
+#include <StThreads/StThreadPool.h>
+#include <StStrings/stConsole.h>
+
+namespace {
+
+    /**
+     * Task blocking the worker until released.
+     */
+    class GateTask : public StThreadPool::Task {
+
+            public:
+
+        GateTask() : myEventStarted(false), myEventRelease(false) {}
+
+        virtual void perform() ST_ATTR_OVERRIDE {
+            myEventStarted.set();
+            myEventRelease.wait();
+        }
+
+        void waitStarted() { myEventStarted.wait(); }
+
+        void release() { myEventRelease.set(); }
+
+            private:
+
+        StCondition myEventStarted;
+        StCondition myEventRelease;
+
+    };
+
+    /**
+     * Task recording its identifier into shared execution log.
+     */
+    class OrderTask : public StThreadPool::Task {
+
+            public:
+
+        OrderTask(StMutex& theMutex, std::vector<int>& theLog, const int theId)
+        : myMutex(theMutex), myLog(theLog), myId(theId) {}
+
+        virtual void perform() ST_ATTR_OVERRIDE {
+            StMutexAuto aLock(myMutex);
+            myLog.push_back(myId);
+        }
+
+            private:
+
+        StMutex&          myMutex;
+        std::vector<int>& myLog;
+        int               myId;
+
+    };
+
+    /**
+     * Task simulating short work and incrementing the counter.
+     */
+    class CountTask : public StThreadPool::Task {
+
+            public:
+
+        CountTask(StAtomic<int32_t>& theCounter) : myCounter(theCounter) {}
+
+        virtual void perform() ST_ATTR_OVERRIDE {
+            StThread::sleep(1);
+            myCounter.increment();
+        }
+
+            private:
+
+        StAtomic<int32_t>& myCounter;
+
+    };
+
+    /**
+     * Task spawning nested tasks into the same pool and waiting for them.
+     */
+    class SpawnTask : public StThreadPool::Task {
+
+            public:
+
+        SpawnTask(StThreadPool& thePool, StAtomic<int32_t>& theCounter, const int theNbTasks)
+        : myPool(thePool), myCounter(theCounter), myNbTasks(theNbTasks) {}
+
+        virtual void perform() ST_ATTR_OVERRIDE {
+            std::vector< StHandle<StThreadPool::Task> > aTasks;
+            for(int aTaskIter = 0; aTaskIter < myNbTasks; ++aTaskIter) {
+                aTasks.push_back(new CountTask(myCounter));
+                myPool.push(aTasks.back());
+            }
+            for(size_t aTaskIter = 0; aTaskIter < aTasks.size(); ++aTaskIter) {
+                aTasks[aTaskIter]->wait();
+            }
+        }
+
+            private:
+
+        StThreadPool&      myPool;
+        StAtomic<int32_t>& myCounter;
+        int                myNbTasks;
+
+    };
+
+    inline void printResult(const char* theName, const bool theResult) {
+        st::cout << stostream_text("  ") << theName
+                 << (theResult ? stostream_text("\tOK\n") : stostream_text("\tFAILED\n"));
+    }
+
+};
+
+bool StTestThreadPool::testPriority() {
+    // single worker - execution order is deterministic once the worker is blocked
+    StThreadPool aPool(1);
+    GateTask* aGate = new GateTask();
+    StHandle<StThreadPool::Task> aGateTask = aGate;
+    aPool.push(aGateTask);
+    aGate->waitStarted();
+
+    StMutex aMutex;
+    std::vector<int> aLog;
+    std::vector< StHandle<StThreadPool::Task> > aTasks;
+    for(int aTaskIter = 0; aTaskIter < 3; ++aTaskIter) {
+        aTasks.push_back(new OrderTask(aMutex, aLog, aTaskIter));
+        aPool.push(aTasks.back(), StThreadPool::Priority_Normal);
+    }
+    aTasks.push_back(new OrderTask(aMutex, aLog, 100));
+    aPool.push(aTasks.back(), StThreadPool::Priority_Realtime);
+
+    aGate->release();
+    for(size_t aTaskIter = 0; aTaskIter < aTasks.size(); ++aTaskIter) {
+        aTasks[aTaskIter]->wait();
+    }
+    return aLog.size() == 4
+        && aLog[0] == 100;
+}
+
+bool StTestThreadPool::testStealing() {
+    // spawning worker is blocked waiting for nested tasks pushed into its own queue,
+    // so that they can be executed only by other workers
+    const int aNbTasks = 64;
+    StThreadPool aPool(4);
+    StAtomic<int32_t> aCounter(0);
+    StHandle<StThreadPool::Task> aSpawn = new SpawnTask(aPool, aCounter, aNbTasks);
+    aPool.push(aSpawn);
+    aSpawn->wait();
+
+    const StThreadPool::Stats aStats = aPool.getStats();
+    st::cout << stostream_text("    ") << aStats.toString() << stostream_text("\n");
+    return aCounter.getValue() == aNbTasks
+        && aStats.NbStolen > 0;
+}
+
+bool StTestThreadPool::testBackground() {
+    const int aNbTasks = 16;
+    StThreadPool aPool(2);
+    StAtomic<int32_t> aCounter(0);
+    std::vector< StHandle<StThreadPool::Task> > aTasks;
+    for(int aTaskIter = 0; aTaskIter < aNbTasks; ++aTaskIter) {
+        aTasks.push_back(new CountTask(aCounter));
+        aPool.push(aTasks.back(), StThreadPool::Priority_Background);
+    }
+    for(size_t aTaskIter = 0; aTaskIter < aTasks.size(); ++aTaskIter) {
+        aTasks[aTaskIter]->wait();
+    }
+    return aCounter.getValue() == aNbTasks
+        && aPool.getStats().NbQueued[StThreadPool::Priority_Background] == 0;
+}
+
+bool StTestThreadPool::testShutdown() {
+    const int aNbTasks = 256;
+    StAtomic<int32_t> aCounter(0);
+    {
+        StThreadPool aPool(2);
+        for(int aTaskIter = 0; aTaskIter < aNbTasks; ++aTaskIter) {
+            const StThreadPool::Priority aPriority = StThreadPool::Priority(aTaskIter % StThreadPool::Priority_NB);
+            aPool.push(new CountTask(aCounter), aPriority);
+        }
+        // destructor should wait for all queued tasks
+    }
+    return aCounter.getValue() == aNbTasks;
+}
+
+void StTestThreadPool::perform() {
+    st::cout << stostream_text("Thread pool tests.\n");
+
+    myTimer.restart();
+    printResult("priority ordering:", testPriority());
+    printResult("work stealing:    ", testStealing());
+    printResult("background tasks: ", testBackground());
+    printResult("shutdown:         ", testShutdown());
+    st::cout << stostream_text("  total time:\t") << myTimer.getElapsedTimeInMilliSec() << stostream_text(" msec\n");
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestThreadPool_h_
+#define __StTestThreadPool_h_
+
+#include "StTest.h"
+
+/**
+ * Tests StThreadPool priority ordering, work stealing and shutdown.
+ */
+class ST_LOCAL StTestThreadPool : public StTest {
+
+        public:
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    /**
+     * Realtime task pushed after normal ones should be executed first.
+     */
+    bool testPriority();
+
+    /**
+     * Tasks spawned by blocked worker should be stolen by other workers.
+     */
+    bool testStealing();
+
+    /**
+     * Background tasks should be executed by dedicated workers.
+     */
+    bool testBackground();
+
+    /**
+     * Pool destruction should execute all queued tasks.
+     */
+    bool testShutdown();
+
+};
+
+#endif // __StTestThreadPool_h_
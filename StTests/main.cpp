@@ -25,6 +25,10 @@
 #include "StTestEmbed.h"
 #include "StTestImageLib.h"
 #include "StTestGlStress.h"
+#include "StTestPlayList.h"
+#include "StTestDictionary.h"
+#include "StTestExif.h"
+#include "StTestThreadPool.h"
 
 int main(int , char** ) { // force console output
 #if defined(_WIN32)
@@ -54,6 +58,10 @@ int main(int , char** ) { // force console output
     const StString ST_TEST_GLHANG  = "glhang";
     const StString ST_TEST_EMBED   = "embed";
     const StString ST_TEST_IMAGE   = "image";
+    const StString ST_TEST_PLAYLIST = "playlist";
+    const StString ST_TEST_DICT     = "dict";
+    const StString ST_TEST_EXIF     = "exif";
+    const StString ST_TEST_POOL     = "pool";
     const StString ST_TEST_ALL     = "all";
     size_t aFound = 0;
     for(size_t anArgId = 0; anArgId < anArgs.size(); ++anArgId) {
@@ -88,11 +96,53 @@ int main(int , char** ) { // force console output
             StTestImageLib anImage(anArgs[anArgId]);
             anImage.perform();
             ++aFound;
+        } else if(aParam == ST_TEST_PLAYLIST) {
+            // playlist parsing speed test
+            StTestPlayList aPlayList;
+            aPlayList.perform();
+            ++aFound;
+        } else if(aParam == ST_TEST_DICT) {
+            // dictionary lookup speed test
+            StTestDictionary aDict;
+            aDict.perform();
+            ++aFound;
+        } else if(aParam == ST_TEST_EXIF) {
+            // EXIF parsing speed test, optionally on specified file
+            StString aFilePath;
+            if(anArgId + 1 < anArgs.size()
+            && StFileNode::isFileExists(anArgs[anArgId + 1])) {
+                aFilePath = anArgs[++anArgId];
+            }
+
+            StTestExif anExif(aFilePath);
+            anExif.perform();
+            ++aFound;
+        } else if(aParam == ST_TEST_POOL) {
+            // thread pool scheduling test
+            StTestThreadPool aPool;
+            aPool.perform();
+            ++aFound;
         } else if(aParam == ST_TEST_ALL) {
             // mutex speed test
             StTestMutex aMutices;
             aMutices.perform();
 
+            // playlist parsing speed test
+            StTestPlayList aPlayList;
+            aPlayList.perform();
+
+            // dictionary lookup speed test
+            StTestDictionary aDict;
+            aDict.perform();
+
+            // EXIF parsing speed test
+            StTestExif anExif;
+            anExif.perform();
+
+            // thread pool scheduling test
+            StTestThreadPool aPool;
+            aPool.perform();
+
             // gl <-> cpu trasfer speed test
             StTestGlBand aGlBand;
             aGlBand.perform();
@@ -114,6 +164,10 @@ int main(int , char** ) { // force console output
                  << stostream_text("  glband - gl <-> cpu trasfer speed test\n")
                  << stostream_text("  glhang - gl stress test\n")
                  << stostream_text("  embed  - test window embedding\n")
+                 << stostream_text("  playlist - playlist parsing speed test\n")
+                 << stostream_text("  dict   - dictionary lookup speed test\n")
+                 << stostream_text("  exif [fileName] - EXIF parsing speed test\n")
+                 << stostream_text("  pool   - thread pool scheduling test\n")
                  << stostream_text("  image fileName - test image libraries\n");
     }
 
@@ -20,8 +20,11 @@ class StAVIOContext {
 
     /**
      * Main constructor.
+     * @param theBufferSize size of intermediate buffer in bytes
+     * @param theToWrite    create context for writing
      */
-    ST_CPPEXPORT StAVIOContext();
+    ST_CPPEXPORT StAVIOContext(const int  theBufferSize = 32768,
+                               const bool theToWrite    = false);
 
     /**
      * Destructor.
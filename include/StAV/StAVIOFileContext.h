@@ -23,6 +23,14 @@ class StAVIOFileContext : public StAVIOContext {
      */
     ST_CPPEXPORT StAVIOFileContext();
 
+    /**
+     * Constructor with custom buffer.
+     * @param theBufferSize size of intermediate buffer in bytes
+     * @param theToWrite    create context for writing
+     */
+    ST_CPPEXPORT StAVIOFileContext(const int  theBufferSize,
+                                   const bool theToWrite);
+
     /**
      * Destructor.
      */
@@ -39,6 +47,15 @@ class StAVIOFileContext : public StAVIOContext {
      */
     ST_CPPEXPORT bool openFromDescriptor(int theFD, const char* theMode);
 
+    /**
+     * Open the file.
+     * The file will be automatically closed on destruction.
+     * @param thePath file path
+     * @param theMode fopen() mode, like "rb" or "wb"
+     */
+    ST_CPPEXPORT bool open(const StString& thePath,
+                           const char*     theMode);
+
     /**
      * Read from the file.
      */
@@ -72,6 +72,15 @@ class StAVImage : public StImageFile {
                                         int             theDataSize,
                                         bool            theIsOnlyRGB) ST_ATTR_OVERRIDE;
 
+    /**
+     * Request decoding at reduced resolution (1/2^theLevel of original dimensions)
+     * for decoders supporting this option (like mjpeg), which is much faster than decoding full image for thumbnails.
+     * @param theLevel lowres level, 0 means full resolution
+     */
+    ST_LOCAL void setLowResolution(const int theLevel) {
+        myLowRes = theLevel;
+    }
+
     /**
      * Save image to specified path.
      */
@@ -95,6 +104,7 @@ class StAVImage : public StImageFile {
     AVCodecContext*  myCodecCtx;    //!< codec context
     AVCodec*         myCodec;       //!< codec
     StAVFrame        myFrame;
+    int              myLowRes;      //!< requested lowres level
 
 };
 
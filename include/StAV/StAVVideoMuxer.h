@@ -12,6 +12,7 @@
 #include <StGLStereo/StFormatEnum.h>
 #include <StSlots/StSignal.h>
 #include <StTemplates/StArrayList.h>
+#include <StThreads/StMutex.h>
 
 struct AVFormatContext;
 struct AVCodecContext;
@@ -21,9 +22,34 @@ struct AVStream;
 
 /**
  * This class implements video re-muxing operation using libav* libraries.
+ * Each input is read-ahead by dedicated thread into bounded packet queue,
+ * while packets are interleaved by DTS and written through large output buffer,
+ * so that memory usage does not depend on the file size.
  */
 class StAVVideoMuxer {
 
+        public:
+
+    /**
+     * Remuxing progress.
+     */
+    struct Progress {
+        double  Ratio;        //!< processed part of the input within 0..1 range
+        double  ElapsedSec;   //!< elapsed time in seconds
+        int64_t BytesRead;    //!< number of bytes read from inputs
+        int64_t BytesWritten; //!< number of bytes written into output
+        int64_t NbPackets;    //!< number of written packets
+
+        Progress() : Ratio(0.0), ElapsedSec(0.0), BytesRead(0), BytesWritten(0), NbPackets(0) {}
+
+        /**
+         * @return read throughput in MiB per second
+         */
+        double getThroughput() const {
+            return ElapsedSec > 0.0 ? double(BytesRead) / (1024.0 * 1024.0 * ElapsedSec) : 0.0;
+        }
+    };
+
         protected:
 
     struct StRemuxContext {
@@ -67,10 +93,27 @@ class StAVVideoMuxer {
     ST_CPPEXPORT bool addFile(const StString& theFileToLoad);
 
     /**
-     * Save to the file.
+     * Save to the file (blocking call).
+     * Operation can be interrupted by cancel() from another thread.
      */
     ST_CPPEXPORT virtual bool save(const StString& theFile);
 
+    /**
+     * Request interruption of save() operation (can be called from any thread).
+     * Partially written output file is removed.
+     */
+    ST_LOCAL void cancel() { myToCancel = true; }
+
+    /**
+     * Return progress of the current (or last) save() operation (can be called from any thread).
+     */
+    ST_CPPEXPORT Progress getProgress() const;
+
+    /**
+     * Set the limit of read-ahead data per input, 64 MiB by default.
+     */
+    ST_LOCAL void setReadAheadLimit(const size_t theNbBytes) { myReadAheadLimit = theNbBytes; }
+
         public: //! @name signals
 
     /**
@@ -82,6 +125,12 @@ class StAVVideoMuxer {
          * @param theUserData (const StString& ) - error description.
          */
         StSignal<void (const StCString& )> onError;
+
+        /**
+         * Emit callback Slot periodically while saving (from the thread calling save()).
+         * @param theUserData (const double ) - processed part of the input within 0..1 range.
+         */
+        StSignal<void (const double )> onProgress;
     } signals;
 
         protected:
@@ -92,10 +141,19 @@ class StAVVideoMuxer {
     ST_CPPEXPORT bool addStream(AVFormatContext* theContext,
                                 AVStream*        theStream);
 
+    /**
+     * Update progress.
+     */
+    ST_LOCAL void setProgress(const Progress& theProgress);
+
         private:
 
     StArrayList<AVFormatContext*> myCtxListSrc;
     StFormat                      myStereoFormat;
+    size_t                        myReadAheadLimit; //!< read-ahead limit per input in bytes
+    volatile bool                 myToCancel;       //!< flag to interrupt save() operation
+    mutable StMutex               myProgressLock;   //!< lock for progress
+    Progress                      myProgress;       //!< progress of save() operation
 
 };
 
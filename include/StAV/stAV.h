@@ -235,6 +235,7 @@ namespace stAV {
         ST_SHARED_CPPEXPORT AVPixelFormat YUV411P;   //!< planar YUV 4:1:1, 12bpp, (1 Cr & Cb sample per 4x1 Y samples)
         ST_SHARED_CPPEXPORT AVPixelFormat YUV440P;   //!< planar YUV 4:4:0 (1 Cr & Cb sample per 1x2 Y samples)
         ST_SHARED_CPPEXPORT AVPixelFormat NV12;      //!< YUV420, Y plane + interleaved UV plane oh half width and height
+        ST_SHARED_CPPEXPORT AVPixelFormat P010;      //!< same as NV12 but with 10 bits stored in upper bits of 16 bits (little-endian)
         // wide planar YUV formats (9,10,14,16 bits stored in 16 bits)
         ST_SHARED_CPPEXPORT AVPixelFormat YUV420P9;
         ST_SHARED_CPPEXPORT AVPixelFormat YUV422P9;
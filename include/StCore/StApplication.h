@@ -18,10 +18,71 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 class StEventsBuffer;
 class StSettings;
 
+/**
+ * Descriptor of output renderer, which is created on first use.
+ */
+class StRendererFactory {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theRendererId identifier returned by StWindow::getRendererId() of created renderer
+     * @param theTitle      name to show in devices list until renderer is created
+     */
+    ST_LOCAL StRendererFactory(const char* theRendererId,
+                               const char* theTitle)
+    : myRendererId(theRendererId),
+      myTitle(theTitle) {}
+
+    ST_LOCAL virtual ~StRendererFactory() {}
+
+    /**
+     * @return renderer identifier
+     */
+    ST_LOCAL const char* getRendererId() const { return myRendererId; }
+
+    /**
+     * @return renderer name
+     */
+    ST_LOCAL const char* getTitle() const { return myTitle; }
+
+    /**
+     * Create renderer instance.
+     */
+    virtual StWindow* create(const StHandle<StResourceManager>& theResMgr,
+                             const StNativeWin_t                theParentWin) const = 0;
+
+        private:
+
+    const char* myRendererId;
+    const char* myTitle;
+
+};
+
+/**
+ * Factory for the renderer class with standard constructor.
+ */
+template<typename Renderer_t>
+class StRendererFactoryT : public StRendererFactory {
+
+        public:
+
+    ST_LOCAL StRendererFactoryT(const char* theRendererId,
+                                const char* theTitle) : StRendererFactory(theRendererId, theTitle) {}
+
+    ST_LOCAL virtual StWindow* create(const StHandle<StResourceManager>& theResMgr,
+                                      const StNativeWin_t                theParentWin) const ST_ATTR_OVERRIDE {
+        return new Renderer_t(theResMgr, theParentWin);
+    }
+
+};
+
 /**
  * This class provides basic interface for interactive application.
  */
@@ -171,6 +232,29 @@ class StApplication {
      */
     ST_CPPEXPORT int getActionIdFromName(const StString& theActionName) const;
 
+    /**
+     * Redraw scheduler statistics.
+     */
+    struct RedrawStats {
+        unsigned int NbDrawn;    //!< number of iterations with redraw
+        unsigned int NbSkipped;  //!< number of idle iterations (without redraw)
+        double       DrawTimeMs; //!< CPU time spent within redraws, in milliseconds
+        double       PeriodMs;   //!< measurement period, in milliseconds
+
+        RedrawStats() : NbDrawn(0), NbSkipped(0), DrawTimeMs(0.0), PeriodMs(0.0) {}
+    };
+
+    /**
+     * Return redraw statistics for the last measurement period (about one second).
+     */
+    ST_LOCAL const RedrawStats& getRedrawStats() const { return myRedrawStats; }
+
+    /**
+     * Request window redraw within next iteration.
+     * Should be called on content change which is not tracked by isRedrawNeeded().
+     */
+    ST_LOCAL void invalidate() { myToRedraw = true; }
+
         protected:
 
     /**
@@ -178,6 +262,15 @@ class StApplication {
      */
     ST_CPPEXPORT virtual void beforeDraw();
 
+    /**
+     * Return true if window should be redrawn within current iteration (called right after beforeDraw()).
+     * Redrawing of unchanged content is skipped (unless params.IdleHeartbeat is zero)
+     * to reduce CPU/GPU load on static content.
+     * Default implementation checks explicit invalidation, window events, renderer requirements and heartbeat period;
+     * inheritors should extend it with own damage sources (new video frames, GUI changes).
+     */
+    ST_CPPEXPORT virtual bool isRedrawNeeded() const;
+
     /**
      * Rendering callback.
      */
@@ -193,6 +286,29 @@ class StApplication {
      */
     ST_CPPEXPORT void addRenderer(const StHandle<StWindow>& theRenderer);
 
+    /**
+     * Register renderer to be created on first use.
+     * Only the renderer requested by settings (or command line) is created on startup,
+     * while others are listed in devices list by single placeholder item
+     * and created only when this item is selected
+     * (all renderers are created on startup in automatic mode to choose the best device).
+     */
+    ST_CPPEXPORT void addRenderer(const StHandle<StRendererFactory>& theFactory);
+
+    /**
+     * Register renderer class to be created on first use.
+     */
+    template<typename Renderer_t>
+    void addRendererLazy(const char* theRendererId,
+                         const char* theTitle) {
+        addRenderer(StHandle<StRendererFactory>(new StRendererFactoryT<Renderer_t>(theRendererId, theTitle)));
+    }
+
+    /**
+     * Setup window attributes for all (including not yet created) renderers.
+     */
+    ST_CPPEXPORT void setRendererAttributes(const StWinAttr* theAttribs);
+
     /**
      * Modify actions.
      */
@@ -327,6 +443,7 @@ class StApplication {
 
         StHandle<StEnumParam> ActiveDevice; //!< enumerated devices
         StHandle<StEnumParam> VSyncMode;    //!< VSync mode from StGLContext::VSync_Mode enumeration (shared between renderers)
+        StHandle<StInt32ParamNamed> IdleHeartbeat; //!< redraw period for unchanged content in milliseconds, 0 means continuous redraw
 
     } params;
 
@@ -335,9 +452,34 @@ class StApplication {
     ST_LOCAL void stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo);
     ST_LOCAL void doDrawProxy(unsigned int theView);
 
+    /**
+     * Return renderer identifier without creating renderer.
+     */
+    ST_LOCAL StString getRendererId(const size_t theIndex) const;
+
+    /**
+     * Create renderer with specified index, if not yet created.
+     * @return FALSE if renderer has been already created
+     */
+    ST_LOCAL bool initRenderer(const size_t theIndex);
+
+    /**
+     * Create all registered renderers and update devices list.
+     */
+    ST_LOCAL void initRenderers();
+
+    /**
+     * Re-fill devices list from created renderers
+     * and placeholders of not yet created ones.
+     */
+    ST_LOCAL void updateDevices();
+
         protected: //! @name protected fields
 
-    StArrayList< StHandle<StWindow> > myRenderers; //!< list of registered renderers
+    StArrayList< StHandle<StWindow> > myRenderers; //!< list of registered renderers (NULL if not yet created)
+    std::vector< StHandle<StRendererFactory> >
+                                      myRendererFactories; //!< factories of lazily created renderers
+    std::vector<StWinAttr>            myRendererAttribs;   //!< window attributes to be applied to created renderers
     StHandle<StResourceManager>       myResMgr;    //!< resources manager
     StHandle<StTranslations>          myLangMap;   //!< translated strings map
     StHandle<StMsgQueue>  myMsgQueue;              //!< messages queue
@@ -358,12 +500,21 @@ class StApplication {
     StString              myTitle;                 //!< application title
     StOutDevicesList      myDevices;
     StString              myRendId;                //!< renderer ID
+    StString              myProfileStartup;        //!< path to the JSON file for startup profile
+    bool                  myToProfileStartup;      //!< dump startup profile after the first frame
+    bool                  myIsFirstFrameDrawn;     //!< flag indicating that the first frame has been drawn
     int                   myExitCode;
     bool                  myGlDebug;               //!< request debug OpenGL context
     bool                  myIsOpened;              //!< application execution state
     bool                  myToQuit;                //!< request for application termination
     bool                  myToRecreateMenu;        //!< flag to recreate the menu
     StTimer               myExitTimer;             //!< double click exit timer
+    bool                  myToRedraw;              //!< flag indicating that content has been changed since last redraw
+    StTimer               myRedrawTimer;           //!< timer since last redraw
+    StTimer               myStatsTimer;            //!< timer for redraw statistics period
+    StTimer               myDrawTimer;             //!< timer measuring redraw duration
+    RedrawStats           myRedrawStats;           //!< redraw statistics of the last period
+    RedrawStats           myRedrawStatsAcc;        //!< redraw statistics accumulated within current period
 
         private: //! @name no copies, please
 
@@ -311,6 +311,11 @@ class StWindow {
      */
     ST_CPPEXPORT bool isMouseMoved() const;
 
+    /**
+     * @return true if any input or window events have been processed (or cursor has been moved) within previous processEvents().
+     */
+    ST_CPPEXPORT bool hasNewEvents() const;
+
     /**
      * Resources manager.
      */
@@ -469,6 +474,13 @@ class StWindow {
      */
     ST_CPPEXPORT virtual void setTrackOrientation(const bool theToTrack);
 
+    /**
+     * Return true if renderer should be redrawn in every iteration even when content is unchanged
+     * (e.g. software page flipping or head tracking).
+     * Default implementation returns true only when orientation tracking is active.
+     */
+    ST_CPPEXPORT virtual bool toDrawContinuously() const;
+
     /**
      * Setup visibility of system bars.
      */
@@ -13,11 +13,17 @@
 #include <StFile/StFolder.h>
 
 #include <map>
+#include <vector>
 
 /**
  * Class to manage the list of available fonts in the system.
  * Unlike font management classes this one does not share access to font instances,
  * but only the list to the font files.
+ *
+ * Opening font files for reading their family and style is slow,
+ * so that resolved fonts can be stored within persistent index file (see setIndexPath()).
+ * The index is validated by modification time of scanned folders;
+ * outdated index is still used by current session while the index is rebuilt in background.
  */
 class StFTFontRegistry {
 
@@ -33,6 +39,21 @@ class StFTFontRegistry {
      */
     ST_CPPEXPORT virtual ~StFTFontRegistry();
 
+    /**
+     * @return path to the persistent fonts index
+     */
+    ST_LOCAL const StString& getIndexPath() const {
+        return myIndexPath;
+    }
+
+    /**
+     * Set path to the persistent fonts index, should be called before init().
+     * Empty path (default) disables the index.
+     */
+    ST_LOCAL void setIndexPath(const StString& thePath) {
+        myIndexPath = thePath;
+    }
+
     /**
      * Initialize the fonts list.
      * @param theToSearchAll flag to register ALL font files within specified search folders (slower)
@@ -58,11 +79,103 @@ class StFTFontRegistry {
 
         private:
 
+    /**
+     * Resolved font file.
+     */
+    struct FontEntry {
+        StString Name;       //!< font file name within search paths (or absolute path)
+        StString Path;       //!< resolved file path, empty if file has not been found
+        StString FamilyName; //!< font family name
+        int      FaceId;     //!< face index within the file
+        int      StyleFlags; //!< FreeType style flags
+        int      NbGlyphs;   //!< number of glyphs
+        int      Subsets;    //!< bit mask of StFTFont::Subset covered by the font
+        bool     IsMajor;    //!< major font flag
+
+        ST_LOCAL FontEntry() : FaceId(0), StyleFlags(0), NbGlyphs(0), Subsets(0), IsMajor(false) {}
+    };
+
+    /**
+     * Scanned folder.
+     */
+    struct FolderEntry {
+        StString Path;    //!< folder path
+        int64_t  ModTime; //!< modification time (seconds since epoch)
+        bool     IsRoot;  //!< search path flag
+
+        ST_LOCAL FolderEntry() : ModTime(0), IsRoot(false) {}
+    };
+
+    /**
+     * Fonts index.
+     */
+    struct FontIndex {
+        std::vector<FolderEntry> Folders; //!< scanned folders
+        std::vector<FontEntry>   Fonts;   //!< resolved font files
+    };
+
+    /**
+     * Index state.
+     */
+    enum IndexState {
+        IndexState_Missing, //!< index does not exist or it has been created for another list of fonts
+        IndexState_Stale,   //!< some folders have been modified since index creation
+        IndexState_Valid,   //!< index is up-to-date
+    };
+
+    class IndexTask;
+
+        private:
+
+    /**
+     * Scan search folders and resolve specified font files.
+     */
+    ST_LOCAL static void scanFonts(const StHandle<StFTLibrary>& theFTLib,
+                                   const StArrayList<StString>& theFolders,
+                                   const StArrayList<StString>& theExtensions,
+                                   const StArrayList<StString>& theFilesMajor,
+                                   const StArrayList<StString>& theFilesMinor,
+                                   FontIndex&                   theIndex);
+
+    /**
+     * Append folder and its sub-folders to the index.
+     */
+    ST_LOCAL static void addFolders(const StFolder& theFolder,
+                                    const bool      theIsRoot,
+                                    FontIndex&      theIndex);
+
     /**
      * Search the specified font files.
      */
-    void searchFiles(const StArrayList<StString>& theNames,
-                     const bool                   theIsMajor);
+    ST_LOCAL static void searchFiles(const StHandle<StFTLibrary>& theFTLib,
+                                     const StFolder&              theFoldersRoot,
+                                     const StArrayList<StString>& theNames,
+                                     const bool                   theIsMajor,
+                                     FontIndex&                   theIndex);
+
+    /**
+     * Read the index file.
+     */
+    ST_LOCAL static bool readIndex(const StString& thePath,
+                                   FontIndex&      theIndex);
+
+    /**
+     * Write the index file.
+     */
+    ST_LOCAL static bool writeIndex(const StString&  thePath,
+                                    const FontIndex& theIndex);
+
+    /**
+     * Check if index has been created for current search paths and font files
+     * and that scanned folders have not been modified since then.
+     */
+    ST_LOCAL IndexState checkIndex(const FontIndex& theIndex) const;
+
+    /**
+     * Fill in font families from the index.
+     */
+    ST_LOCAL void registerFonts(const FontIndex& theIndex,
+                                const bool       theToCheckFiles);
 
         private:
 
@@ -71,7 +184,7 @@ class StFTFontRegistry {
     StArrayList<StString> myFilesMajor;  //!< major font file names which should present in the system
     StArrayList<StString> myFilesMinor;  //!< minor font file names
 
-    StFolder              myFoldersRoot; //!< files tree
+    StString              myIndexPath;   //!< path to the persistent fonts index
     StHandle<StFTLibrary> myFTLib;       //!< handle to the FT library object
 
     std::map<StString, StFTFontFamily> myFonts; //!< map family name -> font files
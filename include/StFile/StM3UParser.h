@@ -0,0 +1,103 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StM3UParser_h__
+#define __StM3UParser_h__
+
+#include <StFile/StRawFile.h>
+
+#include <vector>
+
+/**
+ * Streaming parser of M3U/M3U8 playlists.
+ * The file is read by fixed-size chunks, so that memory usage does not depend on playlist size
+ * and the caller may publish parsed entries incrementally.
+ */
+class StM3UParser {
+
+        public:
+
+    /**
+     * Playlist entry.
+     */
+    struct Entry {
+        StString Path;  //!< item path as written in the playlist (might be relative)
+        StString Title; //!< item title from #EXTINF tag (or empty)
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theChunkSize size of read chunk in bytes
+     */
+    ST_CPPEXPORT StM3UParser(const size_t theChunkSize = 64 * 1024);
+
+    /**
+     * Destructor.
+     */
+    ST_CPPEXPORT ~StM3UParser();
+
+    /**
+     * Open the playlist file for parsing.
+     */
+    ST_CPPEXPORT bool open(const StCString& thePath);
+
+    /**
+     * Close the file.
+     */
+    ST_CPPEXPORT void close();
+
+    /**
+     * Read the next entry.
+     * @param theEntry the entry to fill
+     * @return FALSE at the end of file
+     */
+    ST_CPPEXPORT bool readNext(Entry& theEntry);
+
+    /**
+     * @return number of processed lines since open()
+     */
+    ST_LOCAL size_t getNbLines() const {
+        return myNbLines;
+    }
+
+    /**
+     * @return TRUE if path has m3u or m3u8 extension
+     */
+    ST_CPPEXPORT static bool isPlayListPath(const StString& thePath);
+
+        private:
+
+    /**
+     * Fetch the next line from the file.
+     * Line is terminated by zero within internal buffer, trailing CR and spaces are removed.
+     * @return NULL at the end of file
+     */
+    ST_LOCAL char* readLine();
+
+    /**
+     * Read the next chunk into the buffer.
+     * @return FALSE if nothing has been read
+     */
+    ST_LOCAL bool fillBuffer();
+
+        private:
+
+    StRawFile         myFile;      //!< file handle
+    std::vector<char> myBuffer;    //!< read buffer
+    size_t            myChunkSize; //!< read chunk size
+    size_t            myStart;     //!< position of unprocessed data within the buffer
+    size_t            myEnd;       //!< end of valid data within the buffer
+    size_t            myNbLines;   //!< processed lines counter
+    bool              myIsEof;     //!< end of file flag
+    bool              myIsFirst;   //!< flag to check BOM within the first line
+
+};
+
+#endif // __StM3UParser_h__
@@ -121,6 +121,16 @@ class StRawFile : public StFileNode {
     ST_CPPEXPORT size_t write(const char*  theBuffer,
                               const size_t theBytes);
 
+    /**
+     * Read the next portion of opened file into specified buffer.
+     * Unlike readFile(), allows processing large files in chunks.
+     * @param theBuffer destination buffer
+     * @param theBytes  the buffer size
+     * @return number of read bytes, 0 at the end of file or on error
+     */
+    ST_CPPEXPORT size_t read(char*        theBuffer,
+                             const size_t theBytes);
+
     /**
      * Fill the buffer with file content.
      * @param theFilePath the file path
@@ -286,6 +286,108 @@ class StGLContext {
      */
     ST_CPPEXPORT void stglSyncState();
 
+    /**
+     * Interface for deferred (batched) drawing.
+     * Pending geometry should be submitted before any other GL state change
+     * to preserve the drawing order.
+     */
+    class DeferredDraw {
+
+            public:
+
+        virtual ~DeferredDraw() {}
+
+        /**
+         * Submit pending geometry.
+         */
+        virtual void stglFlush(StGLContext& theCtx) = 0;
+
+    };
+
+    /**
+     * Per-frame counters.
+     */
+    struct FrameStats {
+        unsigned int NbProgramBinds;  //!< number of glUseProgram() calls
+        unsigned int NbProgramSkips;  //!< number of redundant glUseProgram() calls which have been skipped
+    };
+
+    /**
+     * @return active deferred drawing interface or NULL
+     */
+    ST_LOCAL DeferredDraw* stglDeferredDraw() const {
+        return myDeferredDraw;
+    }
+
+    /**
+     * Setup deferred drawing interface (should be NULL when deferred drawing is not used).
+     */
+    ST_LOCAL void stglSetDeferredDraw(DeferredDraw* theDraw) {
+        myDeferredDraw = theDraw;
+    }
+
+    /**
+     * Submit pending geometry of deferred drawing interface.
+     * Should be called before any GL state change.
+     */
+    ST_LOCAL void stglFlushDeferred() {
+        if(myDeferredDraw != NULL) {
+            // prevent recursive flush from programs used by deferred drawing itself
+            DeferredDraw* aDraw = myDeferredDraw;
+            myDeferredDraw = NULL;
+            aDraw->stglFlush(*this);
+            myDeferredDraw = aDraw;
+        }
+    }
+
+    /**
+     * @return currently bound GLSL program
+     */
+    ST_LOCAL GLuint stglActiveProgram() const {
+        return myActiveProgram;
+    }
+
+    /**
+     * Bind GLSL program (skipped if the same program is already bound).
+     */
+    ST_CPPEXPORT void stglUseProgram(const GLuint theProgram);
+
+    /**
+     * Access per-frame counters.
+     */
+    ST_LOCAL const FrameStats& getFrameStats() const {
+        return myFrameStats;
+    }
+
+    /**
+     * Reset per-frame counters.
+     */
+    ST_LOCAL void resetFrameStats() {
+        stMemZero(&myFrameStats, sizeof(myFrameStats));
+    }
+
+    /**
+     * @return true if current draw target is an offscreen buffer expecting premultiplied alpha
+     */
+    ST_LOCAL bool stglIsPremultipliedTarget() const {
+        return myIsPremultTarget;
+    }
+
+    /**
+     * Setup flag indicating that current draw target is an offscreen buffer
+     * (initially cleared to transparent) which will be composited with premultiplied alpha.
+     */
+    ST_LOCAL void stglSetPremultipliedTarget(const bool theIsPremult) {
+        myIsPremultTarget = theIsPremult;
+    }
+
+    /**
+     * Setup blending function for conventional alpha blending
+     * (takes into account premultiplied target flag).
+     * GL_BLEND should be enabled by caller.
+     */
+    ST_CPPEXPORT void stglSetBlendAlpha();
+
     /**
      * Enable scissor test for this context (glScissor).
      * @param thePushStack If true than current rectangle will be pushed into stack
@@ -455,6 +557,10 @@ class StGLContext {
     StGLBoxPx               myViewport;           //!< cached viewport rectangle
     GLuint                  myFramebufferDraw;    //!< bound draw buffer
     GLuint                  myFramebufferRead;    //!< bound read buffer
+    GLuint                  myActiveProgram;      //!< bound GLSL program
+    DeferredDraw*           myDeferredDraw;       //!< deferred drawing interface
+    FrameStats              myFrameStats;         //!< per-frame counters
+    bool                    myIsPremultTarget;    //!< flag indicating offscreen target with premultiplied alpha
     bool                    myIsBound;            //!< flag indicating make current state
 
 };
@@ -51,8 +51,11 @@ class StGLFontManager : public StGLResource {
 
     /**
      * Main constructor.
+     * @param theResolution  font resolution
+     * @param theCacheFolder folder to store fonts index, empty to disable
      */
-    ST_CPPEXPORT StGLFontManager(const unsigned int theResolution = 72);
+    ST_CPPEXPORT StGLFontManager(const unsigned int theResolution  = 72,
+                                 const StString&    theCacheFolder = StString());
 
     /**
      * Destructor - should be called after release()!
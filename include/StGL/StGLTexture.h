@@ -217,6 +217,19 @@ class StGLTexture : public StGLResource {
                                 const GLsizei       theRowFrom,
                                 const GLsizei       theRowTo);
 
+    /**
+     * Fill the rectangular region of the texture with the image plane (e.g. the cell of texture atlas).
+     * @param theCtx     current context
+     * @param theData    the image plane to copy data from (should fit into the texture at specified offset)
+     * @param theOffsetX texel offset in the x direction
+     * @param theOffsetY texel offset in the y direction
+     * @return true on success
+     */
+    ST_CPPEXPORT bool fillRegion(StGLContext&        theCtx,
+                                 const StImagePlane& theData,
+                                 const GLsizei       theOffsetX,
+                                 const GLsizei       theOffsetY);
+
     /**
      * @return GL texture ID.
      */
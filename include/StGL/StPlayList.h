@@ -10,13 +10,16 @@
 #define __StPlayList_h__
 
 #include <StFile/StFolder.h>
+#include <StFile/StM3UParser.h>
 #include <StGL/StParams.h>
 
 #include <StGLStereo/StGLTextureQueue.h>
 #include <StThreads/StMinGen.h>
+#include <StThreads/StThread.h>
 #include <StSlots/StSignal.h>
 
 #include <deque>
+#include <map>
 
 /**
  * Playlist node.
@@ -287,6 +290,12 @@ class StPlayList {
      */
     ST_CPPEXPORT bool walkToNext(const bool theToForce = true);
 
+    /**
+     * Returns file node for the item to be played next by walkToNext(false).
+     * @return NULL if there is no next item or it is unpredictable (random order in shuffle mode)
+     */
+    ST_CPPEXPORT StHandle<StFileNode> getNextFile();
+
     /**
      * Verify the filename extension is in supported list.
      */
@@ -313,6 +322,11 @@ class StPlayList {
     ST_CPPEXPORT void open(const StCString& thePath,
                            const StCString& theItem = stCString(""));
 
+    /**
+     * @return TRUE if playlist file is still being parsed in background
+     */
+    ST_CPPEXPORT bool isParsing() const;
+
     /**
      * Fill list with playlist items (only titles).
      * @param theList  the list to fill
@@ -399,6 +413,14 @@ class StPlayList {
          * @param theItem index of changed item
          */
         StSignal<void (const size_t )> onTitleChange;
+
+        /**
+         * Emit callback Slot when the item requested within open() has been found
+         * by background playlist parsing and became current.
+         * Called from the working thread.
+         * @param theItem position of found item
+         */
+        StSignal<void (const size_t )> onTargetFound;
     } signals;
 
         private:
@@ -408,6 +430,23 @@ class StPlayList {
         StHandle<StStereoParams> Params;
     };
 
+    /**
+     * State of incremental M3U parsing.
+     */
+    struct StM3UTask {
+        StM3UParser    Parser;      //!< streaming parser
+        StString       Target;      //!< path to the item to be set as current
+        StStereoParams DefParams;   //!< default stereo parameters for new items
+        StFolder*      Folder;      //!< folder for relative paths
+        size_t         Generation;  //!< playlist generation this task fills
+        size_t         NbEntries;   //!< number of published entries
+        bool           HasTarget;   //!< target item is not yet found
+        bool           IsNested;    //!< nested playlist is being parsed
+        bool           IsAsync;     //!< parsing is performed by working thread
+
+        StM3UTask() : Folder(NULL), Generation(0), NbEntries(0), HasTarget(false), IsNested(false), IsAsync(false) {}
+    };
+
         private:
 
     /**
@@ -432,11 +471,30 @@ class StPlayList {
                                                          const bool        theToFront = true);
 
     /**
-     * M3U parsing stuff.
+     * Parse the next portion of M3U playlist and append it to the list.
+     * The file is parsed without lock, so that playlist remains accessible.
+     * @param theTask  parsing state
+     * @param theLimit maximum number of entries to parse
+     * @return FALSE if parsing is done or has been cancelled
+     */
+    ST_LOCAL bool parseM3UChunk(StM3UTask&   theTask,
+                                const size_t theLimit);
+
+    /**
+     * Thread function parsing the rest of playlist file.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION parseM3UThread(void* thePlayList);
+
+    /**
+     * Cancel background parsing and wait for working thread.
+     * Should be called without lock.
+     */
+    ST_LOCAL void stopParsing();
+
+    /**
+     * Verify extension is within supported list (memoized).
      */
-    ST_LOCAL char* parseM3UIter(char*     theIter,
-                                StFolder* theFolder,
-                                StString& theTitle);
+    ST_LOCAL bool isSupportedExtension(const StString& theExtension);
 
     /**
      * Save current playlist in m3u format.
@@ -454,6 +512,7 @@ class StPlayList {
     std::deque<StPlayItem*> myStackNext;     //!< stack of next     items (for shuffle playback)
     size_t                  myItemsCount;    //!< current playlist size
     StArrayList<StString>   myExtensions;    //!< extensions list
+    std::map<StString, bool> myExtCache;     //!< cached results of extension checks
     StStereoParams          myDefStParams;   //!< default stereo parameters
     StMinGen                myRandGen;       //!< random number generator for shuffle playback
     size_t                  myPlayedCount;   //!< played items in current iteration (< myItemsCount)
@@ -470,6 +529,11 @@ class StPlayList {
     StAtomic<int32_t>       mySerial;        //!< serial number of playlist content
     bool                    myWasCleared;    //!< flag to indicate that playlist was cleared recently
 
+    StHandle<StM3UTask>     myParseTask;     //!< background parsing state
+    StHandle<StThread>      myParseThread;   //!< background parsing thread
+    size_t                  myParseGen;      //!< playlist generation, incremented on clear() to cancel parsing
+    bool                    myIsParsing;     //!< background parsing is in progress
+
 };
 
 #endif // __StPlayList_h__
@@ -150,6 +150,12 @@ class StGLTextureData {
 
     ST_CPPEXPORT void getCopy(StImage* outDataL, StImage* outDataR) const;
 
+    /**
+     * Similar to getCopy() but takes reference to the source buffer when it is ref-counted,
+     * so that the data is copied only if it has been converted into own buffer.
+     */
+    ST_CPPEXPORT void getReference(StImage* theDataL, StImage* theDataR) const;
+
     /**
      * Release memory.
      */
@@ -12,6 +12,7 @@
 #include <StThreads/StCondition.h>
 #include <StThreads/StFPSMeter.h>
 #include <StThreads/StMutex.h>
+#include <StStrings/StStringBuilder.h>
 
 #include <StGL/StGLDeviceCaps.h>
 
@@ -118,7 +119,11 @@ class StGLTextureQueue {
         const bool isUpdated = myFPSMeter.isUpdated();
         myMeterMutex.unlock();
         if(isUpdated) {
-            ST_DEBUG_LOG("Queue playback FPS " + theFps + ", buffers: " + theQueued + "/" + theQueueLen);
+        #ifdef ST_DEBUG
+            StStringBuilder aMsg;
+            aMsg << "Queue playback FPS " << theFps << ", buffers: " << theQueued << "/" << theQueueLen;
+            StLogger::GetDefault().write(aMsg.toString(), StLogger::ST_TRACE);
+        #endif
         }
     }
 
@@ -146,6 +151,22 @@ class StGLTextureQueue {
         return aResult;
     }
 
+    /**
+     * Return true if queue has a frame to upload or uploaded frame ready to be shown,
+     * so that next stglUpdateStTextures() call will change displayed content.
+     * Should be called only from plugin (rendering) thread.
+     */
+    ST_LOCAL bool hasPendingUpdate() const {
+        if(myIsReadyToSwap) {
+            mySwapFBMutex.lock();
+                const bool toSwap = mySwapFBCount != 0;
+            mySwapFBMutex.unlock();
+            return toSwap;
+        }
+        return myIsInUpdTexture
+           || !isEmpty();
+    }
+
     /**
      * @return true if queue is FULL.
      */
@@ -239,9 +260,17 @@ class StGLTextureQueue {
         SNAPSHOT_SUCCESS = 1,
     };
 
+    /**
+     * Retrieve views of currently displayed frame.
+     * @param theOutDataLeft  output left view
+     * @param theOutDataRight output right view
+     * @param theToForce      retrieve the frame even if it has been already retrieved
+     * @param theToReference  take reference to shared buffer instead of copying data when possible
+     */
     ST_CPPEXPORT int getSnapshot(StImage* theOutDataLeft,
                                  StImage* theOutDataRight,
-                                 bool     theToForce = false);
+                                 bool     theToForce     = false,
+                                 bool     theToReference = false);
 
         private:
 
@@ -269,7 +298,7 @@ class StGLTextureQueue {
 
     StGLQuadTexture  myQTexture;       //!< quad stereo texture
 
-    StMutex          mySwapFBMutex;
+    mutable StMutex  mySwapFBMutex;
     size_t           mySwapFBCount;
 
     StMutex          myMeterMutex;
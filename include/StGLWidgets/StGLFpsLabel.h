@@ -34,6 +34,44 @@ class StGLFpsLabel : public StGLTextArea {
     ST_LOCAL int&    changePlayQueued()      { return myPlayQueued; }
     ST_LOCAL int&    changePlayQueueLength() { return myPlayQueueLen; }
 
+    /**
+     * Setup redraw scheduler statistics to be displayed.
+     * @param theNbDrawn   number of redrawn frames within the period
+     * @param theNbSkipped number of skipped idle iterations within the period
+     * @param theBusyRatio ratio of time spent within redraws to the period
+     */
+    ST_LOCAL void setRedrawStats(const unsigned int theNbDrawn,
+                                 const unsigned int theNbSkipped,
+                                 const double       theBusyRatio) {
+        myNbDrawn    = theNbDrawn;
+        myNbSkipped  = theNbSkipped;
+        myBusyRatio  = theBusyRatio;
+    }
+
+    /**
+     * Setup playback synchronization statistics to be displayed.
+     * @param theErrorP50  median of absolute sync error in milliseconds
+     * @param theErrorP95  95th percentile of absolute sync error in milliseconds
+     * @param theErrorP99  99th percentile of absolute sync error in milliseconds
+     * @param theNbDropped number of dropped frames
+     * @param theNbRepeated number of repeated frames
+     * @param theDriftPpm  clock drift in ppm
+     */
+    ST_LOCAL void setPlaySyncStats(const double       theErrorP50,
+                                   const double       theErrorP95,
+                                   const double       theErrorP99,
+                                   const unsigned int theNbDropped,
+                                   const unsigned int theNbRepeated,
+                                   const double       theDriftPpm) {
+        myHasSyncStats   = true;
+        mySyncErrors[0]  = theErrorP50;
+        mySyncErrors[1]  = theErrorP95;
+        mySyncErrors[2]  = theErrorP99;
+        myNbDropped      = theNbDropped;
+        myNbRepeated     = theNbRepeated;
+        myClockDriftPpm  = theDriftPpm;
+    }
+
         public:  //! @name Signals
 
     struct {
@@ -53,8 +91,17 @@ class StGLFpsLabel : public StGLTextArea {
     double       myPlayFps;      //!< video decoding FPS
     int          myPlayQueued;   //!< queued frames
     int          myPlayQueueLen; //!< queue length
+    unsigned int myNbDrawn;      //!< number of redrawn frames (redraw scheduler)
+    unsigned int myNbSkipped;    //!< number of skipped idle iterations (redraw scheduler)
+    double       myBusyRatio;    //!< ratio of time spent within redraws, negative if undefined
+    double       mySyncErrors[3];//!< percentiles (50, 95, 99) of playback sync error
+    double       myClockDriftPpm;//!< playback clock drift
+    unsigned int myNbDropped;    //!< number of dropped frames
+    unsigned int myNbRepeated;   //!< number of repeated frames
+    bool         myHasSyncStats; //!< indicates that playback sync statistics are defined
     StTimer      myTimer;        //!< FPS timer
     unsigned int myCounter;      //!< frames counter
+    uint32_t     myNbStrAllocs;  //!< string allocations counter on last update
 
 };
 
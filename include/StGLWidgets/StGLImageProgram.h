@@ -20,7 +20,7 @@
 /**
  * GLSL program for Image Region widget.
  */
-class StGLImageProgram : public StGLProgramMatrix<1, 5, StGLMeshProgram> {
+class StGLImageProgram : public StGLProgramMatrix<1, 6, StGLMeshProgram> {
 
         public:
 
@@ -37,6 +37,7 @@ class StGLImageProgram : public StGLProgramMatrix<1, 5, StGLMeshProgram> {
     enum VertMain {
         VertMain_Normal = 0,
         VertMain_Cubemap,
+        VertMain_Panorama, //!< full-screen quad with view ray
         VertMain_NB
     };
 
@@ -49,9 +50,39 @@ class StGLImageProgram : public StGLProgramMatrix<1, 5, StGLMeshProgram> {
         FragSection_ToRgb,    //!< color conversion
         FragSection_Correct,  //!< color correction
         FragSection_Gamma,    //!< gamma correction
+        FragSection_Surface,  //!< mapping of view ray onto panorama surface
         FragSection_NB
     };
 
+    /**
+     * Main function options in GLSL Fragment Shader.
+     */
+    enum FragMain {
+        FragMain_Flat = 0,  //!< texture coordinates are interpolated from vertices
+        FragMain_Panorama,  //!< texture coordinates are computed from view ray
+        FragMain_NB
+    };
+
+    /**
+     * Panorama surface options in GLSL Fragment Shader (for FragMain_Panorama).
+     */
+    enum FragSurface {
+        FragSurface_Flat = 0,   //!< no panorama
+        FragSurface_Sphere,     //!< equirectangular 360 x 180 panorama
+        FragSurface_Hemisphere, //!< equirectangular 180 x 180 panorama
+        FragSurface_Cylinder,   //!< cylindrical 360 panorama
+        FragSurface_NB
+    };
+
+    /**
+     * Projection of view rays for panorama (FragMain_Panorama).
+     */
+    enum PanoProjection {
+        PanoProjection_Perspective = 0, //!< rectilinear projection
+        PanoProjection_Stereographic,   //!< stereographic projection, "little planet" when looking down
+        PanoProjection_Fisheye,         //!< equidistant fisheye projection
+    };
+
     /**
      * Color getter options in GLSL Fragment Shader.
      */
@@ -78,6 +109,8 @@ class StGLImageProgram : public StGLProgramMatrix<1, 5, StGLMeshProgram> {
         FragToRgb_FromYuv10Mpeg,
         FragToRgb_FromYuvNvFull,
         FragToRgb_FromYuvNvMpeg,
+        FragToRgb_FromYuvNv10Full,
+        FragToRgb_FromYuvNv10Mpeg,
         FragToRgb_CUBEMAP,
         //FragToRgb_NB = FragToRgb_CUBEMAP * 2
     };
@@ -118,6 +151,12 @@ class StGLImageProgram : public StGLProgramMatrix<1, 5, StGLMeshProgram> {
     ST_CPPEXPORT void setCubeTextureFlipZ(StGLContext&    theCtx,
                                           bool theToFlip);
 
+    /**
+     * Set projection of view rays for panorama.
+     */
+    ST_CPPEXPORT void setPanoProjection(StGLContext&         theCtx,
+                                        const PanoProjection theProjection);
+
     ST_LOCAL void setColorScale(const StGLVec3& theScale) {
         myColorScale = theScale;
     }
@@ -128,11 +167,14 @@ class StGLImageProgram : public StGLProgramMatrix<1, 5, StGLMeshProgram> {
 
     /**
      * Initialize default shaders, nothing more.
+     * @param theSurface panorama surface to ray-cast on full-screen quad,
+     *                   in this case projection and model matrices should be inverted
      */
     ST_CPPEXPORT virtual bool init(StGLContext&                 theCtx,
                                    const StImage::ImgColorModel theColorModel,
                                    const StImage::ImgColorScale theColorScale,
-                                   const FragGetColor           theFilter);
+                                   const FragGetColor           theFilter,
+                                   const FragSurface            theSurface = FragSurface_Flat);
 
         public: //!< Properties
 
@@ -167,6 +209,7 @@ class StGLImageProgram : public StGLProgramMatrix<1, 5, StGLMeshProgram> {
     StGLVarLocation uniTexSizePxLoc;
     StGLVarLocation uniTexelSizePxLoc;
     StGLVarLocation uniTexCubeFlipZLoc;
+    StGLVarLocation uniPanoProjectionLoc;
     StGLVarLocation uniColorProcessingLoc;
     StGLVarLocation uniGammaLoc;
 
@@ -177,6 +177,7 @@ class StGLImageRegion : public StGLWidget {
                                          bool theIsPreciseInput) ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual bool stglInit() ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual void stglDraw(unsigned int theView) ST_ATTR_OVERRIDE;
+    ST_LOCAL     virtual bool isDynamic() const ST_ATTR_OVERRIDE { return true; }
     ST_CPPEXPORT virtual bool tryClick  (const StClickEvent& theEvent, bool& theIsItemClicked)   ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual bool tryUnClick(const StClickEvent& theEvent, bool& theIsItemUnclicked) ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual bool doKeyDown (const StKeyEvent& theEvent) ST_ATTR_OVERRIDE;
@@ -202,6 +203,8 @@ class StGLImageRegion : public StGLWidget {
         StHandle<StEnumParam>         DisplayMode;           //!< StGLImageRegion::DisplayMode    - display mode
         StHandle<StEnumParam>         DisplayRatio;          //!< StGLImageRegion::DisplayRatio   - display ratio
         StHandle<StBoolParamNamed>    ToHealAnamorphicRatio; //!< correct aspect ratio for 1080p/720p anamorphic pairs
+        StHandle<StBoolParamNamed>    ToRayCastPanorama;     //!< draw panoramas by ray-casting full-screen quad instead of tessellated mesh (mesh by default)
+        StHandle<StEnumParam>         PanoProjection;        //!< StGLImageProgram::PanoProjection - projection of ray-cast panorama
         StHandle<StEnumParam>         TextureFilter;         //!< StGLImageProgram::TextureFilter - texture filter;
         StHandle<StFloat32Param>      Gamma;                 //!< gamma correction coefficient
         StHandle<StFloat32Param>      Brightness;            //!< brightness level
@@ -131,6 +131,11 @@ class StGLMessageBox : public StGLWidget {
          */
         StSignal<void (const size_t )> onClickLeft;
         StSignal<void (const size_t )> onClickRight;
+        /**
+         * Emitted from destructor (message box destroys itself on close).
+         * @param theUserData (const size_t ) - user predefined data.
+         */
+        StSignal<void (const size_t )> onDestroy;
     } signals;
 
         public:    //! @name callback Slots
@@ -13,6 +13,8 @@
 #include <StGLWidgets/StGLWidget.h>
 #include <StStrings/StMsgQueue.h>
 
+class StGLMessageBox;
+
 /**
  * Widget intended to display text messages.
  */
@@ -29,8 +31,35 @@ class ST_LOCAL StGLMsgStack : public StGLContainer {
 
         private:
 
+    /**
+     * Message box displaying the last message of specific level.
+     */
+    struct Shown {
+        StGLMessageBox* Box; //!< message box, reset to NULL when box is destroyed
+        StMsg           Msg; //!< displayed message with accumulated repeats counter
+
+        Shown() : Box(NULL) {}
+    };
+
+    /**
+     * Increment repeats counter of already displayed message.
+     * @return false if message box has been already closed
+     */
+    ST_LOCAL bool updateShown(const StMsg& theMsg);
+
+        private: //! @name callback Slots
+
+    /**
+     * Forget the message box of specified level being destroyed.
+     */
+    ST_LOCAL void doBoxDestroyed(const size_t theLevel);
+
+        private:
+
     StHandle<StMsgQueue> myMsgQueue; //!< messages queue
-    StMsg                myMsgTmp;   //!< temporary message object
+    std::deque<StMsg>    myMsgBatch; //!< temporary list of retrieved messages
+    Shown                myShown[StLogger::ST_TRACE + 1];
+                                     //!< last displayed message box per level
 
 };
 
@@ -1,6 +1,6 @@
 /**
  * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
- * Copyright © 2015-2019 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2015-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * Distributed under the Boost Software License, Version 1.0.
  * See accompanying file license-boost.txt or copy at
@@ -18,6 +18,8 @@
 class StGLMenu;
 class StGLMenuItem;
 class StGLMenuCheckbox;
+class StGLThumbnailGrid;
+class StThumbnailCache;
 
 /**
  * Widget for file system navigation.
@@ -52,6 +54,14 @@ class StGLOpenFile : public StGLMessageBox {
         myToShowExtraFilter->setValue(theToDisplay);
     }
 
+    /**
+     * Add checkbox switching between file list and thumbnails grid.
+     * @param theParam application parameter to be synchronized with the checkbox
+     * @param theName  checkbox label
+     */
+    ST_CPPEXPORT void addThumbnailsCheckbox(const StHandle<StBoolParam>& theParam,
+                                            const StString& theName);
+
     /**
     * Add checkbox.
     */
@@ -102,6 +112,16 @@ class StGLOpenFile : public StGLMessageBox {
      */
     ST_CPPEXPORT void doFilterCheck(const bool theIsChecked);
 
+    /**
+     * Handle thumbnails view check.
+     */
+    ST_CPPEXPORT void doThumbnailsCheck(const bool theIsChecked);
+
+    /**
+     * Handle thumbnails grid click event.
+     */
+    ST_CPPEXPORT void doGridItemClick(const size_t theUserData);
+
     /**
      * Handle item click event - just remember item id.
      */
@@ -123,6 +143,17 @@ class StGLOpenFile : public StGLMessageBox {
      */
     ST_CPPEXPORT void initExtensions();
 
+    /**
+     * Create file list or thumbnails grid depending on current view mode.
+     */
+    ST_LOCAL void initView();
+
+    /**
+     * Create folder and file icon textures.
+     * @return FALSE if icons are unavailable
+     */
+    ST_LOCAL bool initItemIcons();
+
         protected: //! @name class fields
 
     StHandle<StGLTextureArray> myTextureFolder;
@@ -131,10 +162,14 @@ class StGLOpenFile : public StGLMessageBox {
     StGLScrollArea*            myHotListContent;
     StGLMenu*                  myHotList;       //!< widget containing the list of predefined libraries
     StGLMenu*                  myList;          //!< widget containing the file list of currently opened folder
+    StGLThumbnailGrid*         myGrid;          //!< widget containing the thumbnails of currently opened folder (alternative to myList)
+    StHandle<StThumbnailCache> myThumbCache;    //!< thumbnails generator
     StGLMenuCheckbox*          myMainFilterCheck;  //!< main  file filter checkbox
     StGLMenuCheckbox*          myExtraFilterCheck; //!< extra file filter checkbox
     StHandle<StBoolParam>      myToShowMainFilter;
     StHandle<StBoolParam>      myToShowExtraFilter;
+    StHandle<StBoolParam>      myToShowThumbs;  //!< show thumbnails grid instead of file list
+    StHandle<StBoolParam>      myToShowThumbsApp; //!< application parameter synchronized with myToShowThumbs
     StArrayList<StString>      myHotPaths;      //!< array of hot-links
     StHandle<StFolder>         myFolder;        //!< currently opened folder
     StMIMEList                 myFilter;        //!< file filter
@@ -0,0 +1,60 @@
+/**
+ * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StGLOverlayProgram_h_
+#define __StGLOverlayProgram_h_
+
+#include <StGL/StGLProgram.h>
+#include <StGL/StGLVec.h>
+
+/**
+ * GLSL program compositing cached GUI layer (texture with premultiplied alpha)
+ * onto the screen with horizontal displacement.
+ */
+class StGLOverlayProgram : public StGLProgram {
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_CPPEXPORT StGLOverlayProgram();
+
+    /**
+     * Initialize program.
+     * @param theCtx active GL context
+     * @return true if no error
+     */
+    ST_CPPEXPORT virtual bool init(StGLContext& theCtx) ST_ATTR_OVERRIDE;
+
+    /**
+     * @return vertex attribute location
+     */
+    ST_LOCAL inline StGLVarLocation getVVertexLoc() const {
+        return StGLVarLocation(0);
+    }
+
+    /**
+     * Use the program and setup uniforms.
+     * @param theCtx      active GL context
+     * @param theDispX    displacement in normalized device coordinates
+     * @param theTexScale scale factor for texture coordinates (viewport within texture)
+     */
+    ST_CPPEXPORT void use(StGLContext&    theCtx,
+                          const GLfloat   theDispX,
+                          const StGLVec2& theTexScale);
+
+        private:
+
+    StGLVarLocation uniDispLoc;     //!< location of uniform variable of displacement
+    StGLVarLocation uniTexScaleLoc; //!< location of uniform variable of texture coordinates scale
+
+};
+
+#endif // __StGLOverlayProgram_h_
@@ -13,13 +13,18 @@
 #include <StGLWidgets/StGLShare.h>
 #include <StGLWidgets/StGLWidget.h>
 #include <StGL/StGLFontManager.h>
+#include <StGL/StGLFrameBuffer.h>
 #include <StGL/StGLTexture.h>
+#include <StGL/StGLVertexBuffer.h>
 #include <StThreads/StResourceManager.h>
+#include <StThreads/StTimer.h>
 
 template<> inline void StArray<StGLNamedTexture>::sort() {}
 typedef StArray<StGLNamedTexture> StGLTextureArray;
 class StGLMenuProgram;
 class StGLMessageBox;
+class StGLOverlayProgram;
+class StGLTextBatch;
 class StGLTextProgram;
 class StGLTextBorderProgram;
 
@@ -83,6 +88,21 @@ class StGLRootWidget : public StGLWidget {
         IconImage_NB
     };
 
+    /**
+     * Widgets drawing statistics.
+     */
+    struct DrawStats {
+        unsigned int NbTextDraws;    //!< number of draw calls submitted by text batch
+        unsigned int NbTextBlocks;   //!< number of text blocks merged into text batch
+        unsigned int NbTextQuads;    //!< number of glyph quads submitted by text batch
+        unsigned int NbProgramBinds; //!< number of GLSL program switches
+        unsigned int NbCacheHits;    //!< number of views composited from cached GUI layer without redrawing
+        unsigned int NbCacheUpdates; //!< number of cached GUI layer redraws
+        double       CpuTimeMs;      //!< CPU time spent on widgets drawing, in milliseconds
+
+        DrawStats() : NbTextDraws(0), NbTextBlocks(0), NbTextQuads(0), NbProgramBinds(0), NbCacheHits(0), NbCacheUpdates(0), CpuTimeMs(0.0) {}
+    };
+
         public:
 
     /**
@@ -107,6 +127,38 @@ class StGLRootWidget : public StGLWidget {
      */
     ST_CPPEXPORT virtual void stglDraw(unsigned int theView) ST_ATTR_OVERRIDE;
 
+    /**
+     * Return true if static part of GUI (widgets drawn after the last dynamic widget)
+     * is rendered once into offscreen buffer and then composited for each view.
+     */
+    ST_LOCAL bool isCachedGui() const {
+        return myToCacheGui;
+    }
+
+    /**
+     * Enable or disable caching of static GUI layer (disabled by default).
+     */
+    ST_LOCAL void setCachedGui(const bool theToCache) {
+        myToCacheGui   = theToCache;
+        myIsCacheDirty = true;
+    }
+
+    /**
+     * Mark cached GUI layer as outdated (and widgets as damaged).
+     */
+    ST_LOCAL void invalidateCache() {
+        myIsCacheDirty = true;
+        myIsDamaged    = true;
+    }
+
+    /**
+     * Return true if widgets have been changed since the beginning of last stglUpdate(),
+     * so that window should be redrawn.
+     */
+    ST_LOCAL bool isDamaged() const {
+        return myIsDamaged;
+    }
+
     /**
      * Get shared menu program instance.
      */
@@ -117,6 +169,16 @@ class StGLRootWidget : public StGLWidget {
      */
     ST_LOCAL StGLTextProgram& getTextProgram() { return *myTextProgram; }
 
+    /**
+     * Get shared text batch instance.
+     */
+    ST_LOCAL StGLTextBatch& getTextBatch() { return *myTextBatch; }
+
+    /**
+     * Return drawing statistics of the last frame (all views).
+     */
+    ST_LOCAL const DrawStats& getDrawStats() const { return myDrawStatsLast; }
+
     /**
      * Get shared text border program instance.
      */
@@ -485,6 +547,19 @@ class StGLRootWidget : public StGLWidget {
 
     ST_LOCAL void setupTextures();
 
+    /**
+     * Draw children using cached GUI layer.
+     * @return false if cache can not be used (nothing has been drawn then)
+     */
+    ST_LOCAL bool stglDrawCached(unsigned int theView);
+
+    /**
+     * Compute cheap signature of visible widgets state (position, opacity, clicked state)
+     * to detect changes not reported by widgets explicitly.
+     */
+    ST_LOCAL static size_t computeSignature(StGLWidget* theWidget,
+                                            size_t      theHash);
+
         private:
 
     StGLSharePointer**        myShareArray;    //!< resources shared within GL context (commonly used)
@@ -506,6 +581,18 @@ class StGLRootWidget : public StGLWidget {
     StHandle<StGLMenuProgram>  myMenuProgram;
     StHandle<StGLTextProgram>  myTextProgram;
     StHandle<StGLTextBorderProgram> myTextBorderProgram;
+    StHandle<StGLTextBatch>    myTextBatch;    //!< batch merging text of consecutive widgets
+    DrawStats                  myDrawStats;    //!< drawing statistics of the current frame
+    DrawStats                  myDrawStatsLast;//!< drawing statistics of the last frame
+    StTimer                    myDrawTimer;    //!< timer measuring CPU drawing time
+    StHandle<StGLOverlayProgram> myCacheProgram; //!< program compositing cached GUI layer
+    StGLFrameBuffer            myCacheFbo;     //!< offscreen buffer holding cached GUI layer
+    StGLVertexBuffer           myCacheQuad;    //!< screen quad for compositing cached GUI layer
+    StTimer                    myCacheTimer;   //!< timer since last cache redraw
+    size_t                     myCacheSignature; //!< signature of widgets state at last cache redraw
+    bool                       myToCacheGui;   //!< flag to cache static GUI layer
+    bool                       myIsCacheDirty; //!< flag indicating that cached GUI layer should be redrawn
+    bool                       myIsDamaged;    //!< flag indicating that widgets have been changed since last update
 
     bool                      myIsMobile;      //!< flag indicating mobile device
     StMarginsI                myMarginsPx;     //!< active area margins in pixels
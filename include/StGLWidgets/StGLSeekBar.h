@@ -11,13 +11,40 @@
 #define __StGLSeekBar_h_
 
 #include <StGLWidgets/StGLWidget.h>
+#include <StGL/StGLTexture.h>
 #include <StGL/StGLVertexBuffer.h>
+#include <StImage/StImage.h>
 
 /**
  * Simple seeking bar widget.
  */
 class StGLSeekBar : public StGLWidget {
 
+        public:
+
+    /**
+     * Interface providing preview images (thumbnails) for seeking bar.
+     */
+    class PreviewProvider {
+
+            public:
+
+        /**
+         * Destructor.
+         */
+        virtual ~PreviewProvider() {}
+
+        /**
+         * Return preview image nearest to specified position.
+         * Called from GUI thread on hovering,
+         * so that the request also hints which position should be generated first.
+         * @param thePosition position within 0..1 range
+         * @return RGB image or NULL if not (yet) available
+         */
+        virtual StHandle<StImage> getPreview(const double thePosition) = 0;
+
+    };
+
         public: //! @name public methods
 
     /**
@@ -37,13 +64,23 @@ class StGLSeekBar : public StGLWidget {
      * @param theProgress - current progress from 0.0f to 1.0f;
      */
     ST_LOCAL void setProgress(const GLfloat theProgress) {
-        myProgress = theProgress;
+        if(myProgress != theProgress) {
+            myProgress = theProgress;
+            invalidate();
+        }
     }
 
     ST_LOCAL void setMoveTolerance(const int theTolerPx) {
         myMoveTolerPx = theTolerPx;
     }
 
+    /**
+     * Set provider of preview images shown on hovering.
+     */
+    ST_LOCAL void setPreviewProvider(const StHandle<PreviewProvider>& theProvider) {
+        myPreviewProvider = theProvider;
+    }
+
     ST_CPPEXPORT virtual void stglResize() ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual bool stglInit() ST_ATTR_OVERRIDE;
     ST_CPPEXPORT virtual void stglUpdate(const StPointD_t& theCursor,
@@ -76,12 +113,24 @@ class StGLSeekBar : public StGLWidget {
         private: //! @name private methods
 
     ST_LOCAL void stglUpdateVertices();
+
+    /**
+     * Request preview image for position under cursor.
+     */
+    ST_LOCAL void updatePreview(const StPointD_t& theCursor);
+
+    /**
+     * Draw preview image above the bar.
+     */
+    ST_LOCAL void stglDrawPreview();
     ST_LOCAL double getPointInEx(const StPointD_t& thePointZo) const;
 
         private:
 
     class StProgramSB;
     StHandle<StProgramSB> myProgram;    //!< GLSL program
+    class StProgramPreview;
+    StHandle<StProgramPreview> myPreviewProgram; //!< GLSL program for preview image
 
     StGLVertexBuffer      myVertices;   //!< vertices VBO
     StGLVertexBuffer      myColors;     //!< colors   VBO
@@ -90,6 +139,14 @@ class StGLSeekBar : public StGLWidget {
     int                   myClickPos;
     int                   myMoveTolerPx;
 
+    StHandle<PreviewProvider> myPreviewProvider; //!< provider of preview images
+    StHandle<StImage>     myPreviewImage;   //!< active preview image
+    StGLTexture           myPreviewTexture; //!< texture of active preview image
+    StGLVertexBuffer      myPreviewVerts;   //!< preview quad vertices
+    StGLVertexBuffer      myPreviewTCrds;   //!< preview quad texture coordinates
+    double                myPreviewPos;     //!< hovered position or negative value
+    bool                  myToUploadPreview;//!< flag to re-upload preview texture
+
 };
 
 #endif // __StGLSeekBar_h_
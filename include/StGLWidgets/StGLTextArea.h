@@ -111,14 +111,20 @@ class StGLTextArea : public StGLWidget {
      * @param theColor text color
      */
     inline void setTextColor(const StGLVec3& theColor) {
-        myTextColor.rgb() = theColor;
+        if(myTextColor.rgb() != theColor) {
+            myTextColor.rgb() = theColor;
+            invalidate();
+        }
     }
 
     /**
      * @param theColor text color
      */
     inline void setTextColor(const StGLVec4& theColor) {
-        myTextColor = theColor;
+        if(myTextColor != theColor) {
+            myTextColor = theColor;
+            invalidate();
+        }
     }
 
     /**
@@ -224,7 +230,9 @@ class StGLTextArea : public StGLWidget {
 
         private:
 
-    ST_LOCAL void drawText(StGLContext& theCtx);
+    ST_LOCAL void drawText(StGLContext&      theCtx,
+                           const StGLMatrix& theModelMat,
+                           const StGLVec4&   theColor);
 
     ST_LOCAL void recomputeBorder(StGLContext& theCtx);
 
@@ -234,9 +242,9 @@ class StGLTextArea : public StGLWidget {
 
         private:
 
-    std::vector<GLuint>                       myTexturesList;
-    StArrayList< StHandle<StGLVertexBuffer> > myTextVertBuf;
-    StArrayList< StHandle<StGLVertexBuffer> > myTextTCrdBuf;
+    std::vector<GLuint>                                myTexturesList;
+    std::vector< StHandle< std::vector<StGLVec2> > >  myTextVerts; //!< text vertices per texture, submitted through StGLTextBatch
+    std::vector< StHandle< std::vector<StGLVec2> > >  myTextTCrds; //!< text texture coordinates per texture
 
     StGLVertexBuffer     myBorderIVertBuf;
     StGLVertexBuffer     myBorderOVertBuf;
@@ -0,0 +1,119 @@
+/**
+ * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StGLTextBatch_h_
+#define __StGLTextBatch_h_
+
+#include <StGL/StGLContext.h>
+#include <StGL/StGLMatrix.h>
+#include <StGL/StGLVertexBuffer.h>
+
+#include <vector>
+
+class StGLTextProgram;
+
+/**
+ * Batch collecting text quads of consecutive widgets
+ * into one dynamic vertex stream per font texture.
+ * Pending quads are submitted by single draw call per texture
+ * right before any other GL state change (program, scissor or FBO switch),
+ * so that drawing order and clipping of widgets are preserved.
+ */
+class StGLTextBatch : public StGLContext::DeferredDraw {
+
+        public:
+
+    /**
+     * Main constructor.
+     */
+    ST_CPPEXPORT StGLTextBatch(const StHandle<StGLTextProgram>& theProgram);
+
+    /**
+     * Destructor.
+     */
+    ST_CPPEXPORT virtual ~StGLTextBatch();
+
+    /**
+     * Release GL resources.
+     */
+    ST_CPPEXPORT void release(StGLContext& theCtx);
+
+    /**
+     * Append text quads to the batch.
+     * Pending quads are flushed first if color is different.
+     * @param theCtx      active GL context
+     * @param theModelMat model-view matrix to apply to vertices
+     * @param theColor    text color
+     * @param theTextures textures list
+     * @param theVerts    vertices per texture
+     * @param theTCrds    texture coordinates per texture
+     */
+    ST_CPPEXPORT void append(StGLContext&                                             theCtx,
+                             const StGLMatrix&                                        theModelMat,
+                             const StGLVec4&                                          theColor,
+                             const std::vector<GLuint>&                               theTextures,
+                             const std::vector< StHandle< std::vector<StGLVec2> > >& theVerts,
+                             const std::vector< StHandle< std::vector<StGLVec2> > >& theTCrds);
+
+    /**
+     * Submit pending quads.
+     */
+    ST_CPPEXPORT virtual void stglFlush(StGLContext& theCtx) ST_ATTR_OVERRIDE;
+
+    /**
+     * @return number of draw calls since last reset
+     */
+    ST_LOCAL unsigned int getNbDrawCalls() const { return myNbDrawCalls; }
+
+    /**
+     * @return number of submitted quads since last reset
+     */
+    ST_LOCAL unsigned int getNbQuads() const { return myNbQuads; }
+
+    /**
+     * @return number of text blocks merged into batches since last reset
+     */
+    ST_LOCAL unsigned int getNbBlocks() const { return myNbBlocks; }
+
+    /**
+     * Reset counters.
+     */
+    ST_LOCAL void resetStats() {
+        myNbDrawCalls = 0;
+        myNbQuads     = 0;
+        myNbBlocks    = 0;
+    }
+
+        private:
+
+    /**
+     * Vertex stream for single texture.
+     */
+    struct Stream {
+        GLuint                Texture;
+        std::vector<StGLVec3> Verts;
+        std::vector<StGLVec2> TCrds;
+    };
+
+        private:
+
+    StHandle<StGLTextProgram> myProgram;     //!< shared text program
+    std::vector<Stream>       myStreams;     //!< streams per texture (cleared but not deallocated between frames)
+    size_t                    myNbStreams;   //!< number of active streams
+    StGLVec4                  myColor;       //!< color of pending quads
+    StGLMatrix                myIdentity;    //!< identity model-view matrix
+    StGLVertexBuffer          myVertBuf;     //!< dynamic vertex buffer
+    StGLVertexBuffer          myTCrdBuf;     //!< dynamic texture coordinates buffer
+    unsigned int              myNbDrawCalls; //!< draw calls counter
+    unsigned int              myNbQuads;     //!< quads counter
+    unsigned int              myNbBlocks;    //!< appended text blocks counter
+
+};
+
+#endif // __StGLTextBatch_h_
@@ -0,0 +1,185 @@
+/**
+ * StGLWidgets, small C++ toolkit for writing GUI using OpenGL.
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StGLThumbnailGrid_h_
+#define __StGLThumbnailGrid_h_
+
+#include <StGLWidgets/StGLRootWidget.h>
+#include <StGLWidgets/StGLShare.h>
+#include <StGL/StGLTexture.h>
+#include <StGL/StGLVertexBuffer.h>
+#include <StImage/StThumbnailCache.h>
+
+#include <vector>
+
+class StGLIcon;
+class StGLTextArea;
+
+/**
+ * Grid of image thumbnails with labels, intended to be placed into StGLScrollArea.
+ * Thumbnails are generated by StThumbnailCache (visible cells are requested with higher priority)
+ * and uploaded into single atlas texture with limited number of uploads per frame,
+ * so that scrolling of large folders does not stall rendering.
+ * When atlas is full, slots of the cells farthest from the visible area are reused.
+ */
+class StGLThumbnailGrid : public StGLWidget {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theParent parent widget (scroll area)
+     * @param theCache  thumbnails generator
+     * @param theWidth  grid width in pixels
+     */
+    ST_CPPEXPORT StGLThumbnailGrid(StGLWidget*                        theParent,
+                                   const StHandle<StThumbnailCache>& theCache,
+                                   const int                          theWidth);
+
+    /**
+     * Destructor.
+     */
+    ST_CPPEXPORT virtual ~StGLThumbnailGrid();
+
+    /**
+     * Remove all items and drop pending thumbnail requests.
+     */
+    ST_CPPEXPORT void clearItems();
+
+    /**
+     * Append the item.
+     * @param theLabel     item label
+     * @param theImagePath path to the image to generate thumbnail, empty to show only the icon
+     * @param theIcon      icon displayed until thumbnail is ready (or instead of it)
+     * @param theIconColor icon color
+     * @param theUserData  value to be passed to onItemClick signal
+     */
+    ST_CPPEXPORT void addItem(const StString&                   theLabel,
+                              const StString&                   theImagePath,
+                              const StHandle<StGLTextureArray>& theIcon,
+                              const StGLVec4&                   theIconColor,
+                              const size_t                      theUserData);
+
+    /**
+     * Setup label color.
+     */
+    ST_LOCAL void setTextColor(const StGLVec4& theColor) {
+        myTextColor = theColor;
+    }
+
+    /**
+     * Setup highlight color.
+     */
+    ST_LOCAL void setHilightColor(const StGLVec4& theColor) {
+        myHilightColor = theColor;
+    }
+
+    ST_CPPEXPORT virtual bool stglInit() ST_ATTR_OVERRIDE;
+    ST_CPPEXPORT virtual void stglDraw(unsigned int theView) ST_ATTR_OVERRIDE;
+    ST_CPPEXPORT virtual void stglUpdate(const StPointD_t& theCursorZo,
+                                         bool theIsPreciseInput) ST_ATTR_OVERRIDE;
+    ST_CPPEXPORT virtual bool tryClick  (const StClickEvent& theEvent, bool& theIsItemClicked)   ST_ATTR_OVERRIDE;
+    ST_CPPEXPORT virtual bool tryUnClick(const StClickEvent& theEvent, bool& theIsItemUnclicked) ST_ATTR_OVERRIDE;
+
+        public:    //! @name Signals
+
+    struct {
+        /**
+         * @param theUserData user data of clicked item
+         */
+        StSignal<void (const size_t )> onItemClick;
+    } signals;
+
+        private:
+
+    class Program;
+
+    /**
+     * Thumbnail state of the cell.
+     */
+    enum ThumbState {
+        ThumbState_None,      //!< thumbnail is not requested
+        ThumbState_Requested, //!< thumbnail is requested
+        ThumbState_Loaded,    //!< thumbnail is uploaded into atlas
+        ThumbState_Failed,    //!< thumbnail can not be generated
+    };
+
+    /**
+     * Grid cell.
+     */
+    struct Cell {
+        StString      ImagePath; //!< image path, empty for items without thumbnail
+        StGLIcon*     Icon;      //!< placeholder icon
+        StGLTextArea* Label;     //!< item label
+        size_t        UserData;  //!< user data
+        ThumbState    State;     //!< thumbnail state
+        int           Priority;  //!< priority of requested thumbnail
+        int           Slot;      //!< atlas slot, -1 if not loaded
+        int           SizeX;     //!< thumbnail width
+        int           SizeY;     //!< thumbnail height
+    };
+
+    /**
+     * Return cell rectangle relative to the grid.
+     */
+    ST_LOCAL StRectI_t getCellRect(const size_t theCell) const;
+
+    /**
+     * Return cell index under specified point or -1.
+     */
+    ST_LOCAL int getCellAt(const StPointD_t& thePointZo) const;
+
+    /**
+     * Compute range of visible rows.
+     */
+    ST_LOCAL void getVisibleRows(int& theRowFrom,
+                                 int& theRowTo) const;
+
+    /**
+     * (Re)request thumbnails according to visible area.
+     */
+    ST_LOCAL void updateRequests();
+
+    /**
+     * Find atlas slot for new thumbnail.
+     * @param theToEvict evict the thumbnail farthest from visible area when there are no free slots
+     * @return slot index or -1 if there are no free slots
+     */
+    ST_LOCAL int allocateSlot(const bool theToEvict);
+
+    /**
+     * Upload limited number of generated thumbnails into atlas.
+     */
+    ST_LOCAL void uploadThumbnails(StGLContext& theCtx);
+
+        private:
+
+    StHandle<StThumbnailCache> myCache;         //!< thumbnails generator
+    std::vector<Cell>          myCells;         //!< grid cells
+    std::vector<int>           mySlotOwners;    //!< cell index per atlas slot, -1 for free slot
+    StGLShare<Program>         myProgram;       //!< shared program
+    StGLTexture                myAtlas;         //!< atlas texture
+    StGLVertexBuffer           myVertBuf;       //!< vertices of visible thumbnails
+    StGLVertexBuffer           myTCrdBuf;       //!< texture coordinates of visible thumbnails
+    StGLVertexBuffer           myHilightBuf;    //!< vertices of highlighted cell
+    StGLVec4                   myTextColor;     //!< label color
+    StGLVec4                   myHilightColor;  //!< highlight color
+    int                        myThumbSize;     //!< thumbnail size (atlas slot size)
+    int                        myCellSizeX;     //!< cell width
+    int                        myCellSizeY;     //!< cell height
+    int                        myNbColumns;     //!< number of columns
+    int                        mySlotsPerRow;   //!< number of atlas slots per row
+    int                        myRowFrom;       //!< first visible row on last update
+    int                        myRowTo;         //!< last  visible row on last update
+    int                        myHilightCell;   //!< highlighted cell or -1
+    int                        myClickedCell;   //!< clicked cell or -1
+
+};
+
+#endif // __StGLThumbnailGrid_h_
@@ -239,6 +239,12 @@ class StGLWidget {
                           (aRectGl.top() - aPointGl.y())  / (aRectGl.top() - aRectGl.bottom()));
     }
 
+    /**
+     * Notify root widget that appearance of this widget has been changed
+     * and cached GUI layer should be redrawn.
+     */
+    ST_CPPEXPORT void invalidate();
+
     /**
      * @return true if opacity > 0.0
      */
@@ -371,6 +377,13 @@ class StGLWidget {
      */
     ST_CPPEXPORT virtual void stglDraw(unsigned int theView);
 
+    /**
+     * Return true if widget content changes every frame and differs between views
+     * (e.g. video or image with stereoscopic pair), so that it should not be cached by root widget.
+     * Widgets drawn before dynamic one are also drawn directly.
+     */
+    ST_LOCAL virtual bool isDynamic() const { return false; }
+
     /**
      * @return user-defined data
      */
@@ -0,0 +1,152 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StExifReader_h_
+#define __StExifReader_h_
+
+#include "StExifDir.h"
+
+/**
+ * Light-weight EXIF reader.
+ * In contrast to StExifDir, it does not decode the section into lists of directories and entries,
+ * but scans IFD tables in place over the file buffer on each request
+ * and follows only the links which might lead to requested tag
+ * (vendor-specific Maker Note is not scanned unless its tag is requested).
+ * No memory is allocated, which makes it suitable for reading few tags (orientation, parallax)
+ * from camera files with large Maker Notes - full decoding could be postponed to StExifDir::parseExif().
+ */
+class StExifReader {
+
+        public:
+
+    /**
+     * Found entry.
+     */
+    struct Entry {
+        StExifEntry Value;    //!< entry definition
+        bool        IsFileBE; //!< indicate that entry value is stored in Big-Endian order
+
+        Entry() : IsFileBE(true) {
+            Value.ValuePtr   = NULL;
+            Value.Tag        = 0;
+            Value.Format     = 0;
+            Value.Components = 0;
+        }
+
+        inline  int16_t get16s(const stUByte_t* theShort) const { return StAlienData::Get16s(theShort, IsFileBE); }
+        inline uint16_t get16u(const stUByte_t* theShort) const { return StAlienData::Get16u(theShort, IsFileBE); }
+        inline  int32_t get32s(const stUByte_t* theLong)  const { return StAlienData::Get32s(theLong,  IsFileBE); }
+        inline uint32_t get32u(const stUByte_t* theLong)  const { return StAlienData::Get32u(theLong,  IsFileBE); }
+    };
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_CPPEXPORT StExifReader();
+
+    /**
+     * Initialize reader for EXIF section.
+     * The buffer is not copied and should be kept alive while reader is used.
+     * @param theExifSection section data starting from TIFF header
+     * @param theLength      section length
+     * @param theType        type of the first directory
+     * @return FALSE if section header is invalid
+     */
+    ST_CPPEXPORT bool init(stUByte_t*                theExifSection,
+                           const size_t              theLength,
+                           const StExifDir::DirType  theType = StExifDir::DType_General);
+
+    /**
+     * @return TRUE if reader has not been initialized
+     */
+    inline bool isNull() const {
+        return myData == NULL;
+    }
+
+    /**
+     * @return section data
+     */
+    inline stUByte_t* getData() const {
+        return myData;
+    }
+
+    /**
+     * @return section length
+     */
+    inline size_t getLength() const {
+        return myLength;
+    }
+
+    /**
+     * @return type of the first directory
+     */
+    inline StExifDir::DirType getType() const {
+        return myType;
+    }
+
+    /**
+     * Find entry by tag.
+     * @param theType  directory filter
+     * @param theTag   entry tag
+     * @param theEntry found entry
+     * @return TRUE if entry was found
+     */
+    ST_CPPEXPORT bool findEntry(const StExifDir::DirType theType,
+                                const uint16_t           theTag,
+                                StExifReader::Entry&     theEntry) const;
+
+    /**
+     * Decode entry into string.
+     */
+    ST_CPPEXPORT static void format(const StExifReader::Entry& theEntry,
+                                    StString&                  theString);
+
+    /**
+     * Decode UserComment entry (with character code prefix).
+     * @return FALSE if entry has unsupported encoding
+     */
+    ST_CPPEXPORT static bool decodeUserComment(const StExifEntry& theEntry,
+                                               StString&          theComment);
+
+        public: //! @name comparators
+
+    bool operator==(const StExifReader& theCompare) const { return (myData == theCompare.myData); }
+    bool operator!=(const StExifReader& theCompare) const { return (myData != theCompare.myData); }
+    bool operator> (const StExifReader& theCompare) const { return (myData >  theCompare.myData); }
+    bool operator< (const StExifReader& theCompare) const { return (myData <  theCompare.myData); }
+    bool operator>=(const StExifReader& theCompare) const { return (myData >= theCompare.myData); }
+    bool operator<=(const StExifReader& theCompare) const { return (myData <= theCompare.myData); }
+
+        private:
+
+    struct Query;
+
+    /**
+     * Scan the EXIF directory and linked directories.
+     */
+    ST_LOCAL static bool scanDirectory(Query&                   theQuery,
+                                       stUByte_t*               theDirStart,
+                                       stUByte_t*               theOffsetBase,
+                                       const size_t             theExifLength,
+                                       const bool               theIsFileBE,
+                                       const StExifDir::DirType theType,
+                                       const int                theNestingLevel);
+
+        private:
+
+    stUByte_t*         myData;        //!< section data
+    size_t             myLength;      //!< section length
+    size_t             myFirstOffset; //!< offset to the first directory
+    StExifDir::DirType myType;        //!< type of the first directory
+    bool               myIsFileBE;    //!< section byte order
+
+};
+
+#endif // __StExifReader_h_
@@ -50,10 +50,16 @@ namespace StExifTags {
     extern const StExifTag OLYMP_TAGS[];
 
     enum Image {
+        Image_Make        = 0x010F,
+        Image_Model       = 0x0110,
         Image_Orientation = 0x0112,
         Image_DateTime    = 0x0132,
     };
 
+    enum Photo {
+        Photo_UserComment = 0x9286,
+    };
+
     enum Fuji {
         Fuji_Parallax = 0xB211,
     };
@@ -70,6 +70,8 @@ class StImage {
         ImgScale_Jpeg10,  //!< 10 bits in 16 bits 0..1023
         ImgScale_NvFull,  //!< full range (use all bits)
         ImgScale_NvMpeg,  //!< YUV  8 bits per component Y   16..235;   U and V   16..240
+        ImgScale_Nv10Full,//!< YUV 10 bits in upper bits of 16 bits (P010), full range
+        ImgScale_Nv10Mpeg,//!< YUV 10 bits in upper bits of 16 bits (P010) Y 64..940 << 6; U and V 64..960 << 6
     } ImgColorScale;
 
     ST_CPPEXPORT static StString formatImgColorModel(ImgColorModel theColorModel);
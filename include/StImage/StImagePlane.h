@@ -41,8 +41,9 @@ class StImagePlane {
         ImgRGBAF,       //!< 4 floats (16-bytes) RGBA image plane
         ImgBGRAF,       //!< same as RGBAF but with different components order
         ImgUV,          //!< 2 bytes packed UV image plane
+        ImgUV16,        //!< 4 bytes packed UV image plane (2x16 bits, e.g. P010 with 10 bits stored in upper bits)
     };
-    enum { ImgNB = ImgUV + 1 };
+    enum { ImgNB = ImgUV16 + 1 };
 
     ST_CPPEXPORT static StString formatImgFormat(ImgFormat theImgFormat);
     inline StString formatImgFormat() const { return formatImgFormat(myImgFormat); }
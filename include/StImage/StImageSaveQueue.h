@@ -0,0 +1,139 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StImageSaveQueue_h_
+#define __StImageSaveQueue_h_
+
+#include <StImage/StImageFile.h>
+#include <StStrings/StMsgQueue.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StThreadPool.h>
+
+#include <deque>
+#include <vector>
+
+/**
+ * Queue encoding and writing images in background tasks of shared thread pool,
+ * so that the thread producing the image (image loader or video demuxer) is not blocked.
+ * The result is reported through message queue.
+ * The queue is bounded - push() does not block but rejects the job when queue is full.
+ */
+class StImageSaveQueue {
+
+        public:
+
+    /**
+     * Save job.
+     */
+    struct Job {
+        StHandle<StImageFile>  Image;   //!< image to save (should hold its own or referenced data)
+        StString               Path;    //!< destination file path
+        StImageFile::ImageType Type;    //!< image type
+        StFormat               Format;  //!< stereo format to be stored as metadata
+        StString               DoneMsg; //!< message to report on success, empty to save silently
+
+        Job() : Type(StImageFile::ST_TYPE_NONE), Format(StFormat_AUTO) {}
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theMsgQueue  message queue to report results
+     * @param theNbThreads maximum number of images encoded simultaneously
+     * @param theMaxJobs   maximum number of queued (not yet saved) jobs
+     */
+    ST_CPPEXPORT StImageSaveQueue(const StHandle<StMsgQueue>& theMsgQueue,
+                                  const int                   theNbThreads = 1,
+                                  const size_t                theMaxJobs   = 8);
+
+    /**
+     * Destructor, saves pending jobs.
+     */
+    ST_CPPEXPORT ~StImageSaveQueue();
+
+    /**
+     * Append the job.
+     * @return FALSE if queue is full
+     */
+    ST_CPPEXPORT bool push(const Job& theJob);
+
+    /**
+     * @return TRUE if queue is full and push() would reject the job;
+     *         allows skipping preparation of the image (e.g. copying the frame)
+     */
+    ST_CPPEXPORT bool isFull() const;
+
+    /**
+     * Wait until all queued jobs are saved.
+     */
+    ST_CPPEXPORT void waitAll();
+
+    /**
+     * @return number of queued and processed jobs
+     */
+    ST_CPPEXPORT size_t getNbPending() const;
+
+    /**
+     * @return number of saved images
+     */
+    ST_CPPEXPORT size_t getNbSaved() const;
+
+    /**
+     * @return number of failed jobs
+     */
+    ST_CPPEXPORT size_t getNbFailed() const;
+
+        private:
+
+    /**
+     * Pool task calling saveLoop().
+     */
+    class SaveTask : public StThreadPool::Task {
+
+            public:
+
+        ST_LOCAL SaveTask(StImageSaveQueue* theQueue) : myQueue(theQueue) {}
+
+        ST_LOCAL virtual void perform() {
+            myQueue->saveLoop();
+        }
+
+            private:
+
+        StImageSaveQueue* myQueue;
+
+    };
+
+    /**
+     * Save queued jobs until queue becomes empty.
+     */
+    ST_LOCAL void saveLoop();
+
+    /**
+     * Save single image.
+     */
+    ST_LOCAL void save(Job& theJob);
+
+        private:
+
+    StHandle<StMsgQueue>                      myMsgQueue;   //!< message queue to report results
+    std::vector< StHandle<StThreadPool::Task> > myTasks;      //!< pushed pool tasks
+    int                                       myNbThreads;  //!< maximum number of active tasks
+    int                                       myNbActive;   //!< number of active tasks
+    size_t                                    myMaxJobs;    //!< queue limit
+    mutable StMutex                           myMutex;      //!< lock for the queue
+    StCondition                               myEventIdle;  //!< event signaling that all jobs are done
+    std::deque<Job>                           myJobs;       //!< queued jobs
+    size_t                                    myNbBusy;     //!< number of jobs being saved
+    size_t                                    myNbSaved;    //!< number of saved images
+    size_t                                    myNbFailed;   //!< number of failed jobs
+
+};
+
+#endif // __StImageSaveQueue_h_
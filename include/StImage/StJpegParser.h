@@ -12,7 +12,7 @@
 #include <StFile/StRawFile.h>
 #include <StGLStereo/StFormatEnum.h>
 
-#include "StExifDir.h"
+#include "StExifReader.h"
 
 /**
  * JPEG format parser (Joint Photographic Experts Group).
@@ -57,8 +57,10 @@ class StJpegParser : public StRawFile {
     struct Image {
         unsigned char*  Data;     //!< pointer to the data
         size_t          Length;   //!< data length
+        StArrayList<StExifReader>
+                        ExifRaw;  //!< EXIF sections (not decoded)
         StArrayList< StHandle<StExifDir> >
-                        Exif;     //!< EXIF sections
+                        Exif;     //!< EXIF sections, decoded on demand by decodeExif()
         StHandle<Image> Thumb;    //!< optional thumbnail
         StHandle<Image> Next;     //!< link to the next image in file (if any)
         size_t          SizeX;    //!< image width  in pixels
@@ -69,6 +71,31 @@ class StJpegParser : public StRawFile {
         ST_CPPEXPORT Image();
         ST_CPPEXPORT ~Image();
 
+        /**
+         * Decode EXIF sections into Exif list (all directories and entries).
+         * Does nothing if sections have been already decoded.
+         */
+        ST_CPPEXPORT void decodeExif();
+
+        /**
+         * Find EXIF entry without decoding complete EXIF sections.
+         * @param theType  directory filter
+         * @param theTag   entry tag
+         * @param theEntry found entry
+         * @return TRUE if entry was found
+         */
+        ST_CPPEXPORT bool findExifEntry(const StExifDir::DirType theType,
+                                        const uint16_t           theTag,
+                                        StExifReader::Entry&     theEntry) const;
+
+        /**
+         * Read string EXIF entry.
+         * @return TRUE if entry was found
+         */
+        ST_CPPEXPORT bool getExifString(const StExifDir::DirType theType,
+                                        const uint16_t           theTag,
+                                        StString&                theValue) const;
+
         /**
          * Read image timestamp property.
          */
@@ -0,0 +1,289 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StStereoConverter_h_
+#define __StStereoConverter_h_
+
+#include <StImage/StImageFile.h>
+#include <StGLStereo/StFormatEnum.h>
+#include <StSlots/StSignal.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThreadPool.h>
+
+#include <vector>
+
+/**
+ * Headless batch converter of stereoscopic images between layouts.
+ * Each job passes through decode, transform and encode stages;
+ * worker threads pick the most advanced pending stage of any job,
+ * so that decoding of one file overlaps with re-layout and encoding of others,
+ * while the number of decoded images kept in memory is limited.
+ *
+ * Source views are extracted by StGLTextureData (the same splitting code used for GPU upload),
+ * so that all source layouts supported by viewer are accepted.
+ * Video files are not re-encoded - they are only remuxed by StAVVideoMuxer
+ * to tag the stereo layout or to merge separate left/right files into one container.
+ */
+class StStereoConverter {
+
+        public:
+
+    /**
+     * Output layout.
+     */
+    enum Layout {
+        Layout_SideBySide_LR,        //!< parallel side-by-side
+        Layout_SideBySide_RL,        //!< cross-eyed side-by-side (JPS / PNS)
+        Layout_TopBottom_LR,         //!< over/under
+        Layout_SeparateFrames,       //!< left and right views into separate files (suffixes -L and -R)
+        Layout_Rows,                 //!< row-interlaced, left view within even rows
+        Layout_Columns,              //!< column-interlaced, left view within even columns
+        Layout_AnaglyphRedCyan,      //!< simple red-cyan anaglyph
+        Layout_AnaglyphYellowBlue,   //!< simple yellow-blue anaglyph
+        Layout_AnaglyphGreenMagenta, //!< simple green-magenta anaglyph
+    };
+
+    /**
+     * Conversion job.
+     */
+    struct Job {
+        StString SrcPath;   //!< source file path
+        StString SrcPathR;  //!< optional source file path with right view
+        StString DstPath;   //!< destination file path
+        StFormat SrcFormat; //!< source layout, StFormat_AUTO to detect from metadata and file name
+
+        Job() : SrcFormat(StFormat_AUTO) {}
+    };
+
+    /**
+     * Throughput report.
+     */
+    struct Report {
+        size_t NbDone;        //!< number of converted jobs
+        size_t NbFailed;      //!< number of failed jobs
+        double DecodeSec;     //!< total time spent by decode stage (sum over threads)
+        double TransformSec;  //!< total time spent by transform stage (sum over threads)
+        double EncodeSec;     //!< total time spent by encode stage (sum over threads)
+        double WallSec;       //!< elapsed time of whole batch
+        double NbMegaPixels;  //!< number of processed source pixels in millions
+        int    NbThreads;     //!< number of worker threads
+
+        Report() : NbDone(0), NbFailed(0), DecodeSec(0.0), TransformSec(0.0), EncodeSec(0.0), WallSec(0.0), NbMegaPixels(0.0), NbThreads(0) {}
+
+        /**
+         * Format report as multi-line text.
+         */
+        ST_CPPEXPORT StString toString() const;
+    };
+
+        public:
+
+    /**
+     * Return layout from string (sbs, sbsrl, ou, separate, rows, columns, anaglyph, anaglyphYB, anaglyphGM).
+     * @return FALSE if string is unknown
+     */
+    ST_CPPEXPORT static bool layoutFromString(const StString& theString,
+                                              Layout&         theLayout);
+
+    /**
+     * Return stereo format to be stored as metadata of the output with specified layout.
+     */
+    ST_CPPEXPORT static StFormat layoutToFormat(const Layout theLayout);
+
+    /**
+     * Extract left and right views from the source frame(s).
+     * @param theSrcL   frame with left or both views
+     * @param theSrcR   frame with right view (might be empty)
+     * @param theFormat source layout
+     * @param theViewL  output left view (compact copy)
+     * @param theViewR  output right view (compact copy)
+     * @return FALSE if source is monoscopic or views can not be extracted
+     */
+    ST_CPPEXPORT static bool splitViews(const StImage& theSrcL,
+                                        const StImage& theSrcR,
+                                        const StFormat theFormat,
+                                        StImage&       theViewL,
+                                        StImage&       theViewR);
+
+    /**
+     * Compose left and right views into single frame.
+     * Views should have the same dimensions and packed pixel format;
+     * anaglyph layouts require 8-bit RGB(A) / BGR(A) data.
+     * @param theViewL  left view
+     * @param theViewR  right view
+     * @param theLayout output layout (Layout_SeparateFrames is not allowed)
+     * @param theResult output frame
+     * @return FALSE on error
+     */
+    ST_CPPEXPORT static bool composeViews(const StImage& theViewL,
+                                          const StImage& theViewR,
+                                          const Layout   theLayout,
+                                          StImage&       theResult);
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theImageLib image library to decode and encode images
+     * @param theLayout   output layout
+     * @param theNbThreads number of parallel workers, 0 means concurrency budget of StThreadPool
+     */
+    ST_CPPEXPORT StStereoConverter(const StImageFile::ImageClass theImageLib,
+                                   const Layout                  theLayout,
+                                   const int                     theNbThreads = 0);
+
+    /**
+     * Destructor.
+     */
+    ST_CPPEXPORT ~StStereoConverter();
+
+    /**
+     * Append the job.
+     */
+    ST_CPPEXPORT void addJob(const Job& theJob);
+
+    /**
+     * @return number of queued jobs
+     */
+    ST_LOCAL size_t getNbJobs() const {
+        return myItems.size();
+    }
+
+    /**
+     * Process all queued jobs (blocking call).
+     * @return TRUE if all jobs have been converted
+     */
+    ST_CPPEXPORT bool perform();
+
+    /**
+     * Return report of last perform() call.
+     */
+    ST_LOCAL const Report& getReport() const {
+        return myReport;
+    }
+
+        public: //! @name signals
+
+    /**
+     * All callback handlers should be thread-safe.
+     */
+    struct {
+        /**
+         * Emit callback Slot on error.
+         * @param theUserData (const StString& ) - error description.
+         */
+        StSignal<void (const StCString& )> onError;
+
+        /**
+         * Emit callback Slot when job has been processed.
+         * @param theUserData (const StCString& ) - destination path.
+         */
+        StSignal<void (const StCString& )> onDone;
+    } signals;
+
+        private:
+
+    /**
+     * Job processing stage.
+     */
+    enum Stage {
+        Stage_Decode,    //!< job is waiting for decoding
+        Stage_Transform, //!< decoded views are waiting for re-layout
+        Stage_Encode,    //!< result is waiting for encoding
+        Stage_Finished,  //!< job is done (or failed)
+    };
+
+    /**
+     * Job with intermediate data.
+     */
+    struct Item {
+        Job                   Task;     //!< job definition
+        Stage                 State;    //!< current stage
+        bool                  IsBusy;   //!< flag indicating that item is processed by some thread
+        bool                  IsVideo;  //!< flag indicating video file to be remuxed
+        StFormat              Format;   //!< detected source layout
+        StHandle<StImageFile> FrameL;   //!< decoded frame with left view (or both views)
+        StHandle<StImageFile> FrameR;   //!< decoded frame with right view
+        StImage               ViewL;    //!< extracted left  view
+        StImage               ViewR;    //!< extracted right view
+        StHandle<StImageFile> Result;   //!< composed frame (or left view for separate output)
+        StHandle<StImageFile> ResultR;  //!< right view for separate output
+        StString              Error;    //!< error description
+
+        Item() : State(Stage_Decode), IsBusy(false), IsVideo(false), Format(StFormat_AUTO) {}
+    };
+
+        private:
+
+    /**
+     * Pool task calling workerLoop().
+     */
+    class WorkerTask : public StThreadPool::Task {
+
+            public:
+
+        ST_LOCAL WorkerTask(StStereoConverter* theConverter) : myConverter(theConverter) {}
+
+        ST_LOCAL virtual void perform() {
+            myConverter->workerLoop();
+        }
+
+            private:
+
+        StStereoConverter* myConverter;
+
+    };
+
+    /**
+     * Worker loop.
+     */
+    ST_LOCAL void workerLoop();
+
+    /**
+     * Decode source file(s).
+     */
+    ST_LOCAL bool decode(Item& theItem);
+
+    /**
+     * Extract views and compose the result.
+     */
+    ST_LOCAL bool transform(Item& theItem);
+
+    /**
+     * Write result file(s) or remux video.
+     */
+    ST_LOCAL bool encode(Item& theItem);
+
+    /**
+     * Decode single image file.
+     */
+    ST_LOCAL bool decodeImage(Item& theItem);
+
+    /**
+     * Forward muxer error.
+     */
+    ST_LOCAL void doMuxerError(const StCString& theMsg);
+
+        private:
+
+    StImageFile::ImageClass      myImageLib;     //!< image library
+    Layout                       myLayout;       //!< output layout
+    int                          myNbThreads;    //!< number of parallel workers
+    size_t                       myMaxDecoded;   //!< maximum number of decoded jobs kept in memory
+    std::vector< StHandle<Item> > myItems;       //!< jobs list
+    StMutex                      myMutex;        //!< lock for jobs state
+    StCondition                  myEventChanged; //!< event signaling that some job has changed its stage
+    size_t                       myNextDecode;   //!< index of the next job to decode
+    size_t                       myNbDecoded;    //!< number of decoded but not yet encoded jobs
+    size_t                       myNbFinished;   //!< number of finished jobs
+    Report                       myReport;       //!< report of the last batch
+
+};
+
+#endif // __StStereoConverter_h_
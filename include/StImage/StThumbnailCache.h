@@ -0,0 +1,206 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StThumbnailCache_h_
+#define __StThumbnailCache_h_
+
+#include <StImage/StImageFile.h>
+#include <StImage/StJpegParser.h>
+#include <StThreads/StThreadPool.h>
+
+#include <deque>
+#include <vector>
+
+/**
+ * Generator of image thumbnails for file browser.
+ * Thumbnails are produced by background task of shared thread pool:
+ *  - embedded EXIF thumbnail is used for JPEG/MPO/JPS files when present;
+ *  - otherwise the image is decoded (JPEG at reduced resolution) and reduced to the thumbnail size.
+ * Generated thumbnails are stored within cache folder keyed by file path, size and modification time,
+ * so that browsing the same folder again does not decode images anymore;
+ * the oldest thumbnails are removed when the folder exceeds size limit.
+ *
+ * Requests are processed in priority order, so that the caller might raise priority of visible items
+ * after scrolling without cancelling already queued ones.
+ */
+class StThumbnailCache {
+
+        public:
+
+    /**
+     * Generated thumbnail.
+     */
+    struct Thumbnail {
+        size_t                 Id;    //!< item id passed to request()
+        StHandle<StImagePlane> Image; //!< RGB image fitting into thumbnail size, NULL if file can not be decoded
+
+        Thumbnail() : Id(0) {}
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theCacheFolder cache folder (ending with separator), empty to disable persistent cache
+     * @param theSize        maximum thumbnail dimension in pixels
+     * @param theCacheLimit  size limit for cached thumbnails in bytes
+     */
+    ST_CPPEXPORT StThumbnailCache(const StString& theCacheFolder,
+                                  const int       theSize = 128,
+                                  const int64_t   theCacheLimit = 64 * 1024 * 1024);
+
+    /**
+     * Destructor, drops pending requests and waits for active one.
+     */
+    ST_CPPEXPORT ~StThumbnailCache();
+
+    /**
+     * @return maximum thumbnail dimension in pixels
+     */
+    ST_LOCAL int getSize() const {
+        return mySize;
+    }
+
+    /**
+     * Request the thumbnail or change priority of already queued request.
+     * @param theId       item id to be returned within result
+     * @param thePath     image file path
+     * @param thePriority request priority, greater value is processed first
+     */
+    ST_CPPEXPORT void request(const size_t    theId,
+                              const StString& thePath,
+                              const int       thePriority);
+
+    /**
+     * Drop pending requests and not yet fetched results (e.g. on opening another folder).
+     */
+    ST_CPPEXPORT void clear();
+
+    /**
+     * Fetch next generated thumbnail.
+     * @return FALSE if there are no new thumbnails
+     */
+    ST_CPPEXPORT bool pop(Thumbnail& theThumb);
+
+    /**
+     * @return TRUE if there are generated thumbnails to be fetched by pop()
+     */
+    ST_CPPEXPORT bool hasResults() const;
+
+    /**
+     * @return number of queued requests
+     */
+    ST_CPPEXPORT size_t getNbPending() const;
+
+        private:
+
+    /**
+     * Queued request.
+     */
+    struct Request {
+        size_t   Id;
+        StString Path;
+        int      Priority;
+    };
+
+    /**
+     * Pool task calling workLoop().
+     */
+    class WorkTask : public StThreadPool::Task {
+
+            public:
+
+        ST_LOCAL WorkTask(StThumbnailCache* theCache) : myCache(theCache) {}
+
+        ST_LOCAL virtual void perform() {
+            myCache->workLoop();
+        }
+
+            private:
+
+        StThumbnailCache* myCache;
+
+    };
+
+    /**
+     * Generate thumbnails until request queue becomes empty.
+     */
+    ST_LOCAL void workLoop();
+
+    /**
+     * Read thumbnail from cache or generate new one.
+     */
+    ST_LOCAL StHandle<StImagePlane> generate(const StString& thePath);
+
+    /**
+     * Decode embedded EXIF thumbnail.
+     * @param thePath    image file path
+     * @param theJpegImg parsed JPEG image, NULL for other formats
+     */
+    ST_LOCAL StHandle<StImagePlane> decodeEmbedded(const StString& thePath,
+                                                   const StHandle<StJpegParser::Image>& theJpegImg) const;
+
+    /**
+     * Decode the image itself.
+     * @param thePath    image file path
+     * @param theImgType image format
+     * @param theJpegImg parsed JPEG image (defines orientation and dimensions), NULL for other formats
+     */
+    ST_LOCAL StHandle<StImagePlane> decodeImage(const StString&                      thePath,
+                                                const StImageFile::ImageType         theImgType,
+                                                const StHandle<StJpegParser::Image>& theJpegImg) const;
+
+    /**
+     * Reduce decoded image to the thumbnail size (box filter).
+     * @param theImage  decoded image
+     * @param theOrient EXIF orientation to apply
+     */
+    ST_LOCAL StHandle<StImagePlane> reduceImage(const StImage& theImage,
+                                                const int      theOrient) const;
+
+    /**
+     * @return path to the cached thumbnail
+     */
+    ST_LOCAL StString getCachePath(const StString& thePath) const;
+
+    /**
+     * Read cached thumbnail, NULL if missing or outdated.
+     */
+    ST_LOCAL StHandle<StImagePlane> readCached(const StString& thePath,
+                                               const int64_t   theFileSize,
+                                               const int64_t   theModTime) const;
+
+    /**
+     * Store thumbnail in cache.
+     */
+    ST_LOCAL bool writeCached(const StString&     thePath,
+                              const int64_t       theFileSize,
+                              const int64_t       theModTime,
+                              const StImagePlane& theThumb);
+
+    /**
+     * Remove the oldest cached thumbnails to fit into size limit.
+     */
+    ST_LOCAL void trimCache();
+
+        private:
+
+    StString                     myCacheFolder; //!< thumbnails cache folder
+    int                          mySize;        //!< maximum thumbnail dimension
+    int64_t                      myCacheLimit;  //!< size limit for cache folder
+    int64_t                      myCacheUsed;   //!< estimated size of cache folder (accessed by pool task only)
+    mutable StMutex              myMutex;       //!< lock for queues
+    std::vector<Request>         myRequests;    //!< pending requests
+    std::deque<Thumbnail>        myResults;     //!< generated thumbnails not yet fetched
+    StHandle<StThreadPool::Task> myTask;        //!< last pushed pool task
+    size_t                       myGeneration;  //!< counter incremented by clear() to discard results of active request
+    bool                         myIsActive;    //!< flag indicating that pool task is running
+
+};
+
+#endif // __StThumbnailCache_h_
@@ -11,6 +11,7 @@
 
 #include <StStrings/StString.h>
 #include <StTemplates/StArrayList.h>
+#include <StTemplates/StHashIndex.h>
 
 /**
  * This class represents dictionary entry key+value.
@@ -151,6 +152,10 @@ class StDictEntry {
 /**
  * Simple array-map for StArguments. Could be exported/imported into/from string
  * (default '\n' symbol will be used as delimiter).
+ * Entries are kept in order of insertion, while key lookups use hash index.
+ * The index is updated only by mutating methods, so that concurrent lookups (const methods) are safe.
+ * Keys of entries should not be modified in-place (through changeValue())
+ * nor entries should be replaced through base class interface, as such modifications can not be tracked.
  */
 class StDictionary : public StArrayList<StDictEntry> {
 
@@ -178,6 +183,12 @@ class StDictionary : public StArrayList<StDictEntry> {
      */
     ST_CPPEXPORT const StDictEntry& operator[](const StString& theKey) const;
 
+    /**
+     * Find the entry with specified key (case-insensitive).
+     * @return index of the first entry with this key or size_t(-1) if not found
+     */
+    ST_CPPEXPORT size_t find(const StString& theKey) const;
+
     /**
      * Access to the arguments throw indexes.
      * Use parent ::size() method to retrieve map's size.
@@ -193,8 +204,60 @@ class StDictionary : public StArrayList<StDictEntry> {
 
     ST_CPPEXPORT StDictEntry& addChange(const StString& theKey);
 
+    /**
+     * Append new entry (key is not checked for duplicates).
+     */
+    ST_CPPEXPORT StDictionary& add(const StDictEntry& theEntry);
+
+    /**
+     * Put the entry at specified position (key is not checked for duplicates).
+     */
+    ST_CPPEXPORT StDictionary& add(const size_t       theIndex,
+                                   const StDictEntry& theEntry);
+
+    /**
+     * Remove the entry at specified position.
+     */
+    ST_CPPEXPORT StDictionary& remove(const size_t theIndex);
+
+    /**
+     * Remove all entries.
+     */
+    ST_CPPEXPORT virtual StArrayList<StDictEntry>& clear() ST_ATTR_OVERRIDE;
+
+    /**
+     * Initialize the list with reserved capacity (all current entries are destroyed).
+     */
+    ST_LOCAL void initList(const size_t theListSize) {
+        StArrayList<StDictEntry>::initList(theListSize);
+        myIndex.clear();
+    }
+
+    /**
+     * Sort entries by keys.
+     */
+    ST_CPPEXPORT virtual void sort() ST_ATTR_OVERRIDE;
+
     ST_CPPEXPORT virtual StString toString() const;
 
+        private:
+
+    /**
+     * Rebuild the index if it does not cover all entries.
+     */
+    ST_LOCAL void updateIndex();
+
+    /**
+     * @return true if index covers all entries
+     */
+    ST_LOCAL bool isIndexed() const {
+        return myIndex.size() == size();
+    }
+
+        private:
+
+    StHashIndex myIndex; //!< hash index of case-insensitive keys, covering first myIndex.size() entries
+
 };
 
 #endif // __StDictionary_h_
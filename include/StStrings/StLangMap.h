@@ -9,9 +9,11 @@
 #ifndef __StLangMap_h__
 #define __StLangMap_h__
 
-#include <map> // STL map template
-
 #include <StStrings/StString.h>
+#include <StTemplates/StHashIndex.h>
+
+#include <deque>
+#include <vector>
 
 /**
  * Key -> string map for translation files.
@@ -83,18 +85,30 @@ class StLangMap {
      */
     ST_CPPEXPORT const StString& getValue(const StString& theStringKey) const;
 
-        public:
+        private:
 
-    typedef std::map<size_t, StString> stMapInt2String_t;
-    typedef std::map<StString, size_t> stMapString2Int_t;
+    /**
+     * @return index of value for specified key or StHashIndex::NOT_FOUND()
+     */
+    ST_LOCAL size_t findValue(const size_t theId) const;
+
+    /**
+     * Append new value for specified key.
+     */
+    ST_LOCAL StString& addValue(const size_t    theId,
+                                const StString& theValue);
 
         private:
 
-    StString          myLngFile;    //!< path to the language file
-    StString          myEmptyStr;   //!< empty string to return for invalid keys
-    stMapInt2String_t myMap;        //!< key -> string map
-    stMapString2Int_t myMapStrKeys; //!< auxiliary map of string key -> int key
-    bool              myToShowId;
+    StString              myLngFile;    //!< path to the language file
+    StString              myEmptyStr;   //!< empty string to return for invalid keys
+    std::deque<StString>  myValues;     //!< values in order of insertion (deque keeps references valid)
+    std::vector<size_t>   myKeys;       //!< int keys of values
+    StHashIndex           myIndex;      //!< hash index of int key -> value
+    std::vector<StString> myStrKeys;    //!< string key aliases
+    std::vector<size_t>   myStrKeyIds;  //!< int keys of aliases
+    StHashIndex           myStrIndex;   //!< hash index of string key -> alias
+    bool                  myToShowId;
 
 };
 
@@ -10,39 +10,120 @@
 #define __StMsgQueue_h__
 
 #include <StThreads/StMutex.h>
+#include <StThreads/StTimer.h>
 #include <StStrings/StLogger.h>
 
 #include <deque>
 
 struct StMsg {
 
-    StHandle<StString> Text;  //!< message text
-    StLogger::Level    Level; //!< message level
+    StHandle<StString> Text;      //!< message text
+    StLogger::Level    Level;     //!< message level
+    size_t             NbRepeats; //!< number of identical messages folded into this one
+    bool               IsRepeat;  //!< message repeats the one of the same level drained shortly before
+
+    StMsg() : Level(StLogger::ST_INFO), NbRepeats(1), IsRepeat(false) {}
+
+    /**
+     * @return true if message has the same level and text
+     */
+    bool isSame(const StMsg& theOther) const {
+        return Level == theOther.Level
+            && (Text == theOther.Text
+             || (!Text.isNull() && !theOther.Text.isNull() && Text->isEquals(*theOther.Text)));
+    }
+
+    /**
+     * @return message text with repeats counter
+     */
+    StString getText() const {
+        if(Text.isNull()) {
+            return StString();
+        }
+        return NbRepeats > 1
+             ? (*Text + " (x" + NbRepeats + ")")
+             : *Text;
+    }
 
 };
 
 /**
- * Queue of messages.
+ * Queue of messages sent from working threads (decoders, loaders) to GUI thread.
+ * The queue is bounded - messages exceeding the limit are dropped,
+ * and identical messages (same level and text) already waiting in the queue
+ * are folded into the queued one with repeats counter incremented.
+ * GUI thread is expected to drain the queue at once per frame using popBatch(),
+ * thus a message repeating the last drained one of the same level within a short time window
+ * is marked by StMsg::IsRepeat flag, so that GUI could update already shown message instead of showing a new one.
  */
 class StMsgQueue {
 
         public:
 
+    /**
+     * Queue statistics.
+     */
+    struct Stats {
+        size_t NbPushed;    //!< total number of pushed messages
+        size_t NbCoalesced; //!< number of messages folded into already queued or recently drained ones
+        size_t NbDropped;   //!< number of messages dropped due to queue overflow
+
+        Stats() : NbPushed(0), NbCoalesced(0), NbDropped(0) {}
+
+        /**
+         * @return statistics as string
+         */
+        StString toString() const {
+            return StString("pushed: ") + NbPushed
+                 + ", coalesced: "      + NbCoalesced
+                 + ", dropped: "        + NbDropped;
+        }
+    };
+
+        public:
+
     /**
      * Empty constructor.
+     * @param theMaxSize maximum number of queued messages
      */
-    ST_CPPEXPORT StMsgQueue();
+    ST_CPPEXPORT StMsgQueue(const size_t theMaxSize = 128);
 
     /**
      * Destructor.
      */
     ST_CPPEXPORT virtual ~StMsgQueue();
 
+    /**
+     * @return time window in seconds to mark messages repeating the last drained one
+     */
+    ST_LOCAL double getRepeatWindow() const {
+        return myRepeatWindow;
+    }
+
+    /**
+     * Set time window in seconds to mark messages repeating the last drained one (2 seconds by default).
+     */
+    ST_LOCAL void setRepeatWindow(const double theSeconds) {
+        myRepeatWindow = theSeconds;
+    }
+
     /**
      * Pop message from the queue.
      */
     ST_CPPEXPORT bool pop(StMsg& theMessage);
 
+    /**
+     * Pop all queued messages at once.
+     * @param theBatch the list to be filled (previous content is discarded)
+     * @return number of retrieved messages
+     */
+    ST_CPPEXPORT size_t popBatch(std::deque<StMsg>& theBatch);
+
+    /**
+     * @return queue statistics
+     */
+    ST_CPPEXPORT Stats getStats() const;
+
     /**
      * Pop all messages and display them using standard dialogs.
      */
@@ -91,8 +172,34 @@ class StMsgQueue {
 
         private:
 
-    StMutex           myMutex; //!< mutex for thread-safe access
-    std::deque<StMsg> myQueue; //!< messages queue
+    /**
+     * Last drained message of specific level.
+     */
+    struct Drained {
+        StMsg   Msg;   //!< drained message
+        StTimer Timer; //!< time elapsed since last drain or repeat of this message
+    };
+
+    /**
+     * @return last drained message of the same level or NULL if level is out of range
+     */
+    ST_LOCAL Drained* findDrained(const StLogger::Level theLevel) {
+        return theLevel >= StLogger::ST_PANIC && theLevel <= StLogger::ST_TRACE
+             ? &myDrained[theLevel]
+             : NULL;
+    }
+
+        private:
+
+    mutable StMutex   myMutex;        //!< mutex for thread-safe access
+    std::deque<StMsg> myQueue;        //!< messages queue
+    Drained           myDrained[StLogger::ST_TRACE + 1];
+                                      //!< last drained message per level
+    Stats             myStats;        //!< queue statistics
+    double            myRepeatWindow; //!< time window in seconds to mark repeats of drained messages
+    size_t            myMaxSize;      //!< maximum number of queued messages
+    size_t            myNbDropRep;    //!< number of dropped messages already reported to log
+    size_t            myNbCoalRep;    //!< number of coalesced messages already reported to log
 
 };
 
@@ -0,0 +1,273 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StStringBuilder_h__
+#define __StStringBuilder_h__
+
+#include <StStrings/StString.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * Builder of UTF-8 string within small buffer allocated on stack.
+ * In contrast to chain of StString::operator+(), which allocates new buffer for each temporary,
+ * appending strings and numbers does not allocate memory unless the text exceeds the stack buffer.
+ * This allows composing the text in per-frame code, comparing it with currently displayed one
+ * and creating StString (single allocation) only when the text has been actually changed.
+ */
+class StStringBuilder {
+
+        public:
+
+    static const size_t STACK_SIZE = 256U;
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    StStringBuilder()
+    : myData(myStack),
+      mySize(0),
+      myCapacity(STACK_SIZE) {
+        myStack[0] = '\0';
+    }
+
+    /**
+     * Destructor.
+     */
+    ~StStringBuilder() {
+        if(myData != myStack) {
+            stMemFree(myData);
+        }
+    }
+
+    /**
+     * Reset the string (memory is not released).
+     */
+    void clear() {
+        mySize    = 0;
+        myData[0] = '\0';
+    }
+
+    /**
+     * @return TRUE if string is empty
+     */
+    bool isEmpty() const {
+        return mySize == 0;
+    }
+
+    /**
+     * @return string size in bytes, excluding NULL-termination symbol
+     */
+    size_t getSize() const {
+        return mySize;
+    }
+
+    /**
+     * @return NULL-terminated UTF-8 string
+     */
+    const char* toCString() const {
+        return myData;
+    }
+
+    /**
+     * @return new StString with the copy of this string
+     */
+    StString toString() const {
+        return StString(myData);
+    }
+
+    /**
+     * Compare with another string.
+     */
+    bool isEquals(const StString& theString) const {
+        return theString.getSize() == mySize
+            && stAreEqual(theString.toCString(), myData, mySize);
+    }
+
+    /**
+     * Append the string of specified size in bytes.
+     */
+    StStringBuilder& append(const char*  theString,
+                            const size_t theSize) {
+        if(theSize != 0
+        && reserve(mySize + theSize)) {
+            stMemCpy(myData + mySize, theString, theSize);
+            mySize += theSize;
+            myData[mySize] = '\0';
+        }
+        return *this;
+    }
+
+    /**
+     * Append the formatted string (printf syntax, C locale is expected).
+     */
+    StStringBuilder& appendFormat(const char* theFormat, ...) {
+        va_list anArgs;
+        va_start(anArgs, theFormat);
+        int aLen = vsnprintf(myData + mySize, myCapacity - mySize + 1, theFormat, anArgs);
+        va_end(anArgs);
+        if(aLen > 0
+        && mySize + size_t(aLen) > myCapacity
+        && reserve(mySize + size_t(aLen))) {
+            // repeat within larger buffer
+            va_start(anArgs, theFormat);
+            aLen = vsnprintf(myData + mySize, myCapacity - mySize + 1, theFormat, anArgs);
+            va_end(anArgs);
+        }
+
+        if(aLen < 0
+        || mySize + size_t(aLen) > myCapacity) {
+            myData[mySize] = '\0';
+            return *this;
+        }
+        mySize += size_t(aLen);
+        return *this;
+    }
+
+    /**
+     * Append floating point number with specified number of decimal places.
+     */
+    StStringBuilder& appendFixed(const double theValue,
+                                 const int    theNbDecimals) {
+        return appendFormat("%.*f", theNbDecimals, theValue);
+    }
+
+    /**
+     * Append time in [-][HH:]MM:SS format, the same as StFormatTime::formatSeconds().
+     */
+    StStringBuilder& appendTime(const double theSeconds) {
+        double aSeconds = theSeconds;
+        if(aSeconds < 0.0) {
+            append("-", 1);
+            aSeconds = -aSeconds;
+        }
+        const unsigned int anHours = (unsigned int )(aSeconds / 3600.0);
+        aSeconds -= double(anHours) * 3600.0;
+        const unsigned int aMinutes = (unsigned int )(aSeconds / 60.0);
+        aSeconds -= double(aMinutes) * 60.0;
+        if(anHours != 0) {
+            appendUInt(anHours, 2).append(":", 1);
+        }
+        return appendUInt(aMinutes, 2).append(":", 1).appendUInt((unsigned int )aSeconds, 2);
+    }
+
+    /**
+     * Append unsigned integer.
+     * @param theValue    the value
+     * @param theMinWidth minimal number of digits (zero padding)
+     */
+    StStringBuilder& appendUInt(const uint64_t theValue,
+                                const int      theMinWidth = 1) {
+        char aBuffer[24];
+        char* anEnd  = aBuffer + sizeof(aBuffer);
+        char* aStart = anEnd;
+        uint64_t aValue = theValue;
+        do {
+            *--aStart = char('0' + int(aValue % 10));
+            aValue /= 10;
+        } while(aValue != 0);
+        for(int aWidth = int(anEnd - aStart); aWidth < theMinWidth && aStart > aBuffer; ++aWidth) {
+            *--aStart = '0';
+        }
+        return append(aStart, size_t(anEnd - aStart));
+    }
+
+    /**
+     * Append signed integer.
+     */
+    StStringBuilder& appendInt(const int64_t theValue) {
+        if(theValue < 0) {
+            append("-", 1);
+            return appendUInt(uint64_t(0) - uint64_t(theValue));
+        }
+        return appendUInt(uint64_t(theValue));
+    }
+
+        public: //! @name stream-like operators
+
+    StStringBuilder& operator<<(const char* theString) {
+        return append(theString, std::strlen(theString));
+    }
+
+    StStringBuilder& operator<<(const StCString& theString) {
+        return append(theString.toCString(), theString.getSize());
+    }
+
+    StStringBuilder& operator<<(const StString& theString) {
+        return append(theString.toCString(), theString.getSize());
+    }
+
+    StStringBuilder& operator<<(const StStringBuilder& theString) {
+        return append(theString.toCString(), theString.getSize());
+    }
+
+    StStringBuilder& operator<<(const char theChar) {
+        return append(&theChar, 1);
+    }
+
+    StStringBuilder& operator<<(const int32_t  theValue) { return appendInt (theValue); }
+    StStringBuilder& operator<<(const uint32_t theValue) { return appendUInt(theValue); }
+    StStringBuilder& operator<<(const int64_t  theValue) { return appendInt (theValue); }
+    StStringBuilder& operator<<(const uint64_t theValue) { return appendUInt(theValue); }
+#ifdef ST_HAS_INT64_EXT
+    StStringBuilder& operator<<(const stInt64ext_t  theValue) { return appendInt (int64_t (theValue)); }
+    StStringBuilder& operator<<(const stUInt64ext_t theValue) { return appendUInt(uint64_t(theValue)); }
+#endif
+
+    /**
+     * Append floating point number in the same format as StString(double).
+     */
+    StStringBuilder& operator<<(const double theValue) {
+        return appendFormat("%f", theValue);
+    }
+
+        private:
+
+    /**
+     * Ensure that buffer is large enough for the string of specified size.
+     */
+    bool reserve(const size_t theSize) {
+        if(theSize <= myCapacity) {
+            return true;
+        }
+
+        size_t aCapacity = myCapacity * 2;
+        for(; aCapacity < theSize; aCapacity *= 2) {}
+        char* aData = stMemAlloc<char*>(aCapacity + 1);
+        if(aData == NULL) {
+            return false;
+        }
+
+        stMemCpy(aData, myData, mySize + 1);
+        if(myData != myStack) {
+            stMemFree(myData);
+        }
+        myData     = aData;
+        myCapacity = aCapacity;
+        return true;
+    }
+
+        private:
+
+    StStringBuilder(const StStringBuilder& );
+    StStringBuilder& operator=(const StStringBuilder& );
+
+        private:
+
+    char   myStack[STACK_SIZE + 1]; //!< buffer on stack (with extra byte for NULL-termination)
+    char*  myData;                  //!< current buffer - stack or heap one
+    size_t mySize;                  //!< string size in bytes
+    size_t myCapacity;              //!< buffer capacity, excluding NULL-termination symbol
+
+};
+
+#endif // __StStringBuilder_h__
@@ -14,6 +14,24 @@
 
 #include <iostream>
 
+// string buffers allocations counter performs atomic increment on each allocation,
+// so that it is enabled only in debug builds or when requested explicitly for profiling
+#if defined(ST_DEBUG) && !defined(ST_STR_ALLOC_STATS)
+    #define ST_STR_ALLOC_STATS
+#endif
+
+/**
+ * Increment the global counter of string buffers allocations (all threads).
+ * Called by string allocator only when ST_STR_ALLOC_STATS is defined.
+ */
+ST_CPPEXPORT void stStrAllocCounterIncrement();
+
+/**
+ * @return global counter of string buffers allocations (wraps around), intended for performance statistics;
+ *         remains zero if ST_STR_ALLOC_STATS is not defined
+ */
+ST_CPPEXPORT uint32_t stStrAllocCounter();
+
 /**
  * This template of POD structure for constant UTF-* string.
  */
@@ -492,6 +510,9 @@ class StStringUnicode : public StConstStringUnicode<Type> {
      * Allocate NULL-terminated string buffer.
      */
     static inline Type* stStrAlloc(const size_t theSizeBytes) {
+    #ifdef ST_STR_ALLOC_STATS
+        stStrAllocCounterIncrement();
+    #endif
         Type* aPtr = stMemAlloc<Type*>(theSizeBytes + sizeof(Type));
         if(aPtr != NULL) {
             // always NULL-terminate the string
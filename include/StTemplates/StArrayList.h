@@ -15,8 +15,8 @@
  * This template declare simple-to-use size-scaled Array class.
  * This mean you can work with this class like with List (methods add() and remove()),
  * but memory allocated as array (not a single-linked or double-linked list!).
- * You can manage array-allocation size on construction. When array is full, it automatically upscaled + 8 items
- * and array copying processed.
+ * You can manage array-allocation size on construction. When array is full, it is automatically upscaled
+ * (twice, to keep appending amortized constant) and array copying processed.
  */
 template<typename Element_t>
 class StArrayList : public StArray<Element_t> {
@@ -104,7 +104,7 @@ class StArrayList : public StArray<Element_t> {
      */
     StArrayList& add(const size_t theIndex, const Element_t& theElement) {
         if(theIndex >= mySizeMax) {
-            size_t aNewSize = getAligned(theIndex + 7); // increment with 8 elements...
+            const size_t aNewSize = getAligned(theIndex + 1 > mySizeMax * 2 ? theIndex + 1 : mySizeMax * 2);
             Element_t* aNewArray = new Element_t[aNewSize];
             for(size_t anElem = 0; anElem < mySizeMax; ++anElem) {
                 aNewArray[anElem] = StArray<Element_t>::myArray[anElem];
@@ -37,6 +37,16 @@ class StAtomic {
         return myValue;
     }
 
+    /**
+     * Read the value with acquire semantics - memory accesses following this call
+     * are not reordered before the read, so that data published before the value modification are visible.
+     */
+    Type getValueAcquire() const {
+        const Type aValue = myValue;
+        StAtomicOp::Barrier();
+        return aValue;
+    }
+
     /**
      * Increment the value with 1.
      * @return incrementation result.
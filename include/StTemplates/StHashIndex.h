@@ -0,0 +1,178 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StHashIndex_h__
+#define __StHashIndex_h__
+
+#include <stTypes.h>
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Open-addressing (linear probing) hash index over elements stored in external container.
+ * The index keeps only hashes and positions of elements,
+ * so that elements themselves stay in their container in original order.
+ * Duplicated keys are allowed - find() returns the element with the smallest position.
+ */
+class StHashIndex {
+
+        public:
+
+    /**
+     * Value returned for not found elements.
+     */
+    static size_t NOT_FOUND() { return size_t(-1); }
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    StHashIndex() : myNbElements(0) {}
+
+    /**
+     * @return number of indexed elements
+     */
+    size_t size() const {
+        return myNbElements;
+    }
+
+    /**
+     * Remove all elements.
+     */
+    void clear() {
+        mySlots.clear();
+        myNbElements = 0;
+    }
+
+    /**
+     * Add element into the index.
+     * Elements should be added in order of increasing position.
+     * @param theHash element hash
+     * @param thePos  element position within external container
+     */
+    void add(const size_t theHash,
+             const size_t thePos) {
+        if((myNbElements + 1) * 2 > mySlots.size()) {
+            rehash(mySlots.empty() ? 16 : mySlots.size() * 2);
+        }
+        insert(theHash, thePos);
+        ++myNbElements;
+    }
+
+    /**
+     * Find element.
+     * @param theHash    element hash
+     * @param theIsEqual functor verifying that element at specified position matches the key
+     * @return position of element or NOT_FOUND()
+     */
+    template<typename IsEqual_t>
+    size_t find(const size_t     theHash,
+                const IsEqual_t& theIsEqual) const {
+        if(mySlots.empty()) {
+            return NOT_FOUND();
+        }
+
+        const size_t aMask = mySlots.size() - 1;
+        for(size_t aSlotIter = theHash & aMask;; aSlotIter = (aSlotIter + 1) & aMask) {
+            const Slot& aSlot = mySlots[aSlotIter];
+            if(aSlot.Pos == NOT_FOUND()) {
+                return NOT_FOUND();
+            } else if(aSlot.Hash == theHash
+                   && theIsEqual(aSlot.Pos)) {
+                return aSlot.Pos;
+            }
+        }
+    }
+
+    /**
+     * FNV-1a hash of byte string.
+     * @param theData  bytes
+     * @param theSize  number of bytes
+     * @param theToFoldCase fold ASCII letters to lower case
+     */
+    static size_t hashBytes(const char*  theData,
+                            const size_t theSize,
+                            const bool   theToFoldCase) {
+        size_t aHash = size_t(2166136261u);
+        for(size_t aByteIter = 0; aByteIter < theSize; ++aByteIter) {
+            char aByte = theData[aByteIter];
+            if(theToFoldCase
+            && aByte >= 'A' && aByte <= 'Z') {
+                aByte += 'a' - 'A';
+            }
+            aHash = (aHash ^ size_t((unsigned char )aByte)) * size_t(16777619u);
+        }
+        return aHash;
+    }
+
+    /**
+     * Hash of integer key.
+     */
+    static size_t hashInteger(const size_t theKey) {
+        // spread sequential keys over the table (Fibonacci hashing)
+        const uint64_t aHash = uint64_t(theKey) * uint64_t(0x9E3779B97F4A7C15ull);
+        return size_t(aHash ^ (aHash >> 32));
+    }
+
+        private:
+
+    /**
+     * Index slot.
+     */
+    struct Slot {
+        size_t Hash; //!< element hash
+        size_t Pos;  //!< element position or NOT_FOUND() for empty slot
+
+        Slot() : Hash(0), Pos(size_t(-1)) {}
+
+        bool operator<(const Slot& theOther) const { return Pos < theOther.Pos; }
+    };
+
+    /**
+     * Put element into the first free slot.
+     */
+    void insert(const size_t theHash,
+                const size_t thePos) {
+        const size_t aMask = mySlots.size() - 1;
+        size_t aSlotIter = theHash & aMask;
+        for(; mySlots[aSlotIter].Pos != NOT_FOUND(); aSlotIter = (aSlotIter + 1) & aMask) {}
+        mySlots[aSlotIter].Hash = theHash;
+        mySlots[aSlotIter].Pos  = thePos;
+    }
+
+    /**
+     * Resize slots table and re-insert elements.
+     * Elements are re-inserted in order of their positions,
+     * so that the first duplicate is still found first.
+     */
+    void rehash(const size_t theNbSlots) {
+        std::vector<Slot> anOld;
+        anOld.reserve(myNbElements);
+        for(size_t aSlotIter = 0; aSlotIter < mySlots.size(); ++aSlotIter) {
+            if(mySlots[aSlotIter].Pos != NOT_FOUND()) {
+                anOld.push_back(mySlots[aSlotIter]);
+            }
+        }
+        std::sort(anOld.begin(), anOld.end());
+
+        mySlots.assign(theNbSlots, Slot());
+        for(size_t anElemIter = 0; anElemIter < anOld.size(); ++anElemIter) {
+            insert(anOld[anElemIter].Hash, anOld[anElemIter].Pos);
+        }
+    }
+
+        private:
+
+    std::vector<Slot> mySlots;      //!< slots table, size is power of two
+    size_t            myNbElements; //!< number of indexed elements
+
+};
+
+#endif // __StHashIndex_h__
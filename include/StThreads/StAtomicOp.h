@@ -27,6 +27,25 @@ class StAtomicOp {
 
         public:
 
+    /**
+     * Full memory barrier - memory accesses are not reordered across this call
+     * neither by compiler nor by CPU.
+     */
+    static inline void Barrier() {
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+        // g++ compiler
+        __sync_synchronize();
+    #elif defined(_WIN32)
+        MemoryBarrier();
+    #elif defined(__APPLE__)
+        OSMemoryBarrier();
+    #elif defined(__GNUC__)
+        #error "Set -march=i486 or -march=armv7-a for gcc compiler"
+    #else
+        #error "Atomic operation doesn't implemented for current platform!"
+    #endif
+    }
+
     /**
      * Increment the value with 1 and return result.
      * @param theValue (volatile int32_t& ) - input value;
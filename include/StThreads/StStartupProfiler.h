@@ -0,0 +1,136 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StStartupProfiler_h_
+#define __StStartupProfiler_h_
+
+#include <StStrings/StString.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTimer.h>
+
+#include <vector>
+
+/**
+ * Process-wide recorder of application startup phases
+ * (settings and translations loading, font registry, renderer initialization, GL context, first frame).
+ * Phases are recorded as wall time intervals relative to the profiler creation (library load),
+ * until finish() is called after the first frame is drawn - further records are ignored.
+ */
+class StStartupProfiler {
+
+        public:
+
+    /**
+     * Recorded phase.
+     */
+    struct Phase {
+        const char* Name;     //!< phase name (should be a string literal)
+        double      StartMs;  //!< phase start time since profiler creation
+        double      TimeMs;   //!< phase duration, 0 for instant marks
+        size_t      Depth;    //!< nesting level
+        bool        IsOpened; //!< flag indicating that phase is not yet ended
+    };
+
+    /**
+     * Scoped phase - begins phase in constructor and ends in destructor.
+     */
+    class Scope {
+
+            public:
+
+        ST_LOCAL Scope(const char* thePhase)
+        : myPhase(StStartupProfiler::getDefault().begin(thePhase)) {}
+
+        ST_LOCAL ~Scope() {
+            StStartupProfiler::getDefault().end(myPhase);
+        }
+
+            private:
+
+        Scope(const Scope& );
+        Scope& operator=(const Scope& );
+
+            private:
+
+        int myPhase;
+
+    };
+
+        public:
+
+    /**
+     * Return global profiler.
+     */
+    ST_CPPEXPORT static StStartupProfiler& getDefault();
+
+    /**
+     * Start the phase.
+     * @param thePhase phase name (should be a string literal)
+     * @return phase index to be passed to end(), or -1 if recording is finished
+     */
+    ST_CPPEXPORT int begin(const char* thePhase);
+
+    /**
+     * End the phase.
+     */
+    ST_CPPEXPORT void end(const int thePhase);
+
+    /**
+     * Record instant event.
+     */
+    ST_CPPEXPORT void mark(const char* theEvent);
+
+    /**
+     * Stop recording.
+     * @return FALSE if recording has been already finished
+     */
+    ST_CPPEXPORT bool finish();
+
+    /**
+     * @return TRUE if recording is not yet finished
+     */
+    ST_CPPEXPORT bool isRecording() const;
+
+    /**
+     * Format recorded phases as multi-line text.
+     */
+    ST_CPPEXPORT StString toString() const;
+
+    /**
+     * Format recorded phases as JSON.
+     */
+    ST_CPPEXPORT StString toJson() const;
+
+    /**
+     * Write recorded phases into the log.
+     */
+    ST_CPPEXPORT void dumpToLog() const;
+
+    /**
+     * Write recorded phases into JSON file.
+     */
+    ST_CPPEXPORT bool dumpToJson(const StString& thePath) const;
+
+        private:
+
+    /**
+     * Empty constructor.
+     */
+    ST_LOCAL StStartupProfiler();
+
+        private:
+
+    mutable StMutex    myMutex;       //!< lock for phases list
+    StTimer            myTimer;       //!< timer started on creation
+    std::vector<Phase> myPhases;      //!< recorded phases
+    size_t             myDepth;       //!< current nesting level
+    bool               myIsRecording; //!< recording state
+
+};
+
+#endif // __StStartupProfiler_h_
@@ -65,6 +65,19 @@ class StThread {
      */
     ST_CPPEXPORT static void setCurrentThreadName(const char* theName);
 
+    /**
+     * Lower scheduling priority of the active thread,
+     * so that background work does not compete with playback and rendering threads.
+     */
+    ST_CPPEXPORT static void setCurrentThreadLowPriority();
+
+    /**
+     * Bind the active thread to specified logical processor.
+     * @param theCpuIndex logical processor index within 0..countLogicalProcessors()-1 range
+     * @return FALSE if not supported by the system
+     */
+    ST_CPPEXPORT static bool setCurrentThreadAffinity(const int theCpuIndex);
+
     /**
      * Returns the CPU architecture used to build the program (may not match the system).
      */
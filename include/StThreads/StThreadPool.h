@@ -0,0 +1,284 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StThreadPool_h_
+#define __StThreadPool_h_
+
+#include <StStrings/StString.h>
+#include <StTemplates/StAtomic.h>
+#include <StTemplates/StHandle.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+#include <deque>
+#include <vector>
+
+/**
+ * Process-wide pool of worker threads for short tasks
+ * (prefetching, image encoding, thumbnails and similar)
+ * which otherwise would spawn dedicated threads.
+ *
+ * Tasks are executed in priority order:
+ *  - realtime tasks are taken first from the shared FIFO queue;
+ *  - normal tasks are pushed to per-worker queues (each guarded by its own lock),
+ *    the owner takes the newest one while idle workers steal the oldest ones from other workers;
+ *  - background tasks are executed by dedicated low-priority workers,
+ *    so that long background jobs never occupy the main workers nor compete with playback threads.
+ *
+ * The pool also defines the concurrency budget - the number of CPU threads
+ * which might be shared by heavy consumers like FFmpeg codecs.
+ */
+class StThreadPool {
+
+        public:
+
+    /**
+     * Task priority.
+     */
+    enum Priority {
+        Priority_Realtime = 0, //!< latency-critical task (executed before others)
+        Priority_Normal,       //!< normal task
+        Priority_Background,   //!< long low-priority task
+    };
+    enum { Priority_NB = Priority_Background + 1 };
+
+    /**
+     * CPU affinity policy for workers.
+     */
+    enum Affinity {
+        Affinity_None,    //!< leave scheduling to the system
+        Affinity_PerCore, //!< bind each worker to its own logical processor
+    };
+
+    /**
+     * Interface for the task.
+     */
+    class Task {
+
+            public:
+
+        ST_CPPEXPORT Task();
+
+        ST_CPPEXPORT virtual ~Task();
+
+        /**
+         * Task body, executed by worker thread.
+         */
+        virtual void perform() = 0;
+
+        /**
+         * Wait until the task is performed.
+         * Returns immediately if task has not been pushed to the pool.
+         */
+        ST_LOCAL void wait() {
+            myEventDone.wait();
+        }
+
+        /**
+         * @return TRUE if task is not queued nor performed
+         */
+        ST_LOCAL bool isDone() {
+            return myEventDone.check();
+        }
+
+            private:
+
+        StCondition myEventDone; //!< event signaling task completion
+
+        friend class StThreadPool;
+
+    };
+
+    /**
+     * Pool statistics.
+     */
+    struct Stats {
+        int    NbThreads;             //!< number of main workers
+        int    NbBgThreads;           //!< number of background workers
+        int    Budget;                //!< concurrency budget
+        size_t NbQueued[Priority_NB]; //!< number of currently queued tasks per priority
+        size_t MaxQueued;             //!< maximum number of queued tasks observed
+        size_t NbExecuted;            //!< number of executed tasks
+        size_t NbStolen;              //!< number of normal tasks stolen from other workers
+
+        Stats() : NbThreads(0), NbBgThreads(0), Budget(0), MaxQueued(0), NbExecuted(0), NbStolen(0) {
+            NbQueued[0] = NbQueued[1] = NbQueued[2] = 0;
+        }
+
+        /**
+         * Format statistics as single-line text.
+         */
+        ST_CPPEXPORT StString toString() const;
+    };
+
+        public:
+
+    /**
+     * Return global pool, created on first call.
+     */
+    ST_CPPEXPORT static StThreadPool& getDefault();
+
+    /**
+     * Stop global pool (performs queued tasks and joins workers).
+     * Should be called by application before exit, so that workers are not joined during static destruction.
+     */
+    ST_CPPEXPORT static void releaseDefault();
+
+    /**
+     * Main constructor.
+     * Threads are started on first push.
+     * @param theNbThreads number of main workers, 0 means number of logical processors
+     *                     (half of this number, but at least 2, background workers are created in addition)
+     * @param theAffinity  CPU affinity policy
+     */
+    ST_CPPEXPORT StThreadPool(const int      theNbThreads = 0,
+                              const Affinity theAffinity  = Affinity_None);
+
+    /**
+     * Destructor, performs queued tasks and stops threads.
+     */
+    ST_CPPEXPORT ~StThreadPool();
+
+    /**
+     * @return number of main workers
+     */
+    ST_LOCAL int getNbThreads() const {
+        return myNbThreads;
+    }
+
+    /**
+     * Append the task.
+     * The task should not be pushed again until it is performed.
+     */
+    ST_CPPEXPORT void push(const StHandle<Task>& theTask,
+                           const Priority        thePriority = Priority_Normal);
+
+    /**
+     * @return pool statistics
+     */
+    ST_CPPEXPORT Stats getStats() const;
+
+    /**
+     * @return the number of CPU threads which heavy consumers might share
+     */
+    ST_CPPEXPORT int getConcurrencyBudget() const;
+
+    /**
+     * Override concurrency budget (number of logical processors by default).
+     */
+    ST_CPPEXPORT void setConcurrencyBudget(const int theBudget);
+
+    /**
+     * Return the number of codec threads so that specified number of simultaneously active decoders
+     * fit into concurrency budget.
+     * @param theNbDecoders number of decoders sharing the budget
+     */
+    ST_CPPEXPORT int getCodecThreads(const int theNbDecoders) const;
+
+        private:
+
+    typedef std::deque< StHandle<Task> > TaskQueue;
+
+    /**
+     * Main worker with its own queue of normal tasks.
+     */
+    struct Worker {
+        StThreadPool*   Pool;     //!< owning pool
+        int             Index;    //!< worker index
+        mutable StMutex Mutex;    //!< lock for the queue
+        TaskQueue       Queue;    //!< normal tasks pushed to this worker
+        volatile size_t ThreadId; //!< worker thread id (0 until thread is started)
+
+        Worker(StThreadPool* thePool, const int theIndex) : Pool(thePool), Index(theIndex), ThreadId(0) {}
+    };
+
+    /**
+     * Thread function of main worker.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* theWorker);
+
+    /**
+     * Thread function of background worker.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunctionBg(void* thePool);
+
+    /**
+     * Start workers on first push.
+     */
+    ST_LOCAL void startThreads();
+
+    /**
+     * Stop workers.
+     */
+    ST_LOCAL void stopThreads();
+
+    /**
+     * Main worker loop.
+     */
+    ST_LOCAL void workerLoop(const int theWorker);
+
+    /**
+     * Background worker loop.
+     */
+    ST_LOCAL void workerLoopBg();
+
+    /**
+     * Return index of the main worker for current thread or -1.
+     */
+    ST_LOCAL int findWorker(const size_t theThreadId) const;
+
+    /**
+     * Pick the next realtime or normal task for specified worker.
+     */
+    ST_LOCAL bool pickTask(const int       theWorker,
+                           StHandle<Task>& theTask);
+
+    /**
+     * Pop the task from the queue under its lock.
+     * @param theQueue   the queue
+     * @param theMutex   lock of the queue
+     * @param theToFront take the oldest (TRUE) or the newest (FALSE) task
+     */
+    ST_LOCAL static bool popTask(TaskQueue&      theQueue,
+                                 StMutex&        theMutex,
+                                 const bool      theToFront,
+                                 StHandle<Task>& theTask);
+
+    /**
+     * Update maximum number of queued tasks.
+     */
+    ST_LOCAL void updateMaxQueued();
+
+        private:
+
+    std::vector< StHandle<StThread> > myThreads;      //!< all workers (main ones, then background)
+    std::vector< StHandle<Worker> >   myWorkers;      //!< main workers with their queues
+    TaskQueue                         myRealtime;     //!< shared queue of realtime tasks
+    mutable StMutex                   myRtMutex;      //!< lock for realtime queue
+    TaskQueue                         myBackground;   //!< shared queue of background tasks
+    mutable StMutex                   myBgMutex;      //!< lock for background queue
+    mutable StMutex                   myMutex;        //!< lock for workers startup and settings
+    StCondition                       myEventWake;    //!< event waking main workers (runnable tasks or stop request)
+    StCondition                       myEventWakeBg;  //!< event waking background workers
+    StAtomic<int32_t>                 myNbQueued;     //!< number of queued realtime and normal tasks
+    StAtomic<int32_t>                 myNbQueuedBg;   //!< number of queued background tasks
+    StAtomic<int32_t>                 myNbExecuted;   //!< number of executed tasks
+    StAtomic<int32_t>                 myNbStolen;     //!< number of stolen tasks
+    StAtomic<int32_t>                 myNextQueue;    //!< round-robin index for pushes from foreign threads
+    volatile size_t                   myMaxQueued;    //!< maximum number of queued tasks observed
+    int                               myNbThreads;    //!< number of main workers
+    int                               myNbBgThreads;  //!< number of background workers
+    volatile int                      myBudget;       //!< concurrency budget
+    Affinity                          myAffinity;     //!< CPU affinity policy
+    volatile bool                     myIsStarted;    //!< flag indicating that workers have been started
+    volatile bool                     myToQuit;       //!< stop request
+
+};
+
+#endif // __StThreadPool_h_
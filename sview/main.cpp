@@ -9,6 +9,7 @@
 #include "StMultiApp.h"
 #include <StVersion.h>
 #include <StFile/StFolder.h>
+#include <StThreads/StThreadPool.h>
 #include "../StOutPageFlip/StOutPageFlip.h"
 
 #ifdef _WIN32
@@ -54,12 +55,17 @@ int main(int , char** ) {
     StHandle<StApplication>     anApp   = StMultiApp::getInstance(aResMgr);
     for(;;) {
         if(anApp.isNull() || !anApp->open()) {
+            anApp.nullify();
+            StThreadPool::releaseDefault();
             return 1;
         }
 
         int aResult = anApp->exec();
         StHandle<StOpenInfo> anOther = anApp->getOpenFileInOtherDrawer();
         if(anOther.isNull()) {
+            // release application before the pool, so that its background tasks are stopped
+            anApp.nullify();
+            StThreadPool::releaseDefault();
             return aResult;
         }
 